@@ -36,8 +36,11 @@ commands and subcommands are available:
     [template],
     [Generate files from Jinja2 templates using various data sources],
     [], [stub], [Generate Verilog and Liberty stub files for selected modules],
+    [netlist], [trace], [Query the connectivity of a processed netlist],
     [gui], [], [Start the software in GUI mode],
     [agent], [], [Start interactive AI agent for SoC design automation],
+    [batch], [], [Run many commands from a script in one process],
+    [serve], [], [Run a persistent daemon that keeps libraries loaded],
   )],
   caption: [COMMAND LINE INTERFACE],
   kind: table,
@@ -118,6 +121,13 @@ The `module import` command imports Verilog modules into module libraries.
     [Define macro as KEY or KEY=VALUE. Can be used multiple times to define multiple macros],
     [`-U`, `--undefine <macro>`],
     [Undefine macro KEY at the start of all source files. Can be used multiple times],
+    [`--chunk <n>`], [Parse the verilog files in chunks of n files to bound memory use],
+    [`--no-cache`], [Do not reuse or store preprocessed import results],
+    [`--cache`], [Keep preprocessed import results in the user cache for later runs],
+    [`-G`, `--parameterize <set>`],
+    [Also elaborate a module with parameter overrides, written as `module:NAME=VALUE[,NAME=VALUE]`. Can be used multiple times],
+    [`--netlist <file>`], [Also elaborate the modules with the parameters of their netlist instances],
+    [`-j`, `--jobs <n>`], [Number of parameterizations elaborated in parallel, default is all cores],
     [files], [The verilog files to be processed],
   )],
   caption: [MODULE IMPORT OPTIONS],
@@ -154,6 +164,62 @@ qsoc module import -D NEW_FEATURE -U OLD_FEATURE module.v
 qsoc module import -p myproject -l stdlib -D DEBUG=1 -f filelist.txt
 ```
 
+=== Large Libraries
+<module-import-chunk>
+The import extracts the port and parameter descriptors of the matching modules, writes the
+library, and then frees the elaborated design. Its memory is not held for the rest of the
+session, which matters in the `agent`, `serve` and `batch` flows. For very large file lists,
+`--chunk <n>` parses the files n at a time and frees each chunk before the next one starts,
+so peak memory follows the chunk size rather than the whole list. Every chunk is parsed
+separately. Use chunks only when each file is self-contained: a package, macro or include
+defined in one chunk is not visible to the files of another.
+
+```bash
+qsoc module import -l ip_lib -f ip_lib.f --chunk 200
+```
+
+The descriptors of every parsed file list or chunk are cached for the rest of the process,
+so importing the same sources again, for example into another library or with another module
+pattern in an `agent`, `serve` or `batch` session, reuses them without preprocessing. With
+`--cache` they are also kept in `~/.cache/qsoc/import` and reused by later runs. A cached
+result is only used while the source list with its include directories, the `-D` and `-U`
+macros, the working directory, the qsoc version and the content of every file read for it,
+included headers too, are unchanged. Only files that were read are checked: a header added
+to an include directory searched earlier, which would now shadow the one read, is not
+noticed. Delete the cache directory after such changes. `--no-cache` parses the sources
+anyway and leaves the cache untouched.
+
+Several qsoc processes may import into the same library at once, for example one per IP in
+a parallel build. A save holds the lock file `<library>.soc_mod.lock` next to the library
+while it rereads the file and applies only the modules that process changed or removed, so
+no import overwrites another.
+
+Each save still writes the whole library file: the library is YAML that may be edited by
+hand, so qsoc does not splice single modules into it. Batch runs and deferred saves write each
+library once when they end, and splitting a large IP set over several libraries keeps every
+rewrite small.
+
+=== Parameterized Modules
+<module-import-parameterize>
+The descriptor of an imported module holds its port types as elaborated with the default
+parameter values, so the width of a port such as `[WIDTH-1:0]` is only right for instances
+that keep the defaults. `-G` and `--netlist` elaborate
+the imported modules again under other parameter sets and store one descriptor per set below
+the module's `parameterization` key, for example `DEPTH=4,WIDTH=16`. The key lists every
+parameter of the module with the overrides applied, the same way the generator resolves an
+instance, so width checks of such an instance use the exact port types.
+
+The sources are parsed once. Each parameter set elaborates only its module, on its own
+thread, never the whole design. Sets equal to the defaults, or to another set, are skipped.
+
+```bash
+# Elaborate two widths of a FIFO
+qsoc module import -l ip_lib -f ip_lib.f -G fifo:WIDTH=16 -G fifo:WIDTH=64,DEPTH=32
+
+# Elaborate every parameter set used by the instances of a netlist
+qsoc module import -l ip_lib -f ip_lib.f --netlist soc.soc_net -j 8
+```
+
 == BUS COMMAND OPTIONS
 <bus-options>
 The bus command provides functionality for managing bus interfaces.
@@ -198,12 +264,45 @@ The `generate verilog` command generates Verilog code from netlist files.
     [Merge multiple netlist files in order before processing],
     [`-f`, `--force`],
     [Force overwrite existing primitive cell files (clock_cell.v, reset_cell.v)],
+    [`-j`, `--jobs <n>`], [Number of netlist files generated in parallel, default is 1],
+    [`--depfile <file>`], [Write a make or ninja depfile listing the input files of each output],
+    [`--sv-interface`],
+    [Emit bus links as SystemVerilog interfaces instead of flattened wires],
+    [`-w`, `--watch`],
+    [Keep running and regenerate outputs when their input files change],
+    [`--lint`], [Check the generated Verilog with the built-in SystemVerilog compiler],
     [files], [The netlist files to be processed],
   )],
   caption: [VERILOG GENERATION OPTIONS],
   kind: table,
 )
 
+Without `--merge`, every netlist file produces its own Verilog file. With `--jobs` greater
+than one, the files are generated in parallel on copies of the loaded module and bus
+libraries. Messages are still printed in command line order, all files are processed even
+when some fail, and the command exits with an error if any file failed. Merge mode always
+produces a single file and ignores `--jobs`.
+
+With `--sv-interface`, each bus link becomes one instance of a SystemVerilog interface
+instead of one wire per bus signal, and the generated file must be compiled as
+SystemVerilog. See the bus interface format for details.
+
+With `--watch`, the command stays running after the first generation and watches the
+netlist files, the files they include and the module and bus libraries. When a file
+changes, only the libraries that changed are parsed again, and only the outputs that depend
+on a changed file are generated again. A new library file regenerates every output. The
+depfile, when requested, is rewritten after each round. Stop watching with Ctrl+C. Watch
+mode is not available in `serve` or `batch` sessions.
+
+With `--lint`, every generated file is elaborated in process by the built-in slang compiler
+after generation, without an external simulator. The files are checked in parallel, using
+all cores unless `--jobs` is given. Each file is loaded together with the primitive cell
+files, and with `<module>.v` from the output directory for each module it instantiates, such
+as generated sub-netlists. Modules imported into the library have no source attached and
+are treated as black boxes. Syntax errors, width truncation and width expansion are reported
+as `file:line:column: severity: message`, followed by the instance or net in brackets. Any
+error fails the command; warnings do not.
+
 ==== Unconnected Port Report
 <unconnected-port-report>
 The Verilog generation automatically creates an unconnected port report when unconnected ports are detected. The report is saved as `<module_name>.nc.rpt` in YAML format containing:
@@ -249,12 +348,29 @@ The `generate template` command generates files from Jinja2 templates using CSV,
     [`--rdl <file>`], [SystemRDL data file (can be used multiple times)],
     [`--rcsv <file>`],
     [RCSV (Register-CSV) data file (can be used multiple times)],
+    [`--depfile <file>`], [Write a make or ninja depfile listing the input files of each output],
     [templates], [The Jinja2 template files to be processed],
   )],
   caption: [TEMPLATE GENERATION OPTIONS],
   kind: table,
 )
 
+=== Dependency Files
+<generate-depfile>
+Both `generate verilog` and `generate template` accept `--depfile <file>`. After a successful
+run, qsoc writes one make rule per generated file that lists every input actually read: the
+netlist files, the module and bus libraries used by the instances, the template and the
+templates it includes, and all data files. The format is read by make and by ninja, so
+incremental builds can skip qsoc when none of the inputs changed.
+
+```bash
+qsoc generate verilog --depfile build/top.d top.soc_net
+```
+
+```make
+-include build/top.d
+```
+
 === Template Generation Examples
 <template-generation-examples>
 The following examples demonstrate usage of different data sources with template generation:
@@ -320,6 +436,8 @@ The `generate stub` command generates Verilog and Liberty stub files for selecte
     [The library base name or regex pattern to filter libraries],
     [`-m`, `--module <regex>`],
     [The module name or regex pattern to filter modules],
+    [`-t`, `--timing <file>`],
+    [CSV file with default timing arcs and pin capacitance, can be given more than once],
     [stubname],
     [The base name for the generated stub files (generates stubname.v and stubname.lib)],
   )],
@@ -327,4 +445,173 @@ The `generate stub` command generates Verilog and Liberty stub files for selecte
   kind: table,
 )
 
+Liberty cells carry timing when a module, or one of its ports, has a `timing` section.
+Port values override module values. The keys are `clock` (the related clock pin),
+`capacitance`, `max_transition`, `setup`, `hold` and `clk_to_q`. Ports named as a
+related clock become clock pins. A clock that is not a port of the module is reported,
+and the ports using it get no timing arcs. Inputs get setup and hold arcs, outputs get a
+clock-to-output arc whose transition is the `max_transition` value. Every value is
+written as a single-point NLDM table of two shared templates.
+
+```yaml
+sram_macro:
+  timing:
+    clock: clk
+    setup: 0.12
+    hold: 0.03
+    clk_to_q: 0.45
+  port:
+    clk:
+      direction: in
+    addr:
+      type: logic[9:0]
+      direction: in
+      timing:
+        capacitance: 0.004
+```
+
+The same values can come from CSV files with a `module` column, an optional `port`
+column and one column per timing key. A `*` module applies to every selected module,
+and an empty or `*` port sets the module timing. CSV values override the module YAML,
+so a library can be characterized without editing its module files.
+
+```csv
+module,port,clock,setup,hold,clk_to_q,capacitance,max_transition
+*,,clk,0.1,0.05,0.3,,
+sram_macro,addr,,,,,0.004,
+sram_macro,dout,,,,0.5,,0.2
+```
+
+== NETLIST COMMAND OPTIONS
+<netlist-command>
+The netlist command inspects netlist files without generating any output.
+
+=== Netlist Trace Options
+<netlist-trace>
+The `netlist trace` command answers connectivity queries on a netlist after links,
+uplinks and buses have been expanded, exactly as `generate verilog` sees it. The
+netlist is indexed once, and each query is a breadth-first search that visits every
+net at most once, so queries on designs with many thousands of nets return at once.
+Instance arrays are not part of the index, so connections through them are not
+traced. Sub-netlists are expanded for their ports, but a query writes no files, not
+even the Verilog of sub-netlists.
+
+#figure(
+  align(center)[#table(
+    columns: (0.5fr, 1fr),
+    align: (auto, left),
+    table.header([Option], [Description]),
+    table.hline(),
+    [`-d`, `--directory <path>`], [The path to the project directory],
+    [`-p`, `--project <name>`], [The project name],
+    [`--depth <n>`], [Number of levels for `fanout` and `fanin`, defaults to 1],
+    [netlist], [The netlist file to query],
+    [query], [One of `driver`, `fanout`, `fanin`, `path` or `bits`],
+    [target], [A net name, a pin as `instance.port`, or an instance name],
+    [to], [The end target of a `path` query],
+  )],
+  caption: [NETLIST TRACE OPTIONS],
+  kind: table,
+)
+
+Top-level ports appear as pins of the instance `top`. An input port drives its net
+and an output port is a load. Instances are treated as black boxes: every input of
+an instance reaches every output, and a search continues through them.
+
+- `driver` lists the pins driving the target net, or each net read by a pin or
+  instance target, and reports nets without a driver.
+- `fanout` lists the loads reached from the target, one level per instance crossed.
+- `fanin` lists the drivers reaching the target, in the same way.
+- `path` prints a shortest path from the target to the end target along the signal
+  flow, alternating nets and the instance pins crossed.
+- `bits` lists the bit range of every pin on a net, then the ranges with no driver
+  and the ranges with more than one driver.
+
+```bash
+$ qsoc netlist trace soc.soc_net fanout u_cpu.irq_ack --depth 2
+1 irq_ack -> u_plic.ack
+2 irq_mask -> u_gpio.mask
+$ qsoc netlist trace soc.soc_net path clk_core u_uart
+clk_core -> u_cpu.clk -> u_cpu.uart_en -> uart_en -> u_uart.en
+$ qsoc netlist trace soc.soc_net bits gpio_out
+[15:0] driver u_gpio.out[15:0]
+[31:0] load top.gpio_out
+[31:16] undriven
+```
+
+Instance arrays and the nets written by `comb`, `seq` and `fsm` sections are not
+part of the graph.
+
+== BATCH COMMAND OPTIONS
+<batch-command>
+The `batch` command runs every command of a script in a single process. Module and
+bus libraries are loaded once and shared by all commands, and library saves are
+written once when the script ends instead of after every command. Consecutive
+`generate` commands do not depend on each other and run concurrently. Pending
+library saves are written before such a group starts. Execution stops at the first
+failing command, and its line is reported. Module and bus library files are replaced
+atomically, so an interrupted run leaves either the old or the new library on disk.
+
+#figure(
+  align(center)[#table(
+    columns: (0.5fr, 1fr),
+    align: (auto, left),
+    table.header([Option], [Description]),
+    table.hline(),
+    [`-j`, `--jobs <n>`],
+    [Number of generate commands run concurrently, defaults to the number of CPU cores],
+    [script],
+    [Text file with one command per line, or a YAML list when the file ends with
+      `.yml` or `.yaml`],
+  )],
+  caption: [BATCH OPTIONS],
+  kind: table,
+)
+
+In text scripts, blank lines and lines starting with `#` are ignored, and arguments
+are split with shell-like quoting. The leading `qsoc` is optional. YAML list items
+are either a command line string or a list of arguments.
+
+```bash
+# setup.qsoc
+module import -d myproject -l cpu rtl/c906.v
+module bus add -d myproject -m c906 -b axi4 -o slave axi
+generate verilog -d myproject soc.soc_net
+generate verilog -d myproject periph.soc_net
+```
+
+== SERVE COMMAND OPTIONS
+<serve-command>
+The `serve` command runs a long-lived daemon on a local socket. The daemon keeps
+module and bus libraries loaded between commands and only re-reads a library file
+after it has changed, so build scripts that call `qsoc` many times avoid the
+startup and parsing cost of every invocation. Library directories are watched,
+adding or removing library files drops the cached data.
+
+#figure(
+  align(center)[#table(
+    columns: (0.5fr, 1fr),
+    align: (auto, left),
+    table.header([Option], [Description]),
+    table.hline(),
+    [`-s`, `--socket <name>`],
+    [The local socket name or path, defaults to `qsoc-<user>.sock` in the temporary directory],
+    [`--stop`], [Stop the daemon listening on the socket],
+  )],
+  caption: [SERVE OPTIONS],
+  kind: table,
+)
+
+Clients use the daemon when the `QSOC_SERVER` environment variable names its socket.
+The command line, working directory and environment are forwarded, output is streamed
+back to stdout and stderr, and the exit code is preserved. When no daemon answers, the
+command runs locally as usual. The `gui`, `agent` and `serve` commands always run locally.
+
+```bash
+qsoc serve &
+export QSOC_SERVER=qsoc-$USER.sock
+qsoc generate verilog -d myproject soc.soc_net
+qsoc serve --stop
+```
+
 #pagebreak()
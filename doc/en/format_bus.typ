@@ -248,6 +248,43 @@ Bus connection properties include:
   kind: table,
 )
 
+=== SystemVerilog Interface Mode
+<soc-net-bus-interface>
+By default every bus link is flattened into one wire per bus signal, as Verilog-2001 requires. Large crossbars then produce thousands of wire declarations. With `qsoc generate verilog --sv-interface`, each bus link is instead emitted as a single instance of a SystemVerilog interface, and instance ports connect to its signals:
+
+```verilog
+    /* Bus interfaces */
+    soc_top_axi4_if cpu_ram_bus ();
+
+    /* Module instantiations */
+    cpu u_cpu (
+        .m_axi_awaddr(cpu_ram_bus.awaddr),
+        ...
+    );
+
+endmodule
+
+interface soc_top_axi4_if;
+    logic [31:0] awaddr;
+    logic awvalid;
+    ...
+
+    modport master (
+        output awaddr,
+        output awvalid,
+        ...
+    );
+
+    modport slave (
+        input awaddr,
+        input awvalid,
+        ...
+    );
+endinterface
+```
+
+The interface holds the signals of the `.soc_bus` definition that the link uses, in definition order, with the same widths the flattened wires would have. It has one modport per bus mode, such as `master` and `slave`, using the directions of that mode. Links of the same bus type and widths share one definition. The definition is named `<module>_<bus>_if`, with a numeric suffix for other widths, so that generated files can be compiled together. Nets that are not bus signals are still declared as wires. Logic in `comb`, `seq` or `fsm` sections must refer to a bus signal as `<link>.<signal>`. Since no flattened wire is declared, generation stops with an error when a `comb`, `seq`, `fsm`, `reset`, `clock` or `power` section names the flattened net, such as `cpu_ram_bus_awaddr`.
+
 == BIT SELECTION
 <soc-net-bit-selection>
 Bit selection allows connecting specific bits of a port to a net, enabling flexible signal routing and bus segmentation. This feature is supported by the `link` attribute and explicit `net` definitions.
@@ -905,11 +905,11 @@ endmodule
 
 === Diagram Output
 <soc-net-clock-diagram>
-Generates `.typ` circuit diagram alongside Verilog.
+Generates `.typ` circuit diagram and `.svg` image alongside Verilog. The SVG is rendered in process from the same layout, so it needs no Typst installation; the render time is logged.
 
 *Elements*: Inputs → MUX → ICG/DIV/INV → Outputs (with frequencies/parameters)
 
-*Files*: `<module>.v`, `<module>.typ` (compile: `typst compile <module>.typ`)
+*Files*: `<module>.v`, `<module>.typ` (compile: `typst compile <module>.typ`), `<module>.svg`
 
 === Syntax Summary
 <soc-net-clock-syntax-summary>
@@ -88,6 +88,7 @@ Instance properties include:
     table.header([Property], [Description]),
     table.hline(),
     [module], [Module name (must exist in the module library)],
+    [netlist], [Sub-netlist file used instead of a library module, see below],
     [parameter], [Optional module parameters (name-value pairs)],
     [port], [Optional port-specific attributes like tie values],
     [ifdef],
@@ -99,6 +100,66 @@ Instance properties include:
   kind: table,
 )
 
+=== Sub-netlists
+<soc-net-instance-netlist>
+An instance can reference another `.soc_net` file with `netlist` instead of a library module, which builds a hierarchy without importing generated Verilog back into the library:
+
+```yaml
+instance:
+  u_cluster0:
+    netlist: cluster.soc_net   # Relative to this netlist file
+    parameter:
+      CORE_NUM: 4
+  u_cluster1:
+    netlist: cluster.soc_net
+```
+
+The sub-netlist is processed and written as `<file base name>.v`, here `cluster.v`, and the instances use the module `cluster`. Its top-level `port` and `parameter` sections are the interface seen by the instantiating netlist, so links, uplinks, bus expansion and width checks work as for library modules. Sub-netlists may instantiate further sub-netlists; a netlist that instantiates itself, directly or indirectly, is an error.
+
+Parameter overrides on a `netlist` instance must be constant expressions of the instantiating netlist's parameters, and must name parameters declared by the sub-netlist. Each distinct set of values that differs from the sub-netlist defaults produces its own module, named `<file base name>_<hash>` and written as `<file base name>_<hash>.v`, whose parameter defaults are the override values. Internal wires of that module are therefore as wide as the overrides require. In the example above, `u_cluster0` uses a module such as `cluster_3f2a9c1e`, while `u_cluster1` uses `cluster`.
+
+Each distinct sub-netlist and parameter set is generated once however many times it is instantiated. Results are cached by the content hash of the sub-netlist file and its parameter set, and reused by later netlists of the same command, as long as none of the files it read have changed and its output file still exists.
+
+=== Instance Arrays
+<soc-net-instance-array>
+Many identical instances, such as the cores of a cluster or the banks of a memory, can be written once as an instance array by appending an index range to the instance name. Within the array, `{i}` in a `parameter`, `link` or `tie` value stands for the index:
+
+```yaml
+instance:
+  u_core[0:63]:
+    module: core
+    parameter:
+      CORE_ID: "{i}"
+    port:
+      clk:
+        link: clk                      # Shared by every core
+      irq:
+        link: "irq[{i}]"               # One bit per core
+      rdata:
+        link: "rdata[{i}*32 +: 32]"    # One 32-bit slice per core
+```
+
+The array is not expanded. It is emitted as a single `generate for` loop with the genvar `u_core_i` and the block label `gen_u_core`, so netlist processing time and output size do not depend on the array length:
+
+```verilog
+    genvar u_core_i;
+    generate
+        for (u_core_i = 0; u_core_i <= 63; u_core_i = u_core_i + 1) begin : gen_u_core
+            core #(
+                .CORE_ID(u_core_i)
+            ) u_core (
+                .clk(clk),
+                .irq(irq[u_core_i]),
+                .rdata(rdata[u_core_i*32 +: 32])
+            );
+        end
+    endgenerate
+```
+
+Nets linked only by arrays are declared wide enough for the selects at the first and last index, here `wire [63:0] irq` and `wire [2047:0] rdata`. Each port links one net, using `{i}` only inside its bit select; per-index net names, `uplink` and `bus` connections are not supported on arrays. Quote values containing `{i}`, since braces start a YAML flow mapping.
+
+An array may also link a net of the `net` section or a top-level port. Such a net keeps its own declaration, and when the array selects bits beyond its declared width, for example `data[8*{i} +: 8]` over four cores on an 8-bit `data`, generation warns and writes a FIXME comment next to the wire declarations. With `--sv-interface`, a link to a bus signal refers to the signal of the interface instance. Arrays are not part of the direction and multiple driver checks of the `net` section, and `netlist trace` does not follow connections through them.
+
 === Conditional Compilation
 <soc-net-instance-ifdef>
 Instances support conditional compilation via `ifdef`/`ifndef` lists:
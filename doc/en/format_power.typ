@@ -227,11 +227,11 @@ qsoc_power_rst_sync #(.STAGE(4)) u_rst_sync_gpu_0 (
 
 === Diagram Output
 <soc-net-power-diagram>
-Generates `.typ` circuit diagram alongside Verilog.
+Generates `.typ` circuit diagram and `.svg` image alongside Verilog. The SVG is rendered in process from the same layout, so it needs no Typst installation; the render time is logged.
 
 *Elements*: Domains → FSM → SYNC → Ready (with dependencies/timing/parameters)
 
-*Files*: `<module>.v`, `<module>.typ` (compile: `typst compile <module>.typ`)
+*Files*: `<module>.v`, `<module>.typ` (compile: `typst compile <module>.typ`), `<module>.svg`
 
 == PROPERTIES
 <soc-net-power-properties>
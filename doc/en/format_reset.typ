@@ -511,13 +511,13 @@ endmodule
 
 === Diagram Output
 <soc-net-reset-diagram>
-Generates `.typ` circuit diagram alongside Verilog.
+Generates `.typ` circuit diagram and `.svg` image alongside Verilog. The SVG is rendered in process from the same layout, so it needs no Typst installation; the render time is logged.
 
 *Elements*: Sources → AND → ASYNC/SYNC/COUNT → Targets (with active levels/parameters)
 
 *Note*: AND logic is used because reset signals are active-low. When any source asserts (goes low), the AND output goes low, asserting the target reset. This is equivalent to OR logic for the reset assertion semantic.
 
-*Files*: `<module>.v`, `<module>.typ` (compile: `typst compile <module>.typ`)
+*Files*: `<module>.v`, `<module>.typ` (compile: `typst compile <module>.typ`), `<module>.svg`
 
 == BEST PRACTICES
 <soc-net-reset-practices>
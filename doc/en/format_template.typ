@@ -33,6 +33,11 @@ QSoC uses the Inja template engine, which provides:
 - Filters: `{{ value | filter_name(args) }}`
 - Comments: `{# This is a comment #}`
 
+The rendered text is written to the output file while the template runs, so memory use
+does not grow with the size of the output. A multi-gigabyte register model or memory
+initialization file needs no more memory than its data. The output file is replaced only
+when rendering succeeds, and a failed render leaves the previous output in place.
+
 == REGEX FILTERS
 <regex-filters>
 QSoC provides three powerful regex filters for text processing within templates. All filters support inline modifiers for pattern matching options.
@@ -140,6 +145,43 @@ Use inline modifiers instead of separate parameters:
 {{ text | regex_search("name:(?i:[a-z]+)") }}
 ````
 
+== JOIN FILTERS
+<join-filters>
+Joining two data sources with nested loops scans the inner source once per outer element,
+which is slow on large register tables. The join filters look elements up by key through
+hash indexes instead. `lookup(array, key, value)` builds an index over an array of the input
+data the first time it is used and reuses it for the rest of the render. `index_by` and
+`group_by` build a new object on every call, so a call inside a loop is as slow as the nested
+loop; qsoc warns when either is called twice on the same array and key. Key values are
+compared as text, so `5` and `"5"` are the same key. A key may name a nested field with dots,
+such as `"reset.value"`.
+
+#figure(
+  align(center)[#table(
+    columns: (0.4fr, 1fr),
+    align: (auto, left),
+    table.header([Filter], [Result]),
+    table.hline(),
+    [`index_by(array, key)`], [Object of the first element for each key value],
+    [`group_by(array, key)`], [Object of the element arrays for each key value, in array order],
+    [`lookup(index, value)`], [Entry of an `index_by` or `group_by` object, null if absent],
+    [`lookup(array, key, value)`], [First element whose key equals the value, null if absent],
+    [`sort_by(array, key, reverse)`], [Array stably sorted by key value, `reverse` is optional],
+  )],
+  caption: [JOIN FILTERS],
+  kind: table,
+)
+
+Build an index once with `set` before the loop and look elements up in it:
+````
+{% set regs = index_by(registers, "name") %}
+{% for f in fields %}{% set r = lookup(regs, f.reg) %}
+{{ f.name }} at {{ r.offset }}
+{% endfor %}
+
+{% for r in sort_by(registers, "offset") %}{{ r.name }} {% endfor %}
+````
+
 == DATA ACCESS PATTERNS
 <data-access-patterns>
 Template data is organized based on input file types and can be accessed using standard Inja syntax.
@@ -119,6 +119,8 @@ QSoC performs automatic width checking for all connections:
 
 This automatic checking helps catch design errors early in the development process and ensures signal integrity across the design hierarchy.
 
+Port ranges may be constant expressions over parameters, such as `logic[DATA_W-1:0]` or `logic[$clog2(DEPTH):0]`. Module port ranges are evaluated with the module parameter defaults and the instance `parameter` overrides, and override values may use the top-level netlist parameters. Each distinct module parameterization is evaluated once, so many instances of the same module cost no more than one. Ranges that cannot be evaluated, for example because they use an unknown name, are left out of the comparison instead of being treated as one bit.
+
 == BEST PRACTICES FOR VALIDATION
 <soc-net-validation-practices>
 
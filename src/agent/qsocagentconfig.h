@@ -91,6 +91,7 @@ Workflow: query_docs → understand format → file_write .soc_net → generate_
 - bus_import/list/show: Manage bus definitions
 - generate_verilog: Generate RTL from .soc_net netlist (clock/reset/power/fsm primitives + module instances)
 - generate_template: Render Jinja2 templates with CSV/YAML/JSON/SystemRDL/RCSV data
+- netlist_trace: Query netlist connectivity: driver, fanout, fanin, path, bits of a net/pin/instance
 
 ### Documentation & Skills
 - query_docs: Query built-in docs. Topics: about, commands, config, datasheet, bus, clock, fsm, logic, netlist, format_overview, power, reset, template, validation, overview
@@ -229,3 +229,131 @@ void QSocToolGenerateTemplate::setGenerateManager(QSocGenerateManager *generateM
 {
     generateManager = generateManager;
 }
+
+/* QSocToolNetlistTrace Implementation */
+
+QSocToolNetlistTrace::QSocToolNetlistTrace(QObject *parent, QSocGenerateManager *generateManager)
+    : QSocTool(parent)
+    , generateManager(generateManager)
+{}
+
+QSocToolNetlistTrace::~QSocToolNetlistTrace() = default;
+
+QString QSocToolNetlistTrace::getName() const
+{
+    return "netlist_trace";
+}
+
+QString QSocToolNetlistTrace::getDescription() const
+{
+    return "Query the connectivity of a netlist after link, uplink and bus expansion. "
+           "Finds the drivers of a net, the fanout or fanin of a net, pin or instance, "
+           "a path between two of them, or the bit slices of a net and their owners.";
+}
+
+json QSocToolNetlistTrace::getParametersSchema() const
+{
+    return {
+        {"type", "object"},
+        {"properties",
+         {{"netlist_file",
+           {{"type", "string"}, {"description", "Path to the netlist YAML file to query"}}},
+          {"query",
+           {{"type", "string"},
+            {"enum", json::array({"driver", "fanout", "fanin", "path", "bits"})},
+            {"description", "Query to run"}}},
+          {"target",
+           {{"type", "string"},
+            {"description", "Net name, instance.port pin or instance name to query"}}},
+          {"to", {{"type", "string"}, {"description", "End target of a path query"}}},
+          {"depth",
+           {{"type", "integer"},
+            {"description", "Number of levels for fanout and fanin queries (default: 1)"}}}}},
+        {"required", json::array({"netlist_file", "query", "target"})}};
+}
+
+QString QSocToolNetlistTrace::execute(const json &arguments)
+{
+    if (!generateManager) {
+        return "Error: Generate manager not configured";
+    }
+
+    if (!arguments.contains("netlist_file") || !arguments["netlist_file"].is_string()) {
+        return "Error: netlist_file is required";
+    }
+
+    if (!arguments.contains("query") || !arguments["query"].is_string()) {
+        return "Error: query is required";
+    }
+
+    if (!arguments.contains("target") || !arguments["target"].is_string()) {
+        return "Error: target is required";
+    }
+
+    const QString netlistFile = QString::fromStdString(
+        arguments["netlist_file"].get<std::string>());
+    const QString query  = QString::fromStdString(arguments["query"].get<std::string>());
+    const QString target = QString::fromStdString(arguments["target"].get<std::string>());
+
+    if (!QSocNetlistGraph::queryNames().contains(query)) {
+        return QString("Error: Unknown query: %1").arg(query);
+    }
+
+    QString endTarget;
+    if (query == "path") {
+        if (!arguments.contains("to") || !arguments["to"].is_string()) {
+            return "Error: to is required for path queries";
+        }
+        endTarget = QString::fromStdString(arguments["to"].get<std::string>());
+    }
+
+    int depth = 1;
+    if (arguments.contains("depth") && arguments["depth"].is_number_integer()) {
+        depth = arguments["depth"].get<int>();
+        if (depth < 1) {
+            return "Error: depth must be at least 1";
+        }
+    }
+
+    /* Check if netlist file exists */
+    QFileInfo fileInfo(netlistFile);
+    if (!fileInfo.exists()) {
+        return QString("Error: Netlist file not found: %1").arg(netlistFile);
+    }
+
+    /* Load and process netlist */
+    if (!generateManager->loadNetlist(netlistFile)) {
+        return QString("Error: Failed to load netlist file: %1").arg(netlistFile);
+    }
+
+    if (!generateManager->processNetlist()) {
+        return "Error: Failed to process netlist";
+    }
+
+    const QSocNetlistGraph graph = generateManager->buildNetlistGraph();
+    QStringList            result;
+    switch (graph.query(query, target, endTarget, depth, result)) {
+    case QSocNetlistGraph::QueryStatus::Ok:
+        break;
+    case QSocNetlistGraph::QueryStatus::UnknownQuery:
+        return QString("Error: Unknown query: %1").arg(query);
+    case QSocNetlistGraph::QueryStatus::UnknownTarget:
+        return QString("Error: Unknown net, pin or instance: %1").arg(target);
+    case QSocNetlistGraph::QueryStatus::UnknownEndTarget:
+        return QString("Error: Unknown net, pin or instance: %1").arg(endTarget);
+    case QSocNetlistGraph::QueryStatus::NoPath:
+        return QString("No path from %1 to %2").arg(target, endTarget);
+    case QSocNetlistGraph::QueryStatus::NotNet:
+        return QString("Error: Not a net: %1").arg(target);
+    }
+
+    if (result.isEmpty()) {
+        return QString("No %1 results for: %2").arg(query, target);
+    }
+    return result.join("\n");
+}
+
+void QSocToolNetlistTrace::setGenerateManager(QSocGenerateManager *generateManager)
+{
+    this->generateManager = generateManager;
+}
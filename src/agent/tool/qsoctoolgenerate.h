@@ -53,4 +53,27 @@ private:
     QSocGenerateManager *generateManager = nullptr;
 };
 
+/**
+ * @brief Tool to query the connectivity of a processed netlist
+ */
+class QSocToolNetlistTrace : public QSocTool
+{
+    Q_OBJECT
+
+public:
+    explicit QSocToolNetlistTrace(
+        QObject *parent = nullptr, QSocGenerateManager *generateManager = nullptr);
+    ~QSocToolNetlistTrace() override;
+
+    QString getName() const override;
+    QString getDescription() const override;
+    json    getParametersSchema() const override;
+    QString execute(const json &arguments) override;
+
+    void setGenerateManager(QSocGenerateManager *generateManager);
+
+private:
+    QSocGenerateManager *generateManager = nullptr;
+};
+
 #endif // QSOCTOOLGENERATE_H
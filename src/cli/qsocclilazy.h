@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCCLILAZY_H
+#define QSOCCLILAZY_H
+
+#include <functional>
+#include <utility>
+
+/**
+ * @brief Pointer to an object that is created on first use.
+ * @details Behaves like a plain pointer for member access, conversion and
+ *          truth tests, but runs the factory only when the object is first
+ *          needed. Commands that never touch a heavyweight service therefore
+ *          never pay for its construction. An existing object can also be
+ *          assigned directly, in which case the factory is never called.
+ * @tparam T The object type.
+ */
+template<typename T>
+class QSocCliLazy
+{
+public:
+    using Factory = std::function<T *()>;
+
+    QSocCliLazy() = default;
+
+    /**
+     * @brief Construct with a factory.
+     * @param[in] factory Creates the object, called at most once.
+     */
+    explicit QSocCliLazy(Factory factory)
+        : factory(std::move(factory))
+    {}
+
+    /**
+     * @brief Use an existing object instead of creating one.
+     * @param[in] object The object, owned by the caller.
+     * @return QSocCliLazy& This lazy pointer.
+     */
+    QSocCliLazy &operator=(T *object)
+    {
+        this->object = object;
+        return *this;
+    }
+
+    /**
+     * @brief Get the object, creating it when needed.
+     * @return T* The object.
+     */
+    T *get()
+    {
+        if (!object && factory) {
+            object = factory();
+        }
+        return object;
+    }
+
+    /**
+     * @brief Check whether the object exists without creating it.
+     * @retval true The object was created or assigned.
+     * @retval false The object was not needed yet.
+     */
+    bool isCreated() const { return object != nullptr; }
+
+    T *operator->() { return get(); }
+
+    T &operator*() { return *get(); }
+
+    operator T *() { return get(); }
+
+private:
+    Factory factory;
+    T      *object = nullptr;
+};
+
+#endif // QSOCCLILAZY_H
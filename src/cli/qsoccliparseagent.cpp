@@ -414,8 +414,10 @@ bool QSocCliWorker::parseAgent(const QStringList &appArguments)
     /* Generate tools */
     auto *generateVerilogTool  = new QSocToolGenerateVerilog(this, generateManager);
     auto *generateTemplateTool = new QSocToolGenerateTemplate(this, generateManager);
+    auto *netlistTraceTool     = new QSocToolNetlistTrace(this, generateManager);
     toolRegistry->registerTool(generateVerilogTool);
     toolRegistry->registerTool(generateTemplateTool);
+    toolRegistry->registerTool(netlistTraceTool);
 
     /* Path context (must be before file tools) */
     auto *pathContext     = new QSocPathContext(this, projectManager);
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+
+#include "common/qstaticlog.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+
+namespace {
+
+/* One command of a batch script */
+struct BatchCommand
+{
+    int         line = 0;  /* Script line or list item number, for messages */
+    QStringList arguments; /* Full command line, program name first */
+};
+
+/* Message logged by a command running on a pool thread */
+struct BatchMessage
+{
+    QtMsgType type;
+    QString   text;
+};
+
+QStringList batchArguments(QStringList words)
+{
+    /* The program name is optional in scripts */
+    if (!words.isEmpty() && words.first() == "qsoc") {
+        words.removeFirst();
+    }
+    words.prepend("qsoc");
+    return words;
+}
+
+bool isGenerateCommand(const BatchCommand &command)
+{
+    /* Find the subcommand with the root options of the worker */
+    QCommandLineParser parser;
+    parser.addOptions(QSocCliWorker::rootOptions());
+    parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsPositionalArguments);
+    parser.parse(command.arguments);
+    return parser.positionalArguments().value(0) == "generate";
+}
+
+bool loadBatchYaml(const QString &scriptPath, QList<BatchCommand> &commandList, QString &error)
+{
+    try {
+        const YAML::Node script = YAML::LoadFile(scriptPath.toStdString());
+        if (!script.IsSequence()) {
+            error = QCoreApplication::translate("main", "Error: batch script is not a list: %1")
+                        .arg(scriptPath);
+            return false;
+        }
+        for (std::size_t index = 0; index < script.size(); ++index) {
+            const YAML::Node item = script[index];
+            QStringList      words;
+            if (item.IsScalar()) {
+                words = QProcess::splitCommand(QString::fromStdString(item.as<std::string>()));
+            } else if (item.IsSequence()) {
+                for (const YAML::Node &word : item) {
+                    words.append(QString::fromStdString(word.as<std::string>()));
+                }
+            } else {
+                error = QCoreApplication::translate(
+                            "main", "Error: invalid batch command at item %1: %2")
+                            .arg(index + 1)
+                            .arg(scriptPath);
+                return false;
+            }
+            if (!words.isEmpty()) {
+                commandList.append({static_cast<int>(index + 1), batchArguments(words)});
+            }
+        }
+    } catch (const YAML::Exception &e) {
+        error = QCoreApplication::translate("main", "Error parsing YAML file: %1: %2")
+                    .arg(scriptPath, e.what());
+        return false;
+    }
+    return true;
+}
+
+bool loadBatchText(const QString &scriptPath, QList<BatchCommand> &commandList, QString &error)
+{
+    QFile file(scriptPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = QCoreApplication::translate("main", "Error: unable to open batch script: %1")
+                    .arg(scriptPath);
+        return false;
+    }
+    QTextStream stream(&file);
+    int         line = 0;
+    while (!stream.atEnd()) {
+        const QString text = stream.readLine().trimmed();
+        ++line;
+        /* Skip blank lines and comments */
+        if (text.isEmpty() || text.startsWith('#')) {
+            continue;
+        }
+        const QStringList words = QProcess::splitCommand(text);
+        if (!words.isEmpty()) {
+            commandList.append({line, batchArguments(words)});
+        }
+    }
+    return true;
+}
+
+/* Run commands on a thread pool, each with its own set of managers */
+std::vector<int> runBatchConcurrent(
+    const QList<BatchCommand> &commandList, int jobs, std::vector<QList<BatchMessage>> &outputList)
+{
+    std::vector<int> exitCodeList(commandList.size(), 1);
+    outputList.assign(commandList.size(), QList<BatchMessage>());
+
+    /* Every worker starts at the batch level and keeps its changes to itself */
+    const QStaticLog::Level level = QStaticLog::getLevel();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    for (qsizetype index = 0; index < commandList.size(); ++index) {
+        pool.start([&commandList, &exitCodeList, &outputList, index, level]() {
+            /* Capture output so that it can be replayed in script order */
+            QList<BatchMessage> &output = outputList[index];
+            QStaticLog::setOutputSink([&output](QtMsgType type, const QString &text) {
+                output.append({type, text});
+            });
+            QStaticLog::setThreadLevel(level);
+            {
+                QSocCliWorker worker;
+                exitCodeList[index] = worker.execute(commandList.at(index).arguments);
+            }
+            QStaticLog::clearThreadLevel();
+            QStaticLog::setOutputSink(nullptr);
+        });
+    }
+    pool.waitForDone();
+    return exitCodeList;
+}
+
+} /* namespace */
+
+bool QSocCliWorker::parseBatch(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addOptions({
+        {{"j", "jobs"},
+         QCoreApplication::translate(
+             "main",
+             "Number of consecutive generate commands run concurrently,\n"
+             "default is the number of CPU cores."),
+         "jobs"},
+    });
+    parser.addPositionalArgument(
+        "script",
+        QCoreApplication::translate(
+            "main",
+            "The batch script, one qsoc command per line, or a YAML list\n"
+            "of command lines when the file ends with .yml or .yaml."),
+        "<script>");
+
+    parser.parse(appArguments);
+
+    if (parser.isSet("help")) {
+        return showHelp(0);
+    }
+
+    const QStringList cmdArguments = parser.positionalArguments();
+    if (cmdArguments.isEmpty()) {
+        return showHelpOrError(
+            1, QCoreApplication::translate("main", "Error: missing batch script."));
+    }
+
+    int jobs = QThread::idealThreadCount();
+    if (parser.isSet("jobs")) {
+        bool ok = false;
+        jobs    = parser.value("jobs").toInt(&ok);
+        if (!ok || jobs < 1) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid number of jobs: %1.")
+                    .arg(parser.value("jobs")));
+        }
+    }
+
+    /* Load the whole script before running anything */
+    const QString       scriptPath = cmdArguments.first();
+    const QString       suffix     = QFileInfo(scriptPath).suffix().toLower();
+    QList<BatchCommand> commandList;
+    QString             error;
+    const bool          loaded = (suffix == "yml" || suffix == "yaml")
+                                     ? loadBatchYaml(scriptPath, commandList, error)
+                                     : loadBatchText(scriptPath, commandList, error);
+    if (!loaded) {
+        return showError(1, error);
+    }
+
+    /* Commands share the libraries, saves are written once at the end */
+    const bool moduleLibraryCache = moduleManager->isLibraryCache();
+    const bool busLibraryCache    = busManager->isLibraryCache();
+    moduleManager->setDeferredSave(true);
+    busManager->setDeferredSave(true);
+
+    Managers managers;
+    managers.socConfig       = socConfig;
+    managers.llmService      = llmService;
+    managers.busManager      = busManager;
+    managers.moduleManager   = moduleManager;
+    managers.generateManager = generateManager;
+
+    QSocProjectManager *const batchProject   = projectManager;
+    QSocProjectManager       *commandProject = nullptr;
+    const QStaticLog::Level   level          = QStaticLog::getLevel();
+
+    bool result = true;
+    for (qsizetype index = 0; result && index < commandList.size();) {
+        /* Consecutive generate commands do not depend on each other */
+        qsizetype end = index + 1;
+        if (jobs > 1 && isGenerateCommand(commandList.at(index))) {
+            while (end < commandList.size() && isGenerateCommand(commandList.at(end))) {
+                ++end;
+            }
+        }
+
+        if (end - index > 1) {
+            /* Concurrent steps load libraries from disk, write edits first */
+            const bool busFlushed = busManager->flush();
+            if (!moduleManager->flush() || !busFlushed) {
+                result = showError(
+                    1, QCoreApplication::translate("main", "Error: failed to save libraries."));
+                break;
+            }
+            const QList<BatchCommand>        group = commandList.mid(index, end - index);
+            std::vector<QList<BatchMessage>> outputList;
+            const std::vector<int> exitCodeList = runBatchConcurrent(group, jobs, outputList);
+            for (qsizetype item = 0; item < group.size(); ++item) {
+                for (const BatchMessage &message : outputList[item]) {
+                    QStaticLog::replayMessage(message.type, message.text);
+                }
+                if (result && exitCodeList[item] != 0) {
+                    result = showError(
+                        exitCodeList[item],
+                        QCoreApplication::translate(
+                            "main", "Error: batch command failed at line %1: %2")
+                            .arg(group.at(item).line)
+                            .arg(group.at(item).arguments.join(' ')));
+                }
+            }
+        } else {
+            /* Fresh project state for every command, libraries stay shared */
+            const BatchCommand &command = commandList.at(index);
+            QSocProjectManager *project = new QSocProjectManager(this);
+            managers.attachProject(project);
+            delete commandProject;
+            commandProject = project;
+
+            int commandExitCode = 0;
+            {
+                QSocCliWorker worker(nullptr, managers);
+                commandExitCode = worker.execute(command.arguments);
+            }
+            QStaticLog::setLevel(level);
+            if (commandExitCode != 0) {
+                result = showError(
+                    commandExitCode,
+                    QCoreApplication::translate(
+                        "main", "Error: batch command failed at line %1: %2")
+                        .arg(command.line)
+                        .arg(command.arguments.join(' ')));
+            }
+        }
+        index = end;
+    }
+
+    /* Write every deferred library save at once */
+    const bool busFlushed = busManager->flush();
+    const bool flushed    = moduleManager->flush() && busFlushed;
+    moduleManager->setDeferredSave(false);
+    busManager->setDeferredSave(false);
+    moduleManager->setLibraryCache(moduleLibraryCache);
+    busManager->setLibraryCache(busLibraryCache);
+    managers.attachProject(batchProject);
+    delete commandProject;
+
+    if (!flushed) {
+        return showError(
+            1, QCoreApplication::translate("main", "Error: failed to save libraries."));
+    }
+    return result;
+}
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
 
 #include "cli/qsoccliworker.h"
+#include "common/qslangdriver.h"
 #include "common/qsocconfig.h"
 #include "common/qsocgeneratemanager.h"
 #include "common/qsocmodulemanager.h"
@@ -9,13 +10,68 @@
 #include "common/qsocyamlutils.h"
 #include "common/qstaticlog.h"
 
-#include <fstream>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QGuiApplication>
+#include <QSaveFile>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/* Outcome and messages of one netlist file generated on a pool thread */
+struct NetlistResult
+{
+    bool                             success = false;
+    QString                          error;
+    QList<QPair<QtMsgType, QString>> messageList;
+    QStringList                      dependencyList;
+};
+
+/* Load, process and write one netlist file */
+bool generateNetlistFile(
+    QSocGenerateManager *generateManager, const QString &netlistFilePath, QString &error)
+{
+    /* Check if the netlist file exists before trying to load it */
+    if (!QFile::exists(netlistFilePath)) {
+        error = QCoreApplication::translate("main", "Error: Netlist file does not exist: \"%1\"")
+                    .arg(netlistFilePath);
+        return false;
+    }
+
+    /* Load the netlist file */
+    if (!generateManager->loadNetlist(netlistFilePath)) {
+        error = QCoreApplication::translate("main", "Error: failed to load netlist file: %1")
+                    .arg(netlistFilePath);
+        return false;
+    }
+
+    /* Process the netlist */
+    if (!generateManager->processNetlist()) {
+        error = QCoreApplication::translate("main", "Error: failed to process netlist file: %1")
+                    .arg(netlistFilePath);
+        return false;
+    }
+
+    /* Generate Verilog code */
+    const QString outputFileName = QFileInfo(netlistFilePath).baseName();
+    if (!generateManager->generateVerilog(outputFileName)) {
+        error = QCoreApplication::translate(
+                    "main", "Error: failed to generate Verilog code for: %1")
+                    .arg(outputFileName);
+        return false;
+    }
+    return true;
+}
+
+} /* namespace */
 
 bool QSocCliWorker::parseGenerate(const QStringList &appArguments)
 {
@@ -75,6 +131,23 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
         {{"f", "force"},
          QCoreApplication::translate(
              "main", "Force overwrite existing primitive cell files (clock_cell.v, reset_cell.v).")},
+        {{"j", "jobs"},
+         QCoreApplication::translate(
+             "main", "Number of netlist files generated in parallel, default is 1."),
+         "jobs"},
+        {"depfile",
+         QCoreApplication::translate(
+             "main", "Write a make or ninja depfile listing the input files of each output."),
+         "depfile"},
+        {"sv-interface",
+         QCoreApplication::translate(
+             "main", "Emit bus links as SystemVerilog interfaces instead of flattened wires.")},
+        {{"w", "watch"},
+         QCoreApplication::translate(
+             "main", "Keep running and regenerate outputs when their input files change.")},
+        {"lint",
+         QCoreApplication::translate(
+             "main", "Check the generated Verilog with the built-in SystemVerilog compiler.")},
     });
 
     parser.addPositionalArgument(
@@ -95,6 +168,18 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
             1, QCoreApplication::translate("main", "Error: missing netlist files."));
     }
 
+    int jobs = 1;
+    if (parser.isSet("jobs")) {
+        bool ok = false;
+        jobs    = parser.value("jobs").toInt(&ok);
+        if (!ok || jobs < 1) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid number of jobs: %1.")
+                    .arg(parser.value("jobs")));
+        }
+    }
+
     /* Setup project manager and project path  */
     if (parser.isSet("directory")) {
         const QString dirPath = parser.value("directory");
@@ -125,6 +210,19 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
                 .arg(projectManager->getOutputPath()));
     }
 
+    /* Watch mode keeps the libraries resident and reloads only changed files */
+    const bool watchMode = parser.isSet("watch");
+    if (watchMode) {
+        if (resident) {
+            return showError(
+                1,
+                QCoreApplication::translate(
+                    "main", "Error: watch is not available in daemon or batch mode."));
+        }
+        moduleManager->setLibraryCache(true);
+        busManager->setLibraryCache(true);
+    }
+
     /* Load modules */
     if (!moduleManager->load(QRegularExpression(".*"))) {
         return showErrorWithHelp(
@@ -145,12 +243,36 @@ bool QSocCliWorker::parseGenerateVerilog(const QStringList &appArguments)
         generateManager->setForceOverwrite(true);
     }
 
+    /* Bus links as SystemVerilog interfaces, flattened wires otherwise */
+    generateManager->setBusInterface(parser.isSet("sv-interface"));
+
+    bool result = false;
     if (mergeMode && filePathList.size() > 1) {
         /* Merge mode: combine multiple netlist files */
-        return processMergedNetlists(filePathList);
+        result = processMergedNetlists(filePathList);
+    } else if (jobs > 1 && filePathList.size() > 1) {
+        /* Parallel mode: independent netlist files on separate generators */
+        result = processParallelNetlists(filePathList, jobs);
+    } else {
+        /* Normal mode: process each netlist file separately */
+        result = processIndividualNetlists(filePathList);
+    }
+    result = result && writeDepfile();
+
+    /* Lint what was generated, on all cores unless jobs says otherwise */
+    const int lintJobs = parser.isSet("jobs") ? jobs : QThread::idealThreadCount();
+    if (result && parser.isSet("lint")) {
+        QStringList outputFilePathList;
+        for (const auto &[outputFilePath, dependencyList] : depfileRuleList) {
+            outputFilePathList.append(outputFilePath);
+        }
+        result = lintOutputs(outputFilePathList, lintJobs);
     }
-    /* Normal mode: process each netlist file separately */
-    return processIndividualNetlists(filePathList);
+
+    if (watchMode) {
+        return watchNetlists(filePathList, mergeMode && filePathList.size() > 1, jobs);
+    }
+    return result;
 }
 
 bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
@@ -165,16 +287,11 @@ bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
         }
     }
 
-    /* Load and merge all netlist files */
-    YAML::Node mergedNetlist;
-    QString    outputFileName;
-
-    for (int i = 0; i < filePathList.size(); ++i) {
-        const QString &netlistFilePath = filePathList.at(i);
-
+    /* Load all netlist files, then merge them in one pass */
+    QList<YAML::Node> netlistList;
+    for (const QString &netlistFilePath : filePathList) {
         /* Load the current netlist file */
-        std::ifstream fileStream(netlistFilePath.toStdString());
-        if (!fileStream.is_open()) {
+        if (!QFileInfo(netlistFilePath).isReadable()) {
             return showError(
                 1,
                 QCoreApplication::translate("main", "Error: Unable to open netlist file: \"%1\"")
@@ -182,23 +299,7 @@ bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
         }
 
         try {
-            const YAML::Node currentNetlist = YAML::Load(fileStream);
-            fileStream.close();
-
-            if (i == 0) {
-                /* For the first file, use it as the base */
-                mergedNetlist = currentNetlist;
-
-                /* Use the first file's basename for output */
-                const QFileInfo fileInfo(netlistFilePath);
-                outputFileName = fileInfo.baseName();
-            } else {
-                /* For subsequent files, merge them using the QSocYamlUtils mergeNodes function */
-                mergedNetlist = QSocYamlUtils::mergeNodes(mergedNetlist, currentNetlist);
-
-                /* Keep using the first file's basename for output filename */
-                /* No need to append additional names for merged content */
-            }
+            netlistList.append(QSocYamlUtils::loadFile(netlistFilePath));
 
             showInfo(
                 0,
@@ -212,8 +313,24 @@ bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
         }
     }
 
+    /* Later files override earlier ones, report every overridden value */
+    QStringList      conflictList;
+    const YAML::Node mergedNetlist
+        = QSocYamlUtils::mergeNodeList(netlistList, filePathList, &conflictList);
+    for (const QString &conflict : conflictList) {
+        qWarning().noquote()
+            << QCoreApplication::translate("main", "Warning: merge conflict at %1").arg(conflict);
+    }
+
+    /* Use the first file's basename for output */
+    const QString outputFileName = QFileInfo(filePathList.first()).baseName();
+
     /* Set the merged netlist data in the generate manager */
-    if (!generateManager->setNetlistData(mergedNetlist)) {
+    generateManager->clearDependencyList();
+    for (const QString &netlistFilePath : filePathList) {
+        generateManager->addDependency(netlistFilePath);
+    }
+    if (!generateManager->setNetlistData(mergedNetlist, filePathList.first())) {
         return showError(
             1, QCoreApplication::translate("main", "Error: failed to set merged netlist data"));
     }
@@ -233,6 +350,10 @@ bool QSocCliWorker::processMergedNetlists(const QStringList &filePathList)
                 .arg(outputFileName));
     }
 
+    depfileRuleList.append(
+        {QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v"),
+         generateManager->getDependencyList()});
+
     showInfo(
         0,
         QCoreApplication::translate(
@@ -246,46 +367,178 @@ bool QSocCliWorker::processIndividualNetlists(const QStringList &filePathList)
 {
     /* Generate Verilog code for each netlist file individually */
     for (const QString &netlistFilePath : filePathList) {
-        /* Check if the netlist file exists before trying to load it */
-        if (!QFile::exists(netlistFilePath)) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: Netlist file does not exist: \"%1\"")
-                    .arg(netlistFilePath));
+        QString error;
+        generateManager->clearDependencyList();
+        if (!generateNetlistFile(generateManager, netlistFilePath, error)) {
+            return showError(1, error);
         }
 
-        /* Load the netlist file */
-        if (!generateManager->loadNetlist(netlistFilePath)) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: failed to load netlist file: %1")
-                    .arg(netlistFilePath));
-        }
+        const QString outputFileName = QFileInfo(netlistFilePath).baseName();
+        const QString outputFilePath
+            = QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v");
+        depfileRuleList.append({outputFilePath, generateManager->getDependencyList()});
+        showInfo(
+            0,
+            QCoreApplication::translate("main", "Successfully generated Verilog code: %1")
+                .arg(outputFilePath));
+    }
 
-        /* Process the netlist */
-        if (!generateManager->processNetlist()) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: failed to process netlist file: %1")
-                    .arg(netlistFilePath));
-        }
+    return true;
+}
 
-        /* Generate Verilog code */
-        const QFileInfo fileInfo(netlistFilePath);
-        const QString   outputFileName = fileInfo.baseName();
-        if (!generateManager->generateVerilog(outputFileName)) {
-            return showError(
-                1,
-                QCoreApplication::translate("main", "Error: failed to generate Verilog code for: %1")
-                    .arg(outputFileName));
-        }
+bool QSocCliWorker::processParallelNetlists(const QStringList &filePathList, int jobs)
+{
+    jobs = static_cast<int>(qMin<qsizetype>(jobs, filePathList.size()));
+
+    /* Copy the libraries before any job starts, YAML lookups are not thread safe */
+    std::vector<std::unique_ptr<QSocBusManager>>    busCopyList;
+    std::vector<std::unique_ptr<QSocModuleManager>> moduleCopyList;
+    for (int job = 0; job < jobs; ++job) {
+        auto busCopy = std::make_unique<QSocBusManager>(nullptr, projectManager);
+        busCopy->copyLibraryData(*busManager);
+        auto moduleCopy = std::make_unique<QSocModuleManager>(
+            nullptr, projectManager, busCopy.get(), nullptr);
+        moduleCopy->copyLibraryData(*moduleManager);
+        busCopyList.push_back(std::move(busCopy));
+        moduleCopyList.push_back(std::move(moduleCopy));
+    }
+
+    std::vector<NetlistResult> resultList(filePathList.size());
+    std::atomic<qsizetype>     nextIndex{0};
+    const bool                 force       = parser.isSet("force");
+    const bool                 svInterface = parser.isSet("sv-interface");
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    for (int job = 0; job < jobs; ++job) {
+        pool.start([&, job]() {
+            QSocGenerateManager generator(
+                nullptr, projectManager, moduleCopyList[job].get(), busCopyList[job].get());
+            generator.setForceOverwrite(force);
+            generator.setBusInterface(svInterface);
+            /* Take the next file until none is left */
+            qsizetype index = 0;
+            while ((index = nextIndex++) < filePathList.size()) {
+                NetlistResult &result = resultList[index];
+                QStaticLog::setOutputSink([&result](QtMsgType type, const QString &text) {
+                    result.messageList.append({type, text});
+                });
+                const QString &netlistFilePath = filePathList.at(index);
+                generator.clearDependencyList();
+                result.success = generateNetlistFile(&generator, netlistFilePath, result.error);
+                result.dependencyList = generator.getDependencyList();
+                QStaticLog::setOutputSink(nullptr);
+            }
+        });
+    }
+    pool.waitForDone();
 
+    /* Replay messages in command line order */
+    int failed = 0;
+    for (qsizetype index = 0; index < filePathList.size(); ++index) {
+        const NetlistResult &result = resultList[index];
+        for (const auto &[type, text] : result.messageList) {
+            QStaticLog::replayMessage(type, text);
+        }
+        if (!result.success) {
+            qCritical().noquote() << result.error;
+            ++failed;
+            continue;
+        }
+        const QString outputFileName = QFileInfo(filePathList.at(index)).baseName();
+        const QString outputFilePath
+            = QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v");
+        depfileRuleList.append({outputFilePath, result.dependencyList});
         showInfo(
             0,
             QCoreApplication::translate("main", "Successfully generated Verilog code: %1")
-                .arg(QDir(projectManager->getOutputPath()).filePath(outputFileName + ".v")));
+                .arg(outputFilePath));
+    }
+
+    if (failed > 0) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to generate %1 of %2 netlist files.")
+                .arg(failed)
+                .arg(filePathList.size()));
+    }
+    return true;
+}
+
+bool QSocCliWorker::lintOutputs(const QStringList &outputFilePathList, int jobs)
+{
+    /* Primitive cells are linted on their own and loaded with every output */
+    const QDir        outputDir(projectManager->getOutputPath());
+    const QStringList cellFileNameList = {"clock_cell.v", "reset_cell.v", "power_cell.v"};
+    QStringList       fileList         = outputFilePathList;
+    QStringList       cellFileList;
+    for (const QString &cellFileName : cellFileNameList) {
+        const QString cellFilePath = outputDir.filePath(cellFileName);
+        if (!QFileInfo::exists(cellFilePath)) {
+            continue;
+        }
+        cellFileList.append(cellFilePath);
+        if (!fileList.contains(cellFilePath)) {
+            fileList.append(cellFilePath);
+        }
     }
 
+    std::vector<QList<QSlangDriver::LintMessage>> resultList(fileList.size());
+    std::atomic<qsizetype>                        nextIndex{0};
+    const QStringList                             searchDirList = {outputDir.absolutePath()};
+    jobs = static_cast<int>(qBound<qsizetype>(1, jobs, fileList.size()));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    for (int job = 0; job < jobs; ++job) {
+        pool.start([&]() {
+            /* Take the next file until none is left */
+            qsizetype index = 0;
+            while ((index = nextIndex++) < fileList.size()) {
+                resultList[index]
+                    = QSlangDriver::lintVerilog(fileList.at(index), cellFileList, searchDirList);
+            }
+        });
+    }
+    pool.waitForDone();
+
+    /* Report in file order, with the netlist entry each diagnostic falls in */
+    int errorCount   = 0;
+    int warningCount = 0;
+    for (const QList<QSlangDriver::LintMessage> &messageList : resultList) {
+        for (const QSlangDriver::LintMessage &message : messageList) {
+            QString text = QString("%1:%2:%3: ")
+                               .arg(message.filePath)
+                               .arg(message.line)
+                               .arg(message.column)
+                           + (message.error ? QString("error: ") : QString("warning: "))
+                           + message.message;
+            if (!message.entry.isEmpty()) {
+                text += " [" + message.entry + "]";
+            }
+            qWarning().noquote() << text;
+            if (message.error) {
+                ++errorCount;
+            } else {
+                ++warningCount;
+            }
+        }
+    }
+
+    if (errorCount > 0) {
+        return showError(
+            1,
+            QCoreApplication::translate(
+                "main", "Error: lint found %1 errors and %2 warnings in %3 files.")
+                .arg(errorCount)
+                .arg(warningCount)
+                .arg(fileList.size()));
+    }
+    showInfo(
+        0,
+        QCoreApplication::translate("main", "Lint passed with %1 warnings in %2 files.")
+            .arg(warningCount)
+            .arg(fileList.size()));
     return true;
 }
 
@@ -314,6 +567,10 @@ bool QSocCliWorker::parseGenerateTemplate(const QStringList &appArguments)
          QCoreApplication::translate(
              "main", "RCSV (Register-CSV) data file (can be used multiple times)."),
          "rcsv file"},
+        {"depfile",
+         QCoreApplication::translate(
+             "main", "Write a make or ninja depfile listing the input files of each output."),
+         "depfile"},
     });
 
     parser.addPositionalArgument(
@@ -410,6 +667,7 @@ bool QSocCliWorker::parseGenerateTemplate(const QStringList &appArguments)
             outputFileName = outputFileName.left(lastDotIndex);
         }
 
+        generateManager->clearDependencyList();
         if (!generateManager->renderTemplate(
                 templateFilePath,
                 csvFiles,
@@ -424,12 +682,56 @@ bool QSocCliWorker::parseGenerateTemplate(const QStringList &appArguments)
                     .arg(templateFilePath));
         }
 
+        const QString outputFilePath
+            = QDir(projectManager->getOutputPath()).filePath(outputFileName);
+        depfileRuleList.append({outputFilePath, generateManager->getDependencyList()});
         showInfo(
             0,
             QCoreApplication::translate("main", "Successfully generated file from template: %1")
-                .arg(QDir(projectManager->getOutputPath()).filePath(outputFileName)));
+                .arg(outputFilePath));
     }
 
+    return writeDepfile();
+}
+
+bool QSocCliWorker::writeDepfile()
+{
+    if (!parser.isSet("depfile")) {
+        return true;
+    }
+
+    /* Make and ninja read the same syntax, escape the characters both treat specially */
+    auto escape = [](const QString &path) {
+        QString escaped = path;
+        escaped.replace('$', "$$");
+        escaped.replace('#', "\\#");
+        escaped.replace(' ', "\\ ");
+        return escaped;
+    };
+
+    const QString depfilePath = parser.value("depfile");
+    QSaveFile     file(depfilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: unable to write depfile: %1")
+                .arg(depfilePath));
+    }
+    QTextStream stream(&file);
+    for (const auto &[target, dependencyList] : depfileRuleList) {
+        stream << escape(QFileInfo(target).absoluteFilePath()) << ":";
+        for (const QString &dependency : dependencyList) {
+            stream << " \\\n  " << escape(dependency);
+        }
+        stream << "\n";
+    }
+    stream.flush();
+    if (!file.commit()) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: unable to write depfile: %1")
+                .arg(depfilePath));
+    }
     return true;
 }
 
@@ -448,6 +750,10 @@ bool QSocCliWorker::parseGenerateStub(const QStringList &appArguments)
         {{"m", "module"},
          QCoreApplication::translate("main", "The module name or regex."),
          "module name or regex"},
+        {{"t", "timing"},
+         QCoreApplication::translate(
+             "main", "The CSV file with default timing arcs and pin capacitance."),
+         "timing csv"},
     });
 
     parser.addPositionalArgument(
@@ -513,7 +819,8 @@ bool QSocCliWorker::parseGenerateStub(const QStringList &appArguments)
     }
 
     /* Generate stub files */
-    if (!generateManager->generateStub(stubName, libraryRegex, moduleRegex)) {
+    if (!generateManager->generateStub(
+            stubName, libraryRegex, moduleRegex, parser.values("timing"))) {
         return showError(
             1,
             QCoreApplication::translate("main", "Error: failed to generate stub files for: %1")
@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+
+namespace {
+
+/* Changes closer together than this are handled as one */
+constexpr int watchSettleMs = 50;
+
+/* Modification time of a file, invalid when the file does not exist */
+QDateTime fileStamp(const QString &filePath)
+{
+    const QFileInfo fileInfo(filePath);
+    return fileInfo.exists() ? fileInfo.lastModified() : QDateTime();
+}
+
+} /* namespace */
+
+bool QSocCliWorker::watchNetlists(const QStringList &filePathList, bool mergeMode, int jobs)
+{
+    const QDir outputDir(projectManager->getOutputPath());
+
+    /* Outputs in command line order, with their netlist files and all their inputs */
+    QStringList                 outputList;
+    QHash<QString, QStringList> sourceMap;
+    QHash<QString, QStringList> inputMap;
+    if (mergeMode) {
+        const QString output = outputDir.filePath(
+            QFileInfo(filePathList.first()).baseName() + ".v");
+        outputList.append(output);
+        sourceMap.insert(output, filePathList);
+    } else {
+        for (const QString &netlistFilePath : filePathList) {
+            const QString output = outputDir.filePath(
+                QFileInfo(netlistFilePath).baseName() + ".v");
+            if (!outputList.contains(output)) {
+                outputList.append(output);
+            }
+            sourceMap[output].append(netlistFilePath);
+        }
+    }
+
+    /* Netlist files stay inputs even when their generation failed */
+    const auto updateInputs = [&]() {
+        for (const auto &[output, dependencyList] : depfileRuleList) {
+            inputMap.insert(output, dependencyList);
+        }
+        for (const QString &output : outputList) {
+            for (const QString &source : sourceMap.value(output)) {
+                const QString sourcePath = QFileInfo(source).absoluteFilePath();
+                if (!inputMap[output].contains(sourcePath)) {
+                    inputMap[output].append(sourcePath);
+                }
+            }
+        }
+    };
+    updateInputs();
+
+    /* Library files are tracked as well, so new libraries are noticed */
+    const QStringList libraryDirList
+        = {projectManager->getModulePath(), projectManager->getBusPath()};
+    const auto libraryFiles = [&]() {
+        QStringList result;
+        for (const QString &libraryDir : libraryDirList) {
+            const QDir dir(libraryDir);
+            for (const QString &fileName :
+                 dir.entryList({"*.soc_mod", "*.soc_bus"}, QDir::Files, QDir::Name)) {
+                result.append(dir.absoluteFilePath(fileName));
+            }
+        }
+        return result;
+    };
+
+    QHash<QString, QDateTime> stampMap;
+    for (const QString &output : outputList) {
+        for (const QString &input : inputMap.value(output)) {
+            stampMap.insert(input, fileStamp(input));
+        }
+    }
+    for (const QString &libraryFile : libraryFiles()) {
+        stampMap.insert(libraryFile, fileStamp(libraryFile));
+    }
+
+    /* Editors often replace files, so watches are renewed after every change */
+    QFileSystemWatcher watcher;
+    const auto         renewWatches = [&]() {
+        QStringList pathList = libraryDirList;
+        for (auto iter = stampMap.constBegin(); iter != stampMap.constEnd(); ++iter) {
+            pathList.append(iter.key());
+        }
+        const QStringList watchedList = watcher.files() + watcher.directories();
+        for (const QString &path : pathList) {
+            if (!watchedList.contains(path) && QFileInfo::exists(path)) {
+                watcher.addPath(path);
+            }
+        }
+    };
+    renewWatches();
+
+    QTimer settleTimer;
+    settleTimer.setSingleShot(true);
+    settleTimer.setInterval(watchSettleMs);
+    QObject::connect(
+        &watcher, &QFileSystemWatcher::fileChanged, &settleTimer, qOverload<>(&QTimer::start));
+    QObject::connect(
+        &watcher,
+        &QFileSystemWatcher::directoryChanged,
+        &settleTimer,
+        qOverload<>(&QTimer::start));
+
+    bool result = true;
+    QObject::connect(&settleTimer, &QTimer::timeout, &settleTimer, [&]() {
+        /* Only files whose time stamp moved count as changed */
+        QSet<QString> changedSet;
+        bool          newFile = false;
+        for (auto iter = stampMap.begin(); iter != stampMap.end(); ++iter) {
+            const QDateTime stamp = fileStamp(iter.key());
+            if (stamp != iter.value()) {
+                newFile = newFile || !iter.value().isValid();
+                changedSet.insert(iter.key());
+                iter.value() = stamp;
+            }
+        }
+        for (const QString &libraryFile : libraryFiles()) {
+            if (!stampMap.contains(libraryFile)) {
+                stampMap.insert(libraryFile, fileStamp(libraryFile));
+                changedSet.insert(libraryFile);
+                newFile = true;
+            }
+        }
+        renewWatches();
+        if (changedSet.isEmpty()) {
+            return;
+        }
+
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+
+        /* Resident libraries parse only the files changed on disk */
+        if (!moduleManager->load(QRegularExpression(".*"))
+            || !busManager->load(QRegularExpression(".*"))) {
+            result = showError(
+                1, QCoreApplication::translate("main", "Error: could not reload libraries"));
+            return;
+        }
+
+        QStringList targetList;
+        for (const QString &output : outputList) {
+            bool affected = newFile;
+            for (const QString &input : inputMap.value(output)) {
+                affected = affected || changedSet.contains(input);
+            }
+            if (affected) {
+                targetList.append(output);
+            }
+        }
+        if (targetList.isEmpty()) {
+            return;
+        }
+
+        depfileRuleList.clear();
+        result = true;
+        if (mergeMode) {
+            result = processMergedNetlists(filePathList);
+        } else {
+            QStringList netlistList;
+            for (const QString &output : targetList) {
+                netlistList.append(sourceMap.value(output));
+            }
+            if (jobs > 1 && netlistList.size() > 1) {
+                result = processParallelNetlists(netlistList, jobs);
+            } else {
+                /* One at a time, so a failing file does not hold back the others */
+                for (const QString &netlistFilePath : netlistList) {
+                    result = processIndividualNetlists({netlistFilePath}) && result;
+                }
+            }
+        }
+        updateInputs();
+        if (result && parser.isSet("lint")) {
+            result = lintOutputs(
+                targetList, parser.isSet("jobs") ? jobs : QThread::idealThreadCount());
+        }
+
+        /* The depfile keeps a rule for every output, not just the regenerated ones */
+        depfileRuleList.clear();
+        for (const QString &output : outputList) {
+            const QStringList inputList = inputMap.value(output);
+            depfileRuleList.append({output, inputList});
+            for (const QString &input : inputList) {
+                if (!stampMap.contains(input)) {
+                    stampMap.insert(input, fileStamp(input));
+                }
+            }
+        }
+        result = writeDepfile() && result;
+        renewWatches();
+
+        showInfo(
+            result ? 0 : 1,
+            QCoreApplication::translate("main", "Regenerated %1 of %2 outputs in %3 ms")
+                .arg(targetList.size())
+                .arg(outputList.size())
+                .arg(elapsedTimer.elapsed()));
+    });
+
+    showInfo(
+        exitCode,
+        QCoreApplication::translate("main", "Watching %1 files for changes").arg(stampMap.size()));
+
+    /* Runs until the application exits */
+    QEventLoop eventLoop;
+    eventLoop.exec();
+
+    return result;
+}
@@ -91,6 +91,27 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
         {{"U", "undefine"},
          QCoreApplication::translate("main", "Undefine macro KEY at the start of all source files."),
          "macro name"},
+        {"chunk",
+         QCoreApplication::translate(
+             "main", "Parse the verilog files in chunks of n files to bound memory use."),
+         "n"},
+        {"no-cache",
+         QCoreApplication::translate("main", "Do not reuse or store preprocessed import results.")},
+        {"cache",
+         QCoreApplication::translate(
+             "main", "Keep preprocessed import results in the user cache for later runs.")},
+        {{"G", "parameterize"},
+         QCoreApplication::translate(
+             "main", "Also elaborate a module with parameter overrides, can be repeated."),
+         "module:name=value[,name=value]"},
+        {"netlist",
+         QCoreApplication::translate(
+             "main", "Also elaborate the modules with the parameters of their netlist instances."),
+         "netlist file"},
+        {{"j", "jobs"},
+         QCoreApplication::translate(
+             "main", "Number of parameterizations elaborated in parallel, default is all cores."),
+         "jobs"},
     });
     parser.addPositionalArgument(
         "files",
@@ -108,6 +129,66 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
         return showHelpOrError(
             1, QCoreApplication::translate("main", "Error: missing verilog files."));
     }
+    int chunkSize = 0;
+    if (parser.isSet("chunk")) {
+        bool ok   = false;
+        chunkSize = parser.value("chunk").toInt(&ok);
+        if (!ok || chunkSize < 1) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid chunk size: %1.")
+                    .arg(parser.value("chunk")));
+        }
+    }
+    int jobs = 0;
+    if (parser.isSet("jobs")) {
+        bool ok = false;
+        jobs    = parser.value("jobs").toInt(&ok);
+        if (!ok || jobs < 1) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid number of jobs: %1.")
+                    .arg(parser.value("jobs")));
+        }
+    }
+    /* MODULE:NAME=VALUE[,NAME=VALUE] */
+    QList<QSlangDriver::Parameterization> parameterizationList;
+    const QRegularExpression              nameRegex("^[A-Za-z_][A-Za-z0-9_$]*$");
+    for (const QString &value : parser.values("parameterize")) {
+        const qsizetype                split = value.indexOf(':');
+        QSlangDriver::Parameterization parameterization;
+        parameterization.moduleName = value.left(split).trimmed();
+        bool valid = split > 0 && nameRegex.match(parameterization.moduleName).hasMatch();
+        for (const QString &item : value.mid(split + 1).split(',')) {
+            const qsizetype equal = item.indexOf('=');
+            const QString   name  = item.left(equal).trimmed();
+            if (!valid || equal <= 0 || !nameRegex.match(name).hasMatch()
+                || item.mid(equal + 1).trimmed().isEmpty()) {
+                valid = false;
+                break;
+            }
+            parameterization.overrideMap.insert(name, item.mid(equal + 1).trimmed());
+        }
+        if (!valid) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid parameterization: %1.")
+                    .arg(value));
+        }
+        parameterizationList.append(parameterization);
+    }
+    if (parser.isSet("netlist")) {
+        const QString netlistPath = parser.value("netlist");
+        try {
+            parameterizationList.append(QSocModuleManager::parameterizationsFromNetlist(
+                YAML::LoadFile(netlistPath.toStdString())));
+        } catch (const YAML::Exception &) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: unable to read netlist: %1.")
+                    .arg(netlistPath));
+        }
+    }
     /* Setup project manager and project path  */
     if (parser.isSet("directory")) {
         projectManager->setProjectPath(parser.value("directory"));
@@ -175,8 +256,19 @@ bool QSocCliWorker::parseModuleImport(const QStringList &appArguments)
                     .arg(macro));
         }
     }
+    moduleManager->setImportCache(!parser.isSet("no-cache"));
+    moduleManager->setImportCacheDir(
+        parser.isSet("cache") ? QSocImportCache::defaultCacheDir() : QString());
     if (!moduleManager->importFromFileList(
-            libraryName, moduleNameRegex, filelistPath, filePathList, macroDefines, macroUndefines)) {
+            libraryName,
+            moduleNameRegex,
+            filelistPath,
+            filePathList,
+            macroDefines,
+            macroUndefines,
+            chunkSize,
+            parameterizationList,
+            jobs)) {
         return showErrorWithHelp(1, QCoreApplication::translate("main", "Error: import failed."));
     }
 
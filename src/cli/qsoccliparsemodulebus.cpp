@@ -344,8 +344,13 @@ bool QSocCliWorker::parseModuleBusRemove(const QStringList &appArguments)
                 .arg(moduleName));
     }
 
-    /* Process each module */
-    bool allSucceeded = true;
+    /* Process each module, every touched library is written once at the end */
+    bool       allSucceeded = true;
+    const bool ownDeferral  = !moduleManager->isDeferredSave();
+    const bool libraryCache = moduleManager->isLibraryCache();
+    if (ownDeferral) {
+        moduleManager->setDeferredSave(true);
+    }
     for (const QString &currentModule : moduleList) {
         if (!moduleManager->removeModuleBus(currentModule, busInterfaceRegex)) {
             showError(
@@ -362,6 +367,15 @@ bool QSocCliWorker::parseModuleBusRemove(const QStringList &appArguments)
                     .arg(busName, currentModule));
         }
     }
+    /* A batch that already defers saves writes the libraries when it ends */
+    if (ownDeferral) {
+        if (!moduleManager->flush()) {
+            showError(1, QCoreApplication::translate("main", "Error: failed to save libraries."));
+            allSucceeded = false;
+        }
+        moduleManager->setDeferredSave(false);
+        moduleManager->setLibraryCache(libraryCache);
+    }
 
     if (!allSucceeded) {
         return showErrorWithHelp(
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+
+#include "common/qsocbusmanager.h"
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocnetlistgraph.h"
+#include "common/qsocprojectmanager.h"
+
+bool QSocCliWorker::parseNetlist(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addPositionalArgument(
+        "subcommand",
+        QCoreApplication::translate(
+            "main", "trace    Query the connectivity of a processed netlist."),
+        "netlist <subcommand> [subcommand options]");
+
+    parser.parse(appArguments);
+    const QStringList cmdArguments = parser.positionalArguments();
+    if (cmdArguments.isEmpty()) {
+        return showHelpOrError(1, QCoreApplication::translate("main", "Error: missing subcommand."));
+    }
+    const QString &command       = cmdArguments.first();
+    QStringList    nextArguments = appArguments;
+    if (command == "trace") {
+        nextArguments.removeOne(command);
+        if (!parseNetlistTrace(nextArguments)) {
+            return false;
+        }
+    } else {
+        return showHelpOrError(
+            1, QCoreApplication::translate("main", "Error: unknown subcommand: %1.").arg(command));
+    }
+
+    return true;
+}
+
+bool QSocCliWorker::parseNetlistTrace(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addOptions({
+        {{"d", "directory"},
+         QCoreApplication::translate("main", "The path to the project directory."),
+         "project directory"},
+        {{"p", "project"}, QCoreApplication::translate("main", "The project name."), "project name"},
+        {"depth",
+         QCoreApplication::translate("main", "Number of levels for fanout and fanin queries."),
+         "levels"},
+    });
+    parser.addPositionalArgument(
+        "netlist", QCoreApplication::translate("main", "The netlist file to query."), "<netlist>");
+    parser.addPositionalArgument(
+        "query",
+        QCoreApplication::translate(
+            "main",
+            "driver   Drivers of the target nets.\n"
+            "fanout   Loads reached from the target.\n"
+            "fanin    Drivers reaching the target.\n"
+            "path     Shortest path from the target to a second target.\n"
+            "bits     Bit slices of a net and the pins owning them."),
+        "<query>");
+    parser.addPositionalArgument(
+        "target",
+        QCoreApplication::translate("main", "A net, an instance.port pin or an instance."),
+        "<target> [<to>]");
+
+    parser.parse(appArguments);
+    const QStringList cmdArguments = parser.positionalArguments();
+    if (cmdArguments.size() < 3) {
+        return showHelpOrError(
+            1, QCoreApplication::translate("main", "Error: missing netlist, query or target."));
+    }
+    const QString &netlistFilePath = cmdArguments.at(0);
+    const QString &query           = cmdArguments.at(1);
+    const QString &target          = cmdArguments.at(2);
+
+    if (!QSocNetlistGraph::queryNames().contains(query)) {
+        return showErrorWithHelp(
+            1, QCoreApplication::translate("main", "Error: unknown query: %1.").arg(query));
+    }
+    if (query == "path" && cmdArguments.size() < 4) {
+        return showErrorWithHelp(
+            1, QCoreApplication::translate("main", "Error: missing path end target."));
+    }
+
+    int depth = 1;
+    if (parser.isSet("depth")) {
+        bool ok = false;
+        depth   = parser.value("depth").toInt(&ok);
+        if (!ok || depth < 1) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate("main", "Error: invalid depth: %1.")
+                    .arg(parser.value("depth")));
+        }
+    }
+
+    /* Setup project manager and project path  */
+    if (parser.isSet("directory")) {
+        projectManager->setProjectPath(parser.value("directory"));
+    }
+    if (parser.isSet("project")) {
+        projectManager->load(parser.value("project"));
+    } else {
+        const QStringList &projectNameList = projectManager->list(QRegularExpression(".*"));
+        if (projectNameList.length() > 1) {
+            return showErrorWithHelp(
+                1,
+                QCoreApplication::translate(
+                    "main",
+                    "Error: multiple projects found, please specify the project name.\n"
+                    "Available projects are:\n%1\n")
+                    .arg(projectNameList.join("\n")));
+        }
+        projectManager->loadFirst();
+    }
+
+    /* Load modules */
+    if (!moduleManager->load(QRegularExpression(".*"))) {
+        return showErrorWithHelp(
+            1, QCoreApplication::translate("main", "Error: could not load library"));
+    }
+
+    /* Load buses */
+    if (!busManager->load(QRegularExpression(".*"))) {
+        return showErrorWithHelp(
+            1, QCoreApplication::translate("main", "Error: could not load buses"));
+    }
+
+    /* Query the netlist as it is generated, after link, uplink and bus expansion */
+    generateManager->setSubNetlistOutput(false);
+    if (!generateManager->loadNetlist(netlistFilePath)) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to load netlist file: %1")
+                .arg(netlistFilePath));
+    }
+    if (!generateManager->processNetlist()) {
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: failed to process netlist file: %1")
+                .arg(netlistFilePath));
+    }
+
+    const QSocNetlistGraph graph     = generateManager->buildNetlistGraph();
+    const QString          endTarget = cmdArguments.value(3);
+    QStringList            result;
+    switch (graph.query(query, target, endTarget, depth, result)) {
+    case QSocNetlistGraph::QueryStatus::Ok:
+    case QSocNetlistGraph::QueryStatus::UnknownQuery:
+        break;
+    case QSocNetlistGraph::QueryStatus::UnknownTarget:
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: unknown net, pin or instance: %1.")
+                .arg(target));
+    case QSocNetlistGraph::QueryStatus::UnknownEndTarget:
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: unknown net, pin or instance: %1.")
+                .arg(endTarget));
+    case QSocNetlistGraph::QueryStatus::NoPath:
+        return showError(
+            1,
+            QCoreApplication::translate("main", "Error: no path from %1 to %2.")
+                .arg(target, endTarget));
+    case QSocNetlistGraph::QueryStatus::NotNet:
+        return showError(
+            1, QCoreApplication::translate("main", "Error: not a net: %1.").arg(target));
+    }
+
+    if (!result.isEmpty()) {
+        showInfo(0, result.join("\n"));
+    }
+
+    return true;
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+
+#include "cli/qsoccliserver.h"
+#include "common/qstaticlog.h"
+
+#include <QEventLoop>
+
+bool QSocCliWorker::parseServe(const QStringList &appArguments)
+{
+    /* Clear upstream positional arguments and setup subcommand */
+    parser.clearPositionalArguments();
+    parser.addOptions({
+        {{"s", "socket"},
+         QCoreApplication::translate(
+             "main",
+             "The local socket name or path of the daemon.\n"
+             "Clients select the daemon with the QSOC_SERVER environment variable."),
+         "socket"},
+        {"stop", QCoreApplication::translate("main", "Stop a running daemon.")},
+    });
+
+    parser.parse(appArguments);
+
+    if (parser.isSet("help")) {
+        return showHelp(0);
+    }
+
+    const QString serverName = parser.isSet("socket") ? parser.value("socket")
+                                                      : QSocCliServer::defaultServerName();
+
+    if (parser.isSet("stop")) {
+        if (!QSocCliServer::shutdown(serverName)) {
+            return showError(
+                1,
+                QCoreApplication::translate("main", "Error: no daemon is running on %1.")
+                    .arg(serverName));
+        }
+        return showInfo(0, QCoreApplication::translate("main", "Daemon stopped."));
+    }
+
+    QSocCliServer server;
+    if (!server.listen(serverName)) {
+        return showError(
+            1,
+            QCoreApplication::translate(
+                "main", "Error: failed to listen on %1, is a daemon already running?")
+                .arg(serverName));
+    }
+    showInfo(
+        0,
+        QCoreApplication::translate("main", "Listening on %1, export QSOC_SERVER=%1 to use it.")
+            .arg(server.fullServerName()));
+
+    /* Serve until a client sends a shutdown request */
+    QEventLoop loop;
+    connect(&server, &QSocCliServer::finished, &loop, &QEventLoop::quit, Qt::QueuedConnection);
+    loop.exec();
+
+    QStaticLog::logI(Q_FUNC_INFO, "Daemon stopped.");
+    return true;
+}
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliserver.h"
+
+#include "cli/qsoccliworker.h"
+#include "common/qstaticlog.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMap>
+#include <QProcess>
+
+#include <cstdio>
+
+namespace {
+/* Time to wait for a daemon before falling back to local execution */
+constexpr int connectTimeout = 200;
+} /* namespace */
+
+QSocCliServer::QSocCliServer(QObject *parent)
+    : QObject(parent)
+    , server(new QLocalServer(this))
+    , watcher(new QFileSystemWatcher(this))
+    , projectManager(new QSocProjectManager(this))
+    , socConfig(new QSocConfig(this, projectManager))
+    , llmService(new QLLMService(this, socConfig))
+    , busManager(new QSocBusManager(this, projectManager))
+    , moduleManager(new QSocModuleManager(this, projectManager, busManager, llmService))
+    , generateManager(new QSocGenerateManager(this, projectManager, moduleManager, busManager))
+{
+    /* Libraries stay resident until their files change */
+    busManager->setLibraryCache(true);
+    moduleManager->setLibraryCache(true);
+
+    connect(server, &QLocalServer::newConnection, this, &QSocCliServer::handleNewConnection);
+    connect(
+        watcher,
+        &QFileSystemWatcher::directoryChanged,
+        this,
+        &QSocCliServer::handleDirectoryChanged);
+}
+
+QSocCliServer::~QSocCliServer()
+{
+    server->close();
+}
+
+QString QSocCliServer::defaultServerName()
+{
+    QString user = qEnvironmentVariable("USER");
+    if (user.isEmpty()) {
+        user = qEnvironmentVariable("USERNAME", "default");
+    }
+    return QString("qsoc-%1.sock").arg(user);
+}
+
+bool QSocCliServer::listen(const QString &serverName)
+{
+    /* Refuse to steal the socket of a live daemon */
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if (probe.waitForConnected(connectTimeout)) {
+        probe.disconnectFromServer();
+        return false;
+    }
+    /* Remove a stale socket file left by a crashed daemon */
+    QLocalServer::removeServer(serverName);
+    server->setSocketOptions(QLocalServer::UserAccessOption);
+    return server->listen(serverName);
+}
+
+QString QSocCliServer::fullServerName() const
+{
+    return server->fullServerName();
+}
+
+void QSocCliServer::handleNewConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+            /* Queue the connection once its request line is complete */
+            if (socket->canReadLine() && !pendingList.contains(socket)) {
+                pendingList.append(socket);
+                processPending();
+            }
+        });
+    }
+}
+
+void QSocCliServer::handleDirectoryChanged(const QString &path)
+{
+    /* Files were added, removed or renamed, reload on next use */
+    if (moduleDirSet.contains(path)) {
+        moduleManager->resetModuleData();
+    }
+    if (busDirSet.contains(path)) {
+        busManager->resetBusData();
+    }
+}
+
+void QSocCliServer::processPending()
+{
+    /* Commands with nested event loops must not start another command */
+    if (busy) {
+        return;
+    }
+    busy = true;
+    /* Deliver pending watcher notifications before touching the cache */
+    QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    while (!pendingList.isEmpty()) {
+        const QPointer<QLocalSocket> socket = pendingList.takeFirst();
+        if (!socket || !socket->canReadLine()) {
+            continue;
+        }
+        const QJsonDocument document = QJsonDocument::fromJson(socket->readLine().trimmed());
+        if (!document.isObject()) {
+            writeReply(socket, {{"stream", "stderr"}, {"text", "Error: malformed request."}});
+            writeReply(socket, {{"exit", 1}});
+        } else if (document.object().value("shutdown").toBool()) {
+            writeReply(socket, {{"exit", 0}});
+            socket->waitForBytesWritten(connectTimeout);
+            emit finished();
+        } else {
+            execute(socket, document.object());
+        }
+        if (socket) {
+            socket->disconnectFromServer();
+        }
+    }
+    busy = false;
+}
+
+void QSocCliServer::execute(QLocalSocket *socket, const QJsonObject &request)
+{
+    /* Run in the client working directory */
+    const QString currentPath = QDir::currentPath();
+    QDir::setCurrent(request.value("cwd").toString(currentPath));
+
+    /* Fresh project state per command, libraries stay resident */
+    QSocProjectManager *requestProject = new QSocProjectManager(this);
+    if (request.contains("env")) {
+        QMap<QString, QString> env;
+        for (const QJsonValue &value : request.value("env").toArray()) {
+            const QString   entry = value.toString();
+            const qsizetype index = entry.indexOf('=');
+            if (index > 0) {
+                env.insert(entry.left(index), entry.mid(index + 1));
+            }
+        }
+        requestProject->setEnv(env);
+    }
+    QSocCliWorker::Managers managers;
+    managers.socConfig       = socConfig;
+    managers.llmService      = llmService;
+    managers.busManager      = busManager;
+    managers.moduleManager   = moduleManager;
+    managers.generateManager = generateManager;
+    managers.attachProject(requestProject);
+    delete projectManager;
+    projectManager = requestProject;
+
+    /* Stream every message to the client as it is produced */
+    const QStaticLog::Level level = QStaticLog::getLevel();
+    const QPointer<QLocalSocket> client(socket);
+    QStaticLog::setOutputSink([client](QtMsgType type, const QString &message) {
+        const QString stream = type == QtInfoMsg ? "stdout" : "stderr";
+        writeReply(client, {{"stream", stream}, {"text", message}});
+    });
+
+    QStringList arguments;
+    for (const QJsonValue &value : request.value("args").toArray()) {
+        arguments.append(value.toString());
+    }
+    int exitCode = 1;
+    {
+        QSocCliWorker worker(nullptr, managers);
+        exitCode = worker.execute(arguments);
+    }
+
+    QStaticLog::setOutputSink(nullptr);
+    QStaticLog::setLevel(level);
+    writeReply(client, {{"exit", exitCode}});
+
+    watchProjectPaths();
+    QDir::setCurrent(currentPath);
+}
+
+void QSocCliServer::watchProjectPaths()
+{
+    const QString modulePath = QDir(projectManager->getModulePath()).absolutePath();
+    if (!moduleDirSet.contains(modulePath) && QDir(modulePath).exists()) {
+        moduleDirSet.insert(modulePath);
+        watcher->addPath(modulePath);
+    }
+    const QString busPath = QDir(projectManager->getBusPath()).absolutePath();
+    if (!busDirSet.contains(busPath) && QDir(busPath).exists()) {
+        busDirSet.insert(busPath);
+        watcher->addPath(busPath);
+    }
+}
+
+void QSocCliServer::writeReply(QLocalSocket *socket, const QJsonObject &reply)
+{
+    if (!socket || socket->state() != QLocalSocket::ConnectedState) {
+        return;
+    }
+    socket->write(QJsonDocument(reply).toJson(QJsonDocument::Compact) + '\n');
+    socket->flush();
+}
+
+bool QSocCliServer::forward(const QString &serverName, const QStringList &arguments, int &exitCode)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (!socket.waitForConnected(connectTimeout)) {
+        return false;
+    }
+
+    const QJsonObject request{
+        {"cwd", QDir::currentPath()},
+        {"env", QJsonArray::fromStringList(QProcess::systemEnvironment())},
+        {"args", QJsonArray::fromStringList(arguments)},
+    };
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+    socket.flush();
+
+    /* Copy streamed output until the exit code arrives */
+    while (true) {
+        while (socket.canReadLine()) {
+            const QJsonObject reply = QJsonDocument::fromJson(socket.readLine()).object();
+            if (reply.contains("exit")) {
+                exitCode = reply.value("exit").toInt();
+                return true;
+            }
+            FILE *stream = reply.value("stream").toString() == "stdout" ? stdout : stderr;
+            fprintf(stream, "%s\n", reply.value("text").toString().toUtf8().constData());
+            fflush(stream);
+        }
+        if (!socket.waitForReadyRead(-1)) {
+            break;
+        }
+    }
+
+    /* The daemon went away in the middle of the command */
+    fprintf(stderr, "Error: lost connection to qsoc daemon: %s\n", qPrintable(serverName));
+    exitCode = 1;
+    return true;
+}
+
+bool QSocCliServer::shutdown(const QString &serverName)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (!socket.waitForConnected(connectTimeout)) {
+        return false;
+    }
+    const QJsonObject request{{"shutdown", true}};
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+    socket.flush();
+    while (!socket.canReadLine()) {
+        if (!socket.waitForReadyRead(-1)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCCLISERVER_H
+#define QSOCCLISERVER_H
+
+#include "common/qllmservice.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocconfig.h"
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+
+#include <QFileSystemWatcher>
+#include <QJsonObject>
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocCliServer class.
+ * @details This class implements the persistent `qsoc serve` daemon and its
+ *          thin client. The daemon listens on a local socket and executes
+ *          forwarded command lines one at a time with a set of resident
+ *          managers, so module and bus libraries are parsed once and then
+ *          reused until their files change. Library directories are watched
+ *          and the resident data is dropped when files are added or removed.
+ *
+ *          The protocol is newline delimited JSON. A request carries the
+ *          client working directory, environment and arguments. The daemon
+ *          answers with one line per output message followed by a final line
+ *          holding the exit code.
+ */
+class QSocCliServer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Constructor for QSocCliServer.
+     * @details This constructor will create the resident managers.
+     * @param[in] parent parent object.
+     */
+    explicit QSocCliServer(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor for QSocCliServer.
+     * @details This destructor will close the server socket.
+     */
+    ~QSocCliServer() override;
+
+    /**
+     * @brief Get the default server name.
+     * @details The name is derived from the user name so that daemons of
+     *          different users do not collide in the temporary directory.
+     * @return QString The default server name.
+     */
+    static QString defaultServerName();
+
+    /**
+     * @brief Start listening on a local socket.
+     * @details Fails when another daemon already answers on the same name.
+     *          A stale socket file left by a crashed daemon is removed.
+     * @param serverName The local socket name or path.
+     * @retval true Listening started.
+     * @retval false Another daemon is running or the socket failed.
+     */
+    bool listen(const QString &serverName);
+
+    /**
+     * @brief Get the full path of the listening socket.
+     * @return QString The socket path, empty when not listening.
+     */
+    QString fullServerName() const;
+
+    /**
+     * @brief Forward a command line to a running daemon.
+     * @details Sends the arguments, working directory and environment of the
+     *          calling process, then copies the streamed output to stdout and
+     *          stderr until the daemon reports the exit code.
+     * @param serverName The local socket name or path.
+     * @param arguments The command line arguments, including program name.
+     * @param exitCode Receives the exit code of the forwarded command.
+     * @retval true The command was executed by the daemon.
+     * @retval false No daemon is reachable, the caller should run locally.
+     */
+    static bool forward(const QString &serverName, const QStringList &arguments, int &exitCode);
+
+    /**
+     * @brief Ask a running daemon to shut down.
+     * @param serverName The local socket name or path.
+     * @retval true The daemon acknowledged the request.
+     * @retval false No daemon is reachable.
+     */
+    static bool shutdown(const QString &serverName);
+
+signals:
+    /**
+     * @brief The daemon received a shutdown request.
+     */
+    void finished();
+
+private slots:
+    /**
+     * @brief Accept pending client connections.
+     */
+    void handleNewConnection();
+
+    /**
+     * @brief Drop resident library data after a watched directory changed.
+     * @param path The changed directory path.
+     */
+    void handleDirectoryChanged(const QString &path);
+
+private:
+    /* Local socket server. */
+    QLocalServer *server = nullptr;
+
+    /* Watcher on library directories used by previous commands. */
+    QFileSystemWatcher *watcher = nullptr;
+
+    /* Project manager of the last command, replaced for every command. */
+    QSocProjectManager *projectManager = nullptr;
+
+    /* Resident managers shared by all commands. */
+    QSocConfig          *socConfig       = nullptr;
+    QLLMService         *llmService      = nullptr;
+    QSocBusManager      *busManager      = nullptr;
+    QSocModuleManager   *moduleManager   = nullptr;
+    QSocGenerateManager *generateManager = nullptr;
+
+    /* Watched module and bus directories. */
+    QSet<QString> moduleDirSet;
+    QSet<QString> busDirSet;
+
+    /* Connections waiting for their command to be executed. */
+    QList<QPointer<QLocalSocket>> pendingList;
+
+    /* A command is executing, new requests are queued. */
+    bool busy = false;
+
+    /**
+     * @brief Execute queued requests in arrival order.
+     */
+    void processPending();
+
+    /**
+     * @brief Execute one request and stream its output to the client.
+     * @param socket The client connection.
+     * @param request The decoded request object.
+     */
+    void execute(QLocalSocket *socket, const QJsonObject &request);
+
+    /**
+     * @brief Watch the library directories of the current project.
+     */
+    void watchProjectPaths();
+
+    /**
+     * @brief Write one reply line to a client.
+     * @param socket The client connection.
+     * @param reply The reply object.
+     */
+    static void writeReply(QLocalSocket *socket, const QJsonObject &reply);
+};
+
+#endif // QSOCCLISERVER_H
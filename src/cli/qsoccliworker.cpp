@@ -11,26 +11,62 @@
 #include <QTimer>
 #include <QtGlobal>
 
+#include <mutex>
+
 QSocCliWorker::QSocCliWorker(QObject *parent)
     : QObject(parent)
     , projectManager(new QSocProjectManager(this))
-    , socConfig(new QSocConfig(this, projectManager))
-    , llmService(new QLLMService(this, socConfig))
-    , busManager(new QSocBusManager(this, projectManager))
-    , moduleManager(new QSocModuleManager(this, projectManager, busManager, llmService))
-    , generateManager(new QSocGenerateManager(this, projectManager, moduleManager, busManager))
+    , socConfig([this]() { return new QSocConfig(this, projectManager); })
+    , llmService([this]() { return new QLLMService(this, socConfig); })
+    , busManager([this]() { return new QSocBusManager(this, projectManager); })
+    , moduleManager([this]() {
+        return new QSocModuleManager(this, projectManager, busManager, llmService);
+    })
+    , generateManager([this]() {
+        return new QSocGenerateManager(this, projectManager, moduleManager, busManager);
+    })
+{
+    setupParser();
+}
+
+QSocCliWorker::QSocCliWorker(QObject *parent, const Managers &managers)
+    : QObject(parent)
+    , projectManager(managers.projectManager)
 {
-    /* Set up application name and version */
-    QCoreApplication::setApplicationName("QSoC");
-    QCoreApplication::setApplicationVersion(QSOC_VERSION);
+    socConfig       = managers.socConfig;
+    llmService      = managers.llmService;
+    busManager      = managers.busManager;
+    moduleManager   = managers.moduleManager;
+    generateManager = managers.generateManager;
+    setupParser();
+}
+
+void QSocCliWorker::Managers::attachProject(QSocProjectManager *project)
+{
+    projectManager = project;
+    socConfig->setProjectManager(project);
+    busManager->setProjectManager(project);
+    moduleManager->setProjectManager(project);
+    generateManager->setProjectManager(project);
+    generateManager->resetCommandState();
+}
+
+QSocCliWorker::~QSocCliWorker() = default;
+
+void QSocCliWorker::setupParser()
+{
+    /* Set up application name and version once, workers may run in threads */
+    static std::once_flag applicationOnce;
+    std::call_once(applicationOnce, []() {
+        QCoreApplication::setApplicationName("QSoC");
+        QCoreApplication::setApplicationVersion(QSOC_VERSION);
+    });
     /* Set up command line parser */
     parser.setApplicationDescription(
         QCoreApplication::translate("main", "Generate SoC components via the command line."));
     parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsOptions);
 }
 
-QSocCliWorker::~QSocCliWorker() = default;
-
 void QSocCliWorker::setup(const QStringList &appArguments, bool isGui)
 {
     /* Set up exit code */
@@ -63,6 +99,14 @@ void QSocCliWorker::run()
     emit exit(exitCode);
 }
 
+int QSocCliWorker::execute(const QStringList &appArguments)
+{
+    resident = true;
+    exitCode = 0;
+    parseRoot(appArguments);
+    return exitCode;
+}
+
 bool QSocCliWorker::showVersion(int exitCode)
 {
     qInfo().noquote() << QCoreApplication::applicationName()
@@ -113,10 +157,9 @@ bool QSocCliWorker::showHelpOrError(int exitCode, const QString &message)
     return result;
 }
 
-bool QSocCliWorker::parseRoot(const QStringList &appArguments)
+QList<QCommandLineOption> QSocCliWorker::rootOptions()
 {
-    /* Set up command line options */
-    parser.addOptions({
+    return {
         {{"h", "help"},
          QCoreApplication::translate("main", "Displays help on commandline options.")},
         {"verbose",
@@ -127,7 +170,13 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
              "0=silent, 1=error, 2=warning, 3=info, 4=debug, 5=verbose"),
          "level"},
         {{"v", "version"}, QCoreApplication::translate("main", "Displays version information.")},
-    });
+    };
+}
+
+bool QSocCliWorker::parseRoot(const QStringList &appArguments)
+{
+    /* Set up command line options */
+    parser.addOptions(rootOptions());
     parser.addPositionalArgument(
         "command",
         QCoreApplication::translate(
@@ -138,7 +187,10 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
             "bus         Import, update of bus.\n"
             "schematic   Processing of Schematic.\n"
             "generate    Generate rtl, such as verilog, etc.\n"
-            "agent       Run interactive AI agent mode.\n"),
+            "netlist     Query the connectivity of netlists.\n"
+            "agent       Run interactive AI agent mode.\n"
+            "batch       Run many commands from a script in one process.\n"
+            "serve       Run a persistent daemon for fast repeated commands.\n"),
         "<command> [command options]");
     parser.parse(appArguments);
     /* Set verbosity level as early as possible */
@@ -165,6 +217,13 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
     /* Perform different operations according to different subcommands */
     const QString &command       = cmdArguments.first();
     QStringList    nextArguments = appArguments;
+    if (resident && (command == "gui" || command == "agent" || command == "serve")) {
+        return showError(
+            1,
+            QCoreApplication::translate(
+                "main", "Error: %1 is not available in daemon or batch mode.")
+                .arg(command));
+    }
     if (command == "gui") {
         QStaticLog::logV(Q_FUNC_INFO, "Starting GUI ...");
     } else if (command == "project") {
@@ -190,15 +249,40 @@ bool QSocCliWorker::parseRoot(const QStringList &appArguments)
         if (!parseGenerate(nextArguments)) {
             return false;
         }
+    } else if (command == "netlist") {
+        nextArguments.removeOne(command);
+        if (!parseNetlist(nextArguments)) {
+            return false;
+        }
     } else if (command == "agent") {
         nextArguments.removeOne(command);
         if (!parseAgent(nextArguments)) {
             return false;
         }
+    } else if (command == "batch") {
+        nextArguments.removeOne(command);
+        if (!parseBatch(nextArguments)) {
+            return false;
+        }
+    } else if (command == "serve") {
+        nextArguments.removeOne(command);
+        if (!parseServe(nextArguments)) {
+            return false;
+        }
     } else {
         return showHelpOrError(
             1, QCoreApplication::translate("main", "Error: unknown subcommand: %1.").arg(command));
     }
+    if (resident) {
+        /* QCommandLineParser::process() exits on errors, never in the daemon */
+        if (!parser.unknownOptionNames().isEmpty()) {
+            return showError(
+                1,
+                QCoreApplication::translate("main", "Error: unknown options: %1.")
+                    .arg(parser.unknownOptionNames().join(", ")));
+        }
+        return true;
+    }
     parser.process(*QCoreApplication::instance());
     return true;
 }
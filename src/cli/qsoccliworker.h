@@ -4,6 +4,7 @@
 #ifndef QSOCCLIWORKER_H
 #define QSOCCLIWORKER_H
 
+#include "cli/qsocclilazy.h"
 #include "common/qllmservice.h"
 #include "common/qsocbusmanager.h"
 #include "common/qsocconfig.h"
@@ -14,7 +15,9 @@
 #include <QApplication>
 #include <QCommandLineParser>
 #include <QFileInfo>
+#include <QList>
 #include <QObject>
+#include <QPair>
 #include <QStringList>
 
 class QSocAgent;
@@ -37,6 +40,40 @@ public:
      */
     explicit QSocCliWorker(QObject *parent = nullptr);
 
+    /**
+     * @brief Managers shared with a long-lived host.
+     * @details The host owns these objects and keeps them alive between
+     *          commands, so loaded libraries stay resident.
+     */
+    struct Managers
+    {
+        QSocProjectManager  *projectManager  = nullptr;
+        QSocConfig          *socConfig       = nullptr;
+        QLLMService         *llmService      = nullptr;
+        QSocBusManager      *busManager      = nullptr;
+        QSocModuleManager   *moduleManager   = nullptr;
+        QSocGenerateManager *generateManager = nullptr;
+
+        /**
+         * @brief Point every manager at a new project manager.
+         * @details Used to give each command fresh project state while the
+         *          libraries stay resident. The generate manager drops the
+         *          options and netlist state of the previous command.
+         * @param[in] project The project manager of the next command.
+         */
+        void attachProject(QSocProjectManager *project);
+    };
+
+    /**
+     * @brief Constructor for QSocCliWorker with shared managers.
+     * @details This constructor will initialize the command line parser and
+     *          reuse the given managers instead of creating its own. Commands
+     *          are then run with execute().
+     * @param[in] parent parent object.
+     * @param[in] managers managers owned by the host.
+     */
+    QSocCliWorker(QObject *parent, const Managers &managers);
+
     /**
      * @brief Destructor for QSocCliWorker.
      * @details This destructor will free the command line parser.
@@ -60,6 +97,27 @@ public:
      */
     void process();
 
+    /**
+     * @brief Execute one command synchronously.
+     * @details Parses and runs the command line arguments in the calling
+     *          thread and returns once the command has finished. The worker
+     *          runs in resident mode: it never terminates the process and
+     *          refuses the interactive gui, agent and serve commands.
+     * @param[in] appArguments command line arguments, including the program
+     *            name as the first element.
+     * @return int The exit code of the command.
+     */
+    int execute(const QStringList &appArguments);
+
+    /**
+     * @brief Options accepted before the subcommand.
+     * @details The global options of the root parser, shared with callers
+     *          that need to find the subcommand of a command line the same
+     *          way the worker does.
+     * @return QList<QCommandLineOption> The root options.
+     */
+    static QList<QCommandLineOption> rootOptions();
+
 public slots:
     /**
      * @brief Run the command line parser.
@@ -75,14 +133,22 @@ private:
     QStringList cmdArguments;
 
     /* ExitCode of the application. */
-    int exitCode;
+    int exitCode = 0;
+
+    /* Running inside a host such as the serve daemon or a batch script. */
+    bool resident = false;
 
-    QSocProjectManager  *projectManager  = nullptr;
-    QSocConfig          *socConfig       = nullptr;
-    QLLMService         *llmService      = nullptr;
-    QSocBusManager      *busManager      = nullptr;
-    QSocModuleManager   *moduleManager   = nullptr;
-    QSocGenerateManager *generateManager = nullptr;
+    /* Generated files and the input files each one was built from. */
+    QList<QPair<QString, QStringList>> depfileRuleList;
+
+    QSocProjectManager *projectManager = nullptr;
+
+    /* Services created on first use, so light commands start fast. */
+    QSocCliLazy<QSocConfig>          socConfig;
+    QSocCliLazy<QLLMService>         llmService;
+    QSocCliLazy<QSocBusManager>      busManager;
+    QSocCliLazy<QSocModuleManager>   moduleManager;
+    QSocCliLazy<QSocGenerateManager> generateManager;
 
     /**
      * @brief Parse the application command line arguments.
@@ -305,6 +371,26 @@ private:
      */
     bool parseBusShow(const QStringList &appArguments);
 
+    /**
+     * @brief Parse the netlist command line arguments.
+     * @details This function will parse the netlist command line arguments.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseNetlist(const QStringList &appArguments);
+
+    /**
+     * @brief Parse the netlist trace command line arguments.
+     * @details This function will parse the netlist trace command line
+     *          arguments to answer driver, fanout, fanin, path and bit slice
+     *          queries on a processed netlist.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseNetlistTrace(const QStringList &appArguments);
+
     /**
      * @brief Parse the generate commandline arguments.
      * @details This function will parse the generate command line arguments.
@@ -343,6 +429,58 @@ private:
      */
     bool processIndividualNetlists(const QStringList &filePathList);
 
+    /**
+     * @brief Process netlist files individually in parallel.
+     * @details Every job gets its own generate manager and its own copy of
+     *          the loaded module and bus libraries. Messages of each file are
+     *          collected and printed in command line order. All files are
+     *          processed even when some of them fail.
+     * @param filePathList List of netlist file paths to process.
+     * @param jobs Number of netlist files generated at the same time.
+     * @retval true All files were generated.
+     * @retval false At least one file failed.
+     */
+    bool processParallelNetlists(const QStringList &filePathList, int jobs);
+
+    /**
+     * @brief Lint generated Verilog files in process.
+     * @details Elaborates every file with slang on a thread pool, together
+     *          with the primitive cell files and the generated files of the
+     *          modules it instantiates. Diagnostics are printed in the order
+     *          of the file list, each with the instance or net it belongs to.
+     * @param outputFilePathList List of generated Verilog files.
+     * @param jobs Number of files linted at the same time.
+     * @retval true No file has lint errors, warnings are allowed.
+     * @retval false At least one file has lint errors.
+     */
+    bool lintOutputs(const QStringList &outputFilePathList, int jobs);
+
+    /**
+     * @brief Regenerate netlist outputs whenever their inputs change.
+     * @details Watches the netlist files, every input recorded for each
+     *          output and the module and bus directories. After a change
+     *          settles, libraries are reloaded, parsing only the files that
+     *          changed on disk, and only the outputs depending on a changed
+     *          file are generated again. A new library file regenerates all
+     *          outputs. Runs until the application exits.
+     * @param filePathList List of netlist file paths to process.
+     * @param mergeMode Generate one output from all netlist files merged.
+     * @param jobs Number of netlist files generated at the same time.
+     * @retval true The last regeneration succeeded.
+     * @retval false The last regeneration failed.
+     */
+    bool watchNetlists(const QStringList &filePathList, bool mergeMode, int jobs);
+
+    /**
+     * @brief Write the depfile requested with the depfile option.
+     * @details Writes one make rule per generated file, listing the input
+     *          files it was built from, in the format read by make and ninja.
+     *          Does nothing when the depfile option is not set.
+     * @retval true The depfile was written or not requested.
+     * @retval false The depfile could not be written.
+     */
+    bool writeDepfile();
+
     /**
      * @brief Parse the generate template command line arguments.
      * @details This function will parse the generate template command line arguments
@@ -363,6 +501,28 @@ private:
      */
     bool parseGenerateStub(const QStringList &appArguments);
 
+    /**
+     * @brief Parse the batch command line arguments.
+     * @details This function will parse the batch command line arguments
+     *          to run every command of a script in this process, sharing
+     *          the loaded libraries and deferring library saves to the end.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseBatch(const QStringList &appArguments);
+
+    /**
+     * @brief Parse the serve command line arguments.
+     * @details This function will parse the serve command line arguments
+     *          to run a persistent daemon on a local socket, or to stop a
+     *          running one.
+     * @param appArguments command line arguments.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseServe(const QStringList &appArguments);
+
     /**
      * @brief Parse the agent command line arguments.
      * @details This function will parse the agent command line arguments
@@ -465,6 +625,12 @@ private:
      */
     bool showHelpOrError(int exitCode, const QString &message);
 
+    /**
+     * @brief Set up application information and the command line parser.
+     * @details This function is shared by all constructors.
+     */
+    void setupParser();
+
 signals:
     /**
      * @brief Exit the application.
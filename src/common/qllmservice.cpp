@@ -16,11 +16,10 @@
 
 QLLMService::QLLMService(QObject *parent, QSocConfig *config)
     : QObject(parent)
-    , networkManager(new QNetworkAccessManager(this))
     , config(config)
 {
+    /* The network manager is created on the first request */
     loadConfigSettings();
-    setupNetworkProxy();
 }
 
 QLLMService::~QLLMService() = default;
@@ -39,6 +38,15 @@ QSocConfig *QLLMService::getConfig()
     return config;
 }
 
+QNetworkAccessManager *QLLMService::getNetworkManager()
+{
+    if (!networkManager) {
+        networkManager = new QNetworkAccessManager(this);
+        setupNetworkProxy();
+    }
+    return networkManager;
+}
+
 /* Endpoint management */
 
 void QLLMService::addEndpoint(const LLMEndpoint &endpoint)
@@ -121,7 +129,8 @@ void QLLMService::sendRequestAsync(
     QNetworkRequest request = prepareRequest(endpoint);
     json payload = buildRequestPayload(prompt, systemPrompt, temperature, jsonMode, endpoint.model);
 
-    QNetworkReply *reply = networkManager->post(request, QByteArray::fromStdString(payload.dump()));
+    QNetworkReply *reply
+        = getNetworkManager()->post(request, QByteArray::fromStdString(payload.dump()));
 
     /* Set timeout */
     auto *timer = new QTimer(this);
@@ -442,7 +451,8 @@ LLMResponse QLLMService::sendRequestToEndpoint(
     json payload = buildRequestPayload(prompt, systemPrompt, temperature, jsonMode, endpoint.model);
 
     QEventLoop     loop;
-    QNetworkReply *reply = networkManager->post(request, QByteArray::fromStdString(payload.dump()));
+    QNetworkReply *reply
+        = getNetworkManager()->post(request, QByteArray::fromStdString(payload.dump()));
 
     /* Set timeout */
     QTimer timer;
@@ -536,7 +546,8 @@ void QLLMService::sendChatCompletionStream(
     streamAccumulatedReasoning.clear();
     streamCompleted = false;
 
-    currentStreamReply = networkManager->post(request, QByteArray::fromStdString(payload.dump()));
+    currentStreamReply
+        = getNetworkManager()->post(request, QByteArray::fromStdString(payload.dump()));
 
     /* Set timeout */
     auto *timer = new QTimer(this);
@@ -835,7 +846,7 @@ json QLLMService::sendChatCompletion(
 
         QEventLoop     loop;
         QNetworkReply *reply
-            = networkManager->post(request, QByteArray::fromStdString(payload.dump()));
+            = getNetworkManager()->post(request, QByteArray::fromStdString(payload.dump()));
 
         /* Set timeout */
         QTimer timer;
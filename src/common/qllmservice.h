@@ -248,6 +248,12 @@ private:
      */
     void setupNetworkProxy();
 
+    /**
+     * @brief Get the network manager, creating it on first use
+     * @return QNetworkAccessManager* The network manager
+     */
+    QNetworkAccessManager *getNetworkManager();
+
     /**
      * @brief Select an endpoint based on fallback strategy
      * @return Selected endpoint, or empty endpoint if none available
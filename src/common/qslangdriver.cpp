@@ -11,10 +11,16 @@
 #include <QRegularExpression>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
 
 #include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <functional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <slang/ast/ASTSerializer.h>
 #include <slang/ast/ASTVisitor.h>
@@ -22,12 +28,16 @@
 #include <slang/ast/expressions/MiscExpressions.h>
 #include <slang/ast/symbols/CompilationUnitSymbols.h>
 #include <slang/ast/symbols/ValueSymbol.h>
+#include <slang/diagnostics/DiagnosticEngine.h>
+#include <slang/diagnostics/Diagnostics.h>
 #include <slang/diagnostics/TextDiagnosticClient.h>
 #include <slang/driver/Driver.h>
 #include <slang/syntax/AllSyntax.h>
 #include <slang/syntax/SyntaxTree.h>
 #include <slang/syntax/SyntaxVisitor.h>
 #include <slang/text/Json.h>
+#include <slang/text/SourceManager.h>
+#include <slang/util/Bag.h>
 #include <slang/util/String.h>
 #include <slang/util/TimeTrace.h>
 #include <slang/util/VersionInfo.h>
@@ -60,6 +70,7 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
     slang::OS::setStdoutColorsEnabled(false);
 
     auto guard = slang::OS::captureOutput();
+    sourceFileList.clear();
 
     slang::driver::Driver driver;
     driver.addStandardArgs();
@@ -108,6 +119,16 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
             }
             throw std::runtime_error("Failed to parse sources");
         }
+        /* Every file the preprocessor opened, sources and includes alike */
+        QSet<QString> sourceFileSet;
+        for (const slang::BufferID buffer : driver.sourceManager.getAllBuffers()) {
+            const std::filesystem::path &fullPath = driver.sourceManager.getFullPath(buffer);
+            const QString                filePath = QString::fromStdString(fullPath.string());
+            if (!filePath.isEmpty() && !sourceFileSet.contains(filePath)) {
+                sourceFileSet.insert(filePath);
+                sourceFileList.append(filePath);
+            }
+        }
         slang::OS::capturedStdout.clear();
         slang::OS::capturedStderr.clear();
         driver.reportMacros();
@@ -159,9 +180,9 @@ bool QSlangDriver::parseArgs(const QString &args, bool silent)
             return depth <= 6;
         };
 
-        /* Parse JSON with depth limitation using callback */
-        auto jsonStr = std::string(writer.view());
-        ast          = json::parse(jsonStr, callback);
+        /* Parse JSON with depth limitation, straight from the writer buffer */
+        const std::string_view jsonView = writer.view();
+        ast                             = json::parse(jsonView.begin(), jsonView.end(), callback);
 
         /* Print partial AST */
         if (!silent) {
@@ -182,111 +203,303 @@ bool QSlangDriver::parseFileList(
     const QStringList &macroDefines,
     const QStringList &macroUndefines)
 {
-    bool    result  = false;
+    const QStringList sourceList = resolveFileList(fileListPath, filePathList);
+    if (sourceList.isEmpty()) {
+        QStaticLog::logE(Q_FUNC_INFO, "No source file found:" + fileListPath);
+        return false;
+    }
+    return parseSourceList(sourceList, macroDefines, macroUndefines);
+}
+
+namespace {
+
+/* Replace ${NAME} with its value in one pass, unknown names are kept as they are */
+QString expandEnvironment(const QString &entry, const QMap<QString, QString> &env)
+{
+    QString   result;
+    qsizetype index = 0;
+    while (index < entry.size()) {
+        const qsizetype open  = entry.indexOf("${", index);
+        const qsizetype close = open < 0 ? -1 : entry.indexOf('}', open + 2);
+        if (close < 0) {
+            break;
+        }
+        const QString name = entry.mid(open + 2, close - open - 2);
+        result += entry.mid(index, open - index);
+        result += env.contains(name) ? env.value(name) : entry.mid(open, close - open + 1);
+        index = close + 1;
+    }
+    result += entry.mid(index);
+    return result;
+}
+
+} // namespace
+
+QStringList QSlangDriver::resolveFileList(
+    const QString &fileListPath, const QStringList &filePathList)
+{
     QString content = "";
     if (!QFileInfo::exists(fileListPath) && filePathList.isEmpty()) {
         QStaticLog::logE(
             Q_FUNC_INFO,
             "File path parameter is empty, also the file list path not exist:" + fileListPath);
-    } else {
-        /* Process read file list path */
-        if (QFileInfo::exists(fileListPath)) {
-            QStaticLog::logD(Q_FUNC_INFO, "Use file list path:" + fileListPath);
-            /* Read text from filelist */
-            QFile inputFile(fileListPath);
-            if (inputFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                QTextStream inputStream(&inputFile);
-                content = inputStream.readAll();
-            } else {
-                QStaticLog::logE(Q_FUNC_INFO, "Failed to open file list:" + fileListPath);
-            }
-        }
-        /* Process append of file path list */
-        if (!filePathList.isEmpty()) {
-            QStaticLog::logD(Q_FUNC_INFO, "Use file path list:" + filePathList.join(","));
-            /* Append file path list to the end of content */
-            content.append("\n" + filePathList.join("\n"));
-        }
-        /* Removes comments from the content */
-        content = contentCleanComment(content);
-        /* Substitute environment variables */
-        if (projectManager) {
-            const QMap<QString, QString>   env = projectManager->getEnv();
-            QMapIterator<QString, QString> iterator(env);
-            while (iterator.hasNext()) {
-                iterator.next();
-                /* Create pattern */
-                const QString pattern = QString("${%1}").arg(iterator.key());
-                /* Replace environment variable */
-                content = content.replace(pattern, iterator.value());
-            }
-        }
-        /* Convert relative path to absolute path */
-        if (QFileInfo::exists(fileListPath)) {
-            content = contentValidFile(content, QFileInfo(fileListPath).absoluteDir());
-        }
-        /* Create a temporary file */
-        QTemporaryFile tempFile("qsoc.fl");
-        /* Do not remove file after close */
-        tempFile.setAutoRemove(false);
-        if (tempFile.open()) {
-            /* Write new content to temporary file */
-            QTextStream outputStream(&tempFile);
-            outputStream << content;
-            tempFile.flush();
-            tempFile.close();
-            /* clang-format off */
-            QString baseArgs = QStaticStringWeaver::stripCommonLeadingWhitespace(R"(
-                slang
-                --ignore-unknown-modules
-                --single-unit
-                --compat vcs
-                --timescale 1ns/10ps
-                --error-limit=0
-                -Wunknown-sys-name
-                -Wbitwise-op-mismatch
-                -Wcomparison-mismatch
-                -Wunconnected-port
-                -Wsign-compare
-                --ignore-directive delay_mode_path
-                --ignore-directive suppress_faults
-                --ignore-directive enable_portfaults
-                --ignore-directive disable_portfaults
-                --ignore-directive nosuppress_faults
-                --ignore-directive delay_mode_distributed
-                --ignore-directive delay_mode_unit
-            )");
-            /* Add macro definitions */
-            for (const QString &macro : macroDefines) {
-                baseArgs += QString(" -D\"%1\"").arg(macro);
-            }
-            /* Add macro undefines */
-            for (const QString &macro : macroUndefines) {
-                baseArgs += QString(" -U\"%1\"").arg(macro);
-            }
-            /* Add file list */
-            baseArgs += QString(" -f \"%1\"").arg(tempFile.fileName());
-            const QString args = baseArgs;
-            /* clang-format on */
-
-            QStaticLog::logV(Q_FUNC_INFO, "TemporaryFile name:" + tempFile.fileName());
-            QStaticLog::logV(Q_FUNC_INFO, "Content list begin");
-            QStaticLog::logV(Q_FUNC_INFO, content.toStdString().c_str());
-            QStaticLog::logV(Q_FUNC_INFO, "Content list end");
-            result = parseArgs(args);
-            /* Delete temporary file */
-            tempFile.remove();
+        return QStringList();
+    }
+    /* Process read file list path */
+    const bool useFileList = QFileInfo::exists(fileListPath);
+    if (useFileList) {
+        QStaticLog::logD(Q_FUNC_INFO, "Use file list path:" + fileListPath);
+        /* Read text from filelist */
+        QFile inputFile(fileListPath);
+        if (inputFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            QTextStream inputStream(&inputFile);
+            content = inputStream.readAll();
+        } else {
+            QStaticLog::logE(Q_FUNC_INFO, "Failed to open file list:" + fileListPath);
+        }
+    }
+    /* Process append of file path list */
+    if (!filePathList.isEmpty()) {
+        QStaticLog::logD(Q_FUNC_INFO, "Use file path list:" + filePathList.join(","));
+        /* Append file path list to the end of content */
+        content.append("\n" + filePathList.join("\n"));
+    }
+
+    /* One tokenizer pass, then environment and path resolution per entry */
+    const QMap<QString, QString> env = projectManager ? projectManager->getEnv()
+                                                      : QMap<QString, QString>();
+    const QDir                   baseDir = QFileInfo(fileListPath).absoluteDir();
+    QStringList                  sourceList;
+    for (const QString &token : tokenizeFileList(content)) {
+        const QString entry = token.contains("${") ? expandEnvironment(token, env) : token;
+        if (!useFileList) {
+            sourceList.append(entry);
+            continue;
         }
+        /* Convert relative path to absolute path, keep existing files only */
+        const QString   absolutePath = QDir::isRelativePath(entry) ? baseDir.filePath(entry)
+                                                                   : entry;
+        const QFileInfo fileInfo(absolutePath);
+        if (fileInfo.exists() && fileInfo.isFile()) {
+            sourceList.append(absolutePath);
+        }
+    }
+    return sourceList;
+}
+
+QString QSlangDriver::sourceListArgs(
+    const QString &fileListPath, const QStringList &macroDefines, const QStringList &macroUndefines)
+{
+    /* clang-format off */
+    QString args = QStaticStringWeaver::stripCommonLeadingWhitespace(R"(
+        slang
+        --ignore-unknown-modules
+        --single-unit
+        --compat vcs
+        --timescale 1ns/10ps
+        --error-limit=0
+        -Wunknown-sys-name
+        -Wbitwise-op-mismatch
+        -Wcomparison-mismatch
+        -Wunconnected-port
+        -Wsign-compare
+        --ignore-directive delay_mode_path
+        --ignore-directive suppress_faults
+        --ignore-directive enable_portfaults
+        --ignore-directive disable_portfaults
+        --ignore-directive nosuppress_faults
+        --ignore-directive delay_mode_distributed
+        --ignore-directive delay_mode_unit
+    )");
+    /* Add macro definitions */
+    for (const QString &macro : macroDefines) {
+        args += QString(" -D\"%1\"").arg(macro);
+    }
+    /* Add macro undefines */
+    for (const QString &macro : macroUndefines) {
+        args += QString(" -U\"%1\"").arg(macro);
+    }
+    /* Add file list */
+    args += QString(" -f \"%1\"").arg(fileListPath);
+    /* clang-format on */
+    return args;
+}
+
+bool QSlangDriver::parseSourceList(
+    const QStringList &sourceList,
+    const QStringList &macroDefines,
+    const QStringList &macroUndefines)
+{
+    bool          result  = false;
+    const QString content = sourceList.join("\n");
+    /* Create a temporary file */
+    QTemporaryFile tempFile("qsoc.fl");
+    /* Do not remove file after close */
+    tempFile.setAutoRemove(false);
+    if (tempFile.open()) {
+        /* Write new content to temporary file */
+        QTextStream outputStream(&tempFile);
+        outputStream << content;
+        tempFile.flush();
+        tempFile.close();
+        const QString args = sourceListArgs(tempFile.fileName(), macroDefines, macroUndefines);
+
+        QStaticLog::logV(Q_FUNC_INFO, "TemporaryFile name:" + tempFile.fileName());
+        QStaticLog::logV(Q_FUNC_INFO, "Content list begin");
+        QStaticLog::logV(Q_FUNC_INFO, content.toStdString().c_str());
+        QStaticLog::logV(Q_FUNC_INFO, "Content list end");
+        result = parseArgs(args);
+        /* The temporary file list is not a source */
+        sourceFileList.removeAll(QFileInfo(tempFile.fileName()).absoluteFilePath());
+        /* Delete temporary file */
+        tempFile.remove();
     }
 
     return result;
 }
 
+void QSlangDriver::release()
+{
+    /* Swap with empty values, clear() alone keeps the capacity */
+    compilation.reset();
+    json().swap(ast);
+    QStringList().swap(moduleList);
+    QStringList().swap(sourceFileList);
+}
+
+namespace {
+
+/* Elaborate one module as the only top, on a compilation of its own */
+json elaborateParameterization(
+    const std::vector<std::shared_ptr<slang::syntax::SyntaxTree>> &treeList,
+    const slang::Bag                                              &baseOptions,
+    const QSlangDriver::Parameterization                          &parameterization)
+{
+    /* topModules holds views, the name must outlive the compilation */
+    const std::string              moduleName = parameterization.moduleName.toStdString();
+    slang::ast::CompilationOptions compilationOptions
+        = baseOptions.getOrDefault<slang::ast::CompilationOptions>();
+    compilationOptions.topModules.clear();
+    compilationOptions.topModules.emplace(moduleName);
+    compilationOptions.paramOverrides.clear();
+    for (auto iter = parameterization.overrideMap.constBegin();
+         iter != parameterization.overrideMap.constEnd();
+         ++iter) {
+        compilationOptions.paramOverrides.push_back(
+            QString("%1=%2").arg(iter.key(), iter.value()).toStdString());
+    }
+    slang::Bag options = baseOptions;
+    options.set(compilationOptions);
+
+    slang::ast::Compilation compilation(options);
+    for (const auto &tree : treeList) {
+        compilation.addSyntaxTree(tree);
+    }
+    for (const slang::ast::InstanceSymbol *instance : compilation.getRoot().topInstances) {
+        if (instance->name != moduleName) {
+            continue;
+        }
+        slang::JsonWriter         writer;
+        slang::ast::ASTSerializer serializer(compilation, writer);
+        serializer.serialize(*instance);
+
+        /* Ports and parameters sit a few levels below the instance */
+        const json::parser_callback_t callback =
+            [](int depth, json::parse_event_t /*event*/, json & /*parsed*/) -> bool {
+            return depth <= 6;
+        };
+        const std::string_view jsonView = writer.view();
+        return json::parse(jsonView.begin(), jsonView.end(), callback);
+    }
+    return json();
+}
+
+} // namespace
+
+QList<json> QSlangDriver::elaborateParameterizations(
+    const QStringList             &sourceList,
+    const QStringList             &macroDefines,
+    const QStringList             &macroUndefines,
+    const QList<Parameterization> &parameterizationList,
+    int                            jobs)
+{
+    /* Filled by index from pool threads, a vector never detaches */
+    std::vector<json> resultList(parameterizationList.size());
+    const auto        result = [&resultList]() {
+        return QList<json>(resultList.begin(), resultList.end());
+    };
+    if (parameterizationList.isEmpty()) {
+        return result();
+    }
+
+    QTemporaryFile tempFile("qsoc.fl");
+    if (!tempFile.open()) {
+        QStaticLog::logE(Q_FUNC_INFO, "Failed to create temporary file list");
+        return result();
+    }
+    QTextStream outputStream(&tempFile);
+    outputStream << sourceList.join("\n");
+    outputStream.flush();
+    tempFile.close();
+    const QString args = sourceListArgs(tempFile.fileName(), macroDefines, macroUndefines);
+
+    /* Parse once on this thread, slang output capture is process wide */
+    slang::OS::setStderrColorsEnabled(false);
+    slang::OS::setStdoutColorsEnabled(false);
+    auto                  guard = slang::OS::captureOutput();
+    slang::driver::Driver driver;
+    driver.addStandardArgs();
+    try {
+        if (!driver.parseCommandLine(std::string_view(args.toStdString()))
+            || !driver.processOptions() || !driver.parseAllSources()) {
+            QStaticLog::logE(Q_FUNC_INFO, slang::OS::capturedStderr.c_str());
+            return result();
+        }
+    } catch (const std::exception &e) {
+        QStaticLog::logE(Q_FUNC_INFO, e.what());
+        return result();
+    }
+    const slang::Bag baseOptions = driver.createOptionBag();
+
+    /* Syntax trees are immutable once parsed, every compilation shares them */
+    std::atomic<qsizetype> nextIndex{0};
+    const auto             elaborate = [&]() {
+        qsizetype index = 0;
+        while ((index = nextIndex++) < parameterizationList.size()) {
+            try {
+                resultList[index] = elaborateParameterization(
+                    driver.syntaxTrees, baseOptions, parameterizationList.at(index));
+            } catch (const std::exception &e) {
+                QStaticLog::logE(Q_FUNC_INFO, e.what());
+            }
+        }
+    };
+
+    const int threadCount = static_cast<int>(qMin<qsizetype>(
+        jobs > 0 ? jobs : QThread::idealThreadCount(), parameterizationList.size()));
+    if (threadCount <= 1) {
+        elaborate();
+        return result();
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount);
+    for (int job = 0; job < threadCount; ++job) {
+        pool.start(elaborate);
+    }
+    pool.waitForDone();
+    return result();
+}
+
 const json &QSlangDriver::getAst()
 {
     return ast;
 }
 
+const QStringList &QSlangDriver::getSourceFileList() const
+{
+    return sourceFileList;
+}
+
 const json &QSlangDriver::getModuleAst(const QString &moduleName)
 {
     if (ast.contains("members")) {
@@ -317,36 +530,63 @@ const QStringList &QSlangDriver::getModuleList()
     return moduleList;
 }
 
+QStringList QSlangDriver::tokenizeFileList(const QString &content)
+{
+    QStringList     entryList;
+    QString         entry;
+    bool            blockComment = false;
+    const qsizetype size         = content.size();
+
+    /* Every line break ends an entry, also inside a block comment */
+    const auto endEntry = [&]() {
+        const QString trimmed = entry.trimmed();
+        if (!trimmed.isEmpty()) {
+            entryList.append(trimmed);
+        }
+        entry.clear();
+    };
+
+    for (qsizetype index = 0; index < size; ++index) {
+        const QChar current = content.at(index);
+        const QChar next    = index + 1 < size ? content.at(index + 1) : QChar();
+        if (current == '\n' || current == '\r') {
+            endEntry();
+        } else if (blockComment) {
+            if (current == '*' && next == '/') {
+                blockComment = false;
+                ++index;
+            }
+        } else if (current == '/' && next == '/') {
+            /* Skip to the line break, which ends the entry */
+            while (index + 1 < size && content.at(index + 1) != '\n'
+                   && content.at(index + 1) != '\r') {
+                ++index;
+            }
+        } else if (current == '/' && next == '*') {
+            blockComment = true;
+            ++index;
+        } else {
+            entry.append(current);
+        }
+    }
+    endEntry();
+    return entryList;
+}
+
 QString QSlangDriver::contentCleanComment(const QString &content)
 {
-    QString result = content;
-    /* Normalize line endings to Unix-style */
-    result.replace(QRegularExpression(R"(\r\n|\r)"), "\n");
-    /* Remove single line comment */
-    result.remove(QRegularExpression(R"(\s*//[^\n]*\s*)"));
-    /* Remove multiline comments */
-    result.remove(QRegularExpression(R"(\s*/\*.*?\*/\s*)"));
-    /* Remove empty lines */
-    result.remove(QRegularExpression(R"(\n\s*\n)"));
-    return result;
+    return tokenizeFileList(content).join("\n");
 }
 
 QString QSlangDriver::contentValidFile(const QString &content, const QDir &baseDir)
 {
     QStringList result;
-    /* Splitting content into lines, considering different newline characters */
-    const QStringList lines = content.split(QRegularExpression(R"(\r\n|\n|\r)"), Qt::KeepEmptyParts);
-
-    for (const QString &line : lines) {
-        QString absolutePath = line;
-        /* Check for relative path and convert it to absolute */
-        if (QDir::isRelativePath(line)) {
-            /* Convert relative path to absolute path */
-            absolutePath = baseDir.filePath(line);
-        } else {
-            /* Preserve absolute paths and non-path content as is */
-            absolutePath = line;
+    for (QString line : content.split('\n')) {
+        if (line.endsWith('\r')) {
+            line.chop(1);
         }
+        /* Relative paths are taken from the base directory, anything else as is */
+        const QString   absolutePath = QDir::isRelativePath(line) ? baseDir.filePath(line) : line;
         const QFileInfo fileInfo(absolutePath);
         /* Check if path exists and is a regular file (including valid symlinks to files) */
         if (fileInfo.exists() && fileInfo.isFile()) {
@@ -642,3 +882,439 @@ QSet<QString> QSlangDriver::extractSignalReferences(const QSet<QString> &exclude
 
     return signalSet;
 }
+
+namespace {
+
+/* Prefix of the temporary module wrapping each analyzed snippet */
+constexpr std::string_view snippetModulePrefix = "__qsoc_snippet_";
+
+/* Integer value of a plain decimal literal, -1 for anything else */
+int snippetConstantValue(const slang::syntax::ExpressionSyntax *expr)
+{
+    if (!expr || expr->kind != slang::syntax::SyntaxKind::IntegerLiteralExpression) {
+        return -1;
+    }
+    const auto &literal = expr->as<slang::syntax::LiteralExpressionSyntax>();
+    try {
+        return std::stoi(std::string(literal.literal.valueText()));
+    } catch (...) {
+        return -1;
+    }
+}
+
+/* Text of an identifier token as QString */
+QString snippetTokenText(const slang::parsing::Token &token)
+{
+    return QString::fromStdString(std::string(token.valueText()));
+}
+
+/* Names, parameters and select widths found below one snippet module */
+struct SnippetCollector
+{
+    QSet<QString>      names;
+    QSet<QString>      parameters;
+    QMap<QString, int> bitWidths;
+
+    void recordWidth(const QString &signalName, int highBit)
+    {
+        if (signalName.isEmpty() || highBit < 0) {
+            return;
+        }
+        const int requiredWidth = highBit + 1;
+        if (bitWidths.value(signalName, 0) < requiredWidth) {
+            bitWidths[signalName] = requiredWidth;
+        }
+    }
+
+    void visit(
+        const slang::syntax::SyntaxNode &node, bool constantScope, const QString &selectOwner)
+    {
+        using slang::syntax::SyntaxKind;
+
+        QString owner = selectOwner;
+        switch (node.kind) {
+        case SyntaxKind::ParameterDeclaration:
+        case SyntaxKind::TypeParameterDeclaration:
+        case SyntaxKind::EnumType:
+            /* Parameter and enum member names are constants, not signals */
+            constantScope = true;
+            break;
+        case SyntaxKind::Declarator: {
+            const auto &declarator = node.as<slang::syntax::DeclaratorSyntax>();
+            if (constantScope) {
+                parameters.insert(snippetTokenText(declarator.name));
+            } else {
+                names.insert(snippetTokenText(declarator.name));
+            }
+            break;
+        }
+        case SyntaxKind::IdentifierName: {
+            const auto &idName = node.as<slang::syntax::IdentifierNameSyntax>();
+            names.insert(snippetTokenText(idName.identifier));
+            break;
+        }
+        case SyntaxKind::IdentifierSelectName: {
+            const auto &selectName = node.as<slang::syntax::IdentifierSelectNameSyntax>();
+            owner                  = snippetTokenText(selectName.identifier);
+            names.insert(owner);
+            break;
+        }
+        case SyntaxKind::SimpleRangeSelect:
+        case SyntaxKind::AscendingRangeSelect:
+        case SyntaxKind::DescendingRangeSelect: {
+            const auto &rangeSelect = node.as<slang::syntax::RangeSelectSyntax>();
+            const int   leftIdx     = snippetConstantValue(rangeSelect.left);
+            const int   rightIdx    = snippetConstantValue(rangeSelect.right);
+            if (leftIdx >= 0 && rightIdx >= 0) {
+                recordWidth(selectOwner, std::max(leftIdx, rightIdx));
+            }
+            break;
+        }
+        case SyntaxKind::BitSelect: {
+            const auto &bitSelect = node.as<slang::syntax::BitSelectSyntax>();
+            recordWidth(selectOwner, snippetConstantValue(bitSelect.expr));
+            break;
+        }
+        default:
+            break;
+        }
+
+        for (uint32_t i = 0; i < node.getChildCount(); i++) {
+            const auto *child = node.childNode(i);
+            if (child) {
+                visit(*child, constantScope, owner);
+            }
+        }
+    }
+};
+
+/* Byte range of one wrapped snippet inside the parsed text */
+struct SnippetRange
+{
+    qsizetype index;
+    size_t    begin;
+    size_t    end;
+};
+
+/* Append a snippet wrapped in its indexed temporary module */
+SnippetRange snippetWrap(std::string &text, qsizetype index, const QString &verilogCode)
+{
+    SnippetRange range{index, text.size(), 0};
+    text += "module " + std::string(snippetModulePrefix) + std::to_string(index) + "__;\n";
+    text += verilogCode.toStdString();
+    text += "\nendmodule\n";
+    range.end = text.size();
+    return range;
+}
+
+/*
+ * Parse wrapped snippets held in memory and fill the result entries of every
+ * module found. Returns the snippet indexes touched by syntax errors or whose
+ * module could not be recovered from the tree.
+ */
+QSet<qsizetype> snippetAnalyzeText(
+    const std::string                      &text,
+    const std::vector<SnippetRange>        &ranges,
+    QList<QSlangDriver::SnippetSignalInfo> &result)
+{
+    slang::SourceManager sourceManager;
+    const auto           tree = slang::syntax::SyntaxTree::fromText(text, sourceManager);
+
+    QSet<qsizetype> failed;
+    for (const slang::Diagnostic &diag : tree->diagnostics()) {
+        if (!diag.isError()) {
+            continue;
+        }
+        const size_t offset = diag.location.offset();
+        const auto   range  = std::upper_bound(
+            ranges.begin(), ranges.end(), offset, [](size_t value, const SnippetRange &item) {
+                return value < item.begin;
+            });
+        if (range != ranges.begin() && offset < std::prev(range)->end) {
+            failed.insert(std::prev(range)->index);
+        }
+    }
+
+    QSet<qsizetype>                                        found;
+    std::function<void(const slang::syntax::SyntaxNode &)> findModules =
+        [&](const slang::syntax::SyntaxNode &node) {
+            if (node.kind == slang::syntax::SyntaxKind::ModuleDeclaration) {
+                const auto            &module = node.as<slang::syntax::ModuleDeclarationSyntax>();
+                const std::string_view name   = module.header->name.valueText();
+                if (!name.starts_with(snippetModulePrefix) || !name.ends_with("__")) {
+                    return;
+                }
+                const QString   indexText = QString::fromStdString(std::string(name.substr(
+                    snippetModulePrefix.size(), name.size() - snippetModulePrefix.size() - 2)));
+                bool            ok        = false;
+                const qsizetype index     = indexText.toLongLong(&ok);
+                if (!ok || index < 0 || index >= result.size()) {
+                    return;
+                }
+                SnippetCollector collector;
+                collector.visit(node, false, QString());
+                QSlangDriver::SnippetSignalInfo &info = result[index];
+                info.valid                            = !failed.contains(index);
+                info.signalSet.clear();
+                info.bitWidths = collector.bitWidths;
+                for (const QString &signalName : collector.names) {
+                    if (!signalName.isEmpty() && !signalName.startsWith("__")
+                        && !collector.parameters.contains(signalName)) {
+                        info.signalSet.insert(signalName);
+                    }
+                }
+                found.insert(index);
+                return;
+            }
+            for (uint32_t i = 0; i < node.getChildCount(); i++) {
+                const auto *child = node.childNode(i);
+                if (child) {
+                    findModules(*child);
+                }
+            }
+        };
+    findModules(tree->root());
+
+    for (const SnippetRange &range : ranges) {
+        if (!found.contains(range.index)) {
+            failed.insert(range.index);
+        }
+    }
+    return failed;
+}
+
+} // namespace
+
+QList<QSlangDriver::SnippetSignalInfo> QSlangDriver::analyzeVerilogSnippets(
+    const QStringList &verilogCodes)
+{
+    QList<SnippetSignalInfo> result(verilogCodes.size());
+    if (verilogCodes.isEmpty()) {
+        return result;
+    }
+
+    /* Pass 1: all snippets in one syntax tree, each inside its own module */
+    std::string               text;
+    std::vector<SnippetRange> ranges;
+    ranges.reserve(verilogCodes.size());
+    for (qsizetype i = 0; i < verilogCodes.size(); ++i) {
+        ranges.push_back(snippetWrap(text, i, verilogCodes.at(i)));
+    }
+    QList<qsizetype> failed = snippetAnalyzeText(text, ranges, result).values();
+    std::sort(failed.begin(), failed.end());
+
+    /* Pass 2: isolate snippets touched by syntax errors so they cannot spill over */
+    for (const qsizetype index : failed) {
+        std::string                     single;
+        const std::vector<SnippetRange> singleRange{
+            snippetWrap(single, index, verilogCodes.at(index))};
+        snippetAnalyzeText(single, singleRange, result);
+        if (result.at(index).valid) {
+            continue;
+        }
+        QStaticLog::logD(
+            Q_FUNC_INFO, "Syntax error in snippet: " + verilogCodes.at(index).simplified());
+    }
+
+    return result;
+}
+
+namespace {
+
+/* Byte range of an instance or net declaration in the linted file */
+struct LintEntry
+{
+    size_t  begin;
+    size_t  end;
+    QString name;
+};
+
+/* Modules declared and instantiated in one syntax tree, and its entry ranges */
+struct LintScan
+{
+    QSet<QString>          definedSet;
+    QStringList            instantiatedList;
+    std::vector<LintEntry> entryList;
+
+    using DeclaratorList = slang::syntax::SeparatedSyntaxList<slang::syntax::DeclaratorSyntax>;
+
+    void addDeclarators(const slang::syntax::SyntaxNode &node, const DeclaratorList &declarators)
+    {
+        for (const auto *declarator : declarators) {
+            /* A single declarator owns the whole declaration, type included */
+            const auto range = declarators.size() == 1 ? node.sourceRange()
+                                                       : declarator->sourceRange();
+            entryList.push_back(
+                {range.start().offset(),
+                 range.end().offset(),
+                 "net " + snippetTokenText(declarator->name)});
+        }
+    }
+
+    void visit(const slang::syntax::SyntaxNode &node)
+    {
+        using slang::syntax::SyntaxKind;
+
+        switch (node.kind) {
+        case SyntaxKind::ModuleDeclaration:
+        case SyntaxKind::InterfaceDeclaration:
+        case SyntaxKind::ProgramDeclaration: {
+            const auto &module = node.as<slang::syntax::ModuleDeclarationSyntax>();
+            definedSet.insert(snippetTokenText(module.header->name));
+            break;
+        }
+        case SyntaxKind::HierarchyInstantiation: {
+            const auto &instantiation = node.as<slang::syntax::HierarchyInstantiationSyntax>();
+            const QString moduleName  = snippetTokenText(instantiation.type);
+            if (!instantiatedList.contains(moduleName)) {
+                instantiatedList.append(moduleName);
+            }
+            /* The parameter assignment in front belongs to the first instance */
+            size_t begin = instantiation.sourceRange().start().offset();
+            for (const auto *instance : instantiation.instances) {
+                if (instance->decl) {
+                    entryList.push_back(
+                        {begin,
+                         instance->sourceRange().end().offset(),
+                         "instance " + snippetTokenText(instance->decl->name)});
+                }
+                begin = instance->sourceRange().end().offset();
+            }
+            break;
+        }
+        case SyntaxKind::NetDeclaration:
+            addDeclarators(node, node.as<slang::syntax::NetDeclarationSyntax>().declarators);
+            break;
+        case SyntaxKind::DataDeclaration:
+            addDeclarators(node, node.as<slang::syntax::DataDeclarationSyntax>().declarators);
+            break;
+        default:
+            break;
+        }
+
+        for (uint32_t i = 0; i < node.getChildCount(); i++) {
+            const auto *child = node.childNode(i);
+            if (child) {
+                visit(*child);
+            }
+        }
+    }
+};
+
+/* Innermost entry enclosing an offset, empty when there is none */
+QString lintEntryAt(const std::vector<LintEntry> &entryList, size_t offset)
+{
+    const LintEntry *found = nullptr;
+    for (const LintEntry &entry : entryList) {
+        if (entry.begin <= offset && offset < entry.end
+            && (!found || entry.end - entry.begin < found->end - found->begin)) {
+            found = &entry;
+        }
+    }
+    return found ? found->name : QString();
+}
+
+} // namespace
+
+QList<QSlangDriver::LintMessage> QSlangDriver::lintVerilog(
+    const QString &filePath, const QStringList &libraryFileList, const QStringList &searchDirList)
+{
+    QList<LintMessage> result;
+    const QString      primaryPath = QFileInfo(filePath).absoluteFilePath();
+
+    try {
+        slang::SourceManager           sourceManager;
+        slang::ast::CompilationOptions compilationOptions;
+        compilationOptions.flags |= slang::ast::CompilationFlags::IgnoreUnknownModules;
+        slang::Bag options;
+        options.set(compilationOptions);
+        slang::ast::Compilation compilation(options);
+
+        QSet<QString>          loadedSet;
+        QSet<QString>          definedSet;
+        QStringList            pendingList;
+        std::vector<LintEntry> primaryEntryList;
+        slang::BufferID        primaryBuffer;
+
+        const auto loadFile = [&](const QString &path, bool primary) {
+            const QString absolutePath = QFileInfo(path).absoluteFilePath();
+            if (loadedSet.contains(absolutePath)) {
+                return true;
+            }
+            loadedSet.insert(absolutePath);
+            QFile file(absolutePath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                return false;
+            }
+            const std::string text = file.readAll().toStdString();
+            const auto        tree = slang::syntax::SyntaxTree::fromText(
+                text,
+                sourceManager,
+                QFileInfo(absolutePath).fileName().toStdString(),
+                absolutePath.toStdString(),
+                options);
+            LintScan scan;
+            scan.visit(tree->root());
+            definedSet.unite(scan.definedSet);
+            pendingList.append(scan.instantiatedList);
+            if (primary) {
+                primaryEntryList = std::move(scan.entryList);
+                primaryBuffer    = tree->root().sourceRange().start().buffer();
+            }
+            compilation.addSyntaxTree(tree);
+            return true;
+        };
+
+        if (!loadFile(primaryPath, true)) {
+            result.append(LintMessage{true, primaryPath, 0, 0, "unable to read file", QString()});
+            return result;
+        }
+        for (const QString &libraryFile : libraryFileList) {
+            loadFile(libraryFile, false);
+        }
+        /* Resolve undefined modules by file name, files found add their own */
+        for (qsizetype index = 0; index < pendingList.size(); ++index) {
+            const QString &moduleName = pendingList.at(index);
+            if (definedSet.contains(moduleName)) {
+                continue;
+            }
+            for (const QString &searchDir : searchDirList) {
+                const QString candidate = QDir(searchDir).filePath(moduleName + ".v");
+                if (QFileInfo::exists(candidate)) {
+                    loadFile(candidate, false);
+                    break;
+                }
+            }
+        }
+
+        slang::DiagnosticEngine        engine(sourceManager);
+        const std::vector<std::string> warningOptions
+            = {"default", "width-trunc", "width-expand", "port-width-trunc", "port-width-expand"};
+        engine.setWarningOptions(warningOptions);
+
+        for (const slang::Diagnostic &diag : compilation.getAllDiagnostics()) {
+            const slang::DiagnosticSeverity severity = engine.getSeverity(diag.code, diag.location);
+            if (severity == slang::DiagnosticSeverity::Ignored
+                || severity == slang::DiagnosticSeverity::Note) {
+                continue;
+            }
+            const slang::SourceLocation location = sourceManager.getFullyOriginalLoc(
+                diag.location);
+            if (location.buffer() != primaryBuffer) {
+                continue;
+            }
+            LintMessage message;
+            message.error    = severity >= slang::DiagnosticSeverity::Error;
+            message.filePath = primaryPath;
+            message.line     = static_cast<int>(sourceManager.getLineNumber(location));
+            message.column   = static_cast<int>(sourceManager.getColumnNumber(location));
+            message.message  = QString::fromStdString(engine.formatMessage(diag));
+            message.entry    = lintEntryAt(primaryEntryList, location.offset());
+            result.append(message);
+        }
+    } catch (const std::exception &e) {
+        result.append(LintMessage{true, primaryPath, 0, 0, QString::fromUtf8(e.what()), QString()});
+    }
+
+    return result;
+}
@@ -8,7 +8,9 @@
 
 #include <memory>
 #include <QDir>
+#include <QMap>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
@@ -83,6 +85,82 @@ public slots:
         const QStringList &macroDefines   = QStringList(),
         const QStringList &macroUndefines = QStringList());
 
+    /**
+     * @brief Resolve the source entries of a file list.
+     * @details Reads the file list, appends the file path list, removes
+     *          comments and substitutes project environment variables. When
+     *          a file list is given, only existing files are kept, as absolute
+     *          paths. These are the entries parseFileList() hands to slang.
+     * @param fileListPath file list path.
+     * @param filePathList file path list.
+     * @return QStringList The source entries in order, empty if none is found.
+     */
+    QStringList resolveFileList(const QString &fileListPath, const QStringList &filePathList);
+
+    /**
+     * @brief Parse resolved source entries.
+     * @details Parses the entries returned by resolveFileList(), or any slice
+     *          of them, as one compilation unit.
+     * @param sourceList source entries, one file or option per entry.
+     * @param macroDefines macro definitions in KEY or KEY=VALUE format.
+     * @param macroUndefines macro names to undefine.
+     * @retval true Parse successfully.
+     * @retval false Parse failed.
+     */
+    bool parseSourceList(
+        const QStringList &sourceList,
+        const QStringList &macroDefines   = QStringList(),
+        const QStringList &macroUndefines = QStringList());
+
+    /**
+     * @brief Get the files read by the last parse.
+     * @details Lists every file the preprocessor opened, the sources and
+     *          all files they include, as absolute paths in load order.
+     * @return QStringList & The file list, empty after release().
+     */
+    const QStringList &getSourceFileList() const;
+
+    /**
+     * @brief Release the compilation and the AST.
+     * @details Frees everything the last parse keeps alive. Callers extract
+     *          what they need first, getAst(), getModuleAst() and
+     *          getModuleList() are empty afterwards.
+     */
+    void release();
+
+    /**
+     * @brief A module with parameter overrides to elaborate.
+     */
+    struct Parameterization
+    {
+        QString                moduleName;  /**< Module elaborated as top */
+        QMap<QString, QString> overrideMap; /**< Override value by parameter */
+    };
+
+    /**
+     * @brief Elaborate modules under parameter overrides.
+     * @details The sources are parsed once as a single unit. Each
+     *          parameterization is then elaborated on its own compilation,
+     *          all of them sharing the syntax trees, on up to @p jobs
+     *          threads. Only the requested module is elaborated, with its
+     *          submodules, never the whole design. The parse of this driver,
+     *          if any, is left untouched.
+     * @param sourceList Source entries as returned by resolveFileList().
+     * @param macroDefines Macro definitions in KEY or KEY=VALUE format.
+     * @param macroUndefines Macro names to undefine.
+     * @param parameterizationList Modules and overrides to elaborate.
+     * @param jobs Maximum number of threads, 0 uses all cores.
+     * @return QList<json> The instance AST of each parameterization, in
+     *         the order given, or null where elaboration failed. All null
+     *         when the sources cannot be parsed.
+     */
+    QList<json> elaborateParameterizations(
+        const QStringList             &sourceList,
+        const QStringList             &macroDefines,
+        const QStringList             &macroUndefines,
+        const QList<Parameterization> &parameterizationList,
+        int                            jobs = 0);
+
     /**
      * @brief Get Abstract Syntax Tree.
      * @details This function will return the Abstract Syntax Tree
@@ -130,6 +208,65 @@ public slots:
      */
     QSet<QString> extractSignalReferences(const QSet<QString> &excludeSignals = {});
 
+    /**
+     * @brief Signal information extracted from a single Verilog snippet.
+     */
+    struct SnippetSignalInfo
+    {
+        bool               valid = false; /**< Snippet parsed without syntax errors */
+        QSet<QString>      signalSet;     /**< Signal names referenced or declared */
+        QMap<QString, int> bitWidths;     /**< Minimum width implied by constant selects */
+    };
+
+    /**
+     * @brief Analyze Verilog snippets in one in-memory syntax pass
+     * @details Wraps every snippet in its own temporary module, parses all of
+     *          them as a single syntax tree and walks each module to collect
+     *          signal names and bit width requirements. No temporary files,
+     *          elaboration or AST serialization are involved, so the result is
+     *          purely syntactic: parameters and internal "__" names are dropped,
+     *          everything else referenced or declared is reported. Snippets hit
+     *          by a syntax error are re-parsed alone so that one broken snippet
+     *          cannot affect its neighbours.
+     * @param verilogCodes Verilog code snippets (module items such as assign)
+     * @return One entry per snippet, in the same order as the input
+     */
+    static QList<SnippetSignalInfo> analyzeVerilogSnippets(const QStringList &verilogCodes);
+
+    /**
+     * @brief One diagnostic reported by lintVerilog().
+     */
+    struct LintMessage
+    {
+        bool    error  = false; /**< Error, otherwise a warning */
+        QString filePath;       /**< File the diagnostic points into */
+        int     line   = 0;     /**< One based line number */
+        int     column = 0;     /**< One based column number */
+        QString message;        /**< Diagnostic text */
+        QString entry;          /**< Enclosing instance or net, empty when none */
+    };
+
+    /**
+     * @brief Elaborate a Verilog file in memory and report its diagnostics
+     * @details Parses the file together with the library files, and loads
+     *          <module>.v from the search directories for every module that is
+     *          instantiated but not yet defined, the same way as a simulator
+     *          library directory. Modules found nowhere are treated as black
+     *          boxes. Width truncation and expansion warnings are enabled on
+     *          top of the default set. Only diagnostics inside the file itself
+     *          are reported, each with the instance or net declaration that
+     *          encloses it. The function keeps all state local and does not
+     *          capture console output, so it can run on several threads at once.
+     * @param filePath Verilog file to lint
+     * @param libraryFileList Files always loaded, such as primitive cells
+     * @param searchDirList Directories searched for undefined modules
+     * @return Diagnostics in source order, empty when the file is clean
+     */
+    static QList<LintMessage> lintVerilog(
+        const QString     &filePath,
+        const QStringList &libraryFileList = QStringList(),
+        const QStringList &searchDirList   = QStringList());
+
 private:
     /**
      * @brief Extract bit width requirements from Verilog code syntax
@@ -149,6 +286,17 @@ private:
     QSet<QString> extractAllIdentifiers(const QString &verilogCode);
 
 public:
+    /**
+     * @brief Split file list content into entries.
+     * @details Scans the content once, removing single line and multiline
+     *          comments. Every line break ends an entry, entries are trimmed
+     *          and empty ones are dropped. Accepts Unix, Windows and classic
+     *          Mac line endings.
+     * @param content The file list content.
+     * @return QStringList The entries in order.
+     */
+    static QStringList tokenizeFileList(const QString &content);
+
     /**
      * @brief Removes comments from the content.
      * @details This function strips both single line and multiline comments
@@ -174,6 +322,18 @@ public:
     QString contentValidFile(const QString &content, const QDir &baseDir);
 
 private:
+    /**
+     * @brief Build the slang command line for a source list.
+     * @param fileListPath Path of the file list holding the sources.
+     * @param macroDefines Macro definitions in KEY or KEY=VALUE format.
+     * @param macroUndefines Macro names to undefine.
+     * @return QString The command line.
+     */
+    static QString sourceListArgs(
+        const QString     &fileListPath,
+        const QStringList &macroDefines,
+        const QStringList &macroUndefines);
+
     /* Pointer of project manager. */
     QSocProjectManager *projectManager = nullptr;
     /* Compilation object to store parsing results */
@@ -182,6 +342,8 @@ private:
     json ast;
     /* Module list. */
     QStringList moduleList;
+    /* Files read by the last parse, sources and includes. */
+    QStringList sourceFileList;
 };
 
 #endif // QSLANGDRIVER_H
@@ -3,11 +3,14 @@
 
 #include "common/qsocbusmanager.h"
 
+#include "common/qsocyamlutils.h"
 #include "common/qstaticregex.h"
 
 #include <QDebug>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
 
 #include <fstream>
 #include <string>
@@ -15,6 +18,13 @@
 
 #include <rapidcsv.h>
 
+namespace {
+
+/* How long a save waits for another process writing the same library */
+constexpr int libraryLockTimeout = 60000;
+
+} // namespace
+
 QSocBusManager::QSocBusManager(QObject *parent, QSocProjectManager *projectManager)
     : QObject{parent}
     , projectManager(projectManager)
@@ -22,7 +32,13 @@ QSocBusManager::QSocBusManager(QObject *parent, QSocProjectManager *projectManag
     /* All private members set by constructor */
 }
 
-QSocBusManager::~QSocBusManager() = default;
+QSocBusManager::~QSocBusManager()
+{
+    /* Deferred saves still reach the disk when the owner forgets to flush */
+    if (!dirtyLibrarySet.isEmpty()) {
+        flush();
+    }
+}
 
 void QSocBusManager::setProjectManager(QSocProjectManager *projectManager)
 {
@@ -52,6 +68,63 @@ bool QSocBusManager::isBusPathValid()
     return true;
 }
 
+void QSocBusManager::resetBusData()
+{
+    /* Clear the library map */
+    libraryMap.clear();
+    libraryDigest.clear();
+    dirtyLibrarySet.clear();
+    changedBusMap.clear();
+    /* Reset the bus data by creating a new empty YAML node */
+    busData = YAML::Node();
+}
+
+void QSocBusManager::copyLibraryData(const QSocBusManager &other)
+{
+    libraryMap       = other.libraryMap;
+    libraryDigest    = other.libraryDigest;
+    libraryCachePath = other.libraryCachePath;
+    /* Clone, so that node lookups never touch the original */
+    busData = YAML::Clone(other.busData);
+}
+
+void QSocBusManager::setLibraryCache(bool enable)
+{
+    libraryCache = enable;
+}
+
+bool QSocBusManager::isLibraryCache() const
+{
+    return libraryCache;
+}
+
+void QSocBusManager::setDeferredSave(bool enable)
+{
+    deferredSave = enable;
+    if (enable) {
+        libraryCache = true;
+    }
+}
+
+bool QSocBusManager::isDeferredSave() const
+{
+    return deferredSave;
+}
+
+bool QSocBusManager::flush()
+{
+    bool result = true;
+    /* Write pending libraries to the directory they were loaded from */
+    for (const QString &libraryName : std::as_const(dirtyLibrarySet)) {
+        if (libraryMap.contains(libraryName) && !writeLibrary(libraryName, libraryCachePath)) {
+            qCritical() << "Error: Failed to flush library:" << libraryName;
+            result = false;
+        }
+    }
+    dirtyLibrarySet.clear();
+    return result;
+}
+
 bool QSocBusManager::importFromFileList(
     const QString &libraryName, const QString &busName, const QStringList &filePathList)
 {
@@ -264,6 +337,20 @@ void QSocBusManager::libraryMapRemove(const QString &libraryName, const QString
     }
 }
 
+void QSocBusManager::unloadLibrary(const QString &libraryName)
+{
+    const YAML::Node &data    = busData;
+    const std::string library = libraryName.toStdString();
+    for (const QString &busName : libraryMap.value(libraryName)) {
+        const YAML::Node busYaml = data[busName.toStdString()];
+        if (busYaml && busYaml["library"] && busYaml["library"].Scalar() == library) {
+            busData.remove(busName.toStdString());
+        }
+    }
+    libraryMap.remove(libraryName);
+    libraryDigest.remove(libraryName);
+}
+
 bool QSocBusManager::saveLibraryYaml(const QString &libraryName, const YAML::Node &libraryYaml)
 {
     YAML::Node localLibraryYaml;
@@ -275,6 +362,16 @@ bool QSocBusManager::saveLibraryYaml(const QString &libraryName, const YAML::Nod
     /* Check file path */
     const QString &busPath  = projectManager->getBusPath();
     const QString &filePath = QDir(busPath).filePath(QString("%1.soc_bus").arg(libraryName));
+    /* Pending edits must reach the file before it is merged */
+    if (dirtyLibrarySet.remove(libraryName) && !writeLibrary(libraryName, libraryCachePath)) {
+        return false;
+    }
+    /* Merge under the lock, so concurrent imports into one library all land */
+    QLockFile lockFile(filePath + ".lock");
+    if (!lockFile.tryLock(libraryLockTimeout)) {
+        qCritical() << "Error: Unable to lock library:" << filePath;
+        return false;
+    }
     if (QFile::exists(filePath)) {
         /* Load library YAML file */
         std::ifstream inputFileStream(filePath.toStdString());
@@ -285,12 +382,10 @@ bool QSocBusManager::saveLibraryYaml(const QString &libraryName, const YAML::Nod
     }
 
     /* Save YAML file */
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
+    if (!QSocYamlUtils::saveFile(filePath, localLibraryYaml)) {
+        qCritical() << "Error: Unable to write file:" << filePath;
         return false;
     }
-    outputFileStream << localLibraryYaml;
     return true;
 }
 
@@ -361,16 +456,32 @@ bool QSocBusManager::load(const QString &libraryName)
     /* Get the full file path by joining bus path and basename with extension */
     const QString filePath = QDir(projectManager->getBusPath()).filePath(libraryName + ".soc_bus");
 
-    /* Open the YAML file */
-    std::ifstream fileStream(filePath.toStdString());
-    if (!fileStream.is_open()) {
+    /* Drop resident libraries that belong to another bus directory */
+    if (libraryCache && libraryCachePath != projectManager->getBusPath()) {
+        flush();
+        resetBusData();
+        libraryCachePath = projectManager->getBusPath();
+    }
+
+    /* Keep the resident copy when the library file is unchanged */
+    const QByteArray digest = QSocYamlUtils::fileDigest(filePath);
+    if (libraryCache && libraryMap.contains(libraryName)
+        && libraryDigest.value(libraryName) == digest) {
+        return true;
+    }
+
+    /* Check if the file can be read */
+    if (!QFileInfo(filePath).isReadable()) {
         qCritical() << "Error: Unable to open file:" << filePath;
         return false;
     }
 
     try {
         /* Load YAML content into a temporary node */
-        YAML::Node tempNode = YAML::Load(fileStream);
+        YAML::Node tempNode = QSocYamlUtils::loadFile(filePath);
+
+        /* A reload replaces the library, buses removed from the file go too */
+        unloadLibrary(libraryName);
 
         /* Iterate through the temporary node and add to busData */
         for (YAML::const_iterator it = tempNode.begin(); it != tempNode.end(); ++it) {
@@ -398,6 +509,7 @@ bool QSocBusManager::load(const QString &libraryName)
         return false;
     }
 
+    libraryDigest.insert(libraryName, digest);
     return true;
 }
 
@@ -414,6 +526,13 @@ bool QSocBusManager::load(const QRegularExpression &libraryNameRegex)
         return false;
     }
 
+    /* Drop libraries loaded earlier whose file has since been deleted */
+    for (const QString &libraryName : libraryDigest.keys()) {
+        if (!dirtyLibrarySet.contains(libraryName) && !isLibraryFileExist(libraryName)) {
+            unloadLibrary(libraryName);
+        }
+    }
+
     /* Get the list of library basenames matching the regex */
     const QStringList matchingBasenames = listLibrary(libraryNameRegex);
 
@@ -479,6 +598,8 @@ bool QSocBusManager::remove(const QString &libraryName)
     /* Remove from busData and libraryMap */
     busData.remove(libraryName.toStdString());
     libraryMap.remove(libraryName);
+    dirtyLibrarySet.remove(libraryName);
+    changedBusMap.remove(libraryName);
 
     return true;
 }
@@ -543,29 +664,104 @@ bool QSocBusManager::save(const QString &libraryName)
         return false;
     }
 
-    /* Extract buses from busData */
-    YAML::Node dataToSave;
-    /* Iterate through each bus in libraryMap */
-    for (const auto &busItem : libraryMap[libraryName]) {
-        const std::string busNameStd = busItem.toStdString();
-        if (!busData[busNameStd]) {
+    /* Only mark the library, flush() writes it later */
+    if (deferredSave) {
+        /* Libraries loaded before saves were deferred come from the current directory */
+        if (libraryCachePath.isEmpty()) {
+            libraryCachePath = projectManager->getBusPath();
+        }
+        dirtyLibrarySet.insert(libraryName);
+        return true;
+    }
+
+    return writeLibrary(libraryName, projectManager->getBusPath());
+}
+
+bool QSocBusManager::writeLibrary(const QString &libraryName, const QString &busPath)
+{
+    const QString filePath = QDir(busPath).filePath(libraryName + ".soc_bus");
+    /* Other processes may save the same library, the read-modify-write is theirs too */
+    QLockFile lockFile(filePath + ".lock");
+    if (!lockFile.tryLock(libraryLockTimeout)) {
+        qCritical() << "Error: Unable to lock library:" << filePath;
+        return false;
+    }
+
+    /* Start from the file as other processes left it, unless it is still the resident one */
+    const bool fileResident = libraryCache && busPath == libraryCachePath
+                              && libraryDigest.contains(libraryName)
+                              && libraryDigest.value(libraryName)
+                                     == QSocYamlUtils::fileDigest(filePath);
+    YAML::Node dataToSave(YAML::NodeType::Map);
+    if (!fileResident && QFile::exists(filePath)) {
+        try {
+            const YAML::Node diskYaml = QSocYamlUtils::loadFile(filePath);
+            if (diskYaml.IsMap()) {
+                for (const auto &entry : diskYaml) {
+                    dataToSave[entry.first] = entry.second;
+                }
+            }
+        } catch (const YAML::Exception &e) {
+            qWarning() << "Warning: Replacing unreadable library:" << filePath << e.what();
+        }
+    }
+
+    /* Apply the buses changed here, every resident bus when changes are not tracked */
+    const QSet<QString> residentSet = libraryMap.value(libraryName);
+    const auto          changed     = changedBusMap.constFind(libraryName);
+    const QSet<QString> changedSet  = (fileResident || changed == changedBusMap.constEnd())
+                                          ? residentSet
+                                          : changed.value();
+    const YAML::Node   &constData   = busData;
+    for (const QString &busName : changedSet) {
+        const std::string busNameStd = busName.toStdString();
+        if (!residentSet.contains(busName)) {
+            /* Removed by this process */
+            dataToSave.remove(busNameStd);
+            continue;
+        }
+        const YAML::Node &busNode = constData[busNameStd];
+        if (!busNode) {
             qCritical() << "Error: Bus data is not exist: " << busNameStd;
             return false;
         }
-        dataToSave[busNameStd] = busData[busNameStd];
-        if (dataToSave[busNameStd]["library"]) {
-            dataToSave[busNameStd].remove("library");
+        /* Share the entries except the library key, busData keeps its own */
+        YAML::Node busYaml(YAML::NodeType::Map);
+        for (const auto &entry : busNode) {
+            if (entry.first.Scalar() != "library") {
+                busYaml[entry.first] = entry.second;
+            }
         }
+        dataToSave[busNameStd] = busYaml;
     }
 
-    /* Serialize and save to file */
-    const QString filePath = QDir(projectManager->getBusPath()).filePath(libraryName + ".soc_bus");
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
+    /* Replace the file in one rename, a failed write keeps the old library */
+    if (!QSocYamlUtils::saveFile(filePath, dataToSave)) {
+        qCritical() << "Error: Unable to write file:" << filePath;
         return false;
     }
-    outputFileStream << dataToSave;
+    changedBusMap.remove(libraryName);
+
+    /* Take over what other processes changed, the resident library matches the file */
+    const YAML::Node &savedData = dataToSave;
+    for (const QString &busName : residentSet) {
+        if (!savedData[busName.toStdString()]) {
+            libraryMapRemove(libraryName, busName);
+            busData.remove(busName.toStdString());
+        }
+    }
+    for (const auto &entry : savedData) {
+        const QString busName = QString::fromStdString(entry.first.Scalar());
+        if (!changedSet.contains(busName)) {
+            /* Freshly parsed from the file, nothing else refers to the node */
+            busData[entry.first.Scalar()]            = entry.second;
+            busData[entry.first.Scalar()]["library"] = libraryName.toStdString();
+            libraryMapAdd(libraryName, busName);
+        }
+    }
+    if (libraryCache && busPath == libraryCachePath) {
+        libraryDigest.insert(libraryName, QSocYamlUtils::fileDigest(filePath));
+    }
     return true;
 }
 
@@ -671,6 +867,7 @@ bool QSocBusManager::removeBus(const QRegularExpression &busNameRegex)
         const QString libraryName = QString::fromStdString(
             busData[busName.toStdString()]["library"].as<std::string>());
         libraryMapRemove(libraryName, busName);
+        changedBusMap[libraryName].insert(busName);
         if (!libraryMap.contains(libraryName)) {
             libraryToRemove.insert(libraryName);
         }
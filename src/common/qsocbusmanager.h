@@ -6,6 +6,7 @@
 
 #include "common/qsocprojectmanager.h"
 
+#include <QByteArray>
 #include <QObject>
 #include <QRegularExpression>
 
@@ -59,6 +60,67 @@ public slots:
      */
     bool isBusPathValid();
 
+    /**
+     * @brief Reset the bus data in memory.
+     * @details Clears the libraryMap and busData members, providing a fresh
+     *          environment for the next load operation. This method does not
+     *          physically delete any files on disk, only clearing the in-memory
+     *          representation of bus data.
+     */
+    void resetBusData();
+
+    /**
+     * @brief Copy the loaded bus data of another bus manager.
+     * @details Deep copies the library map and busData, so that the copy can
+     *          be read from another thread while the original is in use.
+     *          Lookups on YAML nodes may insert entries, so sharing one
+     *          manager between threads is not safe even for reading.
+     * @param[in] other The bus manager to copy from.
+     */
+    void copyLibraryData(const QSocBusManager &other);
+
+    /**
+     * @brief Enable or disable reuse of already loaded libraries.
+     * @details When enabled, load() skips a library whose file has not been
+     *          modified since it was last read and keeps the in-memory copy.
+     *          Resident data is dropped when the bus directory changes.
+     * @param enable true to reuse unchanged libraries.
+     */
+    void setLibraryCache(bool enable);
+
+    /**
+     * @brief Check whether already loaded libraries are reused.
+     * @retval true Unchanged libraries are reused on load.
+     * @retval false Every load() reads the library file.
+     */
+    bool isLibraryCache() const;
+
+    /**
+     * @brief Enable or disable deferred library saves.
+     * @details While enabled, save() only marks the library as dirty and
+     *          flush() writes every dirty library at once. Enabling also
+     *          turns on the library cache, so pending edits survive later
+     *          load() calls on the same library.
+     * @param enable true to defer saves until flush().
+     */
+    void setDeferredSave(bool enable);
+
+    /**
+     * @brief Check whether library saves are deferred.
+     * @retval true save() waits for flush().
+     * @retval false save() writes the library at once.
+     */
+    bool isDeferredSave() const;
+
+    /**
+     * @brief Write all libraries with deferred saves.
+     * @details Writes every dirty library to the bus directory it was
+     *          loaded from. Does nothing when no save is pending.
+     * @retval true All pending libraries were written.
+     * @retval false Writing any library failed.
+     */
+    bool flush();
+
     /**
      * @brief Import CSV files into bus library.
      * @details Imports CSV files, specified in filePathList, into the
@@ -334,6 +396,39 @@ private:
     /* Bus library YAML node */
     YAML::Node busData;
 
+    /* Reuse unchanged libraries on load. */
+    bool libraryCache = false;
+
+    /* Content digest of each library file when it was last loaded. */
+    QMap<QString, QByteArray> libraryDigest;
+
+    /* The bus directory the resident libraries were loaded from. */
+    QString libraryCachePath;
+
+    /* Defer save() until flush(). */
+    bool deferredSave = false;
+
+    /* Libraries with deferred saves. */
+    QSet<QString> dirtyLibrarySet;
+
+    /* Buses removed by this process, by library. */
+    QMap<QString, QSet<QString>> changedBusMap;
+
+    /**
+     * @brief Serialize one library into a bus directory.
+     * @details Holds the library lock file while it rereads the library,
+     *          applies the buses this process removed and replaces the
+     *          file, so concurrent processes keep each other's changes.
+     *          The whole file is rewritten; buses are not spliced into
+     *          hand-edited YAML, so large libraries should be split.
+     * @param libraryName The basename of the library, excluding extension.
+     * @param busPath The bus directory to write to.
+     * @retval true The library file was written.
+     * @retval false Bus data is missing, the lock is held elsewhere or the
+     *         file cannot be written.
+     */
+    bool writeLibrary(const QString &libraryName, const QString &busPath);
+
     /**
      * @brief Merge two YAML nodes.
      * @details This function will merge two YAML nodes. It returns a new map
@@ -373,6 +468,15 @@ private:
      */
     void libraryMapRemove(const QString &libraryName, const QString &busName);
 
+    /**
+     * @brief Forget a resident library.
+     * @details Removes the buses loaded from the library, its library map
+     *          entry and its file stamp. Buses another library has since
+     *          redefined are kept.
+     * @param libraryName The basename of the library, excluding extension.
+     */
+    void unloadLibrary(const QString &libraryName);
+
 signals:
 };
 
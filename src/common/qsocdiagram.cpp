@@ -0,0 +1,881 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocdiagram.h"
+#include "common/config.h"
+
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+/* SVG pixels per centimeter at 96 dpi */
+constexpr float pxPerCm = 37.795f;
+/* Centimeters per typographic point */
+constexpr float cmPerPt = 2.54f / 72.0f;
+/* Default text size, as set by the Typst header */
+constexpr float defaultPt = 10.0f;
+/* Stub length of circuiteria, 1em of the default text */
+constexpr float stubLength = defaultPt * cmPerPt;
+/* Gap between a stub end and its name */
+constexpr float stubNameGap = 0.1f;
+/* Page margin, space below the header, and around tables */
+constexpr float pageMargin   = 0.5f;
+constexpr float headerGap    = 0.5f;
+constexpr float tableGap     = 0.3f;
+constexpr float tableNameGap = 0.2f;
+constexpr float tableInset   = 5.0f * cmPerPt;
+
+QString number(float value)
+{
+    return QString::number(value, 'f', 2);
+}
+
+/* Fill color as Typst expression */
+QString typstColor(const QString &color)
+{
+    static const QStringList palette
+        = {QStringLiteral("orange"),
+           QStringLiteral("yellow"),
+           QStringLiteral("green"),
+           QStringLiteral("pink"),
+           QStringLiteral("purple"),
+           QStringLiteral("blue")};
+    return palette.contains(color) ? QStringLiteral("util.colors.") + color : color;
+}
+
+/* Fill color as SVG paint, the circuiteria palette and Typst named colors */
+QString svgColor(const QString &color, bool text = false)
+{
+    static const QHash<QString, QString> paletteMap
+        = {{QStringLiteral("orange"), QStringLiteral("#f5b493")},
+           {QStringLiteral("yellow"), QStringLiteral("#fae17f")},
+           {QStringLiteral("green"), QStringLiteral("#7fc8ac")},
+           {QStringLiteral("pink"), QStringLiteral("#ec7fb2")},
+           {QStringLiteral("purple"), QStringLiteral("#bd97ff")},
+           {QStringLiteral("blue"), QStringLiteral("#7fcbeb")}};
+    /* Text colors are the Typst named colors, fills the circuiteria palette */
+    static const QHash<QString, QString> namedMap
+        = {{QStringLiteral("gray"), QStringLiteral("#aaaaaa")},
+           {QStringLiteral("red"), QStringLiteral("#ff4136")},
+           {QStringLiteral("blue"), QStringLiteral("#0074d9")},
+           {QStringLiteral("black"), QStringLiteral("#000000")},
+           {QStringLiteral("white"), QStringLiteral("#ffffff")}};
+    if (color.isEmpty()) {
+        return QStringLiteral("#000000");
+    }
+    if (!text && paletteMap.contains(color)) {
+        return paletteMap.value(color);
+    }
+    return namedMap.value(color, color);
+}
+
+/* Text for a Typst string literal */
+QString typstString(const QString &text)
+{
+    QString result = text;
+    return result.replace('\\', QStringLiteral("\\\\")).replace('"', QStringLiteral("\\\""));
+}
+
+/* Text for Typst markup, every markup character is taken literally */
+QString typstMarkup(const QString &text)
+{
+    static const QString special = QStringLiteral("\\[]#$*_`<>@~");
+    QString              result;
+    for (const QChar &character : text) {
+        if (special.contains(character)) {
+            result += '\\';
+        }
+        result += character;
+    }
+    return result;
+}
+
+/* Text for SVG character data and attribute values */
+QString svgText(const QString &text)
+{
+    return text.toHtmlEscaped();
+}
+
+/* Estimated width of a text in the monospaced font, wide characters take a full em */
+float textWidth(const QString &text, float sizePt)
+{
+    float em = 0.0f;
+    for (const QChar &character : text) {
+        if (!character.isLowSurrogate()) {
+            em += character.unicode() >= 0x2E80 ? 1.0f : 0.6f;
+        }
+    }
+    return em * sizePt * cmPerPt;
+}
+
+float textHeight(float sizePt)
+{
+    return sizePt * cmPerPt * 1.2f;
+}
+
+/* Bounding box in diagram coordinates */
+struct Bounds
+{
+    float minX  = 0.0f;
+    float minY  = 0.0f;
+    float maxX  = 0.0f;
+    float maxY  = 0.0f;
+    bool  valid = false;
+
+    void add(float x, float y)
+    {
+        if (!valid) {
+            minX = maxX = x;
+            minY = maxY = y;
+            valid       = true;
+            return;
+        }
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    void add(const QSocDiagram::Point &point) { add(point.x, point.y); }
+
+    /* Box of a text line at a position */
+    void addText(
+        const QSocDiagram::Point &at, const QString &text, float sizePt, QSocDiagram::Align align)
+    {
+        const float width  = textWidth(text, sizePt);
+        const float height = textHeight(sizePt);
+        float       left   = at.x - width / 2;
+        if (align == QSocDiagram::Align::West) {
+            left = at.x;
+        } else if (align == QSocDiagram::Align::East) {
+            left = at.x - width;
+        }
+        add(left, at.y - height / 2);
+        add(left + width, at.y + height / 2);
+    }
+};
+
+/* Unit vector of a stub side */
+QSocDiagram::Point sideVector(const QString &side)
+{
+    if (side == QLatin1String("west")) {
+        return {-1.0f, 0.0f};
+    }
+    if (side == QLatin1String("east")) {
+        return {1.0f, 0.0f};
+    }
+    if (side == QLatin1String("south")) {
+        return {0.0f, -1.0f};
+    }
+    return {0.0f, 1.0f};
+}
+
+/* Position and alignment of a stub name at the free end */
+QSocDiagram::Align stubName(
+    const QSocDiagram::Point &start, const QString &side, QSocDiagram::Point &at)
+{
+    const QSocDiagram::Point direction = sideVector(side);
+    const float              distance  = stubLength + stubNameGap;
+    at = {start.x + direction.x * distance, start.y + direction.y * distance};
+    if (direction.x < 0.0f) {
+        return QSocDiagram::Align::East;
+    }
+    if (direction.x > 0.0f) {
+        return QSocDiagram::Align::West;
+    }
+    /* Vertical stubs carry the name past the end */
+    at.y += direction.y * textHeight(defaultPt) / 2;
+    return QSocDiagram::Align::Center;
+}
+
+} // namespace
+
+QSocDiagram::QSocDiagram(const QString &title)
+    : title(title)
+{
+    /* All private members set by constructor */
+}
+
+void QSocDiagram::comment(const QString &text)
+{
+    Item item;
+    item.kind = Kind::Comment;
+    item.name = text;
+    itemList.append(item);
+}
+
+void QSocDiagram::block(
+    float              x,
+    float              y,
+    float              w,
+    float              h,
+    const QString     &id,
+    const QString     &name,
+    const QString     &fill,
+    const QList<Port> &westPorts,
+    const QList<Port> &eastPorts)
+{
+    Item item;
+    item.kind      = Kind::Block;
+    item.x         = x;
+    item.y         = y;
+    item.w         = w;
+    item.h         = h;
+    item.id        = id;
+    item.name      = name;
+    item.fill      = fill;
+    item.westPorts = westPorts;
+    item.eastPorts = eastPorts;
+    itemList.append(item);
+}
+
+void QSocDiagram::anchor(const QString &id, Point at)
+{
+    Item item;
+    item.kind = Kind::Anchor;
+    item.x    = at.x;
+    item.y    = at.y;
+    item.id   = id;
+    itemList.append(item);
+}
+
+void QSocDiagram::multiplexer(
+    float x, float y, float w, float h, const QString &id, const QString &fill, int entries)
+{
+    Item item;
+    item.kind  = Kind::Multiplexer;
+    item.x     = x;
+    item.y     = y;
+    item.w     = w;
+    item.h     = h;
+    item.id    = id;
+    item.fill  = fill;
+    item.count = entries;
+    itemList.append(item);
+}
+
+void QSocDiagram::stub(const QString &anchor, const QString &side, const QString &name)
+{
+    Item item;
+    item.kind = Kind::Stub;
+    item.from = anchor;
+    item.to   = side;
+    item.name = name;
+    itemList.append(item);
+}
+
+void QSocDiagram::wire(const QString &id, const QString &from, const QString &to)
+{
+    Item item;
+    item.kind = Kind::Wire;
+    item.id   = id;
+    item.from = from;
+    item.to   = to;
+    itemList.append(item);
+}
+
+void QSocDiagram::line(const QString &from, Point to, bool arrow)
+{
+    Item item;
+    item.kind  = Kind::Line;
+    item.from  = from;
+    item.x     = to.x;
+    item.y     = to.y;
+    item.arrow = arrow;
+    itemList.append(item);
+}
+
+void QSocDiagram::polygon(const QList<Point> &points, const QString &fill)
+{
+    Item item;
+    item.kind   = Kind::Polygon;
+    item.points = points;
+    item.fill   = fill;
+    itemList.append(item);
+}
+
+void QSocDiagram::circle(Point center, float radius, const QString &fill)
+{
+    Item item;
+    item.kind = Kind::Circle;
+    item.x    = center.x;
+    item.y    = center.y;
+    item.w    = radius;
+    item.fill = fill;
+    itemList.append(item);
+}
+
+void QSocDiagram::text(Point at, const QString &text, float size, Align align)
+{
+    Item item;
+    item.kind  = Kind::Text;
+    item.x     = at.x;
+    item.y     = at.y;
+    item.name  = text;
+    item.size  = size;
+    item.align = align;
+    itemList.append(item);
+}
+
+void QSocDiagram::table(const QString &title, int columns, const QList<Cell> &cells)
+{
+    Item item;
+    item.kind  = Kind::Table;
+    item.name  = title;
+    item.count = qMax(1, columns);
+    item.cells = cells;
+    itemList.append(item);
+}
+
+QString QSocDiagram::toTypst() const
+{
+    QString     result;
+    QTextStream s(&result);
+
+    s << "#import \"@preview/circuiteria:0.2.0\": *\n"
+      << "#import \"@preview/cetz:0.3.2\": draw\n"
+      << "#set page(width: auto, height: auto, margin: .5cm)\n"
+      << "#set text(font: \"Sarasa Mono SC\", size: 10pt)\n"
+      << "#align(center)[\n"
+      << "  = " << typstMarkup(title) << "\n"
+      << "  #text(size: 8pt, fill: gray)[Generated by QSoC v" << QSOC_VERSION << "]\n"
+      << "]\n"
+      << "#v(0.5cm)\n"
+      << "#circuit({\n";
+
+    /* Port list of one block side, circuiteria needs the trailing comma */
+    auto portList = [](const QList<Port> &portList) {
+        QStringList entryList;
+        for (const Port &port : portList) {
+            entryList << (port.pos < 0.0f
+                              ? QString("(id: \"%1\")").arg(typstString(port.id))
+                              : QString("(id: \"%1\", pos: %2)")
+                                    .arg(typstString(port.id), number(port.pos)));
+        }
+        return "(" + entryList.join(", ") + ",)";
+    };
+
+    for (const Item &item : itemList) {
+        switch (item.kind) {
+        case Kind::Comment:
+            s << "  // " << item.name << "\n";
+            break;
+        case Kind::Block: {
+            QStringList sideList;
+            if (!item.westPorts.isEmpty()) {
+                sideList << "west: " + portList(item.westPorts);
+            }
+            if (!item.eastPorts.isEmpty()) {
+                sideList << "east: " + portList(item.eastPorts);
+            }
+            s << "  element.block(\n"
+              << "    x: " << number(item.x) << ", y: " << number(item.y)
+              << ", w: " << number(item.w) << ", h: " << number(item.h) << ",\n"
+              << "    id: \"" << typstString(item.id) << "\", name: \""
+              << typstString(item.name) << "\", fill: " << typstColor(item.fill) << ",\n"
+              << "    ports: (" << sideList.join(", ") << ")\n"
+              << "  )\n";
+            break;
+        }
+        case Kind::Anchor: {
+            /* Tiny invisible block whose east port is the anchor point */
+            const float size = 0.01f;
+            s << "  element.block(x: " << number(item.x - size)
+              << ", y: " << number(item.y - size / 2) << ", w: " << number(size)
+              << ", h: " << number(size) << ", id: \"" << typstString(item.id)
+              << "\", name: \"\", stroke: none, fill: none, ports: (east: ((id: \"out\"),)))\n";
+            break;
+        }
+        case Kind::Multiplexer:
+            s << "  element.multiplexer(\n"
+              << "    x: " << number(item.x) << ", y: " << number(item.y)
+              << ", w: " << number(item.w) << ", h: " << number(item.h) << ",\n"
+              << "    id: \"" << typstString(item.id) << "\", fill: " << typstColor(item.fill)
+              << ", entries: " << item.count << "\n"
+              << "  )\n";
+            break;
+        case Kind::Stub:
+            s << "  wire.stub(\"" << typstString(item.from) << "\", \"" << item.to
+              << "\", name: \"" << typstString(item.name) << "\")\n";
+            break;
+        case Kind::Wire:
+            s << "  wire.wire(\"" << typstString(item.id) << "\", (\n"
+              << "    \"" << typstString(item.from) << "\", \"" << typstString(item.to)
+              << "\"\n"
+              << "  ))\n";
+            break;
+        case Kind::Line:
+            s << "  draw.line(\"" << typstString(item.from) << "\", (" << number(item.x) << ", "
+              << number(item.y) << ")";
+            if (item.arrow) {
+                s << ", mark: (end: \">\", fill: black)";
+            }
+            s << ")\n";
+            break;
+        case Kind::Polygon: {
+            QStringList pointList;
+            for (const Point &point : item.points) {
+                pointList << QString("(%1, %2)").arg(number(point.x), number(point.y));
+            }
+            s << "  draw.line(" << pointList.join(", ")
+              << ", close: true, fill: " << typstColor(item.fill) << ", stroke: none)\n";
+            break;
+        }
+        case Kind::Circle:
+            s << "  draw.circle((" << number(item.x) << ", " << number(item.y)
+              << "), radius: " << number(item.w) << ", stroke: black, fill: "
+              << typstColor(item.fill) << ")\n";
+            break;
+        case Kind::Text:
+            s << "  draw.content((" << number(item.x) << ", " << number(item.y) << "), ";
+            if (item.align == Align::West) {
+                s << "anchor: \"west\", ";
+            } else if (item.align == Align::East) {
+                s << "anchor: \"east\", ";
+            }
+            if (item.size > 0.0f) {
+                s << "text(size: " << QString::number(item.size) << "pt)";
+            }
+            s << "[" << typstMarkup(item.name) << "])\n";
+            break;
+        case Kind::Table: {
+            /* The table sits between two circuit canvases */
+            QStringList columnList;
+            QStringList alignList;
+            for (int column = 0; column < item.count; ++column) {
+                columnList << QStringLiteral("auto");
+                alignList << (column % 2 == 0 ? QStringLiteral("left") : QStringLiteral("center"));
+            }
+            s << "})\n\n"
+              << "#v(0.3cm)\n"
+              << "#align(center)[\n"
+              << "  #text(weight: \"bold\", size: 10pt)[" << typstMarkup(item.name) << "]\n"
+              << "]\n"
+              << "#v(0.2cm)\n"
+              << "#align(center)[\n"
+              << "#table(\n"
+              << "  columns: (" << columnList.join(", ") << "),\n"
+              << "  align: (" << alignList.join(", ") << "),\n"
+              << "  stroke: 0.5pt + gray,\n"
+              << "  inset: 5pt,\n"
+              << "  fill: (col, row) => if row == 0 { rgb(\"#e0e0e0\") },\n";
+            for (int index = 0; index < item.cells.size(); ++index) {
+                const Cell &cell = item.cells.at(index);
+                QString     text = typstMarkup(cell.text);
+                if (cell.bold && !text.isEmpty()) {
+                    text = "*" + text + "*";
+                }
+                if (!cell.color.isEmpty() && !text.isEmpty()) {
+                    text = QString("#text(fill: %1)[%2]").arg(cell.color, text);
+                }
+                const bool rowStart = index % item.count == 0;
+                const bool rowEnd   = index % item.count == item.count - 1
+                                    || index == item.cells.size() - 1;
+                s << (rowStart ? "  " : "") << "[" << text << "]," << (rowEnd ? "\n" : " ");
+            }
+            s << ")\n"
+              << "]\n\n"
+              << "#v(0.3cm)\n"
+              << "#circuit({\n";
+            break;
+        }
+        }
+    }
+
+    s << "})\n";
+    return result;
+}
+
+bool QSocDiagram::anchorPoint(
+    const QHash<QString, const Item *> &elementMap, const QString &anchor, Point &point)
+{
+    /* Top of an element */
+    if (anchor.endsWith(QLatin1String(".north"))) {
+        const Item *element = elementMap.value(anchor.chopped(6));
+        if (!element) {
+            return false;
+        }
+        /* The slanted top of a multiplexer is lower at its center */
+        const float inset = element->kind == Kind::Multiplexer ? element->h * 0.1f : 0.0f;
+        point             = {element->x + element->w / 2, element->y + element->h - inset};
+        return true;
+    }
+
+    const qsizetype separator = anchor.lastIndexOf(QLatin1String("-port-"));
+    if (separator < 0) {
+        return false;
+    }
+    const Item *element = elementMap.value(anchor.left(separator));
+    if (!element) {
+        return false;
+    }
+    const QString portName = anchor.mid(separator + 6);
+
+    if (element->kind == Kind::Anchor) {
+        point = {element->x, element->y};
+        return portName == QLatin1String("out");
+    }
+
+    if (element->kind == Kind::Multiplexer) {
+        if (portName == QLatin1String("out")) {
+            point = {element->x + element->w, element->y + element->h / 2};
+            return true;
+        }
+        bool      valid = false;
+        const int index = portName.startsWith(QLatin1String("in")) ? portName.mid(2).toInt(&valid)
+                                                                   : -1;
+        if (!valid || index < 0 || index >= element->count) {
+            return false;
+        }
+        const float ratio = 1.0f - (float(index) + 0.5f) / float(element->count);
+        point             = {element->x, element->y + element->h * ratio};
+        return true;
+    }
+
+    /* Block ports spread from top to bottom unless placed explicitly */
+    for (const bool west : {true, false}) {
+        const QList<Port> &portList = west ? element->westPorts : element->eastPorts;
+        for (int index = 0; index < portList.size(); ++index) {
+            if (portList.at(index).id != portName) {
+                continue;
+            }
+            const float ratio = portList.at(index).pos >= 0.0f
+                                    ? portList.at(index).pos
+                                    : 1.0f - (float(index) + 0.5f) / float(portList.size());
+            point = {west ? element->x : element->x + element->w, element->y + element->h * ratio};
+            return true;
+        }
+    }
+    return false;
+}
+
+QString QSocDiagram::toSvg() const
+{
+    QHash<QString, const Item *> elementMap;
+    for (const Item &item : itemList) {
+        if (item.kind == Kind::Block || item.kind == Kind::Anchor
+            || item.kind == Kind::Multiplexer) {
+            elementMap.insert(item.id, &item);
+        }
+    }
+    auto resolve = [&elementMap](const QString &anchor, Point &point) {
+        return anchorPoint(elementMap, anchor, point);
+    };
+
+    /* Split into canvases at the tables and measure every section */
+    struct Section
+    {
+        const Item  *table = nullptr;
+        QList<int>   itemIndexList;
+        Bounds       bounds;
+        QList<float> columnWidthList;
+        float        width  = 0.0f;
+        float        height = 0.0f;
+    };
+    QList<Section> sectionList{Section()};
+    for (int index = 0; index < itemList.size(); ++index) {
+        const Item &item = itemList.at(index);
+        if (item.kind == Kind::Table) {
+            Section tableSection;
+            tableSection.table = &item;
+            sectionList << tableSection << Section();
+            continue;
+        }
+
+        Bounds &bounds = sectionList.last().bounds;
+        sectionList.last().itemIndexList << index;
+        Point point;
+        switch (item.kind) {
+        case Kind::Block:
+        case Kind::Multiplexer:
+            bounds.add(item.x, item.y);
+            bounds.add(item.x + item.w, item.y + item.h);
+            break;
+        case Kind::Anchor:
+            bounds.add(item.x, item.y);
+            break;
+        case Kind::Stub:
+            if (resolve(item.from, point)) {
+                Point       nameAt;
+                const Align align = stubName(point, item.to, nameAt);
+                bounds.add(point);
+                bounds.addText(nameAt, item.name, defaultPt, align);
+            }
+            break;
+        case Kind::Wire:
+            for (const QString &anchor : {item.from, item.to}) {
+                if (resolve(anchor, point)) {
+                    bounds.add(point);
+                }
+            }
+            break;
+        case Kind::Line:
+            if (resolve(item.from, point)) {
+                bounds.add(point);
+            }
+            bounds.add(item.x, item.y);
+            break;
+        case Kind::Polygon:
+            for (const Point &corner : item.points) {
+                bounds.add(corner);
+            }
+            break;
+        case Kind::Circle:
+            bounds.add(item.x - item.w, item.y - item.w);
+            bounds.add(item.x + item.w, item.y + item.w);
+            break;
+        case Kind::Text:
+            bounds.addText(
+                {item.x, item.y}, item.name, item.size > 0.0f ? item.size : defaultPt, item.align);
+            break;
+        case Kind::Comment:
+        case Kind::Table:
+            break;
+        }
+    }
+
+    const float rowHeight = textHeight(defaultPt) + 2 * tableInset;
+    for (Section &section : sectionList) {
+        if (section.table) {
+            const int columns = section.table->count;
+            for (int column = 0; column < columns; ++column) {
+                const QList<Cell> &cellList = section.table->cells;
+                float              width    = 0.0f;
+                for (int index = column; index < cellList.size(); index += columns) {
+                    width = std::max(width, textWidth(cellList.at(index).text, defaultPt));
+                }
+                section.columnWidthList << width + 2 * tableInset;
+            }
+            const int   rows       = (section.table->cells.size() + columns - 1) / columns;
+            const float tableWidth = std::accumulate(
+                section.columnWidthList.begin(), section.columnWidthList.end(), 0.0f);
+            section.width  = std::max(tableWidth, textWidth(section.table->name, defaultPt));
+            section.height = tableGap + textHeight(defaultPt) + tableNameGap + rows * rowHeight
+                             + tableGap;
+        } else if (section.bounds.valid) {
+            section.width  = section.bounds.maxX - section.bounds.minX;
+            section.height = section.bounds.maxY - section.bounds.minY;
+        }
+    }
+
+    /* Page size, the header and the sections are centered */
+    const float   titlePt = defaultPt * 1.4f;
+    const float   notePt  = 8.0f;
+    const QString note    = QStringLiteral("Generated by QSoC v" QSOC_VERSION);
+    float         width   = std::max(textWidth(title, titlePt), textWidth(note, notePt));
+    float         height  = textHeight(titlePt) + textHeight(notePt) + headerGap;
+    for (const Section &section : sectionList) {
+        width = std::max(width, section.width);
+        height += section.height;
+    }
+    width += 2 * pageMargin;
+    height += 2 * pageMargin;
+
+    QString     result;
+    QTextStream s(&result);
+    s.setRealNumberPrecision(2);
+    s.setRealNumberNotation(QTextStream::FixedNotation);
+
+    const float pageWidth = width * pxPerCm;
+    s << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << pageWidth << "\" height=\""
+      << height * pxPerCm << "\" viewBox=\"0 0 " << pageWidth << " " << height * pxPerCm
+      << "\" font-family=\"Sarasa Mono SC, monospace\">\n"
+      << "<defs><marker id=\"arrow\" viewBox=\"0 0 10 10\" refX=\"10\" refY=\"5\" "
+      << "markerWidth=\"6\" markerHeight=\"6\" orient=\"auto-start-reverse\">"
+      << "<path d=\"M 0 0 L 10 5 L 0 10 z\" fill=\"black\"/></marker></defs>\n"
+      << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+
+    /* Text line centered vertically at a pixel position */
+    auto textLine = [&s](float x, float y, const QString &text, float sizePt, Align align,
+                         const QString &attributes = QString()) {
+        const char *anchor = align == Align::West   ? "start"
+                             : align == Align::East ? "end"
+                                                    : "middle";
+        s << "<text x=\"" << x << "\" y=\"" << y << "\" font-size=\"" << sizePt * 4.0f / 3.0f
+          << "\" text-anchor=\"" << anchor << "\" dominant-baseline=\"central\"" << attributes
+          << ">" << svgText(text) << "</text>\n";
+    };
+
+    float cursorY = pageMargin;
+    textLine(
+        pageWidth / 2,
+        (cursorY + textHeight(titlePt) / 2) * pxPerCm,
+        title,
+        titlePt,
+        Align::Center,
+        QStringLiteral(" font-weight=\"bold\""));
+    cursorY += textHeight(titlePt);
+    textLine(
+        pageWidth / 2,
+        (cursorY + textHeight(notePt) / 2) * pxPerCm,
+        note,
+        notePt,
+        Align::Center,
+        QStringLiteral(" fill=\"#aaaaaa\""));
+    cursorY += textHeight(notePt) + headerGap;
+
+    for (const Section &section : sectionList) {
+        const float left = (width - section.width) / 2;
+
+        if (section.table) {
+            const Item &table   = *section.table;
+            const int   columns = table.count;
+            float       y       = cursorY + tableGap;
+            textLine(
+                (left + section.width / 2) * pxPerCm,
+                (y + textHeight(defaultPt) / 2) * pxPerCm,
+                table.name,
+                defaultPt,
+                Align::Center,
+                QStringLiteral(" font-weight=\"bold\""));
+            y += textHeight(defaultPt) + tableNameGap;
+
+            const float tableWidth = std::accumulate(
+                section.columnWidthList.begin(), section.columnWidthList.end(), 0.0f);
+            const float tableLeft = left + (section.width - tableWidth) / 2;
+            for (int index = 0; index < table.cells.size(); ++index) {
+                const int column = index % columns;
+                const int row    = index / columns;
+                float     cellX  = tableLeft;
+                for (int previous = 0; previous < column; ++previous) {
+                    cellX += section.columnWidthList.at(previous);
+                }
+                const float cellY     = y + row * rowHeight;
+                const float cellWidth = section.columnWidthList.at(column);
+                s << "<rect x=\"" << cellX * pxPerCm << "\" y=\"" << cellY * pxPerCm
+                  << "\" width=\"" << cellWidth * pxPerCm << "\" height=\"" << rowHeight * pxPerCm
+                  << "\" fill=\"" << (row == 0 ? "#e0e0e0" : "none")
+                  << "\" stroke=\"#aaaaaa\" stroke-width=\"0.67\"/>\n";
+
+                const Cell &cell = table.cells.at(index);
+                if (cell.text.isEmpty()) {
+                    continue;
+                }
+                QString attributes = QString(" fill=\"%1\"").arg(svgColor(cell.color, true));
+                if (cell.bold) {
+                    attributes += QStringLiteral(" font-weight=\"bold\"");
+                }
+                const bool leftAligned = column % 2 == 0;
+                textLine(
+                    (leftAligned ? cellX + tableInset : cellX + cellWidth / 2) * pxPerCm,
+                    (cellY + rowHeight / 2) * pxPerCm,
+                    cell.text,
+                    defaultPt,
+                    leftAligned ? Align::West : Align::Center,
+                    attributes);
+            }
+            cursorY += section.height;
+            continue;
+        }
+        if (!section.bounds.valid) {
+            continue;
+        }
+
+        /* Canvas coordinates grow upward, SVG coordinates downward */
+        const Bounds &bounds = section.bounds;
+        const float   top    = cursorY;
+        auto          px     = [&](float x) { return (left + x - bounds.minX) * pxPerCm; };
+        auto          py     = [&](float y) { return (top + bounds.maxY - y) * pxPerCm; };
+        auto lineTo = [&](const Point &from, const Point &to, bool arrow) {
+            s << "<line x1=\"" << px(from.x) << "\" y1=\"" << py(from.y) << "\" x2=\""
+              << px(to.x) << "\" y2=\"" << py(to.y) << "\" stroke=\"black\""
+              << (arrow ? " marker-end=\"url(#arrow)\"" : "") << "/>\n";
+        };
+
+        for (const int index : section.itemIndexList) {
+            const Item &item = itemList.at(index);
+            Point       from;
+            Point       to;
+            switch (item.kind) {
+            case Kind::Block:
+                s << "<rect x=\"" << px(item.x) << "\" y=\"" << py(item.y + item.h)
+                  << "\" width=\"" << item.w * pxPerCm << "\" height=\"" << item.h * pxPerCm
+                  << "\" fill=\"" << svgColor(item.fill) << "\" stroke=\"black\"/>\n";
+                textLine(
+                    px(item.x + item.w / 2), py(item.y + item.h / 2), item.name, defaultPt,
+                    Align::Center);
+                break;
+            case Kind::Multiplexer: {
+                /* Trapezoid, the output side is 60% of the input side */
+                const float slant = item.h * 0.2f;
+                s << "<polygon points=\"" << px(item.x) << "," << py(item.y) << " "
+                  << px(item.x) << "," << py(item.y + item.h) << " " << px(item.x + item.w)
+                  << "," << py(item.y + item.h - slant) << " " << px(item.x + item.w) << ","
+                  << py(item.y + slant) << "\" fill=\"" << svgColor(item.fill)
+                  << "\" stroke=\"black\"/>\n";
+                break;
+            }
+            case Kind::Stub:
+                if (resolve(item.from, from)) {
+                    const Point direction = sideVector(item.to);
+                    to = {from.x + direction.x * stubLength, from.y + direction.y * stubLength};
+                    lineTo(from, to, false);
+                    Point       nameAt;
+                    const Align align = stubName(from, item.to, nameAt);
+                    textLine(px(nameAt.x), py(nameAt.y), item.name, defaultPt, align);
+                }
+                break;
+            case Kind::Wire:
+                if (resolve(item.from, from) && resolve(item.to, to)) {
+                    lineTo(from, to, false);
+                }
+                break;
+            case Kind::Line:
+                if (resolve(item.from, from)) {
+                    lineTo(from, {item.x, item.y}, item.arrow);
+                }
+                break;
+            case Kind::Polygon:
+                s << "<polygon points=\"";
+                for (const Point &corner : item.points) {
+                    s << px(corner.x) << "," << py(corner.y) << " ";
+                }
+                s << "\" fill=\"" << svgColor(item.fill) << "\"/>\n";
+                break;
+            case Kind::Circle:
+                s << "<circle cx=\"" << px(item.x) << "\" cy=\"" << py(item.y) << "\" r=\""
+                  << item.w * pxPerCm << "\" fill=\"" << svgColor(item.fill)
+                  << "\" stroke=\"black\"/>\n";
+                break;
+            case Kind::Text:
+                textLine(
+                    px(item.x), py(item.y), item.name, item.size > 0.0f ? item.size : defaultPt,
+                    item.align);
+                break;
+            case Kind::Comment:
+            case Kind::Anchor:
+            case Kind::Table:
+                break;
+            }
+        }
+        cursorY += section.height;
+    }
+
+    s << "</svg>\n";
+    return result;
+}
+
+bool QSocDiagram::writeTypst(const QString &filePath) const
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    file.write(toTypst().toUtf8());
+    return file.commit();
+}
+
+bool QSocDiagram::writeSvg(const QString &filePath) const
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    file.write(toSvg().toUtf8());
+    return file.commit();
+}
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCDIAGRAM_H
+#define QSOCDIAGRAM_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocDiagram class.
+ * @details Drawing of a clock, reset or power tree, recorded once by the
+ *          layout code of a primitive and written in two backends: Typst
+ *          source for the circuiteria package, and SVG rendered in process
+ *          without any external tool.
+ *
+ *          Coordinates are in centimeters with y growing upward, as in
+ *          CeTZ. Blocks and multiplexers are placed by their bottom-left
+ *          corner. Connections refer to anchors by their circuiteria names,
+ *          `<id>-port-<port>` for a port and `<id>.north` for the top of an
+ *          element. Colors are the circuiteria palette names `orange`,
+ *          `yellow`, `green`, `pink`, `purple` and `blue`, or `gray`,
+ *          `black`, `white`, `red` and `none`.
+ *
+ *          A table ends the current canvas, the elements recorded after it
+ *          are drawn in a new canvas below the table.
+ */
+class QSocDiagram
+{
+public:
+    /**
+     * @brief A point in diagram coordinates.
+     */
+    struct Point
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    /**
+     * @brief Side of the text anchored at its position.
+     */
+    enum class Align {
+        Center, /**< The position is the center of the text */
+        West,   /**< The position is the left end of the text */
+        East,   /**< The position is the right end of the text */
+    };
+
+    /**
+     * @brief A port on the side of a block.
+     */
+    struct Port
+    {
+        QString id;          /**< Port name, the anchor is `<block>-port-<id>` */
+        float   pos = -1.0f; /**< Height ratio from the bottom, negative spreads evenly */
+    };
+
+    /**
+     * @brief A table cell.
+     */
+    struct Cell
+    {
+        QString text;  /**< Cell text */
+        QString color; /**< Text color, empty for black */
+        bool    bold = false;
+    };
+
+    /**
+     * @brief Constructor for QSocDiagram.
+     * @param title Title above the drawing, like "Clock tree".
+     */
+    explicit QSocDiagram(const QString &title);
+
+    /**
+     * @brief Add a comment, kept in the Typst source only.
+     * @param text Comment text.
+     */
+    void comment(const QString &text);
+
+    /**
+     * @brief Add a labeled block.
+     * @param x Left edge.
+     * @param y Bottom edge.
+     * @param w Width.
+     * @param h Height.
+     * @param id Element id, unique in the diagram.
+     * @param name Label in the block.
+     * @param fill Fill color.
+     * @param westPorts Ports on the left side, from top to bottom.
+     * @param eastPorts Ports on the right side, from top to bottom.
+     */
+    void block(
+        float              x,
+        float              y,
+        float              w,
+        float              h,
+        const QString     &id,
+        const QString     &name,
+        const QString     &fill,
+        const QList<Port> &westPorts = {{QStringLiteral("in")}},
+        const QList<Port> &eastPorts = {{QStringLiteral("out")}});
+
+    /**
+     * @brief Add an invisible point with an `out` port, for wires to start at.
+     * @param id Element id, unique in the diagram.
+     * @param at Position of the port.
+     */
+    void anchor(const QString &id, Point at);
+
+    /**
+     * @brief Add a multiplexer with inputs `in0` to `in<entries-1>` and output `out`.
+     * @param x Left edge.
+     * @param y Bottom edge.
+     * @param w Width.
+     * @param h Height.
+     * @param id Element id, unique in the diagram.
+     * @param fill Fill color.
+     * @param entries Number of inputs.
+     */
+    void multiplexer(
+        float x, float y, float w, float h, const QString &id, const QString &fill, int entries);
+
+    /**
+     * @brief Add a short named wire leaving an anchor.
+     * @param anchor Anchor the stub starts at.
+     * @param side Direction of the stub, "west", "east", "north" or "south".
+     * @param name Signal name at the free end.
+     */
+    void stub(const QString &anchor, const QString &side, const QString &name);
+
+    /**
+     * @brief Add a straight wire between two anchors.
+     * @param id Wire id.
+     * @param from Start anchor.
+     * @param to End anchor.
+     */
+    void wire(const QString &id, const QString &from, const QString &to);
+
+    /**
+     * @brief Add a line from an anchor to a point.
+     * @param from Start anchor.
+     * @param to End point.
+     * @param arrow Draw an arrow head at the end.
+     */
+    void line(const QString &from, Point to, bool arrow = false);
+
+    /**
+     * @brief Add a filled polygon without outline.
+     * @param points Corners of the polygon.
+     * @param fill Fill color.
+     */
+    void polygon(const QList<Point> &points, const QString &fill);
+
+    /**
+     * @brief Add a circle with a black outline.
+     * @param center Center point.
+     * @param radius Radius.
+     * @param fill Fill color.
+     */
+    void circle(Point center, float radius, const QString &fill);
+
+    /**
+     * @brief Add a text label.
+     * @param at Position of the text.
+     * @param text Plain text, escaped by each backend.
+     * @param size Font size in points, 0 for the default 10pt.
+     * @param align Side of the text at the position.
+     */
+    void text(Point at, const QString &text, float size = 0.0f, Align align = Align::Center);
+
+    /**
+     * @brief Add a titled table between two canvases.
+     * @param title Title above the table.
+     * @param columns Number of columns, the first row is the header.
+     * @param cells Cells in row order.
+     */
+    void table(const QString &title, int columns, const QList<Cell> &cells);
+
+    /**
+     * @brief Write the diagram as Typst source for circuiteria.
+     * @return QString Typst document.
+     */
+    QString toTypst() const;
+
+    /**
+     * @brief Render the diagram as a standalone SVG image.
+     * @return QString SVG document.
+     */
+    QString toSvg() const;
+
+    /**
+     * @brief Write the Typst source of the diagram to a file.
+     * @param filePath Output file path.
+     * @return bool The file was written.
+     */
+    bool writeTypst(const QString &filePath) const;
+
+    /**
+     * @brief Render the diagram and write the SVG image to a file.
+     * @param filePath Output file path.
+     * @return bool The file was written.
+     */
+    bool writeSvg(const QString &filePath) const;
+
+private:
+    /**
+     * @brief Kind of a recorded item.
+     */
+    enum class Kind {
+        Comment,
+        Block,
+        Anchor,
+        Multiplexer,
+        Stub,
+        Wire,
+        Line,
+        Polygon,
+        Circle,
+        Text,
+        Table,
+    };
+
+    /**
+     * @brief A recorded drawing item, only the fields of its kind are set.
+     */
+    struct Item
+    {
+        Kind         kind  = Kind::Comment;
+        float        x     = 0.0f;
+        float        y     = 0.0f;
+        float        w     = 0.0f;
+        float        h     = 0.0f;
+        float        size  = 0.0f;
+        int          count = 0;
+        bool         arrow = false;
+        Align        align = Align::Center;
+        QString      id;
+        QString      name;
+        QString      fill;
+        QString      from;
+        QString      to;
+        QList<Port>  westPorts;
+        QList<Port>  eastPorts;
+        QList<Point> points;
+        QList<Cell>  cells;
+    };
+
+    /**
+     * @brief Position of an anchor.
+     * @param elementMap Blocks, anchors and multiplexers by id.
+     * @param anchor Anchor name.
+     * @param point Set to the position.
+     * @return bool The anchor names a recorded element and port.
+     */
+    static bool anchorPoint(
+        const QHash<QString, const Item *> &elementMap, const QString &anchor, Point &point);
+
+    /* Title above the drawing */
+    QString title;
+    /* Items in drawing order */
+    QList<Item> itemList;
+};
+
+#endif // QSOCDIAGRAM_H
@@ -0,0 +1,395 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocgeneratemanager.h"
+
+#include <QDebug>
+#include <QRegularExpression>
+#include <QTextStream>
+
+namespace {
+
+/* Replace the index placeholder of an instance array value */
+QString substituteIndex(const QString &text, const QString &index)
+{
+    QString result = text;
+    return result.replace("{i}", index);
+}
+
+/* Scalar field of a YAML map, empty when missing */
+QString scalarField(const YAML::Node &node, const char *key)
+{
+    if (!node || !node.IsMap() || !node[key] || !node[key].IsScalar()) {
+        return {};
+    }
+    return QString::fromStdString(node[key].as<std::string>());
+}
+
+/* Highest bit addressed by a select such as `3`, `7:4` or `8*i +: 8` */
+std::optional<qint64> selectHighBit(
+    const QString &select, const QSocWidthEvaluator::ParameterMap &parameters)
+{
+    for (const QString &op : {QStringLiteral("+:"), QStringLiteral("-:")}) {
+        const qsizetype split = select.indexOf(op);
+        if (split < 0) {
+            continue;
+        }
+        const std::optional<qint64> base = QSocWidthEvaluator::evaluate(select.left(split),
+                                                                         parameters);
+        if (!base || op == "-:") {
+            return base;
+        }
+        const std::optional<qint64> width = QSocWidthEvaluator::evaluate(select.mid(split + 2),
+                                                                          parameters);
+        if (!width) {
+            return std::nullopt;
+        }
+        return *base + *width - 1;
+    }
+
+    /* A ternary select addresses a single bit */
+    const qsizetype split = select.contains('?') ? -1 : select.indexOf(':');
+    if (split < 0) {
+        return QSocWidthEvaluator::evaluate(select, parameters);
+    }
+    const std::optional<qint64> msb = QSocWidthEvaluator::evaluate(select.left(split), parameters);
+    const std::optional<qint64> lsb = QSocWidthEvaluator::evaluate(select.mid(split + 1),
+                                                                    parameters);
+    if (!msb || !lsb) {
+        return std::nullopt;
+    }
+    return qMax(*msb, *lsb);
+}
+
+/* Net name and optional bit select of an instance array link */
+const QRegularExpression linkRegex(R"(^\s*([A-Za-z_]\w*)\s*(?:\[(.*)\])?\s*$)");
+
+} /* namespace */
+
+bool QSocGenerateManager::processInstanceArrays()
+{
+    instanceArrayList.clear();
+
+    if (!netlistData["instance"] || !netlistData["instance"].IsMap()) {
+        return true;
+    }
+
+    static const QRegularExpression arrayRegex(
+        R"(^\s*([A-Za-z_]\w*)\s*\[\s*(\d+)\s*:\s*(\d+)\s*\]\s*$)");
+
+    QStringList        nameList;
+    QList<std::string> keyList;
+    for (const auto &instance : netlistData["instance"]) {
+        if (!instance.first.IsScalar()) {
+            continue;
+        }
+        const QString                 key   = QString::fromStdString(instance.first.Scalar());
+        const QRegularExpressionMatch match = arrayRegex.match(key);
+        if (!match.hasMatch()) {
+            continue;
+        }
+
+        InstanceArray array;
+        array.name         = match.captured(1);
+        array.from         = match.captured(2).toLongLong();
+        array.to           = match.captured(3).toLongLong();
+        array.instanceData = instance.second;
+
+        if (nameList.contains(array.name) || netlistData["instance"][array.name.toStdString()]) {
+            qCritical() << "Error: Instance array" << key << "reuses the instance name"
+                        << array.name;
+            return false;
+        }
+        const QString moduleName = scalarField(array.instanceData, "module");
+        if (moduleName.isEmpty()) {
+            qCritical() << "Error: Invalid module name for instance array" << key;
+            return false;
+        }
+        if (array.instanceData["bus"]) {
+            qCritical() << "Error: Bus connections are not supported on instance array" << key
+                        << ", connect the bus signals with link";
+            return false;
+        }
+
+        /* Arrays are not expanded, so each port must map to one expression */
+        const YAML::Node moduleData = getModuleData(moduleName);
+        if (!moduleData.IsMap()) {
+            qWarning() << "Warning: Failed to get module definition for" << moduleName;
+        }
+        const YAML::Node &portSection = array.instanceData["port"];
+        if (portSection && portSection.IsMap()) {
+            for (const auto &port : portSection) {
+                const QString portName = QString::fromStdString(port.first.Scalar());
+                if (port.second.IsMap() && port.second["uplink"]) {
+                    qCritical() << "Error: Uplink is not supported on instance array" << key
+                                << "port" << portName << ", declare the top-level port and link it";
+                    return false;
+                }
+                if (scalarField(port.second, "link").section('[', 0, 0).contains("{i}")) {
+                    qCritical() << "Error: Instance array" << key << "port" << portName
+                                << "links a different net per index, select bits of one net";
+                    return false;
+                }
+                if (moduleData.IsMap() && moduleData["port"] && moduleData["port"].IsMap()
+                    && !moduleData["port"][port.first.Scalar()]) {
+                    qCritical() << "Error: Port" << portName << "not found in module" << moduleName
+                                << "of instance array" << key;
+                    return false;
+                }
+            }
+        }
+
+        qInfo() << "Instance array:" << array.name << "of" << qAbs(array.to - array.from) + 1
+                << "instances of module" << moduleName;
+        nameList.append(array.name);
+        keyList.append(instance.first.Scalar());
+        instanceArrayList.append(array);
+    }
+
+    for (const std::string &key : keyList) {
+        netlistData["instance"].remove(key);
+    }
+    return true;
+}
+
+void QSocGenerateManager::generateInstanceArrayWires(
+    QTextStream &out, const QMap<QString, int> &netDeclaredWidthMap)
+{
+    if (instanceArrayList.isEmpty()) {
+        return;
+    }
+
+    const YAML::Node                      &netlist           = netlistData;
+    const QSocWidthEvaluator::ParameterMap netlistParameters = getNetlistParameters();
+
+    /* Widest use of each net, -1 when it cannot be evaluated */
+    QStringList        netNameList;
+    QMap<QString, int> netWidthMap;
+    for (const InstanceArray &array : instanceArrayList) {
+        const YAML::Node &portSection = array.instanceData["port"];
+        if (!portSection || !portSection.IsMap()) {
+            continue;
+        }
+        const YAML::Node moduleData = getModuleData(scalarField(array.instanceData, "module"));
+
+        /* Parameters at both ends of the array */
+        QList<QPair<qint64, QSocWidthEvaluator::ParameterMap>> endList;
+        for (const qint64 index : {array.from, array.to}) {
+            YAML::Node overrides(YAML::NodeType::Map);
+            if (array.instanceData["parameter"] && array.instanceData["parameter"].IsMap()) {
+                for (const auto &parameter : array.instanceData["parameter"]) {
+                    if (parameter.first.IsScalar() && parameter.second.IsScalar()) {
+                        overrides[parameter.first.Scalar()]
+                            = substituteIndex(
+                                  QString::fromStdString(parameter.second.Scalar()),
+                                  QString::number(index))
+                                  .toStdString();
+                    }
+                }
+            }
+            endList.append(
+                {index,
+                 QSocWidthEvaluator::resolveParameters(
+                     moduleData["parameter"], overrides, netlistParameters)});
+        }
+
+        for (const auto &port : portSection) {
+            const QString link = scalarField(port.second, "link");
+            if (link.isEmpty()) {
+                continue;
+            }
+
+            QString netName;
+            int     width = -1;
+            for (const auto &end : endList) {
+                const QRegularExpressionMatch match = linkRegex.match(
+                    substituteIndex(link, QString::number(end.first)));
+                if (!match.hasMatch()) {
+                    break;
+                }
+                netName = match.captured(1);
+
+                std::optional<qint64> endWidth;
+                if (match.capturedLength(2) > 0) {
+                    const std::optional<qint64> highBit
+                        = selectHighBit(match.captured(2), netlistParameters);
+                    if (highBit && *highBit >= 0) {
+                        endWidth = *highBit + 1;
+                    }
+                } else if (moduleData.IsMap() && moduleData["port"] && moduleData["port"].IsMap()) {
+                    const QString type
+                        = scalarField(moduleData["port"][port.first.Scalar()], "type");
+                    endWidth = QSocWidthEvaluator::typeWidth(type, end.second);
+                }
+                if (endWidth) {
+                    width = qMax(width, static_cast<int>(*endWidth));
+                }
+            }
+            if (netName.isEmpty()) {
+                qWarning() << "Warning: Invalid link" << link << "in instance array" << array.name;
+                continue;
+            }
+
+            if (!netWidthMap.contains(netName)) {
+                netNameList.append(netName);
+                netWidthMap.insert(netName, width);
+            } else {
+                netWidthMap[netName] = qMax(netWidthMap[netName], width);
+            }
+        }
+    }
+
+    bool written = false;
+    for (const QString &netName : netNameList) {
+        const int         width = netWidthMap.value(netName);
+        const std::string key   = netName.toStdString();
+
+        /* Nets of the netlist and top-level ports are declared already */
+        const bool isNet  = netlist["net"] && netlist["net"].IsMap() && netlist["net"][key];
+        const bool isPort = netlist["port"] && netlist["port"].IsMap() && netlist["port"][key];
+        if (isNet || isPort) {
+            int declaredWidth = netDeclaredWidthMap.value(netName, -1);
+            if (declaredWidth < 0 && isPort) {
+                declaredWidth = QSocWidthEvaluator::typeWidth(
+                                    scalarField(netlist["port"][key], "type"), netlistParameters)
+                                    .value_or(-1);
+            }
+            if (width > 0 && declaredWidth > 0 && width > declaredWidth) {
+                qWarning() << "Warning: Instance arrays select" << width << "bits of" << netName
+                           << ", which is declared with" << declaredWidth << "bits";
+                out << "    /* FIXME: " << (isNet ? "Net " : "Port ") << netName << " is "
+                    << declaredWidth << " bits wide, instance arrays select " << width
+                    << " bits */\n";
+                written = true;
+            }
+            continue;
+        }
+
+        if (width < 0) {
+            qWarning() << "Warning: Cannot determine the width of instance array net" << netName;
+        }
+        if (width > 1) {
+            out << "    wire [" << width - 1 << ":0] " << netName << ";\n";
+        } else {
+            out << "    wire " << netName << ";\n";
+        }
+        written = true;
+    }
+    if (written) {
+        out << "\n";
+    }
+}
+
+void QSocGenerateManager::generateInstanceArrays(QTextStream &out)
+{
+    for (const InstanceArray &array : instanceArrayList) {
+        const YAML::Node &instanceData = array.instanceData;
+        const QString     moduleName   = scalarField(instanceData, "module");
+        const QString     genvarName   = array.name + "_i";
+
+        QStringList ifdefList;
+        QStringList ifndefList;
+        if (!parseMacroCondition(instanceData, array.name, ifdefList, ifndefList)) {
+            continue;
+        }
+        if (!ifdefList.isEmpty() || !ifndefList.isEmpty()) {
+            writeIfdefBegin(out, ifdefList, ifndefList);
+        }
+
+        out << "    genvar " << genvarName << ";\n";
+        out << "    generate\n";
+        out << "        for (" << genvarName << " = " << qMin(array.from, array.to) << "; "
+            << genvarName << " <= " << qMax(array.from, array.to) << "; " << genvarName << " = "
+            << genvarName << " + 1) begin : gen_" << array.name << "\n";
+        out << "            " << moduleName << " ";
+
+        if (instanceData["parameter"] && instanceData["parameter"].IsMap()
+            && instanceData["parameter"].size() > 0) {
+            QStringList paramList;
+            for (const auto &parameter : instanceData["parameter"]) {
+                if (!parameter.first.IsScalar() || !parameter.second.IsScalar()) {
+                    qWarning() << "Warning: Invalid parameter in instance array" << array.name;
+                    continue;
+                }
+                paramList.append(
+                    QString("                .%1(%2)")
+                        .arg(QString::fromStdString(parameter.first.Scalar()))
+                        .arg(substituteIndex(
+                            QString::fromStdString(parameter.second.Scalar()), genvarName)));
+            }
+            out << "#(\n" << paramList.join(",\n") << "\n            ) ";
+        }
+        out << array.name << " (\n";
+
+        /* Module port order, or the instance order for unknown modules */
+        QStringList      portNameList;
+        const YAML::Node moduleData = getModuleData(moduleName);
+        if (moduleData.IsMap() && moduleData["port"] && moduleData["port"].IsMap()) {
+            for (const auto &port : moduleData["port"]) {
+                portNameList.append(QString::fromStdString(port.first.Scalar()));
+            }
+        } else if (instanceData["port"] && instanceData["port"].IsMap()) {
+            for (const auto &port : instanceData["port"]) {
+                portNameList.append(QString::fromStdString(port.first.Scalar()));
+            }
+        }
+
+        QStringList portConnections;
+        for (const QString &portName : portNameList) {
+            const YAML::Node &portSection = instanceData["port"];
+            const YAML::Node  portNode    = (portSection && portSection.IsMap())
+                                                ? YAML::Node(portSection[portName.toStdString()])
+                                                : YAML::Node();
+            const QString link   = portNode ? scalarField(portNode, "link") : QString();
+            const QString tie    = portNode ? scalarField(portNode, "tie") : QString();
+            const bool    invert = portNode && portNode.IsMap() && portNode["invert"]
+                                && portNode["invert"].IsScalar() && portNode["invert"].as<bool>();
+
+            QString connection;
+            if (!link.isEmpty()) {
+                connection = substituteIndex(link.trimmed(), genvarName);
+                /* Bus signals are members of their interface instance */
+                const QRegularExpressionMatch match = linkRegex.match(connection);
+                if (match.hasMatch()) {
+                    connection.replace(
+                        match.capturedStart(1),
+                        match.capturedLength(1),
+                        netReference(match.captured(1)));
+                }
+                if (invert) {
+                    connection = "~" + connection;
+                }
+            } else if (!tie.isEmpty()) {
+                connection = substituteIndex(tie, genvarName);
+                if (invert) {
+                    connection = QString("~(%1)").arg(connection);
+                }
+            } else {
+                QString direction = "signal";
+                if (moduleData.IsMap() && moduleData["port"] && moduleData["port"].IsMap()) {
+                    const QString moduleDirection
+                        = scalarField(moduleData["port"][portName.toStdString()], "direction");
+                    if (!moduleDirection.isEmpty()) {
+                        direction = moduleDirection;
+                    }
+                }
+                connection = QString("/* FIXME: %1 %2 missing */").arg(direction).arg(portName);
+            }
+            portConnections.append(
+                QString("                .%1(%2)").arg(portName).arg(connection));
+        }
+
+        if (portConnections.isEmpty()) {
+            out << "                /* No port connections found for this instance */\n";
+        } else {
+            out << portConnections.join(",\n") << "\n";
+        }
+        out << "            );\n";
+        out << "        end\n";
+        out << "    endgenerate\n";
+
+        if (!ifdefList.isEmpty() || !ifndefList.isEmpty()) {
+            writeIfdefEnd(out, ifdefList, ifndefList);
+        }
+    }
+}
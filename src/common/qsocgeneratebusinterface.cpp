@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocyamlutils.h"
+
+#include <QDebug>
+#include <QRegularExpression>
+#include <QTextStream>
+
+namespace {
+
+/* SystemVerilog direction keyword of a bus definition direction */
+QString modportDirection(const QString &direction)
+{
+    const QString lower = direction.trimmed().toLower();
+    if (lower == "out" || lower == "output") {
+        return "output";
+    }
+    if (lower == "in" || lower == "input") {
+        return "input";
+    }
+    if (lower == "inout") {
+        return "inout";
+    }
+    return {};
+}
+
+} /* namespace */
+
+QString QSocGenerateManager::netReference(const QString &netName) const
+{
+    const auto signal = busInterfaceNetMap.constFind(netName);
+    if (signal == busInterfaceNetMap.constEnd()) {
+        return netName;
+    }
+    return signal->busName + "." + signal->signalName;
+}
+
+bool QSocGenerateManager::checkBusInterfaceReferences() const
+{
+    if (busInterfaceNetMap.isEmpty()) {
+        return true;
+    }
+
+    static const QRegularExpression identifierRegex(R"([A-Za-z_][\w$]*)");
+    for (const char *section : {"comb", "seq", "fsm", "reset", "clock", "power"}) {
+        const YAML::Node &node = netlistData[section];
+        if (!node) {
+            continue;
+        }
+        const QString text      = QSocYamlUtils::yamlNodeToString(node);
+        auto          matchIter = identifierRegex.globalMatch(text);
+        while (matchIter.hasNext()) {
+            const QString name = matchIter.next().captured(0);
+            if (busInterfaceNetMap.contains(name)) {
+                qCritical() << "Error: Bus signal net" << name << "is used by the" << section
+                            << "section, which cannot refer to a signal of interface"
+                            << busInterfaceNetMap.value(name).busName
+                            << ", generate without --sv-interface";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+QString QSocGenerateManager::generateBusInterfaces(
+    QTextStream &out, const QString &moduleName, const QMap<QString, QString> &signalWidthMap)
+{
+    if (signalWidthMap.isEmpty()) {
+        return {};
+    }
+
+    /* Declared signals of each bus link, by link name */
+    QMap<QString, QString>                busTypeMap;
+    QMap<QString, QMap<QString, QString>> linkSignalMap;
+    for (auto iter = signalWidthMap.constBegin(); iter != signalWidthMap.constEnd(); ++iter) {
+        const BusInterfaceSignal signal = busInterfaceNetMap.value(iter.key());
+        busTypeMap.insert(signal.busName, signal.busType);
+        linkSignalMap[signal.busName].insert(signal.signalName, iter.value());
+    }
+
+    out << "    /* Bus interfaces */\n";
+
+    QString                definitions;
+    QMap<QString, QString> interfaceNameMap; /* By bus type and signal widths */
+    QMap<QString, int>     interfaceCountMap;
+    for (auto link = busTypeMap.constBegin(); link != busTypeMap.constEnd(); ++link) {
+        const QString                busType  = link.value();
+        const QMap<QString, QString> widthMap = linkSignalMap.value(link.key());
+
+        /* Bus definition, for the signal order and the modports */
+        const YAML::Node busYaml    = busManager ? busManager->getBusYaml(busType) : YAML::Node();
+        const bool       hasBusPort = busYaml.IsMap() && busYaml["port"] && busYaml["port"].IsMap();
+
+        /* Signals in bus definition order, as far as the link uses them */
+        QStringList signalList;
+        if (hasBusPort) {
+            for (const auto &port : busYaml["port"]) {
+                const QString signalName = QString::fromStdString(port.first.Scalar());
+                if (widthMap.contains(signalName)) {
+                    signalList.append(signalName);
+                }
+            }
+        } else {
+            signalList = widthMap.keys();
+        }
+
+        QStringList signatureList{busType};
+        for (const QString &signalName : signalList) {
+            signatureList.append(signalName + widthMap.value(signalName));
+        }
+        const QString signature = signatureList.join(",");
+
+        /* Links with the same bus type and widths share a definition */
+        if (!interfaceNameMap.contains(signature)) {
+            const int     count = interfaceCountMap[busType]++;
+            const QString name  = QString("%1_%2_if%3")
+                                     .arg(moduleName, busType)
+                                     .arg(count > 0 ? QString("_%1").arg(count) : QString());
+            interfaceNameMap.insert(signature, name);
+
+            QString     definition;
+            QTextStream stream(&definition);
+            stream << "interface " << name << ";\n";
+            for (const QString &signalName : signalList) {
+                const QString width = widthMap.value(signalName);
+                stream << "    logic " << (width.isEmpty() ? QString() : width + " ")
+                       << signalName << ";\n";
+            }
+
+            /* One modport per bus mode, with the directions of that mode */
+            QStringList                modeList;
+            QMap<QString, QStringList> modportMap;
+            for (const QString &signalName : hasBusPort ? signalList : QStringList()) {
+                const YAML::Node &portNode = busYaml["port"][signalName.toStdString()];
+                if (!portNode.IsMap()) {
+                    continue;
+                }
+                for (const auto &mode : portNode) {
+                    const QString modeName = QString::fromStdString(mode.first.Scalar());
+                    if (!mode.second.IsMap() || !mode.second["direction"]
+                        || !mode.second["direction"].IsScalar()) {
+                        continue;
+                    }
+                    const QString direction = modportDirection(
+                        QString::fromStdString(mode.second["direction"].as<std::string>()));
+                    if (direction.isEmpty()) {
+                        continue;
+                    }
+                    if (!modeList.contains(modeName)) {
+                        modeList.append(modeName);
+                    }
+                    modportMap[modeName].append(direction + " " + signalName);
+                }
+            }
+            for (const QString &modeName : modeList) {
+                stream << "\n    modport " << modeName << " (\n        "
+                       << modportMap.value(modeName).join(",\n        ") << "\n    );\n";
+            }
+            stream << "endinterface\n";
+            stream.flush();
+
+            if (!definitions.isEmpty()) {
+                definitions += "\n";
+            }
+            definitions += definition;
+        }
+
+        out << "    " << interfaceNameMap.value(signature) << " " << link.key() << " ();\n";
+    }
+    out << "\n";
+
+    return definitions;
+}
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocgeneratemanager.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRecursiveMutex>
+
+namespace {
+
+/* Parallel generators may instantiate the same sub-netlist, write one at a time */
+QRecursiveMutex &subNetlistMutex()
+{
+    static QRecursiveMutex mutex;
+    return mutex;
+}
+
+/* SHA-256 of a file, empty when the file cannot be read */
+QByteArray fileHash(const QString &filePath, const QByteArray &salt = QByteArray())
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(salt);
+    hash.addData(file.readAll());
+    return hash.result();
+}
+
+/* Module definition of a sub-netlist, as seen by the instantiating netlist */
+YAML::Node subNetlistModuleYaml(const YAML::Node &netlist)
+{
+    YAML::Node moduleYaml(YAML::NodeType::Map);
+    if (netlist["port"] && netlist["port"].IsMap()) {
+        YAML::Node portMap(YAML::NodeType::Map);
+        for (const auto &port : netlist["port"]) {
+            if (!port.first.IsScalar() || !port.second.IsMap()) {
+                continue;
+            }
+            /* Only the interface, not how the port is wired inside */
+            YAML::Node portYaml(YAML::NodeType::Map);
+            for (const char *key : {"direction", "type"}) {
+                if (port.second[key] && port.second[key].IsScalar()) {
+                    portYaml[key] = port.second[key].Scalar();
+                }
+            }
+            portMap.force_insert(port.first.Scalar(), portYaml);
+        }
+        moduleYaml["port"] = portMap;
+    }
+    if (netlist["parameter"] && netlist["parameter"].IsMap()) {
+        moduleYaml["parameter"] = YAML::Clone(netlist["parameter"]);
+    }
+    return moduleYaml;
+}
+
+/* Text form of a parameter set, ordered by name so it is stable across runs */
+QString parameterSetText(const QSocWidthEvaluator::ParameterMap &parameterMap)
+{
+    QStringList itemList;
+    for (auto parameter = parameterMap.constBegin(); parameter != parameterMap.constEnd();
+         ++parameter) {
+        itemList.append(parameter.key() + '=' + QString::number(parameter.value()));
+    }
+    return itemList.join(',');
+}
+
+/* Make instance overrides the defaults of the sub-netlist, renaming it when they differ */
+bool specializeNetlist(
+    YAML::Node &netlist, const QSocWidthEvaluator::ParameterMap &overrideMap, QString &moduleName)
+{
+    const QSocWidthEvaluator::ParameterMap defaultMap = QSocWidthEvaluator::resolveParameters(
+        netlist["parameter"]);
+    QSocWidthEvaluator::ParameterMap changedMap;
+    for (auto parameter = overrideMap.constBegin(); parameter != overrideMap.constEnd();
+         ++parameter) {
+        const std::string name = parameter.key().toStdString();
+        if (!netlist["parameter"] || !netlist["parameter"].IsMap() || !netlist["parameter"][name]) {
+            qCritical() << "Error: Sub-netlist" << moduleName << "has no parameter"
+                        << parameter.key();
+            return false;
+        }
+        if (!defaultMap.contains(parameter.key())
+            || defaultMap.value(parameter.key()) != parameter.value()) {
+            changedMap.insert(parameter.key(), parameter.value());
+        }
+    }
+    if (changedMap.isEmpty()) {
+        return true;
+    }
+
+    for (auto parameter = changedMap.constBegin(); parameter != changedMap.constEnd();
+         ++parameter) {
+        const std::string name  = parameter.key().toStdString();
+        const std::string value = QString::number(parameter.value()).toStdString();
+        if (netlist["parameter"][name].IsMap()) {
+            netlist["parameter"][name]["value"] = value;
+        } else {
+            netlist["parameter"][name] = value;
+        }
+    }
+    const QByteArray digest = QCryptographicHash::hash(
+        parameterSetText(changedMap).toUtf8(), QCryptographicHash::Sha256);
+    moduleName += '_' + QString::fromLatin1(digest.toHex().left(8));
+    return true;
+}
+
+} /* namespace */
+
+bool QSocGenerateManager::processSubNetlists()
+{
+    subNetlistModuleMap.clear();
+    clearWidthCache();
+
+    const YAML::Node &netlist = netlistData;
+    if (!netlist["instance"] || !netlist["instance"].IsMap()) {
+        return true;
+    }
+    if (!subNetlistCache) {
+        subNetlistCache = std::make_shared<SubNetlistCache>();
+    }
+
+    const QDir baseDir = netlistPath.isEmpty() ? QDir::current()
+                                               : QFileInfo(netlistPath).absoluteDir();
+
+    /* Sub-netlists resolved for this netlist, by file path and overrides */
+    QHash<QString, SubNetlist> resolvedMap;
+    for (const auto &instance : netlist["instance"]) {
+        if (!instance.second.IsMap() || !instance.second["netlist"]) {
+            continue;
+        }
+        const QString instanceName = QString::fromStdString(instance.first.Scalar());
+        if (!instance.second["netlist"].IsScalar()) {
+            qCritical() << "Error: Invalid 'netlist' field in instance" << instanceName;
+            return false;
+        }
+
+        /* Each set of overrides gets its own module, so internal widths follow it */
+        const YAML::Node                       parameterNode = instance.second["parameter"];
+        const QSocWidthEvaluator::ParameterMap overrideMap
+            = QSocWidthEvaluator::resolveParameters(
+                YAML::Node(), parameterNode, getNetlistParameters());
+        if (parameterNode
+            && (!parameterNode.IsMap()
+                || static_cast<std::size_t>(overrideMap.size()) != parameterNode.size())) {
+            qCritical() << "Error: Parameters of sub-netlist instance" << instanceName
+                        << "must be constant expressions";
+            return false;
+        }
+
+        const QString filePath = QDir::cleanPath(
+            baseDir.absoluteFilePath(QString::fromStdString(instance.second["netlist"].Scalar())));
+        const QString resolvedKey = filePath + '#' + parameterSetText(overrideMap);
+        if (!resolvedMap.contains(resolvedKey)) {
+            SubNetlist subNetlist;
+            if (!generateSubNetlist(filePath, overrideMap, subNetlist)) {
+                qCritical() << "Error: Failed to generate sub-netlist" << filePath
+                            << "of instance" << instanceName;
+                return false;
+            }
+            resolvedMap.insert(resolvedKey, subNetlist);
+        }
+        const SubNetlist &subNetlist = resolvedMap[resolvedKey];
+
+        /* One module name must not stand for two different netlists */
+        const auto defined = subNetlistModuleMap.constFind(subNetlist.moduleName);
+        if (defined != subNetlistModuleMap.constEnd()
+            && !defined.value().is(subNetlist.moduleYaml)) {
+            qCritical() << "Error: Different sub-netlists generate the same module"
+                        << subNetlist.moduleName;
+            return false;
+        }
+        if (moduleManager && moduleManager->isModuleExist(subNetlist.moduleName)) {
+            qWarning() << "Warning: Sub-netlist module" << subNetlist.moduleName
+                       << "hides the library module of the same name";
+        }
+
+        /* The instance now refers to the generated module */
+        YAML::Node instanceNode = instance.second;
+        if (instanceNode["module"] && instanceNode["module"].IsScalar()
+            && QString::fromStdString(instanceNode["module"].Scalar()) != subNetlist.moduleName) {
+            qWarning() << "Warning: Instance" << instanceName << "module is replaced by"
+                       << subNetlist.moduleName << "from its netlist";
+        }
+        instanceNode["module"] = subNetlist.moduleName.toStdString();
+        subNetlistModuleMap.insert(subNetlist.moduleName, subNetlist.moduleYaml);
+
+        for (const auto &input : subNetlist.inputHashList) {
+            addDependency(input.first);
+        }
+    }
+    return true;
+}
+
+bool QSocGenerateManager::generateSubNetlist(
+    const QString                          &filePath,
+    const QSocWidthEvaluator::ParameterMap &overrideMap,
+    SubNetlist                             &subNetlist)
+{
+    const QString canonicalPath = QFileInfo(filePath).canonicalFilePath();
+    if (canonicalPath.isEmpty()) {
+        qCritical() << "Error: Sub-netlist file does not exist:" << filePath;
+        return false;
+    }
+    if (!projectManager) {
+        qCritical() << "Error: Project manager is null";
+        return false;
+    }
+
+    QStringList &activePathList = subNetlistCache->activePathList;
+    if (activePathList.contains(canonicalPath)) {
+        qCritical() << "Error: Recursive sub-netlist:"
+                    << (activePathList + QStringList{canonicalPath}).join(" -> ");
+        return false;
+    }
+
+    /* The same content, name and overrides generated into the same directory is the same module */
+    const QString    salt   = QStringList{projectManager->getOutputPath(),
+                                          QFileInfo(canonicalPath).baseName(),
+                                          parameterSetText(overrideMap)}
+                                  .join('\n');
+    const QByteArray key    = fileHash(canonicalPath, salt.toUtf8());
+    const auto       cached = subNetlistCache->netlistMap.constFind(key);
+    if (subNetlistOutput && cached != subNetlistCache->netlistMap.constEnd()
+        && QFile::exists(cached->outputFilePath)) {
+        /* Nested sub-netlists and libraries may have changed since */
+        bool current = true;
+        for (const auto &input : cached->inputHashList) {
+            if (fileHash(input.first) != input.second) {
+                current = false;
+                break;
+            }
+        }
+        if (current) {
+            qInfo() << "Reusing generated sub-netlist:" << cached->outputFilePath;
+            subNetlist = cached.value();
+            return true;
+        }
+    }
+
+    /* Generate on a separate manager, it shares the cache for nested levels */
+    const QMutexLocker  locker(&subNetlistMutex());
+    QString             moduleName = QFileInfo(canonicalPath).baseName();
+    QSocGenerateManager generator(nullptr, projectManager, moduleManager, busManager, llmService);
+    generator.setForceOverwrite(forceOverwrite);
+    generator.setBusInterface(busInterface);
+    generator.setSubNetlistOutput(subNetlistOutput);
+    generator.subNetlistCache = subNetlistCache;
+
+    activePathList.append(canonicalPath);
+    bool success = generator.loadNetlist(canonicalPath)
+                   && specializeNetlist(generator.netlistData, overrideMap, moduleName);
+    if (success) {
+        generator.clearWidthCache();
+        success = generator.processNetlist()
+                  && (!subNetlistOutput || generator.generateVerilog(moduleName));
+    }
+    activePathList.removeLast();
+    if (!success) {
+        return false;
+    }
+
+    subNetlist.moduleName     = moduleName;
+    subNetlist.moduleYaml     = subNetlistModuleYaml(generator.netlistData);
+    subNetlist.outputFilePath = QDir(projectManager->getOutputPath()).filePath(moduleName + ".v");
+    subNetlist.inputHashList.clear();
+    if (!subNetlistOutput) {
+        /* Nothing was written, so there is no result to reuse */
+        return true;
+    }
+    for (const QString &input : generator.getDependencyList()) {
+        subNetlist.inputHashList.append({input, fileHash(input)});
+    }
+    subNetlistCache->netlistMap.insert(key, subNetlist);
+    return true;
+}
+
+bool QSocGenerateManager::isModuleAvailable(const QString &moduleName)
+{
+    return subNetlistModuleMap.contains(moduleName)
+           || (moduleManager && moduleManager->isModuleExist(moduleName));
+}
+
+YAML::Node QSocGenerateManager::getModuleData(const QString &moduleName)
+{
+    const auto subNetlist = subNetlistModuleMap.constFind(moduleName);
+    if (subNetlist != subNetlistModuleMap.constEnd()) {
+        return subNetlist.value();
+    }
+    if (moduleManager && moduleManager->isModuleExist(moduleName)) {
+        return moduleManager->getModuleYaml(moduleName);
+    }
+    return {};
+}
@@ -109,6 +109,93 @@ void QSocGenerateManager::setForceOverwrite(bool force)
     }
 }
 
+void QSocGenerateManager::setBusInterface(bool enable)
+{
+    busInterface = enable;
+}
+
+void QSocGenerateManager::setSubNetlistOutput(bool enable)
+{
+    subNetlistOutput = enable;
+}
+
+QMutex &QSocGenerateManager::cellFileMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+const QStringList &QSocGenerateManager::getDependencyList() const
+{
+    return dependencyList;
+}
+
+void QSocGenerateManager::clearDependencyList()
+{
+    dependencyList.clear();
+}
+
+void QSocGenerateManager::addDependency(const QString &filePath)
+{
+    const QString absolutePath = QFileInfo(filePath).absoluteFilePath();
+    if (!dependencyList.contains(absolutePath)) {
+        dependencyList.append(absolutePath);
+    }
+}
+
+void QSocGenerateManager::resetCommandState()
+{
+    setForceOverwrite(false);
+    setBusInterface(false);
+    setSubNetlistOutput(true);
+    busInterfaceNetMap.clear();
+    dependencyList.clear();
+    netlistData = YAML::Node();
+    netlistPath.clear();
+    clearWidthCache();
+    subNetlistModuleMap.clear();
+    subNetlistCache.reset();
+    instanceArrayList.clear();
+}
+
+void QSocGenerateManager::addLibraryDependencies()
+{
+    if (!projectManager || !moduleManager || !netlistData["instance"]
+        || !netlistData["instance"].IsMap()) {
+        return;
+    }
+    const QDir moduleDir(projectManager->getModulePath());
+    const QDir busDir(projectManager->getBusPath());
+    for (const auto &instance : netlistData["instance"]) {
+        if (!instance.second.IsMap() || !instance.second["module"]
+            || !instance.second["module"].IsScalar()) {
+            continue;
+        }
+        const QString moduleName = QString::fromStdString(instance.second["module"].Scalar());
+        if (!moduleManager->isModuleExist(moduleName)) {
+            continue;
+        }
+        const QString library = moduleManager->getModuleLibrary(moduleName);
+        addDependency(moduleDir.filePath(library + ".soc_mod"));
+
+        /* Bus interfaces of the module pull in their bus libraries */
+        const YAML::Node moduleYaml = moduleManager->getModuleYaml(moduleName);
+        if (!busManager || !moduleYaml["bus"] || !moduleYaml["bus"].IsMap()) {
+            continue;
+        }
+        for (const auto &busInterface : moduleYaml["bus"]) {
+            if (!busInterface.second.IsMap() || !busInterface.second["bus"]
+                || !busInterface.second["bus"].IsScalar()) {
+                continue;
+            }
+            const QString busName = QString::fromStdString(busInterface.second["bus"].Scalar());
+            if (busManager->isBusExist(busName)) {
+                addDependency(busDir.filePath(busManager->getBusLibrary(busName) + ".soc_bus"));
+            }
+        }
+    }
+}
+
 QString QSocGenerateManager::cleanTypeForWireDeclaration(const QString &typeStr)
 {
     if (typeStr.isEmpty()) {
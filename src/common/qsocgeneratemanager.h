@@ -8,8 +8,10 @@
 #include "common/qsocbusmanager.h"
 #include "common/qsocconfig.h"
 #include "common/qsocmodulemanager.h"
+#include "common/qsocnetlistgraph.h"
 #include "common/qsocnumberinfo.h"
 #include "common/qsocprojectmanager.h"
+#include "common/qsocwidthevaluator.h"
 
 // Forward declarations for primitives
 class QSocResetPrimitive;
@@ -19,12 +21,16 @@ class QSocFSMPrimitive;
 class QSocCombPrimitive;
 class QSocSeqPrimitive;
 
+#include <QHash>
+#include <QMap>
+#include <QMutex>
 #include <QObject>
 #include <QPair>
 #include <QString>
 #include <QStringList>
 
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 #include <yaml-cpp/yaml.h>
@@ -316,6 +322,72 @@ public slots:
      */
     void setForceOverwrite(bool force);
 
+    /**
+     * @brief Set SystemVerilog interface mode for bus connections.
+     * @details When enabled, each bus link is emitted as one instance of a
+     *          SystemVerilog interface derived from the bus definition, with
+     *          a modport per bus mode, and instance ports connect to its
+     *          signals. When disabled, buses are flattened into one wire per
+     *          signal as Verilog-2001 requires.
+     * @param enable true to emit interfaces, false to flatten buses.
+     */
+    void setBusInterface(bool enable);
+
+    /**
+     * @brief Set whether processing writes the Verilog of sub-netlists.
+     * @details Enabled by default, since a generated netlist instantiates
+     *          the modules of its sub-netlists. Read-only queries such as
+     *          netlist trace disable it: sub-netlists are still expanded to
+     *          get their ports, but no file is written and no result is
+     *          kept in the sub-netlist cache.
+     * @param enable true to write sub-netlist files, false to only expand.
+     */
+    void setSubNetlistOutput(bool enable);
+
+    /**
+     * @brief Get the lock guarding shared primitive cell files.
+     * @details Cell files such as clock_cell.v are shared by all netlists of
+     *          a project. Generators running in parallel hold this lock while
+     *          creating or updating them.
+     * @return QMutex& The process wide cell file lock.
+     */
+    static QMutex &cellFileMutex();
+
+    /**
+     * @brief Get the input files read since the list was last cleared.
+     * @details Lists loaded netlist files, the module and bus libraries used
+     *          by generated netlists, and the template, included template and
+     *          data files of rendered templates, as absolute paths without
+     *          duplicates. Used to write depfiles for incremental builds.
+     * @return const QStringList& The input file paths, in reading order.
+     */
+    const QStringList &getDependencyList() const;
+
+    /**
+     * @brief Clear the list of input files read.
+     */
+    void clearDependencyList();
+
+    /**
+     * @brief Record an input file read by the caller.
+     * @details For inputs the manager does not read itself, such as netlist
+     *          files merged before setNetlistData().
+     * @param filePath Path of the input file.
+     */
+    void addDependency(const QString &filePath);
+
+    /**
+     * @brief Drop the options and netlist state of the previous command.
+     * @details A resident manager serves many commands. This clears force
+     *          overwrite and interface mode, turns sub-netlist output back
+     *          on, and drops the dependency list, the loaded
+     *          netlist with its width caches and instance arrays, and the
+     *          sub-netlist cache, so no command inherits them from the one
+     *          before. Libraries held by the module and bus managers are
+     *          not touched.
+     */
+    void resetCommandState();
+
     /**
      * @brief Load netlist file.
      * @details Loads a netlist file and creates an in-memory representation.
@@ -330,19 +402,50 @@ public slots:
      * @details Sets the netlist data directly from a YAML node, useful for
      *          processing merged netlists.
      * @param netlistData YAML node containing the netlist data.
+     * @param netlistFilePath File the data came from, relative sub-netlist
+     *        paths are resolved against its directory. Empty for the
+     *        current directory.
      * @retval true Netlist data set successfully.
      * @retval false Failed to set netlist data.
      */
-    bool setNetlistData(const YAML::Node &netlistData);
+    bool setNetlistData(const YAML::Node &netlistData, const QString &netlistFilePath = QString());
 
     /**
      * @brief Process and expand the netlist.
-     * @details Processes the loaded netlist, expanding buses into individual signals.
+     * @details Processes the loaded netlist, generating sub-netlists and
+     *          expanding buses into individual signals.
      * @retval true Netlist processed successfully.
      * @retval false Failed to process netlist.
      */
     bool processNetlist();
 
+    /**
+     * @brief Generate the sub-netlists instantiated by the netlist.
+     * @details Instances may name another netlist file with a `netlist`
+     *          field instead of a library module. Each sub-netlist is
+     *          processed and written once as `<file base name>.v`, and its
+     *          top-level ports and parameters become the module definition
+     *          of the instance, without importing the generated Verilog.
+     *          Results are cached by the content hash of the sub-netlist
+     *          file and reused for every instance and every later netlist
+     *          processed by this manager while none of its inputs change.
+     * @retval true All sub-netlists generated, or there are none.
+     * @retval false A sub-netlist is missing, recursive or failed.
+     */
+    bool processSubNetlists();
+
+    /**
+     * @brief Take the instance arrays out of the instance section.
+     * @details An instance named `name[from:to]` stands for one instance
+     *          per index. Its `parameter`, `link` and `tie` values may use
+     *          `{i}` for the index. Arrays are kept as one entry and emitted
+     *          as a single `generate for` block, so processing time and
+     *          output size do not grow with the array length.
+     * @retval true All instance arrays are valid, or there are none.
+     * @retval false An instance array has an invalid range or port.
+     */
+    bool processInstanceArrays();
+
     /**
      * @brief Expand bus link references in instance bus sections.
      * @details Scans all instances for bus sections with link attributes,
@@ -370,10 +473,24 @@ public slots:
      */
     bool generateVerilog(const QString &outputFileName);
 
+    /**
+     * @brief Build the connectivity graph of the processed netlist.
+     * @details Indexes every pin of the `net` section after processNetlist()
+     *          has expanded links, uplinks and buses, with top-level ports
+     *          under the instance name `top`. Pin directions come from the
+     *          module definitions, pins of unknown modules are taken as
+     *          inout. Instance arrays and the comb, seq and fsm sections are
+     *          not part of the graph.
+     * @return The connectivity graph.
+     */
+    QSocNetlistGraph buildNetlistGraph();
+
     /**
      * @brief Render a Jinja2 template with provided data files.
      * @details Loads data from CSV, YAML, JSON, SystemRDL, and RCSV files, then renders a Jinja2 template
      *          and saves the result to the output directory.
+     *          The output is streamed into the file while rendering, and the
+     *          file is only replaced when rendering succeeds.
      * @param templateFilePath Path to the Jinja2 template file.
      * @param csvFiles List of CSV data files to load.
      * @param yamlFiles List of YAML data files to load.
@@ -399,14 +516,21 @@ public slots:
      *          for modules matching the specified library and module regex patterns.
      * @param stubName Base name for the output stub files.
      * @param libraryRegex Regular expression to filter libraries.
+     *          Timing arcs and pin capacitance of the Liberty cells come from
+     *          the timing sections of the module YAML, overridden by rows of
+     *          the timing CSV files.
+     * @param stubName Base name for the output stub files.
+     * @param libraryRegex Regular expression to filter libraries.
      * @param moduleRegex Regular expression to filter modules within libraries.
+     * @param timingFiles Timing CSV files with module, port and timing columns.
      * @retval true Stub files generated successfully.
      * @retval false Failed to generate stub files.
      */
     bool generateStub(
         const QString            &stubName,
         const QRegularExpression &libraryRegex,
-        const QRegularExpression &moduleRegex);
+        const QRegularExpression &moduleRegex,
+        const QStringList        &timingFiles = QStringList());
 
     /**
      * @brief Generate Verilog stub file for selected modules.
@@ -431,6 +555,208 @@ public slots:
     bool generateLibStub(const QString &stubName, const QStringList &moduleNames);
 
 private:
+    /**
+     * @brief Generated sub-netlist
+     */
+    struct SubNetlist
+    {
+        QString                           moduleName;     /**< Generated module name */
+        YAML::Node                        moduleYaml;     /**< Derived module definition */
+        QString                           outputFilePath; /**< Generated Verilog file */
+        QList<QPair<QString, QByteArray>> inputHashList;  /**< Input files and their hashes */
+    };
+
+    /**
+     * @brief Sub-netlists generated by a manager and its children
+     */
+    struct SubNetlistCache
+    {
+        QHash<QByteArray, SubNetlist> netlistMap;     /**< Sub-netlists by content hash */
+        QStringList                   activePathList; /**< Sub-netlists being generated */
+    };
+
+    /**
+     * @brief Get a generated sub-netlist, generating it when needed
+     * @details Overrides that differ from the sub-netlist defaults produce a
+     *          specialized module named `<base>_<hash>`, with the overrides
+     *          as its parameter defaults.
+     * @param filePath Path of the sub-netlist file
+     * @param overrideMap Resolved parameter overrides of the instance
+     * @param subNetlist Set to the generated sub-netlist
+     * @retval true The sub-netlist is generated
+     * @retval false The sub-netlist is missing, recursive or failed
+     */
+    bool generateSubNetlist(
+        const QString                          &filePath,
+        const QSocWidthEvaluator::ParameterMap &overrideMap,
+        SubNetlist                             &subNetlist);
+
+    /**
+     * @brief Check whether a module is defined by a sub-netlist or a library
+     * @param moduleName Name of the module
+     * @return Whether the module is defined
+     */
+    bool isModuleAvailable(const QString &moduleName);
+
+    /**
+     * @brief Get a module definition from the sub-netlists or the libraries
+     * @param moduleName Name of the module
+     * @return The module YAML, null if the module is not defined
+     */
+    YAML::Node getModuleData(const QString &moduleName);
+
+    /**
+     * @brief Bus signal net, kept for interface emission
+     */
+    struct BusInterfaceSignal
+    {
+        QString busName;    /**< Bus link name, the interface instance name */
+        QString busType;    /**< Bus definition name */
+        QString signalName; /**< Signal name in the bus definition */
+    };
+
+    /**
+     * @brief Get the expression connecting an instance port to a net
+     * @param netName Name of the net
+     * @return `bus.signal` for bus signals in interface mode, else the net name
+     */
+    QString netReference(const QString &netName) const;
+
+    /**
+     * @brief Reject logic sections that name bus signal nets in interface mode
+     * @details Comb, seq, FSM, reset, clock and power logic is written with
+     *          plain net names, which are not declared when the net is a
+     *          signal of an interface instance.
+     * @retval true No logic section names a bus signal net
+     * @retval false A logic section names one, an error has been logged
+     */
+    bool checkBusInterfaceReferences() const;
+
+    /**
+     * @brief Write one interface instance per bus link
+     * @details Links of the same bus type and signal widths share one
+     *          interface definition, named after the module and bus type.
+     * @param out Output text stream
+     * @param moduleName Name of the generated module
+     * @param signalWidthMap Declared range of each bus signal net, by net name
+     * @return The interface definitions, written after the module
+     */
+    QString generateBusInterfaces(
+        QTextStream                  &out,
+        const QString                &moduleName,
+        const QMap<QString, QString> &signalWidthMap);
+
+    /**
+     * @brief Instance array taken from the instance section
+     */
+    struct InstanceArray
+    {
+        QString    name;         /**< Array name without the range */
+        qint64     from = 0;     /**< First index as written */
+        qint64     to   = 0;     /**< Last index as written */
+        YAML::Node instanceData; /**< Instance entry, with `{i}` placeholders */
+    };
+
+    /**
+     * @brief Write the wire declarations of nets used only by instance arrays
+     * @details Net widths are evaluated at the first and last index. Nets
+     *          declared already, by the `net` section or as top-level ports,
+     *          get a warning and a FIXME comment when the array selects bits
+     *          beyond their declared width.
+     * @param out Output text stream
+     * @param netDeclaredWidthMap Widths of the wires declared for the `net`
+     *        section, -1 when unknown
+     */
+    void generateInstanceArrayWires(
+        QTextStream &out, const QMap<QString, int> &netDeclaredWidthMap);
+
+    /**
+     * @brief Write each instance array as a `generate for` block
+     * @details In interface mode, links to bus signals refer to the signal
+     *          of the interface instance.
+     * @param out Output text stream
+     */
+    void generateInstanceArrays(QTextStream &out);
+
+    /**
+     * @brief Resolved parameter set of an instance
+     */
+    struct InstanceParameters
+    {
+        QString                          moduleName;   /**< Module of the instance */
+        QString                          cacheKey;     /**< Module name and parameter key */
+        QSocWidthEvaluator::ParameterMap parameterMap; /**< Resolved parameter values */
+    };
+
+    /**
+     * @brief Get the resolved top-level parameters of the netlist
+     * @return Netlist parameter values, evaluated once per netlist
+     */
+    QSocWidthEvaluator::ParameterMap getNetlistParameters();
+
+    /**
+     * @brief Get the resolved parameters of an instance
+     * @details Module defaults with the instance overrides applied, the
+     *          overrides being evaluated against the netlist parameters.
+     *          Evaluated once per instance.
+     * @param instanceName Name of the instance
+     * @return The module name and parameter values of the instance
+     */
+    InstanceParameters getInstanceParameters(const QString &instanceName);
+
+    /**
+     * @brief Get the width of an instance port
+     * @details Evaluates the port range with the instance parameters. When
+     *          the module was imported with a descriptor elaborated for the
+     *          same parameters, its exact port type is used instead. Widths
+     *          are memoized per module, parameter set and port, so instances
+     *          sharing a parameterization evaluate each port once.
+     * @param instanceName Name of the instance
+     * @param portName Name of the module port
+     * @return The width in bits, or 0 if cannot be determined
+     */
+    int getInstancePortWidth(const QString &instanceName, const QString &portName);
+
+    /**
+     * @brief Drop the parameter and width caches of the current netlist
+     */
+    void clearWidthCache();
+
+    /**
+     * @brief Collect the YAML of named modules for stub generation.
+     * @param moduleNames Names of the modules, missing modules are skipped.
+     * @return YAML::Node Map from module name to module YAML.
+     */
+    YAML::Node getStubModuleYamls(const QStringList &moduleNames);
+
+    /**
+     * @brief Apply timing CSV files to the timing sections of modules.
+     * @details Each row names a module and optionally a port, "*" matches
+     *          every module. Rows without a port set the module timing,
+     *          other rows the port timing. Modules with rows are cloned, so
+     *          the library data is never changed.
+     * @param timingFiles Timing CSV files.
+     * @param moduleYamls Map from module name to module YAML, updated in place.
+     * @retval true All files applied.
+     * @retval false A file could not be read.
+     */
+    bool applyStubTimingFiles(const QStringList &timingFiles, YAML::Node &moduleYamls);
+
+    /**
+     * @brief Write stub files for a set of modules.
+     * @details Reads each module descriptor once, renders the Verilog and
+     *          Liberty text of all modules on a thread pool when the set is
+     *          large, then writes the files in module order.
+     * @param stubName Base name for the output stub files.
+     * @param moduleYamls Map from module name to module YAML.
+     * @param verilog Write the Verilog (.v) stub file.
+     * @param lib Write the Liberty (.lib) stub file.
+     * @retval true Stub files generated successfully.
+     * @retval false Failed to write a stub file.
+     */
+    bool generateStubFiles(
+        const QString &stubName, const YAML::Node &moduleYamls, bool verilog, bool lib);
+
     /**
      * @brief Process link and uplink connections in the netlist
      * @return true if successful, false on error
@@ -478,10 +804,13 @@ private:
 
     /**
      * @brief Calculate the width of a port from its type string
-     * @param portType The port type string (e.g., "wire [7:0]", "reg [15:0]", "wire")
+     * @param portType The port type string (e.g., "wire [7:0]", "reg [DW-1:0]", "wire")
+     * @param parameters Parameter values used by the range expression
      * @return The width in bits, or -1 if cannot be determined
      */
-    int calculatePortWidth(const std::string &portType);
+    int calculatePortWidth(
+        const std::string                      &portType,
+        const QSocWidthEvaluator::ParameterMap &parameters = QSocWidthEvaluator::ParameterMap());
 
     /**
      * @brief Process combinational logic section in the netlist
@@ -583,6 +912,11 @@ private:
         const QStringList &ifndef,
         const QString     &indent = "    ");
 
+    /**
+     * @brief Record the module and bus libraries used by the netlist
+     */
+    void addLibraryDependencies();
+
     /** Project manager. */
     QSocProjectManager *projectManager = nullptr;
     /** Module manager. */
@@ -600,8 +934,31 @@ private:
     QSocSeqPrimitive   *seqPrimitive   = nullptr;
     /** Force overwrite mode for primitive cell files */
     bool forceOverwrite = false;
+    /** Emit bus links as SystemVerilog interfaces */
+    bool busInterface = false;
+    /** Write the Verilog of sub-netlists while processing */
+    bool subNetlistOutput = true;
+    /** Bus signals by net name, filled in interface mode */
+    QHash<QString, BusInterfaceSignal> busInterfaceNetMap;
+    /** Input files read since the list was last cleared */
+    QStringList dependencyList;
     /** Netlist data. */
     YAML::Node netlistData;
+    /** Resolved netlist parameters, valid when netlistParameterCached is set */
+    QSocWidthEvaluator::ParameterMap netlistParameterCache;
+    bool                             netlistParameterCached = false;
+    /** Resolved parameters by instance name */
+    QHash<QString, InstanceParameters> instanceParameterCache;
+    /** Port widths by module, parameter set and port name */
+    QHash<QString, int> portWidthCache;
+    /** File the netlist was loaded from, empty when set directly */
+    QString netlistPath;
+    /** Module definitions derived from sub-netlists, by module name */
+    QHash<QString, YAML::Node> subNetlistModuleMap;
+    /** Sub-netlist cache, shared with the managers of nested sub-netlists */
+    std::shared_ptr<SubNetlistCache> subNetlistCache;
+    /** Instance arrays of the netlist, in instance section order */
+    QList<InstanceArray> instanceArrayList;
 };
 
 #endif // QSOCGENERATEMANAGER_H
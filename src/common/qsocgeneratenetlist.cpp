@@ -3,6 +3,7 @@
 
 #include "common/qslangdriver.h"
 #include "common/qsocgeneratemanager.h"
+#include "common/qsocyamlutils.h"
 #include "common/qstaticlog.h"
 #include "common/qstaticstringweaver.h"
 
@@ -11,12 +12,12 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QTextStream>
 
 #include <algorithm>
-#include <fstream>
 #include <iostream>
 
 bool QSocGenerateManager::loadNetlist(const QString &netlistFilePath)
@@ -27,16 +28,18 @@ bool QSocGenerateManager::loadNetlist(const QString &netlistFilePath)
         return false;
     }
 
-    /* Open the YAML file */
-    std::ifstream fileStream(netlistFilePath.toStdString());
-    if (!fileStream.is_open()) {
+    /* Check if the file can be read */
+    if (!QFileInfo(netlistFilePath).isReadable()) {
         qCritical() << "Error: Unable to open netlist file:" << netlistFilePath;
         return false;
     }
 
     try {
         /* Load YAML content into netlistData */
-        netlistData = YAML::Load(fileStream);
+        netlistData = QSocYamlUtils::loadFile(netlistFilePath);
+        netlistPath = netlistFilePath;
+        clearWidthCache();
+        instanceArrayList.clear();
 
         /* Validate basic netlist structure */
         // Check if instance section exists and is valid when present
@@ -69,6 +72,7 @@ bool QSocGenerateManager::loadNetlist(const QString &netlistFilePath)
             return false;
         }
 
+        addDependency(netlistFilePath);
         qInfo() << "Successfully loaded netlist file:" << netlistFilePath;
         return true;
     } catch (const YAML::Exception &e) {
@@ -77,7 +81,8 @@ bool QSocGenerateManager::loadNetlist(const QString &netlistFilePath)
     }
 }
 
-bool QSocGenerateManager::setNetlistData(const YAML::Node &netlistData)
+bool QSocGenerateManager::setNetlistData(
+    const YAML::Node &netlistData, const QString &netlistFilePath)
 {
     try {
         /* Validate basic netlist structure - allow missing instance if primitives exist */
@@ -112,6 +117,9 @@ bool QSocGenerateManager::setNetlistData(const YAML::Node &netlistData)
 
         /* Set the netlist data */
         this->netlistData = netlistData;
+        netlistPath       = netlistFilePath;
+        clearWidthCache();
+        instanceArrayList.clear();
 
         qInfo() << "Successfully set netlist data";
         return true;
@@ -136,6 +144,18 @@ bool QSocGenerateManager::processNetlist()
             return false;
         }
 
+        /* Sub-netlists define the modules of their instances */
+        if (!processSubNetlists()) {
+            qCritical() << "Error: Failed to generate sub-netlists";
+            return false;
+        }
+
+        /* Instance arrays stay compact, they are emitted as generate loops */
+        if (!processInstanceArrays()) {
+            qCritical() << "Error: Failed to process instance arrays";
+            return false;
+        }
+
         /* Expand bus links before processing */
         if (!expandBusLink()) {
             qCritical() << "Error: Failed to expand bus links";
@@ -154,6 +174,7 @@ bool QSocGenerateManager::processNetlist()
         }
 
         /* Process bus section if it exists */
+        busInterfaceNetMap.clear();
         if (!netlistData["bus"] || !netlistData["bus"].IsMap() || netlistData["bus"].size() == 0) {
             qInfo() << "No bus section found or empty, skipping bus processing";
         } else {
@@ -230,9 +251,7 @@ bool QSocGenerateManager::processNetlist()
                                 = netlistData["instance"][instanceName]["module"].as<std::string>();
 
                             /* Check if module exists */
-                            if (!moduleManager
-                                || !moduleManager->isModuleExist(
-                                    QString::fromStdString(moduleName))) {
+                            if (!isModuleAvailable(QString::fromStdString(moduleName))) {
                                 qWarning()
                                     << "Warning: Module" << moduleName.c_str() << "not found";
                                 continue;
@@ -241,8 +260,7 @@ bool QSocGenerateManager::processNetlist()
                             /* Get module data */
                             YAML::Node moduleData;
                             try {
-                                moduleData = moduleManager->getModuleYaml(
-                                    QString::fromStdString(moduleName));
+                                moduleData = getModuleData(QString::fromStdString(moduleName));
                             } catch (const YAML::Exception &e) {
                                 qWarning() << "Error getting module data:" << e.what();
                                 continue;
@@ -381,13 +399,13 @@ bool QSocGenerateManager::processNetlist()
                         for (const Connection &conn : validConnections) {
                             try {
                                 /* Skip if module definition not available */
-                                if (!moduleManager->isModuleExist(conn.moduleName.c_str())) {
+                                if (!isModuleAvailable(conn.moduleName.c_str())) {
                                     qWarning() << "Warning: Module" << conn.moduleName.c_str()
                                                << "not found, skipping";
                                     continue;
                                 }
 
-                                YAML::Node moduleData = moduleManager->getModuleYaml(
+                                YAML::Node moduleData = getModuleData(
                                     QString::fromStdString(conn.moduleName));
 
                                 if (!moduleData["bus"] || !moduleData["bus"].IsMap()) {
@@ -480,6 +498,12 @@ bool QSocGenerateManager::processNetlist()
                         /* If no connections were added to this net, remove it */
                         if (netlistData["net"][netName].size() == 0) {
                             netlistData["net"].remove(netName);
+                        } else if (busInterface) {
+                            busInterfaceNetMap.insert(
+                                QString::fromStdString(netName),
+                                {QString::fromStdString(busTypeName),
+                                 QString::fromStdString(busType),
+                                 QString::fromStdString(signalName)});
                         }
                     }
 
@@ -652,14 +676,13 @@ bool QSocGenerateManager::expandBusUplink()
             const std::string moduleName = instanceNode["module"].as<std::string>();
 
             /* Get module data */
-            if (!moduleManager
-                || !moduleManager->isModuleExist(QString::fromStdString(moduleName))) {
+            if (!isModuleAvailable(QString::fromStdString(moduleName))) {
                 continue;
             }
 
             YAML::Node moduleData;
             try {
-                moduleData = moduleManager->getModuleYaml(QString::fromStdString(moduleName));
+                moduleData = getModuleData(QString::fromStdString(moduleName));
             } catch (const YAML::Exception &e) {
                 qWarning() << "Error getting module data for bus uplink:" << e.what();
                 continue;
@@ -862,30 +885,9 @@ bool QSocGenerateManager::checkPortWidthConsistency(const QList<PortConnection>
                     width = QSocGenerateManager::cleanTypeForWireDeclaration(width);
                     widthInfo.originalWidth = width;
 
-                    /* Calculate width in bits */
-                    const QRegularExpression widthRegex(R"(\[(\d+)(?::(\d+))?\])");
-                    auto                     match = widthRegex.match(width);
-                    if (match.hasMatch()) {
-                        bool      msb_ok = false;
-                        const int msb    = match.captured(1).toInt(&msb_ok);
-
-                        if (msb_ok) {
-                            if (match.capturedLength(2) > 0) {
-                                /* Case with specified LSB, e.g. [7:3] */
-                                bool      lsb_ok = false;
-                                const int lsb    = match.captured(2).toInt(&lsb_ok);
-                                if (lsb_ok) {
-                                    widthInfo.effectiveWidth = qAbs(msb - lsb) + 1;
-                                }
-                            } else {
-                                /* Case with only MSB specified, e.g. [7] */
-                                widthInfo.effectiveWidth = msb + 1;
-                            }
-                        }
-                    } else {
-                        /* Default to 1-bit if no width specified */
-                        widthInfo.effectiveWidth = 1;
-                    }
+                    /* Calculate width in bits, the range may use netlist parameters */
+                    widthInfo.effectiveWidth
+                        = QSocWidthEvaluator::typeWidth(width, getNetlistParameters()).value_or(0);
                 }
 
                 /* Get port direction from netlist data */
@@ -952,25 +954,9 @@ bool QSocGenerateManager::checkPortWidthConsistency(const QList<PortConnection>
                         }
                     } else {
                         /* Calculate full width if no bit selection */
-                        const QRegularExpression widthRegex(R"(\[(\d+)(?::(\d+))?\])");
-                        auto                     match = widthRegex.match(width);
-                        if (match.hasMatch()) {
-                            bool      msb_ok = false;
-                            const int msb    = match.captured(1).toInt(&msb_ok);
-                            if (msb_ok) {
-                                if (match.capturedLength(2) > 0) {
-                                    bool      lsb_ok = false;
-                                    const int lsb    = match.captured(2).toInt(&lsb_ok);
-                                    if (lsb_ok) {
-                                        widthInfo.effectiveWidth = qAbs(msb - lsb) + 1;
-                                    }
-                                } else {
-                                    widthInfo.effectiveWidth = msb + 1;
-                                }
-                            }
-                        } else {
-                            widthInfo.effectiveWidth = 1;
-                        }
+                        widthInfo.effectiveWidth
+                            = QSocWidthEvaluator::typeWidth(width, getNetlistParameters())
+                                  .value_or(0);
                     }
                 }
             }
@@ -984,8 +970,8 @@ bool QSocGenerateManager::checkPortWidthConsistency(const QList<PortConnection>
                         .as<std::string>());
 
                 /* Get port width from module definition */
-                if (moduleManager && moduleManager->isModuleExist(moduleName)) {
-                    YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
+                if (isModuleAvailable(moduleName)) {
+                    YAML::Node moduleData = getModuleData(moduleName);
 
                     if (moduleData["port"] && moduleData["port"].IsMap()
                         && moduleData["port"][portName.toStdString()]["type"]
@@ -996,30 +982,8 @@ bool QSocGenerateManager::checkPortWidthConsistency(const QList<PortConnection>
                         width = QSocGenerateManager::cleanTypeForWireDeclaration(width);
                         widthInfo.originalWidth = width;
 
-                        /* Calculate width in bits */
-                        const QRegularExpression widthRegex(R"(\[(\d+)(?::(\d+))?\])");
-                        auto                     match = widthRegex.match(width);
-                        if (match.hasMatch()) {
-                            bool      msb_ok = false;
-                            const int msb    = match.captured(1).toInt(&msb_ok);
-
-                            if (msb_ok) {
-                                if (match.capturedLength(2) > 0) {
-                                    /* Case with specified LSB, e.g. [7:3] */
-                                    bool      lsb_ok = false;
-                                    const int lsb    = match.captured(2).toInt(&lsb_ok);
-                                    if (lsb_ok) {
-                                        widthInfo.effectiveWidth = qAbs(msb - lsb) + 1;
-                                    }
-                                } else {
-                                    /* Case with only MSB specified, e.g. [7] */
-                                    widthInfo.effectiveWidth = msb + 1;
-                                }
-                            }
-                        } else {
-                            /* Default to 1-bit if no width specified */
-                            widthInfo.effectiveWidth = 1;
-                        }
+                        /* Calculate width in bits with the instance parameters */
+                        widthInfo.effectiveWidth = getInstancePortWidth(instanceName, portName);
 
                         /* Get port direction from module definition */
                         if (moduleData["port"][portName.toStdString()]["direction"]
@@ -1188,8 +1152,8 @@ QSocGenerateManager::PortDirectionStatus QSocGenerateManager::checkPortDirection
                         .as<std::string>());
 
                 /* Get port direction from module definition */
-                if (moduleManager && moduleManager->isModuleExist(moduleName)) {
-                    YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
+                if (isModuleAvailable(moduleName)) {
+                    YAML::Node moduleData = getModuleData(moduleName);
 
                     if (moduleData["port"] && moduleData["port"].IsMap()
                         && moduleData["port"][conn.portName.toStdString()]["direction"]
@@ -1399,15 +1363,14 @@ bool QSocGenerateManager::processLinkConnections()
             const auto moduleName = instanceNode["module"].as<std::string>();
 
             /* Check if module exists */
-            if (!moduleManager
-                || !moduleManager->isModuleExist(QString::fromStdString(moduleName))) {
+            if (!isModuleAvailable(QString::fromStdString(moduleName))) {
                 continue;
             }
 
             /* Get module data for port information */
             YAML::Node moduleData;
             try {
-                moduleData = moduleManager->getModuleYaml(QString::fromStdString(moduleName));
+                moduleData = getModuleData(QString::fromStdString(moduleName));
             } catch (const YAML::Exception &e) {
                 qWarning() << "Error getting module data for" << moduleName.c_str() << ":"
                            << e.what();
@@ -1666,8 +1629,10 @@ bool QSocGenerateManager::processUplinkConnection(
 
             if (!existingType.empty() && existingType != modulePortType) {
                 /* Calculate widths for comparison */
-                const int moduleWidth   = calculatePortWidth(modulePortType);
-                const int existingWidth = calculatePortWidth(existingType);
+                const int moduleWidth = calculatePortWidth(
+                    modulePortType,
+                    getInstanceParameters(QString::fromStdString(instanceName)).parameterMap);
+                const int existingWidth = calculatePortWidth(existingType, getNetlistParameters());
 
                 if (moduleWidth > 0 && existingWidth > 0 && moduleWidth != existingWidth) {
                     qCritical() << "Error: Type/width mismatch for uplink port" << netName.c_str()
@@ -1745,40 +1710,97 @@ std::pair<std::string, std::string> QSocGenerateManager::parseLinkValue(const st
 
 /**
  * @brief Calculate the width of a port from its type string
- * @param portType The port type string (e.g., "wire [7:0]", "reg [15:0]", "wire")
+ * @param portType The port type string (e.g., "wire [7:0]", "reg [DW-1:0]", "wire")
+ * @param parameters Parameter values used by the range expression
  * @return The width in bits, or -1 if cannot be determined
  */
-int QSocGenerateManager::calculatePortWidth(const std::string &portType)
+int QSocGenerateManager::calculatePortWidth(
+    const std::string &portType, const QSocWidthEvaluator::ParameterMap &parameters)
 {
-    const QString type = QString::fromStdString(portType);
+    /* [7:0] or [15:8] is |msb-lsb|+1 bits, [5] is 6 bits, no range is a single bit */
+    return QSocWidthEvaluator::typeWidth(QString::fromStdString(portType), parameters).value_or(-1);
+}
 
-    /* Handle range specification like [7:0] or [15:8] */
-    const QRegularExpression      rangeRegex(R"(\[(\d+):(\d+)\])");
-    const QRegularExpressionMatch rangeMatch = rangeRegex.match(type);
-    if (rangeMatch.hasMatch()) {
-        bool      msb_ok = false;
-        bool      lsb_ok = false;
-        const int msb    = rangeMatch.captured(1).toInt(&msb_ok);
-        const int lsb    = rangeMatch.captured(2).toInt(&lsb_ok);
+QSocWidthEvaluator::ParameterMap QSocGenerateManager::getNetlistParameters()
+{
+    if (!netlistParameterCached) {
+        const YAML::Node &netlist = netlistData;
+        netlistParameterCache     = QSocWidthEvaluator::resolveParameters(netlist["parameter"]);
+        netlistParameterCached    = true;
+    }
+    return netlistParameterCache;
+}
 
-        if (msb_ok && lsb_ok) {
-            return qAbs(msb - lsb) + 1;
+QSocGenerateManager::InstanceParameters QSocGenerateManager::getInstanceParameters(
+    const QString &instanceName)
+{
+    const auto cached = instanceParameterCache.constFind(instanceName);
+    if (cached != instanceParameterCache.constEnd()) {
+        return cached.value();
+    }
+
+    InstanceParameters result;
+    const YAML::Node  &netlist = netlistData;
+    if (netlist["instance"] && netlist["instance"].IsMap()) {
+        const YAML::Node instance = netlist["instance"][instanceName.toStdString()];
+        if (instance && instance.IsMap() && instance["module"] && instance["module"].IsScalar()) {
+            result.moduleName = QString::fromStdString(instance["module"].as<std::string>());
+            /* Null for unknown modules, which have no defaults */
+            const YAML::Node moduleData = getModuleData(result.moduleName);
+            result.parameterMap = QSocWidthEvaluator::resolveParameters(
+                moduleData["parameter"], instance["parameter"], getNetlistParameters());
         }
     }
+    result.cacheKey = result.moduleName + "#"
+                      + QSocWidthEvaluator::parameterKey(result.parameterMap);
 
-    /* Handle single bit specification like [5] */
-    const QRegularExpression      singleBitRegex(R"(\[(\d+)\])");
-    const QRegularExpressionMatch singleBitMatch = singleBitRegex.match(type);
-    if (singleBitMatch.hasMatch()) {
-        bool      msb_ok = false;
-        const int msb    = singleBitMatch.captured(1).toInt(&msb_ok);
-        if (msb_ok) {
-            return msb + 1; /* [5] means 6 bits: [5:0] */
+    instanceParameterCache.insert(instanceName, result);
+    return result;
+}
+
+int QSocGenerateManager::getInstancePortWidth(const QString &instanceName, const QString &portName)
+{
+    const InstanceParameters instance = getInstanceParameters(instanceName);
+    const QString            key      = instance.cacheKey + "." + portName;
+    const auto               cached   = portWidthCache.constFind(key);
+    if (cached != portWidthCache.constEnd()) {
+        return cached.value();
+    }
+
+    int width = 0;
+    if (isModuleAvailable(instance.moduleName)) {
+        const YAML::Node moduleData = getModuleData(instance.moduleName);
+        /* A descriptor elaborated for these parameters has exact port types */
+        const YAML::Node &elaboratedMap = moduleData["parameterization"];
+        const YAML::Node  elaborated
+            = (elaboratedMap && elaboratedMap.IsMap())
+                  ? elaboratedMap[QSocWidthEvaluator::parameterKey(instance.parameterMap)
+                                      .toStdString()]
+                  : YAML::Node();
+        const YAML::Node &portMap  = (elaborated && elaborated.IsMap() && elaborated["port"])
+                                         ? elaborated["port"]
+                                         : moduleData["port"];
+        const YAML::Node  portNode = (portMap && portMap.IsMap())
+                                         ? portMap[portName.toStdString()]
+                                         : YAML::Node();
+        if (portNode && portNode.IsMap() && portNode["type"] && portNode["type"].IsScalar()) {
+            width = QSocWidthEvaluator::typeWidth(
+                        QString::fromStdString(portNode["type"].as<std::string>()),
+                        instance.parameterMap)
+                        .value_or(0);
         }
     }
 
-    /* Default single bit */
-    return 1;
+    portWidthCache.insert(key, width);
+    return width;
+}
+
+void QSocGenerateManager::clearWidthCache()
+{
+    netlistParameterCache.clear();
+    netlistParameterCached = false;
+    instanceParameterCache.clear();
+    portWidthCache.clear();
 }
 
 /**
@@ -2161,9 +2183,62 @@ QPair<QString, QString> QSocGenerateManager::parseSignalBitSelect(const QString
 QList<QSocGenerateManager::PortDetailInfo> QSocGenerateManager::collectCombSeqFsmSignals()
 {
     QList<PortDetailInfo> signalList;
-    QSlangDriver          driver; // Create once for all signal extractions
 
     try {
+        /* Index port widths once instead of rescanning the port map per signal */
+        QHash<QString, QString> portWidthMap;
+        if (netlistData["port"] && netlistData["port"].IsMap()) {
+            for (const auto &portEntry : netlistData["port"]) {
+                if (portEntry.first.IsScalar() && portEntry.second.IsMap()
+                    && portEntry.second["type"] && portEntry.second["type"].IsScalar()) {
+                    const QString portName = QString::fromStdString(
+                        portEntry.first.as<std::string>());
+                    const QString portType = QString::fromStdString(
+                        portEntry.second["type"].as<std::string>());
+                    if (!portWidthMap.contains(portName)) {
+                        portWidthMap.insert(portName, cleanTypeForWireDeclaration(portType));
+                    }
+                }
+            }
+        }
+
+        /* Wrap every comb expr and seq next as assign statements for one batched parse */
+        QStringList              snippetList;
+        QHash<size_t, qsizetype> combSnippetIndex;
+        QHash<size_t, qsizetype> seqSnippetIndex;
+        if (netlistData["comb"] && netlistData["comb"].IsSequence()) {
+            for (size_t i = 0; i < netlistData["comb"].size(); ++i) {
+                const YAML::Node &combItem = netlistData["comb"][i];
+                if (combItem.IsMap() && combItem["out"] && combItem["out"].IsScalar()
+                    && combItem["expr"] && combItem["expr"].IsScalar()) {
+                    const QString signalName = QString::fromStdString(
+                        combItem["out"].as<std::string>());
+                    const QString baseName   = parseSignalBitSelect(signalName).first;
+                    const QString expr       = QString::fromStdString(
+                        combItem["expr"].as<std::string>());
+                    combSnippetIndex.insert(i, snippetList.size());
+                    snippetList.append(QString("assign %1 = %2;").arg(baseName, expr));
+                }
+            }
+        }
+        if (netlistData["seq"] && netlistData["seq"].IsSequence()) {
+            for (size_t i = 0; i < netlistData["seq"].size(); ++i) {
+                const YAML::Node &seqItem = netlistData["seq"][i];
+                if (seqItem.IsMap() && seqItem["reg"] && seqItem["reg"].IsScalar()
+                    && seqItem["next"] && seqItem["next"].IsScalar()) {
+                    const QString signalName = QString::fromStdString(
+                        seqItem["reg"].as<std::string>());
+                    const QString baseName   = parseSignalBitSelect(signalName).first;
+                    const QString nextExpr   = QString::fromStdString(
+                        seqItem["next"].as<std::string>());
+                    seqSnippetIndex.insert(i, snippetList.size());
+                    snippetList.append(QString("assign %1 = %2;").arg(baseName, nextExpr));
+                }
+            }
+        }
+        const QList<QSlangDriver::SnippetSignalInfo> snippetInfoList
+            = QSlangDriver::analyzeVerilogSnippets(snippetList);
+
         // Collect comb outputs and inputs
         if (netlistData["comb"] && netlistData["comb"].IsSequence()) {
             for (size_t i = 0; i < netlistData["comb"].size(); ++i) {
@@ -2183,71 +2258,29 @@ QList<QSocGenerateManager::PortDetailInfo> QSocGenerateManager::collectCombSeqFs
                                  << "bits:" << bitSelect;
                     }
 
-                    // Find port width for this output
-                    QString width = "";
-                    if (netlistData["port"] && netlistData["port"].IsMap()) {
-                        for (const auto &portEntry : netlistData["port"]) {
-                            if (portEntry.first.IsScalar()
-                                && QString::fromStdString(portEntry.first.as<std::string>())
-                                       == baseName) {
-                                if (portEntry.second.IsMap() && portEntry.second["type"]
-                                    && portEntry.second["type"].IsScalar()) {
-                                    QString portType = QString::fromStdString(
-                                        portEntry.second["type"].as<std::string>());
-                                    width = cleanTypeForWireDeclaration(portType);
-                                    break;
-                                }
-                            }
-                        }
-                    }
-
                     signalList.append(
-                        PortDetailInfo::createCombSeqFsmPort(baseName, width, "output", bitSelect));
-
-                    /* Extract input signals from expr field */
-                    if (combItem["expr"] && combItem["expr"].IsScalar()) {
-                        const QString expr = QString::fromStdString(
-                            combItem["expr"].as<std::string>());
-
-                        /* Wrap as assignment statement: assign <out> = <expr>; */
-                        QString wrappedExpr = QString("assign %1 = %2;").arg(baseName, expr);
-
-                        /* Use slang to parse and extract input signals */
-                        if (driver.parseVerilogSnippet(wrappedExpr, true)) {
-                            /* Extract all signals referenced in the expression (excluding the output) */
-                            QSet<QString> inputSignals = driver.extractSignalReferences({baseName});
-
-                            /* Add each input signal to the list */
-                            for (const QString &inputSignal : inputSignals) {
-                                /* Find port width for this input */
-                                QString inputWidth = "";
-                                if (netlistData["port"] && netlistData["port"].IsMap()) {
-                                    for (const auto &portEntry : netlistData["port"]) {
-                                        if (portEntry.first.IsScalar()
-                                            && QString::fromStdString(
-                                                   portEntry.first.as<std::string>())
-                                                   == inputSignal) {
-                                            if (portEntry.second.IsMap() && portEntry.second["type"]
-                                                && portEntry.second["type"].IsScalar()) {
-                                                QString portType = QString::fromStdString(
-                                                    portEntry.second["type"].as<std::string>());
-                                                inputWidth = cleanTypeForWireDeclaration(portType);
-                                                break;
-                                            }
-                                        }
-                                    }
+                        PortDetailInfo::createCombSeqFsmPort(
+                            baseName, portWidthMap.value(baseName), "output", bitSelect));
+
+                    /* Add input signals referenced by the expr field (excluding the output) */
+                    if (combSnippetIndex.contains(i)) {
+                        const QSlangDriver::SnippetSignalInfo &snippetInfo = snippetInfoList.at(
+                            combSnippetIndex.value(i));
+                        if (snippetInfo.valid) {
+                            for (const QString &inputSignal : snippetInfo.signalSet) {
+                                if (inputSignal == baseName) {
+                                    continue;
                                 }
-
-                                /* Add input signal with direction="input" */
                                 signalList.append(
                                     PortDetailInfo::createCombSeqFsmPort(
-                                        inputSignal, inputWidth, "input", ""));
+                                        inputSignal, portWidthMap.value(inputSignal), "input", ""));
                             }
                         } else {
                             /* Graceful degradation: log warning but continue */
                             QStaticLog::logW(
                                 Q_FUNC_INFO,
-                                "Failed to parse comb expr for input extraction: " + expr);
+                                "Failed to parse comb expr for input extraction: "
+                                    + QString::fromStdString(combItem["expr"].as<std::string>()));
                         }
                     }
                 }
@@ -2272,71 +2305,29 @@ QList<QSocGenerateManager::PortDetailInfo> QSocGenerateManager::collectCombSeqFs
                                  << "bits:" << bitSelect;
                     }
 
-                    // Find port width for this output
-                    QString width = "";
-                    if (netlistData["port"] && netlistData["port"].IsMap()) {
-                        for (const auto &portEntry : netlistData["port"]) {
-                            if (portEntry.first.IsScalar()
-                                && QString::fromStdString(portEntry.first.as<std::string>())
-                                       == baseName) {
-                                if (portEntry.second.IsMap() && portEntry.second["type"]
-                                    && portEntry.second["type"].IsScalar()) {
-                                    QString portType = QString::fromStdString(
-                                        portEntry.second["type"].as<std::string>());
-                                    width = cleanTypeForWireDeclaration(portType);
-                                    break;
-                                }
-                            }
-                        }
-                    }
-
                     signalList.append(
-                        PortDetailInfo::createCombSeqFsmPort(baseName, width, "output", bitSelect));
-
-                    /* Extract input signals from next field */
-                    if (seqItem["next"] && seqItem["next"].IsScalar()) {
-                        const QString nextExpr = QString::fromStdString(
-                            seqItem["next"].as<std::string>());
-
-                        /* Wrap as assignment statement: assign <out> = <next_expr>; */
-                        QString wrappedNextExpr = QString("assign %1 = %2;").arg(baseName, nextExpr);
-
-                        /* Use slang to parse and extract input signals */
-                        if (driver.parseVerilogSnippet(wrappedNextExpr, true)) {
-                            /* Extract all signals referenced in next expression (excluding the output reg) */
-                            QSet<QString> inputSignals = driver.extractSignalReferences({baseName});
-
-                            /* Add each input signal to the list */
-                            for (const QString &inputSignal : inputSignals) {
-                                /* Find port width for this input */
-                                QString inputWidth = "";
-                                if (netlistData["port"] && netlistData["port"].IsMap()) {
-                                    for (const auto &portEntry : netlistData["port"]) {
-                                        if (portEntry.first.IsScalar()
-                                            && QString::fromStdString(
-                                                   portEntry.first.as<std::string>())
-                                                   == inputSignal) {
-                                            if (portEntry.second.IsMap() && portEntry.second["type"]
-                                                && portEntry.second["type"].IsScalar()) {
-                                                QString portType = QString::fromStdString(
-                                                    portEntry.second["type"].as<std::string>());
-                                                inputWidth = cleanTypeForWireDeclaration(portType);
-                                                break;
-                                            }
-                                        }
-                                    }
+                        PortDetailInfo::createCombSeqFsmPort(
+                            baseName, portWidthMap.value(baseName), "output", bitSelect));
+
+                    /* Add input signals referenced by the next field (excluding the output reg) */
+                    if (seqSnippetIndex.contains(i)) {
+                        const QSlangDriver::SnippetSignalInfo &snippetInfo = snippetInfoList.at(
+                            seqSnippetIndex.value(i));
+                        if (snippetInfo.valid) {
+                            for (const QString &inputSignal : snippetInfo.signalSet) {
+                                if (inputSignal == baseName) {
+                                    continue;
                                 }
-
-                                /* Add input signal with direction="input" */
                                 signalList.append(
                                     PortDetailInfo::createCombSeqFsmPort(
-                                        inputSignal, inputWidth, "input", ""));
+                                        inputSignal, portWidthMap.value(inputSignal), "input", ""));
                             }
                         } else {
                             /* Graceful degradation: log warning but continue */
                             QStaticLog::logW(
                                 Q_FUNC_INFO,
-                                "Failed to parse seq next expr for input extraction: " + nextExpr);
+                                "Failed to parse seq next expr for input extraction: "
+                                    + QString::fromStdString(seqItem["next"].as<std::string>()));
                         }
                     }
 
@@ -2385,26 +2376,9 @@ QList<QSocGenerateManager::PortDetailInfo> QSocGenerateManager::collectCombSeqFs
                         QString baseName  = parsed.first;
                         QString bitSelect = parsed.second;
 
-                        // Find port width for this output
-                        QString width = "";
-                        if (netlistData["port"] && netlistData["port"].IsMap()) {
-                            for (const auto &portEntry : netlistData["port"]) {
-                                if (portEntry.first.IsScalar()
-                                    && QString::fromStdString(portEntry.first.as<std::string>())
-                                           == baseName) {
-                                    if (portEntry.second.IsMap() && portEntry.second["type"]
-                                        && portEntry.second["type"].IsScalar()) {
-                                        QString portType = QString::fromStdString(
-                                            portEntry.second["type"].as<std::string>());
-                                        width = cleanTypeForWireDeclaration(portType);
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-
                         signalList.append(
-                            PortDetailInfo::createTopLevelPort(baseName, width, "output", bitSelect));
+                            PortDetailInfo::createTopLevelPort(
+                                baseName, portWidthMap.value(baseName), "output", bitSelect));
                     }
                 }
             }
@@ -3,6 +3,7 @@
 #include "qsocverilogutils.h"
 #include <cmath>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QSet>
@@ -46,7 +47,8 @@ bool QSocClockPrimitive::generateClockController(const YAML::Node &clockNode, QT
 
     // Generate or update clock_cell.v file
     if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        QString            outputDir = m_parent->getProjectManager()->getOutputPath();
+        const QMutexLocker locker(&QSocGenerateManager::cellFileMutex());
         if (!generateClockCellFile(outputDir)) {
             qWarning() << "Failed to generate clock_cell.v file";
             return false;
@@ -62,14 +64,21 @@ bool QSocClockPrimitive::generateClockController(const YAML::Node &clockNode, QT
     // Close module
     out << "\nendmodule\n\n";
 
-    // Generate Typst clock diagram (failure does not affect Verilog generation)
+    // Generate Typst and SVG clock diagrams (failure does not affect Verilog generation)
     if (m_parent && m_parent->getProjectManager()) {
         QString outputDir = m_parent->getProjectManager()->getOutputPath();
         QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
                             + QStringLiteral(".typ");
-        if (!generateTypstDiagram(config, typstPath)) {
+        QString svgPath   = outputDir + QStringLiteral("/") + config.moduleName
+                          + QStringLiteral(".svg");
+        // Both outputs draw the same scene, lay it out once
+        const QSocDiagram diagram = layoutDiagram(config);
+        if (!generateTypstDiagram(diagram, typstPath)) {
             qWarning() << "Failed to generate Typst diagram (non-critical):" << typstPath;
         }
+        if (!generateSvgDiagram(diagram, svgPath)) {
+            qWarning() << "Failed to generate SVG diagram (non-critical):" << svgPath;
+        }
     }
 
     return true;
@@ -2465,7 +2474,7 @@ QString QSocClockPrimitive::generateTemplateCellDefinition(const QString &cellNa
     return result;
 }
 
-/* Typst Clock Diagram Generation */
+/* Clock Diagram Generation */
 
 QString QSocClockPrimitive::escapeTypstId(const QString &str) const
 {
@@ -2473,149 +2482,82 @@ QString QSocClockPrimitive::escapeTypstId(const QString &str) const
     return result.replace(QRegularExpression(QStringLiteral("[^A-Za-z0-9_-]+")), QStringLiteral("_"));
 }
 
-QString QSocClockPrimitive::typstHeader() const
-{
-    return QStringLiteral(
-        "#import \"@preview/circuiteria:0.2.0\": *\n"
-        "#import \"@preview/cetz:0.3.2\": draw\n"
-        "#set page(width: auto, height: auto, margin: .5cm)\n"
-        "#set text(font: \"Sarasa Mono SC\", size: 10pt)\n"
-        "#align(center)[\n"
-        "  = Clock tree\n"
-        "  #text(size: 8pt, fill: gray)[Generated by QSoC v1.0.2]\n"
-        "]\n"
-        "#v(0.5cm)\n"
-        "#circuit({\n");
-}
-
-QString QSocClockPrimitive::typstLegend() const
+void QSocClockPrimitive::layoutLegend(QSocDiagram &diagram) const
 {
-    const float y  = -1.5f;
-    const float x  = 0.0f;
-    const float w  = 1.6f; // Wider blocks to fit text
-    const float sp = 4.0f; // Spacing between legend items
-
-    QString     result;
-    QTextStream s(&result);
-    s.setRealNumberPrecision(2);
-    s.setRealNumberNotation(QTextStream::FixedNotation);
+    const float                    y    = -1.5f;
+    const float                    x    = 0.0f;
+    const float                    w    = 1.6f; // Wider blocks to fit text
+    const float                    sp   = 4.0f; // Spacing between legend items
+    const QList<QSocDiagram::Port> west = {{QStringLiteral("i")}};
+    const QList<QSocDiagram::Port> east = {{QStringLiteral("o")}};
 
-    s << "  // === Legend ===\n";
+    diagram.comment("=== Legend ===");
 
     // MUX/TEST_MUX - Orange
-    s << "  element.multiplexer(x: " << x << ", y: " << y << ", w: 0.8, h: 1.2, "
-      << "id: \"legend_mux\", fill: util.colors.orange, entries: 2)\n";
-    s << "  draw.content((" << (x + 0.4) << ", " << (y - 0.8) << "), [MUX/TEST_MUX])\n";
+    diagram.multiplexer(x, y, 0.8f, 1.2f, "legend_mux", "orange", 2);
+    diagram.text({x + 0.4f, y - 0.8f}, "MUX/TEST_MUX");
 
     // ICG - Pink
-    s << "  element.block(x: " << (x + sp) << ", y: " << (y + 0.3) << ", w: " << w << ", h: 0.8, "
-      << "id: \"legend_icg\", name: \"ICG\", fill: util.colors.pink, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp + w / 2) << ", " << (y - 0.8) << "), [ICG])\n";
+    diagram.block(x + sp, y + 0.3f, w, 0.8f, "legend_icg", "ICG", "pink", west, east);
+    diagram.text({x + sp + w / 2, y - 0.8f}, "ICG");
 
     // DIV - Yellow
-    s << "  element.block(x: " << (x + sp * 2) << ", y: " << (y + 0.3) << ", w: " << w
-      << ", h: 0.8, "
-      << "id: \"legend_div\", name: \"÷N\", fill: util.colors.yellow, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp * 2 + w / 2) << ", " << (y - 0.8) << "), [DIVIDER])\n";
+    diagram.block(x + sp * 2, y + 0.3f, w, 0.8f, "legend_div", "÷N", "yellow", west, east);
+    diagram.text({x + sp * 2 + w / 2, y - 0.8f}, "DIVIDER");
 
     // INV - Purple
-    s << "  element.block(x: " << (x + sp * 3) << ", y: " << (y + 0.3) << ", w: " << w
-      << ", h: 0.8, "
-      << "id: \"legend_inv\", name: \"INV\", fill: util.colors.purple, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp * 3 + w / 2) << ", " << (y - 0.8) << "), [INVERTER])\n";
+    diagram.block(x + sp * 3, y + 0.3f, w, 0.8f, "legend_inv", "INV", "purple", west, east);
+    diagram.text({x + sp * 3 + w / 2, y - 0.8f}, "INVERTER");
 
     // STA marker indicator - small blue triangle
     float staX = x + sp * 4;
-    s << "  draw.line((" << staX << ", " << (y + 0.3) << "), (" << (staX + 0.3) << ", " << (y + 0.3)
-      << "), (" << (staX + 0.15) << ", " << (y + 0.6) << "), close: true, "
-      << "fill: util.colors.blue, stroke: none)\n";
-    s << "  draw.content((" << (staX + 0.15) << ", " << (y - 0.8) << "), [STA marker])\n\n";
-
-    return result;
+    diagram.polygon({{staX, y + 0.3f}, {staX + 0.3f, y + 0.3f}, {staX + 0.15f, y + 0.6f}}, "blue");
+    diagram.text({staX + 0.15f, y - 0.8f}, "STA marker");
 }
 
-QString QSocClockPrimitive::typstRootStubs(const QList<ClockInput> &inputs, float &bottomY) const
+void QSocClockPrimitive::layoutRootStubs(
+    QSocDiagram &diagram, const QList<ClockInput> &inputs, float &bottomY) const
 {
     if (inputs.isEmpty()) {
         bottomY = -5.0f;
-        return QString();
+        return;
     }
 
-    QString     result;
-    QTextStream s(&result);
-    s.setRealNumberPrecision(2);
-    s.setRealNumberNotation(QTextStream::FixedNotation);
-
-    // Use Typst table for clean two-column layout
-    // End the circuit block temporarily to insert table
-    s << "})\n\n";
-
-    s << "#v(0.3cm)\n";
-    s << "#align(center)[\n";
-    s << "  #text(weight: \"bold\", size: 10pt)[Clock Sources]\n";
-    s << "]\n";
-    s << "#v(0.2cm)\n";
-
-    // Two-column table with source name and frequency
-    s << "#align(center)[\n";
-    s << "#table(\n";
-    s << "  columns: (auto, auto, auto, auto),\n";
-    s << "  align: (left, center, left, center),\n";
-    s << "  stroke: 0.5pt + gray,\n";
-    s << "  inset: 5pt,\n";
-    s << "  fill: (col, row) => if row == 0 { rgb(\"#e0e0e0\") },\n";
-    s << "  [*Source*], [*Freq*], [*Source*], [*Freq*],\n";
-
-    // Fill table rows - two sources per row
+    // Four-column table with two sources per row, source name and frequency
+    const QSocDiagram::Cell  source{QStringLiteral("Source"), QString(), true};
+    const QSocDiagram::Cell  freq{QStringLiteral("Freq"), QString(), true};
+    QList<QSocDiagram::Cell> cells{source, freq, source, freq};
+
     int numSources = inputs.size();
-    for (int i = 0; i < numSources; i += 2) {
-        const ClockInput &src1  = inputs[i];
-        QString           freq1 = src1.freq.isEmpty() ? "-" : src1.freq;
-
-        s << "  [" << src1.name << "], ";
-        s << "[" << freq1 << "], ";
-
-        if (i + 1 < numSources) {
-            const ClockInput &src2  = inputs[i + 1];
-            QString           freq2 = src2.freq.isEmpty() ? "-" : src2.freq;
-            s << "[" << src2.name << "], ";
-            s << "[" << freq2 << "],\n";
-        } else {
-            s << "[], [],\n"; // Empty cells for odd number of sources
-        }
+    for (const ClockInput &input : inputs) {
+        cells << QSocDiagram::Cell{input.name}
+              << QSocDiagram::Cell{input.freq.isEmpty() ? QStringLiteral("-") : input.freq};
+    }
+    if (numSources % 2 != 0) {
+        // Empty cells for odd number of sources
+        cells << QSocDiagram::Cell() << QSocDiagram::Cell();
     }
 
-    s << ")\n";
-    s << "]\n\n";
-
-    // Resume circuit block for targets
-    s << "#v(0.3cm)\n";
-    s << "#circuit({\n";
+    diagram.table("Clock Sources", 4, cells);
 
     // Calculate bottomY for target positioning
     int numRows = (numSources + 1) / 2; // Two sources per row
     bottomY     = -3.0f - numRows * 0.8f;
-
-    return result;
 }
 
-QString QSocClockPrimitive::typstTarget(
-    const ClockTarget &target, float x, float y, const QString &testEnable) const
+void QSocClockPrimitive::layoutTarget(
+    QSocDiagram       &diagram,
+    const ClockTarget &target,
+    float              x,
+    float              y,
+    const QString     &testEnable) const
 {
-    QString     result;
-    QTextStream s(&result);
-    s.setRealNumberPrecision(2);
-    s.setRealNumberNotation(QTextStream::FixedNotation);
-
     QString tid   = escapeTypstId(target.name);
     QString title = target.name;
     if (!target.freq.isEmpty())
         title += QStringLiteral(" (") + target.freq + QStringLiteral(")");
 
-    s << "  // ---- " << title << " ----\n";
+    diagram.comment(QStringLiteral("---- ") + title + QStringLiteral(" ----"));
 
     int numSources = target.links.size();
 
@@ -2685,23 +2627,30 @@ QString QSocClockPrimitive::typstTarget(
 
         if (linkHasComp[i]) {
             // Helper lambda to draw STA marker (small blue triangle inside top-right corner)
-            auto drawStaMarker = [&s](float bx, float by, float bw, float bh) {
+            auto drawStaMarker = [&diagram](float bx, float by, float bw, float bh) {
                 float tx = bx + bw - 0.25f;
                 float ty = by + bh - 0.30f; // Inside the block (triangle height is 0.2)
-                s << "  draw.line((" << tx << ", " << ty << "), (" << (tx + 0.2f) << ", " << ty
-                  << "), (" << (tx + 0.1f) << ", " << (ty + 0.2f)
-                  << "), close: true, fill: util.colors.blue, stroke: none)\n";
+                diagram.polygon({{tx, ty}, {tx + 0.2f, ty}, {tx + 0.1f, ty + 0.2f}}, "blue");
+            };
+
+            // Connect a link component input to the source or the previous component
+            auto connectInput = [&](const QString &compId, const QString &suffix) {
+                if (prevPort.isEmpty()) {
+                    diagram.stub(compId + QStringLiteral("-port-in"), "west", link.source);
+                } else {
+                    diagram.wire(
+                        QString("w_%1_l%2_to_%3").arg(tid).arg(i).arg(suffix),
+                        prevPort,
+                        compId + QStringLiteral("-port-in"));
+                }
+                prevPort = compId + QStringLiteral("-port-out");
             };
 
             // Draw ICG if configured
             if (link.icg.configured) {
                 QString icgId = escapeTypstId(
                     tid + QStringLiteral("_L") + QString::number(i) + QStringLiteral("_ICG"));
-                s << "  element.block(\n";
-                s << "    x: " << compX << ", y: " << compY << ", w: 1.0, h: 0.9,\n";
-                s << "    id: \"" << icgId << "\", name: \"ICG\", fill: util.colors.pink,\n";
-                s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-                s << "  )\n";
+                diagram.block(compX, compY, 1.0f, 0.9f, icgId, "ICG", "pink");
 
                 // STA marker if sta_guide configured
                 if (!link.icg.sta_guide.cell.isEmpty()) {
@@ -2710,19 +2659,10 @@ QString QSocClockPrimitive::typstTarget(
 
                 // Show enable signal above ICG
                 if (!link.icg.enable.isEmpty()) {
-                    s << "  draw.content((" << (compX + 0.5f) << ", " << (compY + 0.9f + 0.2f)
-                      << "), text(size: 7pt)[" << link.icg.enable << "])\n";
+                    diagram.text({compX + 0.5f, compY + 0.9f + 0.2f}, link.icg.enable, 7);
                 }
 
-                if (prevPort.isEmpty()) {
-                    s << "  wire.stub(\"" << icgId << "-port-in\", \"west\", name: \""
-                      << link.source << "\")\n";
-                } else {
-                    s << "  wire.wire(\"w_" << tid << "_l" << i << "_to_icg\", (\n";
-                    s << "    \"" << prevPort << "\", \"" << icgId << "-port-in\"\n";
-                    s << "  ))\n";
-                }
-                prevPort = icgId + QStringLiteral("-port-out");
+                connectInput(icgId, "icg");
                 compX += 1.3f;
             }
 
@@ -2730,11 +2670,7 @@ QString QSocClockPrimitive::typstTarget(
             if (link.div.configured) {
                 QString divId = escapeTypstId(
                     tid + QStringLiteral("_L") + QString::number(i) + QStringLiteral("_DIV"));
-                s << "  element.block(\n";
-                s << "    x: " << compX << ", y: " << compY << ", w: 1.0, h: 0.9,\n";
-                s << "    id: \"" << divId << "\", name: \"÷N\", fill: util.colors.yellow,\n";
-                s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-                s << "  )\n";
+                diagram.block(compX, compY, 1.0f, 0.9f, divId, "÷N", "yellow");
 
                 // STA marker if sta_guide configured
                 if (!link.div.sta_guide.cell.isEmpty()) {
@@ -2744,22 +2680,16 @@ QString QSocClockPrimitive::typstTarget(
                 // Show range annotation above DIV (offset 0.5 to avoid overlap with block text)
                 if (link.div.width > 0) {
                     int maxVal = (1 << link.div.width) - 1;
-                    s << "  draw.content((" << (compX + 0.5f) << ", " << (compY + 0.9f + 0.5f)
-                      << "), text(size: 7pt)[N∈\\[0," << maxVal << "\\]])\n";
+                    diagram.text(
+                        {compX + 0.5f, compY + 0.9f + 0.5f}, QString("N∈[0,%1]").arg(maxVal), 7);
                 } else {
-                    s << "  draw.content((" << (compX + 0.5f) << ", " << (compY + 0.9f + 0.5f)
-                      << "), text(size: 7pt)[N=" << link.div.default_value << "])\n";
+                    diagram.text(
+                        {compX + 0.5f, compY + 0.9f + 0.5f},
+                        QString("N=%1").arg(link.div.default_value),
+                        7);
                 }
 
-                if (prevPort.isEmpty()) {
-                    s << "  wire.stub(\"" << divId << "-port-in\", \"west\", name: \""
-                      << link.source << "\")\n";
-                } else {
-                    s << "  wire.wire(\"w_" << tid << "_l" << i << "_to_div\", (\n";
-                    s << "    \"" << prevPort << "\", \"" << divId << "-port-in\"\n";
-                    s << "  ))\n";
-                }
-                prevPort = divId + QStringLiteral("-port-out");
+                connectInput(divId, "div");
                 compX += 1.3f;
             }
 
@@ -2767,26 +2697,14 @@ QString QSocClockPrimitive::typstTarget(
             if (link.inv.configured) {
                 QString invId = escapeTypstId(
                     tid + QStringLiteral("_L") + QString::number(i) + QStringLiteral("_INV"));
-                s << "  element.block(\n";
-                s << "    x: " << compX << ", y: " << compY << ", w: 1.0, h: 0.9,\n";
-                s << "    id: \"" << invId << "\", name: \"INV\", fill: util.colors.purple,\n";
-                s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-                s << "  )\n";
+                diagram.block(compX, compY, 1.0f, 0.9f, invId, "INV", "purple");
 
                 // STA marker if sta_guide configured
                 if (!link.inv.sta_guide.cell.isEmpty()) {
                     drawStaMarker(compX, compY, 1.0f, 0.9f);
                 }
 
-                if (prevPort.isEmpty()) {
-                    s << "  wire.stub(\"" << invId << "-port-in\", \"west\", name: \""
-                      << link.source << "\")\n";
-                } else {
-                    s << "  wire.wire(\"w_" << tid << "_l" << i << "_to_inv\", (\n";
-                    s << "    \"" << prevPort << "\", \"" << invId << "-port-in\"\n";
-                    s << "  ))\n";
-                }
-                prevPort = invId + QStringLiteral("-port-out");
+                connectInput(invId, "inv");
             }
 
             muxInputPorts[i] = prevPort;
@@ -2800,25 +2718,35 @@ QString QSocClockPrimitive::typstTarget(
     bool    needMux = (numSources > 1) || (!target.select.isEmpty() && numSources > 0);
     QString muxOutputPort;
 
+    // Solid triangle input marker with a tiny invisible anchor at its tip
+    auto drawInputMarker = [&](const QString &label) -> QString {
+        QString sid = escapeTypstId(tid + QStringLiteral("_SRC"));
+        // Right-pointing triangle (42° tip angle), sized to match output arrow
+        float triWidth = 0.38f;
+        float triHalfH = 0.16f;
+        float triBaseX = muxX;
+        float triTipX  = triBaseX + triWidth;
+        float triY     = muxCenterY;
+        diagram.polygon(
+            {{triBaseX, triY + triHalfH}, {triTipX, triY}, {triBaseX, triY - triHalfH}}, "black");
+        diagram.text({triBaseX - 0.1f, triY}, label, 8, QSocDiagram::Align::East);
+        diagram.anchor(sid, {triTipX, triY});
+        return sid + QStringLiteral("-port-out");
+    };
+
     if (needMux) {
         QString muxId   = escapeTypstId(tid + QStringLiteral("_MUX"));
         int     entries = qMax(2, numSources);
-        s << "  element.multiplexer(\n";
-        s << "    x: " << muxX << ", y: " << muxBottomY << ", w: 1.0, h: " << muxHeight << ",\n";
-        s << "    id: \"" << muxId << "\", fill: util.colors.orange, entries: " << entries << "\n";
-        s << "  )\n";
+        diagram.multiplexer(muxX, muxBottomY, 1.0f, muxHeight, muxId, "orange", entries);
 
         if (!target.select.isEmpty())
-            s << "  draw.content((" << (muxX + 0.5f) << ", " << (muxBottomY + muxHeight + 0.3f)
-              << "), text(size: 8pt)[" << target.select << "])\n";
+            diagram.text({muxX + 0.5f, muxBottomY + muxHeight + 0.3f}, target.select, 8);
 
         // STA marker if mux.sta_guide configured (inside top-right corner)
         if (!target.mux.sta_guide.cell.isEmpty()) {
             float mtx = muxX + 1.0f - 0.35f;            // Right edge - margin
             float mty = muxBottomY + muxHeight - 0.35f; // Top edge - margin
-            s << "  draw.line((" << mtx << ", " << mty << "), (" << (mtx + 0.25f) << ", " << mty
-              << "), (" << (mtx + 0.125f) << ", " << (mty + 0.25f)
-              << "), close: true, fill: util.colors.blue, stroke: none)\n";
+            diagram.polygon({{mtx, mty}, {mtx + 0.25f, mty}, {mtx + 0.125f, mty + 0.25f}}, "blue");
         }
 
         // Connect inputs to MUX
@@ -2826,13 +2754,11 @@ QString QSocClockPrimitive::typstTarget(
             QString muxInPort = muxId + QStringLiteral("-port-in") + QString::number(i);
             if (muxInputPorts[i].isEmpty()) {
                 // Direct connection - draw stub
-                s << "  wire.stub(\"" << muxInPort << "\", \"west\", name: \""
-                  << target.links[i].source << "\")\n";
+                diagram.stub(muxInPort, "west", target.links[i].source);
             } else {
                 // Connect from link component output
-                s << "  wire.wire(\"w_" << tid << "_l" << i << "_to_mux\", (\n";
-                s << "    \"" << muxInputPorts[i] << "\", \"" << muxInPort << "\"\n";
-                s << "  ))\n";
+                diagram.wire(
+                    QString("w_%1_l%2_to_mux").arg(tid).arg(i), muxInputPorts[i], muxInPort);
             }
         }
 
@@ -2840,46 +2766,13 @@ QString QSocClockPrimitive::typstTarget(
     } else if (numSources > 0) {
         // Single source - use solid triangle input marker aligned with target components
         if (muxInputPorts[0].isEmpty()) {
-            QString sid = escapeTypstId(tid + QStringLiteral("_SRC"));
-            // Right-pointing triangle (42° tip angle), sized to match output arrow
-            float triWidth = 0.38f;
-            float triHalfH = 0.16f;
-            float triBaseX = muxX;
-            float triTipX  = triBaseX + triWidth;
-            float triY     = muxCenterY;
-            s << "  draw.line((" << triBaseX << ", " << (triY + triHalfH) << "), (" << triTipX
-              << ", " << triY << "), (" << triBaseX << ", " << (triY - triHalfH)
-              << "), close: true, fill: black, stroke: none)\n";
-            s << "  draw.content((" << (triBaseX - 0.1f) << ", " << triY
-              << "), anchor: \"east\", text(size: 8pt)[" << target.links[0].source << "])\n";
-            // Tiny invisible anchor: position so east port aligns with triangle tip
-            float anchorS = 0.01f;
-            s << "  element.block(x: " << (triTipX - anchorS) << ", y: " << (triY - anchorS / 2)
-              << ", w: " << anchorS << ", h: " << anchorS << ", id: \"" << sid
-              << "\", name: \"\", stroke: none, fill: none, ports: (east: ((id: \"out\"),)))\n";
-            muxOutputPort = sid + QStringLiteral("-port-out");
+            muxOutputPort = drawInputMarker(target.links[0].source);
         } else {
             muxOutputPort = muxInputPorts[0];
         }
     } else {
         // No connection - use solid triangle input marker with "NC" label
-        QString sid      = escapeTypstId(tid + QStringLiteral("_SRC"));
-        float   triWidth = 0.38f;
-        float   triHalfH = 0.16f;
-        float   triBaseX = muxX;
-        float   triTipX  = triBaseX + triWidth;
-        float   triY     = muxCenterY;
-        s << "  draw.line((" << triBaseX << ", " << (triY + triHalfH) << "), (" << triTipX << ", "
-          << triY << "), (" << triBaseX << ", " << (triY - triHalfH)
-          << "), close: true, fill: black, stroke: none)\n";
-        s << "  draw.content((" << (triBaseX - 0.1f) << ", " << triY
-          << "), anchor: \"east\", text(size: 8pt)[NC])\n";
-        // Tiny invisible anchor: position so east port aligns with triangle tip
-        float anchorS = 0.01f;
-        s << "  element.block(x: " << (triTipX - anchorS) << ", y: " << (triY - anchorS / 2)
-          << ", w: " << anchorS << ", h: " << anchorS << ", id: \"" << sid
-          << "\", name: \"\", stroke: none, fill: none, ports: (east: ((id: \"out\"),)))\n";
-        muxOutputPort = sid + QStringLiteral("-port-out");
+        muxOutputPort = drawInputMarker(QStringLiteral("NC"));
     }
 
     QString prev = muxOutputPort;
@@ -2893,23 +2786,16 @@ QString QSocClockPrimitive::typstTarget(
     const float targetCompY = muxCenterY - targetCompH / 2; // Port aligns at muxCenterY
 
     // Helper lambda for STA marker on target-level components (inside top-right corner)
-    auto drawStaMarkerTarget = [&s](float bx, float by, float bw, float bh) {
+    auto drawStaMarkerTarget = [&diagram](float bx, float by, float bw, float bh) {
         float tx = bx + bw - 0.35f;
         float ty = by + bh - 0.35f; // Inside the block (triangle height is 0.25)
-        s << "  draw.line((" << tx << ", " << ty << "), (" << (tx + 0.25f) << ", " << ty << "), ("
-          << (tx + 0.125f) << ", " << (ty + 0.25f)
-          << "), close: true, fill: util.colors.blue, stroke: none)\n";
+        diagram.polygon({{tx, ty}, {tx + 0.25f, ty}, {tx + 0.125f, ty + 0.25f}}, "blue");
     };
 
     // Target-level ICG
     if (hasTargetIcg) {
         QString iid = escapeTypstId(tid + QStringLiteral("_ICG"));
-        s << "  element.block(\n";
-        s << "    x: " << currentX << ", y: " << targetCompY << ", w: 1.2, h: " << targetCompH
-          << ",\n";
-        s << "    id: \"" << iid << "\", name: \"ICG\", fill: util.colors.pink,\n";
-        s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-        s << "  )\n";
+        diagram.block(currentX, targetCompY, 1.2f, targetCompH, iid, "ICG", "pink");
 
         // STA marker if sta_guide configured
         if (!target.icg.sta_guide.cell.isEmpty()) {
@@ -2918,14 +2804,14 @@ QString QSocClockPrimitive::typstTarget(
 
         // Show enable signal above ICG
         if (!target.icg.enable.isEmpty()) {
-            s << "  draw.content((" << (currentX + 0.6f) << ", "
-              << (targetCompY + targetCompH + 0.2f) << "), text(size: 7pt)[" << target.icg.enable
-              << "])\n";
+            diagram.text(
+                {currentX + 0.6f, targetCompY + targetCompH + 0.2f}, target.icg.enable, 7);
         }
 
-        s << "  wire.wire(\"w_" << tid << "_to_icg\", (\n";
-        s << "    \"" << prev << "\", \"" << iid << "-port-in\"\n";
-        s << "  ))\n";
+        diagram.wire(
+            QStringLiteral("w_") + tid + QStringLiteral("_to_icg"),
+            prev,
+            iid + QStringLiteral("-port-in"));
         prev = iid + QStringLiteral("-port-out");
         currentX += 2.5f;
     }
@@ -2933,12 +2819,7 @@ QString QSocClockPrimitive::typstTarget(
     // Target-level DIV
     if (hasTargetDiv) {
         QString did = escapeTypstId(tid + QStringLiteral("_DIV"));
-        s << "  element.block(\n";
-        s << "    x: " << currentX << ", y: " << targetCompY << ", w: 1.2, h: " << targetCompH
-          << ",\n";
-        s << "    id: \"" << did << "\", name: \"÷N\", fill: util.colors.yellow,\n";
-        s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-        s << "  )\n";
+        diagram.block(currentX, targetCompY, 1.2f, targetCompH, did, "÷N", "yellow");
 
         // STA marker if sta_guide configured
         if (!target.div.sta_guide.cell.isEmpty()) {
@@ -2948,18 +2829,21 @@ QString QSocClockPrimitive::typstTarget(
         // Show range annotation above DIV (offset 0.5 to avoid overlap with block text)
         if (target.div.width > 0) {
             int maxVal = (1 << target.div.width) - 1;
-            s << "  draw.content((" << (currentX + 0.6f) << ", "
-              << (targetCompY + targetCompH + 0.5f) << "), text(size: 7pt)[N∈\\[0," << maxVal
-              << "\\]])\n";
+            diagram.text(
+                {currentX + 0.6f, targetCompY + targetCompH + 0.5f},
+                QString("N∈[0,%1]").arg(maxVal),
+                7);
         } else {
-            s << "  draw.content((" << (currentX + 0.6f) << ", "
-              << (targetCompY + targetCompH + 0.5f)
-              << "), text(size: 7pt)[N=" << target.div.default_value << "])\n";
+            diagram.text(
+                {currentX + 0.6f, targetCompY + targetCompH + 0.5f},
+                QString("N=%1").arg(target.div.default_value),
+                7);
         }
 
-        s << "  wire.wire(\"w_" << tid << "_to_div\", (\n";
-        s << "    \"" << prev << "\", \"" << did << "-port-in\"\n";
-        s << "  ))\n";
+        diagram.wire(
+            QStringLiteral("w_") + tid + QStringLiteral("_to_div"),
+            prev,
+            did + QStringLiteral("-port-in"));
         prev = did + QStringLiteral("-port-out");
         currentX += 2.5f;
     }
@@ -2967,21 +2851,17 @@ QString QSocClockPrimitive::typstTarget(
     // Target-level INV
     if (hasTargetInv) {
         QString invId = escapeTypstId(tid + QStringLiteral("_INV"));
-        s << "  element.block(\n";
-        s << "    x: " << currentX << ", y: " << targetCompY << ", w: 1.2, h: " << targetCompH
-          << ",\n";
-        s << "    id: \"" << invId << "\", name: \"INV\", fill: util.colors.purple,\n";
-        s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-        s << "  )\n";
+        diagram.block(currentX, targetCompY, 1.2f, targetCompH, invId, "INV", "purple");
 
         // STA marker if sta_guide configured
         if (!target.inv.sta_guide.cell.isEmpty()) {
             drawStaMarkerTarget(currentX, targetCompY, 1.2f, targetCompH);
         }
 
-        s << "  wire.wire(\"w_" << tid << "_to_inv\", (\n";
-        s << "    \"" << prev << "\", \"" << invId << "-port-in\"\n";
-        s << "  ))\n";
+        diagram.wire(
+            QStringLiteral("w_") + tid + QStringLiteral("_to_inv"),
+            prev,
+            invId + QStringLiteral("-port-in"));
         prev = invId + QStringLiteral("-port-out");
         currentX += 2.5f;
     }
@@ -2997,57 +2877,39 @@ QString QSocClockPrimitive::typstTarget(
         const float tmH  = 2.0f;
         const float tmY  = muxCenterY - 3.0f * tmH / 4.0f; // port-in0 aligns at muxCenterY
         finalOutY        = tmY + tmH / 2.0f;               // test MUX output at its center
-        s << "  element.multiplexer(\n";
-        s << "    x: " << currentX << ", y: " << tmY << ", w: 1.0, h: " << tmH << ",\n";
-        s << "    id: \"" << tmId << "\", fill: util.colors.orange, entries: 2\n";
-        s << "  )\n";
-        s << "  wire.stub(\"" << tmId << ".north\", \"north\", name: \"" << te << "\")\n";
-        s << "  wire.stub(\"" << tmId << "-port-in1\", \"west\", name: \"" << target.test_clock
-          << "\")\n";
-        s << "  wire.wire(\"w_" << tid << "_to_tm\", (\n";
-        s << "    \"" << prev << "\", \"" << tmId << "-port-in0\"\n";
-        s << "  ))\n";
+        diagram.multiplexer(currentX, tmY, 1.0f, tmH, tmId, "orange", 2);
+        diagram.stub(tmId + QStringLiteral(".north"), "north", te);
+        diagram.stub(tmId + QStringLiteral("-port-in1"), "west", target.test_clock);
+        diagram.wire(
+            QStringLiteral("w_") + tid + QStringLiteral("_to_tm"),
+            prev,
+            tmId + QStringLiteral("-port-in0"));
         prev = tmId + QStringLiteral("-port-out");
         currentX += 2.5f;
     }
 
     // Step 4: Final output - arrow with label (align with last component output)
     float arrowEndX = currentX + 2.5f;
-    s << "  draw.line(\"" << prev << "\", (" << arrowEndX << ", " << finalOutY
-      << "), mark: (end: \">\", fill: black))\n";
-    s << "  draw.content((" << (arrowEndX + 0.3f) << ", " << finalOutY << "), anchor: \"west\", ["
-      << target.name << "])\n\n";
-
-    return result;
+    diagram.line(prev, {arrowEndX, finalOutY}, true);
+    diagram.text({arrowEndX + 0.3f, finalOutY}, target.name, 0, QSocDiagram::Align::West);
 }
 
-bool QSocClockPrimitive::generateTypstDiagram(
-    const ClockControllerConfig &config, const QString &outputPath)
+QSocDiagram QSocClockPrimitive::layoutDiagram(const ClockControllerConfig &config) const
 {
-    QFile file(outputPath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open Typst output file:" << outputPath;
-        return false;
-    }
-
-    QTextStream out(&file);
-    out.setEncoding(QStringConverter::Utf8);
-
-    // Generate header
-    out << typstHeader();
+    QSocDiagram diagram(QStringLiteral("Clock tree"));
 
     // Generate legend
-    out << typstLegend();
+    layoutLegend(diagram);
 
     // Generate root clock stubs
     float bottomY = -5.0f;
-    out << typstRootStubs(config.inputs, bottomY);
+    layoutRootStubs(diagram, config.inputs, bottomY);
 
     // Generate targets (vertical stacking with dynamic spacing)
     // Key insight: MUX extends UPWARD from y to y+muxHeight
     // So we position MUX TOP at currentY by setting y = currentY - muxHeight
     const float x0          = 0.0f;
-    const float portSpacing = 1.5f; // Match typstTarget portSpacing
+    const float portSpacing = 1.5f; // Match layoutTarget portSpacing
     const float extraMargin = 2.5f; // Extra margin between targets
 
     float currentY = bottomY - 3.0f;
@@ -3056,22 +2918,42 @@ bool QSocClockPrimitive::generateTypstDiagram(
         const ClockTarget &target     = config.targets[idx];
         int                numSources = target.links.size();
 
-        // Calculate target height - same as typstTarget
+        // Calculate target height - same as layoutTarget
         float muxHeight = qMax(2.0f, portSpacing * numSources);
 
         // Position target so MUX TOP is at currentY
-        // typstTarget uses y as MUX bottom, so y = currentY - muxHeight
+        // layoutTarget uses y as MUX bottom, so y = currentY - muxHeight
         float targetY = currentY - muxHeight;
-        out << typstTarget(target, x0, targetY, config.testEnable);
+        layoutTarget(diagram, target, x0, targetY, config.testEnable);
 
         // Move to next target position (MUX bottom is at targetY)
         currentY = targetY - extraMargin;
     }
 
-    // Close circuit
-    out << "})\n";
+    return diagram;
+}
+
+bool QSocClockPrimitive::generateTypstDiagram(const QSocDiagram &diagram, const QString &outputPath)
+{
+    if (!diagram.writeTypst(outputPath)) {
+        qWarning() << "Failed to open Typst output file:" << outputPath;
+        return false;
+    }
 
-    file.close();
     qInfo() << "Generated Typst clock diagram:" << outputPath;
     return true;
 }
+
+bool QSocClockPrimitive::generateSvgDiagram(const QSocDiagram &diagram, const QString &outputPath)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!diagram.writeSvg(outputPath)) {
+        qWarning() << "Failed to open SVG output file:" << outputPath;
+        return false;
+    }
+
+    qInfo() << "Generated SVG clock diagram:" << outputPath << timer.elapsed() << "ms";
+    return true;
+}
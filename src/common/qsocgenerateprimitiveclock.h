@@ -1,6 +1,8 @@
 #ifndef QSOCGENERATEPRIMITIVECLOCK_H
 #define QSOCGENERATEPRIMITIVECLOCK_H
 
+#include "common/qsocdiagram.h"
+
 #include <yaml-cpp/yaml.h>
 #include <QDir>
 #include <QFile>
@@ -192,12 +194,23 @@ public:
     void setForceOverwrite(bool force);
 
     /**
-     * @brief Generate Typst clock tree diagram from configuration
-     * @param config Clock controller configuration
+     * @brief Write Typst clock tree diagram
+     * @param diagram Diagram laid out by layoutDiagram()
      * @param outputPath Output path for .typ file
      * @return true if generation successful, false otherwise
      */
-    bool generateTypstDiagram(const ClockControllerConfig &config, const QString &outputPath);
+    bool generateTypstDiagram(const QSocDiagram &diagram, const QString &outputPath);
+
+    /**
+     * @brief Render SVG clock tree diagram
+     * @details Same diagram as the Typst output, rendered in process without
+     *          an external Typst compiler. The render time is logged, the
+     *          layout is not part of it.
+     * @param diagram Diagram laid out by layoutDiagram()
+     * @param outputPath Output path for .svg file
+     * @return true if generation successful, false otherwise
+     */
+    bool generateSvgDiagram(const QSocDiagram &diagram, const QString &outputPath);
 
 private:
     /**
@@ -303,12 +316,19 @@ private:
      */
     QString getInstanceName(const QString &targetName, const QString &sourceName, int linkIndex);
 
-    // Typst generation helper functions
-    QString typstHeader() const;
-    QString typstLegend() const;
-    QString typstRootStubs(const QList<ClockInput> &inputs, float &bottomY) const;
-    QString typstTarget(const ClockTarget &target, float x, float y, const QString &testEnable) const;
-    QString escapeTypstId(const QString &str) const;
+    // Diagram layout helper functions, shared by the Typst and SVG output
+    QSocDiagram layoutDiagram(const ClockControllerConfig &config) const;
+    QString     escapeTypstId(const QString &str) const;
+
+    void layoutLegend(QSocDiagram &diagram) const;
+    void layoutRootStubs(
+        QSocDiagram &diagram, const QList<ClockInput> &inputs, float &bottomY) const;
+    void layoutTarget(
+        QSocDiagram       &diagram,
+        const ClockTarget &target,
+        float              x,
+        float              y,
+        const QString     &testEnable) const;
 
 private:
     QSocGenerateManager *m_parent;                 // Parent manager for accessing utilities
@@ -6,6 +6,7 @@
 #include "qsocverilogutils.h"
 #include <cmath>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QSet>
@@ -36,7 +37,8 @@ bool QSocPowerPrimitive::generatePowerController(const YAML::Node &powerNode, QT
 
     // Generate or update power_cell.v file
     if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        QString            outputDir = m_parent->getProjectManager()->getOutputPath();
+        const QMutexLocker locker(&QSocGenerateManager::cellFileMutex());
         if (!generatePowerCellFile(outputDir)) {
             qWarning() << "Failed to generate power_cell.v file";
             return false;
@@ -52,14 +54,21 @@ bool QSocPowerPrimitive::generatePowerController(const YAML::Node &powerNode, QT
     // Close module
     out << "\nendmodule\n\n";
 
-    // Generate Typst power diagram (failure does not affect Verilog generation)
+    // Generate Typst and SVG power diagrams (failure does not affect Verilog generation)
     if (m_parent && m_parent->getProjectManager()) {
         QString outputDir = m_parent->getProjectManager()->getOutputPath();
         QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
                             + QStringLiteral(".typ");
-        if (!generateTypstDiagram(config, typstPath)) {
+        QString svgPath   = outputDir + QStringLiteral("/") + config.moduleName
+                          + QStringLiteral(".svg");
+        // Both outputs draw the same scene, lay it out once
+        const QSocDiagram diagram = layoutDiagram(config);
+        if (!generateTypstDiagram(diagram, typstPath)) {
             qWarning() << "Failed to generate Typst diagram (non-critical):" << typstPath;
         }
+        if (!generateSvgDiagram(diagram, svgPath)) {
+            qWarning() << "Failed to generate SVG diagram (non-critical):" << svgPath;
+        }
     }
 
     return true;
@@ -900,7 +909,7 @@ QString QSocPowerPrimitive::getSoftDependencySignal(const PowerDomain &domain)
     return softDeps.join(" & ");
 }
 
-/* Typst Power Diagram Generation */
+/* Power Diagram Generation */
 
 QString QSocPowerPrimitive::escapeTypstId(const QString &str) const
 {
@@ -916,71 +925,37 @@ QString QSocPowerPrimitive::escapeTypstId(const QString &str) const
     return result;
 }
 
-QString QSocPowerPrimitive::typstHeader() const
-{
-    return QStringLiteral(
-        "#import \"@preview/circuiteria:0.2.0\": *\n"
-        "#import \"@preview/cetz:0.3.2\": draw\n"
-        "#set page(width: auto, height: auto, margin: .5cm)\n"
-        "#set text(font: \"Sarasa Mono SC\", size: 10pt)\n"
-        "#align(center)[\n"
-        "  = Power tree\n"
-        "  #text(size: 8pt, fill: gray)[Generated by QSoC v1.0.2]\n"
-        "]\n"
-        "#v(0.5cm)\n"
-        "#circuit({\n");
-}
-
-QString QSocPowerPrimitive::typstLegend() const
+void QSocPowerPrimitive::layoutLegend(QSocDiagram &diagram) const
 {
-    const float y  = -1.5f;
-    const float x  = 0.0f;
-    const float w  = 1.6f; // Wider blocks to fit text
-    const float sp = 4.0f; // Increased spacing for wider blocks
-    QTextStream s;
-    QString     result;
+    const float                    y    = -1.5f;
+    const float                    x    = 0.0f;
+    const float                    w    = 1.6f; // Wider blocks to fit text
+    const float                    sp   = 4.0f; // Increased spacing for wider blocks
+    const QList<QSocDiagram::Port> west = {{QStringLiteral("i")}};
+    const QList<QSocDiagram::Port> east = {{QStringLiteral("o")}};
 
-    s.setString(&result);
-
-    s << "  // === Legend ===\n";
+    diagram.comment("=== Legend ===");
 
     // AO Domain - Gray
-    s << "  element.block(x: " << x << ", y: " << (y + 0.3f) << ", w: " << w << ", h: 0.8, "
-      << "id: \"legend_ao\", name: \"AO\", fill: gray, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + w / 2) << ", " << (y - 0.8f) << "), [AO])\n";
+    diagram.block(x, y + 0.3f, w, 0.8f, "legend_ao", "AO", "gray", west, east);
+    diagram.text({x + w / 2, y - 0.8f}, "AO");
 
     // Root Domain - Green
-    s << "  element.block(x: " << (x + sp) << ", y: " << (y + 0.3f) << ", w: " << w << ", h: 0.8, "
-      << "id: \"legend_root\", name: \"ROOT\", fill: util.colors.green, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp + w / 2) << ", " << (y - 0.8f) << "), [ROOT])\n";
+    diagram.block(x + sp, y + 0.3f, w, 0.8f, "legend_root", "ROOT", "green", west, east);
+    diagram.text({x + sp + w / 2, y - 0.8f}, "ROOT");
 
     // Normal Domain - Blue
-    s << "  element.block(x: " << (x + sp * 2) << ", y: " << (y + 0.3f) << ", w: " << w
-      << ", h: 0.8, "
-      << "id: \"legend_normal\", name: \"NORM\", fill: util.colors.blue, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp * 2 + w / 2) << ", " << (y - 0.8f) << "), [NORMAL])\n";
+    diagram.block(x + sp * 2, y + 0.3f, w, 0.8f, "legend_normal", "NORM", "blue", west, east);
+    diagram.text({x + sp * 2 + w / 2, y - 0.8f}, "NORMAL");
 
     // FSM - Orange
-    s << "  element.block(x: " << (x + sp * 3) << ", y: " << (y + 0.3f) << ", w: " << w
-      << ", h: 0.8, "
-      << "id: \"legend_fsm\", name: \"FSM\", fill: util.colors.orange, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp * 3 + w / 2) << ", " << (y - 0.8f) << "), [FSM])\n";
-
-    s << "\n";
-
-    return result;
+    diagram.block(x + sp * 3, y + 0.3f, w, 0.8f, "legend_fsm", "FSM", "orange", west, east);
+    diagram.text({x + sp * 3 + w / 2, y - 0.8f}, "FSM");
 }
 
-QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, float y) const
+void QSocPowerPrimitive::layoutDomain(
+    QSocDiagram &diagram, const PowerDomain &domain, float x, float y) const
 {
-    QTextStream s;
-    QString     result;
-    s.setString(&result);
-
     const QString domainName = domain.name;
     const QString did        = escapeTypstId(domainName);
 
@@ -1006,11 +981,11 @@ QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, floa
         }
         if (hasActualDeps) {
             domainType  = "normal";
-            domainColor = "util.colors.blue";
+            domainColor = "blue";
         } else {
             // Empty dependency list means root domain
             domainType  = "root";
-            domainColor = "util.colors.green";
+            domainColor = "green";
         }
     }
 
@@ -1033,44 +1008,30 @@ QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, floa
         }
     }
 
-    s << "  // ---- " << domainName << " [" << domainType << "] ----\n";
+    diagram.comment(QString("---- %1 [%2] ----").arg(domainName, domainType));
 
     // Calculate domain block height based on number of dependencies
     const int   numDeps   = dependsList.size();
     const float domHeight = (numDeps > 0) ? qMax(1.5f, 0.6f * numDeps) : 1.2f;
 
     // Generate domain block
-    s << "  element.block(\n";
-    s << "    x: " << (gx + 0.0f) << ", y: " << (gy + 0.3f) << ", w: 1.8, h: " << domHeight
-      << ",\n";
-    s << "    id: \"" << did << "_DOM\", name: \"" << typeLabel << "\", fill: " << domainColor
-      << ",\n";
-
+    QList<QSocDiagram::Port> domPorts{{QStringLiteral("in")}};
     if (numDeps > 0) {
-        s << "    ports: (west: (";
+        domPorts.clear();
         for (int i = 0; i < numDeps; ++i) {
-            if (i > 0)
-                s << ", ";
-            s << "(id: \"in" << i << "\")";
+            domPorts << QSocDiagram::Port{QStringLiteral("in") + QString::number(i)};
         }
-        s << ",), east: ((id: \"out\"),))\n";
-    } else {
-        s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
     }
-    s << "  )\n";
+    diagram.block(
+        gx + 0.0f, gy + 0.3f, 1.8f, domHeight, did + "_DOM", typeLabel, domainColor, domPorts);
 
     // Add domain name and voltage labels
-    s << "  draw.content((" << (gx + 0.9f) << ", " << (gy - 0.3f) << "), text(size: 8pt)["
-      << domainName << "])\n";
-    s << "  draw.content((" << (gx + 0.9f) << ", " << (gy - 0.7f) << "), text(size: 6pt)["
-      << domain.v_mv << "mV])\n";
+    diagram.text({gx + 0.9f, gy - 0.3f}, domainName, 8);
+    diagram.text({gx + 0.9f, gy - 0.7f}, QString("%1mV").arg(domain.v_mv), 6);
 
     // Add dependency input stubs
-    if (numDeps > 0) {
-        for (int i = 0; i < dependsList.size(); ++i) {
-            s << "  wire.stub(\"" << did << "_DOM-port-in" << i << "\", \"west\", name: \""
-              << dependsList[i] << "\")\n";
-        }
+    for (int i = 0; i < dependsList.size(); ++i) {
+        diagram.stub(QString("%1_DOM-port-in%2").arg(did).arg(i), "west", dependsList[i]);
     }
 
     QString prevAnchor = QString("%1_DOM-port-out").arg(did);
@@ -1079,24 +1040,16 @@ QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, floa
     const float fsmY = gy + domHeight / 2.0f - 0.6f;
 
     // Emit FSM block
-    s << "  element.block(\n";
-    s << "    x: " << (gx + 3.0f) << ", y: " << (fsmY + 0.3f) << ", w: 1.5, h: 1.2,\n";
-    s << "    id: \"" << did << "_FSM\", name: \"FSM\", fill: util.colors.orange,\n";
-    s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-    s << "  )\n";
+    diagram.block(gx + 3.0f, fsmY + 0.3f, 1.5f, 1.2f, did + "_FSM", "FSM", "orange");
 
     // Add FSM timing parameters
-    s << "  draw.content((" << (gx + 3.75f) << ", " << (fsmY - 0.3f)
-      << "), text(size: 6pt)[wait:" << domain.wait_dep << "])\n";
-    s << "  draw.content((" << (gx + 3.75f) << ", " << (fsmY - 0.6f)
-      << "), text(size: 6pt)[on:" << domain.settle_on << "])\n";
-    s << "  draw.content((" << (gx + 3.75f) << ", " << (fsmY - 0.9f)
-      << "), text(size: 6pt)[off:" << domain.settle_off << "])\n";
+    diagram.text({gx + 3.75f, fsmY - 0.3f}, QString("wait:%1").arg(domain.wait_dep), 6);
+    diagram.text({gx + 3.75f, fsmY - 0.6f}, QString("on:%1").arg(domain.settle_on), 6);
+    diagram.text({gx + 3.75f, fsmY - 0.9f}, QString("off:%1").arg(domain.settle_off), 6);
 
     // Wire from domain to FSM
-    s << "  wire.wire(\"" << escapeTypstId(QString("w_%1_dom_fsm").arg(did)) << "\", (\n";
-    s << "    \"" << prevAnchor << "\", \"" << did << "_FSM-port-in\"\n";
-    s << "  ))\n";
+    diagram.wire(
+        escapeTypstId(QString("w_%1_dom_fsm").arg(did)), prevAnchor, did + "_FSM-port-in");
 
     prevAnchor = QString("%1_FSM-port-out").arg(did);
 
@@ -1105,21 +1058,14 @@ QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, floa
     for (int syncIdx = 0; syncIdx < numSync; ++syncIdx) {
         const auto   &followEntry = domain.follow_entries[syncIdx];
         const QString syncId      = QString("%1_SYNC%2").arg(did).arg(syncIdx);
+        const float   syncX       = gx + 5.5f + syncIdx * 1.8f;
 
-        s << "  element.block(\n";
-        s << "    x: " << (gx + 5.5f + syncIdx * 1.8f) << ", y: " << (fsmY + 0.3f)
-          << ", w: 1.5, h: 1.2,\n";
-        s << "    id: \"" << syncId << "\", name: \"SYNC\", fill: util.colors.yellow,\n";
-        s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-        s << "  )\n";
+        diagram.block(syncX, fsmY + 0.3f, 1.5f, 1.2f, syncId, "SYNC", "yellow");
 
         // Add clock, reset, stage labels
-        s << "  draw.content((" << (gx + 6.25f + syncIdx * 1.8f) << ", " << (fsmY - 0.3f)
-          << "), text(size: 6pt)[" << followEntry.clock << "])\n";
-        s << "  draw.content((" << (gx + 6.25f + syncIdx * 1.8f) << ", " << (fsmY - 0.6f)
-          << "), text(size: 6pt)[" << followEntry.reset << "])\n";
-        s << "  draw.content((" << (gx + 6.25f + syncIdx * 1.8f) << ", " << (fsmY - 0.9f)
-          << "), text(size: 6pt)[stage:" << followEntry.stage << "])\n";
+        diagram.text({syncX + 0.75f, fsmY - 0.3f}, followEntry.clock, 6);
+        diagram.text({syncX + 0.75f, fsmY - 0.6f}, followEntry.reset, 6);
+        diagram.text({syncX + 0.75f, fsmY - 0.9f}, QString("stage:%1").arg(followEntry.stage), 6);
 
         // Wire from previous block to this SYNC
         QString wireId;
@@ -1129,9 +1075,7 @@ QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, floa
             wireId = QString("w_%1_sync%2_sync%3").arg(did).arg(syncIdx - 1).arg(syncIdx);
         }
 
-        s << "  wire.wire(\"" << escapeTypstId(wireId) << "\", (\n";
-        s << "    \"" << prevAnchor << "\", \"" << syncId << "-port-in\"\n";
-        s << "  ))\n";
+        diagram.wire(escapeTypstId(wireId), prevAnchor, syncId + "-port-in");
 
         prevAnchor = QString("%1-port-out").arg(syncId);
     }
@@ -1142,30 +1086,16 @@ QString QSocPowerPrimitive::typstDomain(const PowerDomain &domain, float x, floa
     const float arrowEnd = finalX + 2.0f;
     const float outY     = fsmY + 0.3f + 0.6f; // FSM/SYNC port center Y
 
-    s << "  draw.line(\"" << prevAnchor << "\", (" << arrowEnd << ", " << outY
-      << "), mark: (end: \">\", fill: black))\n";
-    s << "  draw.content((" << (arrowEnd + 0.3f) << ", " << outY << "), anchor: \"west\", [rdy_"
-      << domainName << "])\n";
-    s << "\n";
-
-    return result;
+    diagram.line(prevAnchor, {arrowEnd, outY}, true);
+    diagram.text({arrowEnd + 0.3f, outY}, "rdy_" + domainName, 0, QSocDiagram::Align::West);
 }
 
-bool QSocPowerPrimitive::generateTypstDiagram(
-    const PowerControllerConfig &config, const QString &outputPath)
+QSocDiagram QSocPowerPrimitive::layoutDiagram(const PowerControllerConfig &config) const
 {
-    QFile file(outputPath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file for writing:" << outputPath;
-        return false;
-    }
-
-    QTextStream out(&file);
-    out.setEncoding(QStringConverter::Utf8);
+    QSocDiagram diagram(QStringLiteral("Power tree"));
 
-    // Generate header and legend
-    out << typstHeader();
-    out << typstLegend();
+    // Generate legend
+    layoutLegend(diagram);
 
     // Layout parameters - vertical stacking with dynamic spacing
     const float x0          = 0.0f;
@@ -1187,17 +1117,36 @@ bool QSocPowerPrimitive::generateTypstDiagram(
         float domHeight = (numDeps > 0) ? qMax(1.5f, 0.6f * numDeps) : 1.2f;
 
         // Position domain at currentY
-        out << typstDomain(domain, x0, currentY);
+        layoutDomain(diagram, domain, x0, currentY);
 
         // Move to next domain position
         currentY -= domHeight + extraMargin + 2.0f; // Extra padding for labels
     }
 
-    // Close circuit
-    out << "})\n";
+    return diagram;
+}
 
-    file.close();
+bool QSocPowerPrimitive::generateTypstDiagram(const QSocDiagram &diagram, const QString &outputPath)
+{
+    if (!diagram.writeTypst(outputPath)) {
+        qWarning() << "Failed to open file for writing:" << outputPath;
+        return false;
+    }
 
     qInfo() << "Generated Typst diagram:" << outputPath;
     return true;
 }
+
+bool QSocPowerPrimitive::generateSvgDiagram(const QSocDiagram &diagram, const QString &outputPath)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!diagram.writeSvg(outputPath)) {
+        qWarning() << "Failed to open file for writing:" << outputPath;
+        return false;
+    }
+
+    qInfo() << "Generated SVG diagram:" << outputPath << timer.elapsed() << "ms";
+    return true;
+}
@@ -4,6 +4,8 @@
 #ifndef QSOCGENERATEPRIMITIVEPOWER_H
 #define QSOCGENERATEPRIMITIVEPOWER_H
 
+#include "common/qsocdiagram.h"
+
 #include <yaml-cpp/yaml.h>
 #include <QDir>
 #include <QFile>
@@ -106,12 +108,23 @@ public:
     void setForceOverwrite(bool force);
 
     /**
-     * @brief Generate Typst power tree diagram from configuration
-     * @param config Power controller configuration
+     * @brief Write Typst power tree diagram
+     * @param diagram Diagram laid out by layoutDiagram()
      * @param outputPath Output path for .typ file
      * @return true if generation successful, false otherwise
      */
-    bool generateTypstDiagram(const PowerControllerConfig &config, const QString &outputPath);
+    bool generateTypstDiagram(const QSocDiagram &diagram, const QString &outputPath);
+
+    /**
+     * @brief Render SVG power tree diagram
+     * @details Same diagram as the Typst output, rendered in process without
+     *          an external Typst compiler. The render time is logged, the
+     *          layout is not part of it.
+     * @param diagram Diagram laid out by layoutDiagram()
+     * @param outputPath Output path for .svg file
+     * @return true if generation successful, false otherwise
+     */
+    bool generateSvgDiagram(const QSocDiagram &diagram, const QString &outputPath);
 
 private:
     /**
@@ -198,11 +211,12 @@ private:
      */
     QString getSoftDependencySignal(const PowerDomain &domain);
 
-    // Typst generation helper functions
-    QString typstHeader() const;
-    QString typstLegend() const;
-    QString typstDomain(const PowerDomain &domain, float x, float y) const;
-    QString escapeTypstId(const QString &str) const;
+    // Diagram layout helper functions, shared by the Typst and SVG output
+    QSocDiagram layoutDiagram(const PowerControllerConfig &config) const;
+    QString     escapeTypstId(const QString &str) const;
+
+    void layoutLegend(QSocDiagram &diagram) const;
+    void layoutDomain(QSocDiagram &diagram, const PowerDomain &domain, float x, float y) const;
 
 private:
     QSocGenerateManager      *m_parent;                 // Parent manager for accessing utilities
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <vector>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 
@@ -33,7 +34,8 @@ bool QSocResetPrimitive::generateResetController(const YAML::Node &resetNode, QT
 
     // Generate or update reset_cell.v file
     if (m_parent && m_parent->getProjectManager()) {
-        QString outputDir = m_parent->getProjectManager()->getOutputPath();
+        QString            outputDir = m_parent->getProjectManager()->getOutputPath();
+        const QMutexLocker locker(&QSocGenerateManager::cellFileMutex());
         if (!generateResetCellFile(outputDir)) {
             qWarning() << "Failed to generate reset_cell.v file";
             return false;
@@ -54,14 +56,21 @@ bool QSocResetPrimitive::generateResetController(const YAML::Node &resetNode, QT
     // Close module
     out << "\nendmodule\n\n";
 
-    // Generate Typst reset diagram (failure does not affect Verilog generation)
+    // Generate Typst and SVG reset diagrams (failure does not affect Verilog generation)
     if (m_parent && m_parent->getProjectManager()) {
         QString outputDir = m_parent->getProjectManager()->getOutputPath();
         QString typstPath = outputDir + QStringLiteral("/") + config.moduleName
                             + QStringLiteral(".typ");
-        if (!generateTypstDiagram(config, typstPath)) {
+        QString svgPath   = outputDir + QStringLiteral("/") + config.moduleName
+                          + QStringLiteral(".svg");
+        // Both outputs draw the same scene, lay it out once
+        const QSocDiagram diagram = layoutDiagram(config);
+        if (!generateTypstDiagram(diagram, typstPath)) {
             qWarning() << "Failed to generate Typst diagram (non-critical):" << typstPath;
         }
+        if (!generateSvgDiagram(diagram, svgPath)) {
+            qWarning() << "Failed to generate SVG diagram (non-critical):" << svgPath;
+        }
     }
 
     return true;
@@ -965,7 +974,7 @@ QString QSocResetPrimitive::getComponentInstanceName(
     }
 }
 
-/* Typst Reset Diagram Generation */
+/* Reset Diagram Generation */
 
 QString QSocResetPrimitive::escapeTypstId(const QString &str) const
 {
@@ -973,149 +982,80 @@ QString QSocResetPrimitive::escapeTypstId(const QString &str) const
     return result.replace(QRegularExpression(QStringLiteral("[^A-Za-z0-9_-]+")), QStringLiteral("_"));
 }
 
-QString QSocResetPrimitive::typstHeader() const
-{
-    return QStringLiteral(
-        "#import \"@preview/circuiteria:0.2.0\": *\n"
-        "#import \"@preview/cetz:0.3.2\": draw\n"
-        "#set page(width: auto, height: auto, margin: .5cm)\n"
-        "#set text(font: \"Sarasa Mono SC\", size: 10pt)\n"
-        "#align(center)[\n"
-        "  = Reset tree\n"
-        "  #text(size: 8pt, fill: gray)[Generated by QSoC v1.0.2]\n"
-        "]\n"
-        "#v(0.5cm)\n"
-        "#circuit({\n");
-}
-
-QString QSocResetPrimitive::typstLegend() const
+void QSocResetPrimitive::layoutLegend(QSocDiagram &diagram) const
 {
-    const float y  = -1.5f;
-    const float x  = 0.0f;
-    const float w  = 1.6f; // Wider blocks to fit text
-    const float sp = 4.0f; // Increased spacing for wider blocks
-
-    QString     result;
-    QTextStream s(&result);
-    s.setRealNumberPrecision(2);
-    s.setRealNumberNotation(QTextStream::FixedNotation);
+    const float                    y    = -1.5f;
+    const float                    x    = 0.0f;
+    const float                    w    = 1.6f; // Wider blocks to fit text
+    const float                    sp   = 4.0f; // Increased spacing for wider blocks
+    const QList<QSocDiagram::Port> west = {{QStringLiteral("i")}};
+    const QList<QSocDiagram::Port> east = {{QStringLiteral("o")}};
 
-    s << "  // === Legend ===\n";
+    diagram.comment("=== Legend ===");
 
     // AND - Green (active-low reset signals use AND logic)
-    s << "  element.block(x: " << x << ", y: " << (y + 0.3) << ", w: " << w << ", h: 0.8, "
-      << "id: \"legend_and\", name: \"AND\", fill: util.colors.green, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + w / 2) << ", " << (y - 0.8) << "), [AND])\n";
+    diagram.block(x, y + 0.3f, w, 0.8f, "legend_and", "AND", "green", west, east);
+    diagram.text({x + w / 2, y - 0.8f}, "AND");
 
     // ASYNC - Blue
-    s << "  element.block(x: " << (x + sp) << ", y: " << (y + 0.3) << ", w: " << w << ", h: 0.8, "
-      << "id: \"legend_async\", name: \"ASYNC\", fill: util.colors.blue, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp + w / 2) << ", " << (y - 0.8) << "), [ASYNC])\n";
+    diagram.block(x + sp, y + 0.3f, w, 0.8f, "legend_async", "ASYNC", "blue", west, east);
+    diagram.text({x + sp + w / 2, y - 0.8f}, "ASYNC");
 
     // SYNC - Yellow
-    s << "  element.block(x: " << (x + sp * 2) << ", y: " << (y + 0.3) << ", w: " << w
-      << ", h: 0.8, "
-      << "id: \"legend_sync\", name: \"SYNC\", fill: util.colors.yellow, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp * 2 + w / 2) << ", " << (y - 0.8) << "), [SYNC])\n";
+    diagram.block(x + sp * 2, y + 0.3f, w, 0.8f, "legend_sync", "SYNC", "yellow", west, east);
+    diagram.text({x + sp * 2 + w / 2, y - 0.8f}, "SYNC");
 
     // COUNT - Orange
-    s << "  element.block(x: " << (x + sp * 3) << ", y: " << (y + 0.3) << ", w: " << w
-      << ", h: 0.8, "
-      << "id: \"legend_count\", name: \"COUNT\", fill: util.colors.orange, "
-      << "ports: (west: ((id: \"i\"),), east: ((id: \"o\"),)))\n";
-    s << "  draw.content((" << (x + sp * 3 + w / 2) << ", " << (y - 0.8) << "), [COUNT])\n\n";
-
-    return result;
+    diagram.block(x + sp * 3, y + 0.3f, w, 0.8f, "legend_count", "COUNT", "orange", west, east);
+    diagram.text({x + sp * 3 + w / 2, y - 0.8f}, "COUNT");
 }
 
-QString QSocResetPrimitive::typstSourceTable(
-    const QList<ResetSource> &sources, float x, float &bottomY) const
+void QSocResetPrimitive::layoutSourceTable(
+    QSocDiagram &diagram, const QList<ResetSource> &sources, float &bottomY) const
 {
     if (sources.isEmpty()) {
         bottomY = -5.0f;
-        return QString();
+        return;
     }
 
-    QString     result;
-    QTextStream s(&result);
-    s.setRealNumberPrecision(2);
-    s.setRealNumberNotation(QTextStream::FixedNotation);
-
-    // Use Typst table for clean two-column layout
-    // End the circuit block temporarily to insert table
-    s << "})\n\n";
-
-    s << "#v(0.3cm)\n";
-    s << "#align(center)[\n";
-    s << "  #text(weight: \"bold\", size: 10pt)[Reset Sources]\n";
-    s << "]\n";
-    s << "#v(0.2cm)\n";
-
-    // Two-column table with source name and active level
-    s << "#align(center)[\n";
-    s << "#table(\n";
-    s << "  columns: (auto, auto, auto, auto),\n";
-    s << "  align: (left, center, left, center),\n";
-    s << "  stroke: 0.5pt + gray,\n";
-    s << "  inset: 5pt,\n";
-    s << "  fill: (col, row) => if row == 0 { rgb(\"#e0e0e0\") },\n";
-    s << "  [*Source*], [*Active*], [*Source*], [*Active*],\n";
-
-    // Fill table rows - two sources per row
+    // Four-column table with two sources per row, source name and active level
+    const QSocDiagram::Cell  source{QStringLiteral("Source"), QString(), true};
+    const QSocDiagram::Cell  active{QStringLiteral("Active"), QString(), true};
+    QList<QSocDiagram::Cell> cells{source, active, source, active};
+
     int numSources = sources.size();
-    for (int i = 0; i < numSources; i += 2) {
-        const ResetSource &src1    = sources[i];
-        QString            active1 = (src1.active == QStringLiteral("high")) ? "H" : "L";
-        QString srcColor1          = (src1.active == QStringLiteral("high")) ? QStringLiteral("red")
-                                                                             : QStringLiteral("blue");
-
-        s << "  [#text(fill: " << srcColor1 << ")[" << src1.name << "]], ";
-        s << "[#text(fill: " << srcColor1 << ")[" << active1 << "]], ";
-
-        if (i + 1 < numSources) {
-            const ResetSource &src2    = sources[i + 1];
-            QString            active2 = (src2.active == QStringLiteral("high")) ? "H" : "L";
-            QString srcColor2 = (src2.active == QStringLiteral("high")) ? QStringLiteral("red")
-                                                                        : QStringLiteral("blue");
-            s << "[#text(fill: " << srcColor2 << ")[" << src2.name << "]], ";
-            s << "[#text(fill: " << srcColor2 << ")[" << active2 << "]],\n";
-        } else {
-            s << "[], [],\n"; // Empty cells for odd number of sources
-        }
+    for (const ResetSource &src : sources) {
+        bool    high  = (src.active == QStringLiteral("high"));
+        QString color = high ? QStringLiteral("red") : QStringLiteral("blue");
+        cells << QSocDiagram::Cell{src.name, color}
+              << QSocDiagram::Cell{high ? QStringLiteral("H") : QStringLiteral("L"), color};
+    }
+    if (numSources % 2 != 0) {
+        // Empty cells for odd number of sources
+        cells << QSocDiagram::Cell() << QSocDiagram::Cell();
     }
 
-    s << ")\n";
-    s << "]\n\n";
-
-    // Resume circuit block for targets
-    s << "#v(0.3cm)\n";
-    s << "#circuit({\n";
+    diagram.table("Reset Sources", 4, cells);
 
     // Calculate bottomY for target positioning
     int numRows = (numSources + 1) / 2; // Two sources per row
     bottomY     = -3.0f - numRows * 0.8f;
-
-    return result;
 }
 
-QString QSocResetPrimitive::typstTarget(
-    const ResetTarget &target, const QMap<QString, bool> &sourceIsHighActive, float x, float y) const
+void QSocResetPrimitive::layoutTarget(
+    QSocDiagram               &diagram,
+    const ResetTarget         &target,
+    const QMap<QString, bool> &sourceIsHighActive,
+    float                      x,
+    float                      y) const
 {
-    QString     result;
-    QTextStream s(&result);
-    s.setRealNumberPrecision(2);
-    s.setRealNumberNotation(QTextStream::FixedNotation);
-
     QString tid   = escapeTypstId(target.name);
     QString title = target.name;
 
-    s << "  // ---- " << title << " ----\n";
+    diagram.comment(QStringLiteral("---- ") + title + QStringLiteral(" ----"));
 
     if (target.links.isEmpty()) {
-        return result;
+        return;
     }
 
     int numSources = target.links.size();
@@ -1265,39 +1205,31 @@ QString QSocResetPrimitive::typstTarget(
                     tid + QStringLiteral("_L") + QString::number(i) + QStringLiteral("_ASYNC"));
                 clock     = link.async.clock;
                 label2    = QStringLiteral("stage:%1").arg(link.async.stage);
-                fillColor = QStringLiteral("util.colors.blue");
+                fillColor = QStringLiteral("blue");
             } else if (linkCompType[i] == QStringLiteral("sync")) {
                 compId = escapeTypstId(
                     tid + QStringLiteral("_L") + QString::number(i) + QStringLiteral("_SYNC"));
                 clock     = link.sync.clock;
                 label2    = QStringLiteral("stage:%1").arg(link.sync.stage);
-                fillColor = QStringLiteral("util.colors.yellow");
+                fillColor = QStringLiteral("yellow");
             } else if (linkCompType[i] == QStringLiteral("count")) {
                 compId = escapeTypstId(
                     tid + QStringLiteral("_L") + QString::number(i) + QStringLiteral("_COUNT"));
                 clock     = link.count.clock;
                 label2    = QStringLiteral("cycle:%1").arg(link.count.cycle);
-                fillColor = QStringLiteral("util.colors.orange");
+                fillColor = QStringLiteral("orange");
             }
 
             // Draw component block (Y is bottom-left corner in circuiteria)
-            s << "  element.block(\n";
-            s << "    x: " << linkCompX << ", y: " << compY << ", w: 1.5, h: " << blockHeight
-              << ",\n";
-            s << "    id: \"" << compId << "\", name: \"" << linkCompType[i].toUpper()
-              << "\", fill: " << fillColor << ",\n";
-            s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-            s << "  )\n";
+            diagram.block(
+                linkCompX, compY, 1.5f, blockHeight, compId, linkCompType[i].toUpper(), fillColor);
 
             // Draw labels below component
-            s << "  draw.content((" << (linkCompX + 0.75f) << ", " << (compY - 0.25f)
-              << "), text(size: 5pt)[" << clock << "])\n";
-            s << "  draw.content((" << (linkCompX + 0.75f) << ", " << (compY - 0.55f)
-              << "), text(size: 5pt)[" << label2 << "])\n";
+            diagram.text({linkCompX + 0.75f, compY - 0.25f}, clock, 5);
+            diagram.text({linkCompX + 0.75f, compY - 0.55f}, label2, 5);
 
             // Draw input stub to component
-            s << "  wire.stub(\"" << compId << "-port-in\", \"west\", name: \"" << srcName
-              << "\")\n";
+            diagram.stub(compId + QStringLiteral("-port-in"), "west", srcName);
 
             // Store output port as AND input
             andInputPorts[i] = compId + QStringLiteral("-port-out");
@@ -1319,36 +1251,26 @@ QString QSocResetPrimitive::typstTarget(
         float triBaseX = andX;
         float triTipX  = triBaseX + triWidth;
         float triY     = andCenterY;
-        s << "  draw.line((" << triBaseX << ", " << (triY + triHalfH) << "), (" << triTipX << ", "
-          << triY << "), (" << triBaseX << ", " << (triY - triHalfH)
-          << "), close: true, fill: black, stroke: none)\n";
-        s << "  draw.content((" << (triBaseX - 0.1f) << ", " << triY
-          << "), anchor: \"east\", text(size: 8pt)[" << target.links[0].source << "])\n";
-        // Tiny invisible anchor: position so east port aligns with triangle tip
-        float anchorS = 0.01f;
-        s << "  element.block(x: " << (triTipX - anchorS) << ", y: " << (triY - anchorS / 2)
-          << ", w: " << anchorS << ", h: " << anchorS << ", id: \"" << sid
-          << "\", name: \"\", stroke: none, fill: none, ports: (east: ((id: \"out\"),)))\n";
+        diagram.polygon(
+            {{triBaseX, triY + triHalfH}, {triTipX, triY}, {triBaseX, triY - triHalfH}}, "black");
+        diagram.text(
+            {triBaseX - 0.1f, triY}, target.links[0].source, 8, QSocDiagram::Align::East);
+        // Tiny invisible anchor: east port aligns with triangle tip
+        diagram.anchor(sid, {triTipX, triY});
         andOutputPort = sid + QStringLiteral("-port-out");
     } else {
         // Use AND gate - height accommodates all link components
         // AND gate bottom at andBottomY, so it's centered at andCenterY
         QString andId = escapeTypstId(tid + QStringLiteral("_AND"));
-        s << "  element.block(\n";
-        s << "    x: " << andX << ", y: " << andBottomY << ", w: 1.2, h: " << andHeight << ",\n";
-        s << "    id: \"" << andId << "\", name: \"AND\", fill: util.colors.green,\n";
 
         // Define ports with explicit positions to align with link components
-        s << "    ports: (west: (";
+        QList<QSocDiagram::Port> andPorts;
         for (int i = 0; i < numSources; ++i) {
-            if (i > 0)
-                s << ", ";
             // Calculate port position as ratio within AND gate height (from bottom)
             float portRatio = (linkPortY[i] - andBottomY) / andHeight;
-            s << "(id: \"in" << i << "\", pos: " << portRatio << ")";
+            andPorts << QSocDiagram::Port{QStringLiteral("in") + QString::number(i), portRatio};
         }
-        s << ",), east: ((id: \"out\"),))\n";
-        s << "  )\n";
+        diagram.block(andX, andBottomY, 1.2f, andHeight, andId, "AND", "green", andPorts);
 
         // Connect inputs to AND gate (with inversion bubble for high-active sources)
         for (int i = 0; i < numSources; ++i) {
@@ -1358,25 +1280,21 @@ QString QSocResetPrimitive::typstTarget(
             // Draw inversion bubble at AND input for high-active sources
             if (linkNeedsInvert[i]) {
                 float bubbleX = andX - 0.15f; // Just before AND gate west edge
-                s << "  draw.circle((" << bubbleX << ", " << portY << "), radius: 0.1, "
-                  << "stroke: black, fill: white)\n";
+                diagram.circle({bubbleX, portY}, 0.1f, "white");
             }
 
             if (andInputPorts[i].isEmpty()) {
                 // Direct connection - draw stub
-                s << "  wire.stub(\"" << andInPort << "\", \"west\", name: \""
-                  << target.links[i].source << "\")\n";
+                diagram.stub(andInPort, "west", target.links[i].source);
             } else {
                 // Connect from link component output to AND input
                 // If bubble exists, wire ends at bubble, otherwise at AND port
                 if (linkNeedsInvert[i]) {
                     float bubbleX = andX - 0.15f;
-                    s << "  draw.line(\"" << andInputPorts[i] << "\", (" << (bubbleX - 0.1f) << ", "
-                      << portY << "))\n";
+                    diagram.line(andInputPorts[i], {bubbleX - 0.1f, portY});
                 } else {
-                    s << "  wire.wire(\"w_" << tid << "_l" << i << "_to_and\", (\n";
-                    s << "    \"" << andInputPorts[i] << "\", \"" << andInPort << "\"\n";
-                    s << "  ))\n";
+                    diagram.wire(
+                        QString("w_%1_l%2_to_and").arg(tid).arg(i), andInputPorts[i], andInPort);
                 }
             }
         }
@@ -1397,38 +1315,32 @@ QString QSocResetPrimitive::typstTarget(
             compId    = escapeTypstId(tid + QStringLiteral("_ASYNC"));
             clock     = target.async.clock;
             label2    = QStringLiteral("stage:%1").arg(target.async.stage);
-            fillColor = QStringLiteral("util.colors.blue");
+            fillColor = QStringLiteral("blue");
         } else if (targetCompType == QStringLiteral("sync")) {
             compId    = escapeTypstId(tid + QStringLiteral("_SYNC"));
             clock     = target.sync.clock;
             label2    = QStringLiteral("stage:%1").arg(target.sync.stage);
-            fillColor = QStringLiteral("util.colors.yellow");
+            fillColor = QStringLiteral("yellow");
         } else if (targetCompType == QStringLiteral("count")) {
             compId    = escapeTypstId(tid + QStringLiteral("_COUNT"));
             clock     = target.count.clock;
             label2    = QStringLiteral("cycle:%1").arg(target.count.cycle);
-            fillColor = QStringLiteral("util.colors.orange");
+            fillColor = QStringLiteral("orange");
         }
 
         // Draw component block
-        s << "  element.block(\n";
-        s << "    x: " << targetCompX << ", y: " << compY << ", w: 1.5, h: " << targetCompH
-          << ",\n";
-        s << "    id: \"" << compId << "\", name: \"" << targetCompType.toUpper()
-          << "\", fill: " << fillColor << ",\n";
-        s << "    ports: (west: ((id: \"in\"),), east: ((id: \"out\"),))\n";
-        s << "  )\n";
+        diagram.block(
+            targetCompX, compY, 1.5f, targetCompH, compId, targetCompType.toUpper(), fillColor);
 
         // Draw labels below component
-        s << "  draw.content((" << (targetCompX + 0.75f) << ", " << (compY - 0.3f)
-          << "), text(size: 6pt)[" << clock << "])\n";
-        s << "  draw.content((" << (targetCompX + 0.75f) << ", " << (compY - 0.7f)
-          << "), text(size: 6pt)[" << label2 << "])\n";
+        diagram.text({targetCompX + 0.75f, compY - 0.3f}, clock, 6);
+        diagram.text({targetCompX + 0.75f, compY - 0.7f}, label2, 6);
 
         // Wire from AND to target component
-        s << "  wire.wire(\"w_" << tid << "_and_to_comp\", (\n";
-        s << "    \"" << andOutputPort << "\", \"" << compId << "-port-in\"\n";
-        s << "  ))\n";
+        diagram.wire(
+            QStringLiteral("w_") + tid + QStringLiteral("_and_to_comp"),
+            andOutputPort,
+            compId + QStringLiteral("-port-in"));
 
         finalOutputPort = compId + QStringLiteral("-port-out");
     }
@@ -1439,32 +1351,15 @@ QString QSocResetPrimitive::typstTarget(
     float arrowEndX   = outX + 0.3f;
 
     // Draw arrow line from component to arrow tip
-    s << "  draw.line(";
-    if (hasTargetComp) {
-        s << "\"" << finalOutputPort << "\", ";
-    } else {
-        s << "\"" << andOutputPort << "\", ";
-    }
-    s << "(" << arrowEndX << ", " << andCenterY << "), mark: (end: \">\", fill: black))\n";
+    diagram.line(hasTargetComp ? finalOutputPort : andOutputPort, {arrowEndX, andCenterY}, true);
 
     // Draw label to the right of arrow
-    s << "  draw.content((" << (arrowEndX + 0.3f) << ", " << andCenterY << "), "
-      << "anchor: \"west\", [" << target.name << "])\n\n";
-
-    return result;
+    diagram.text({arrowEndX + 0.3f, andCenterY}, target.name, 0, QSocDiagram::Align::West);
 }
 
-bool QSocResetPrimitive::generateTypstDiagram(
-    const ResetControllerConfig &config, const QString &outputPath)
+QSocDiagram QSocResetPrimitive::layoutDiagram(const ResetControllerConfig &config) const
 {
-    QFile file(outputPath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open Typst output file:" << outputPath;
-        return false;
-    }
-
-    QTextStream out(&file);
-    out.setEncoding(QStringConverter::Utf8);
+    QSocDiagram diagram(QStringLiteral("Reset tree"));
 
     // Build sourceIsHighActive map for polarity indication
     QMap<QString, bool> sourceIsHighActive;
@@ -1472,25 +1367,22 @@ bool QSocResetPrimitive::generateTypstDiagram(
         sourceIsHighActive[src.name] = (src.active == QStringLiteral("high"));
     }
 
-    // Generate header
-    out << typstHeader();
-
     // Generate legend
-    out << typstLegend();
+    layoutLegend(diagram);
 
     // Generate reset source table (two-column layout)
     float bottomY = -5.0f;
-    out << typstSourceTable(config.sources, 0.0f, bottomY);
+    layoutSourceTable(diagram, config.sources, bottomY);
 
     // Generate targets (vertical stacking with dynamic spacing)
-    // Use same height calculation as typstTarget to determine spacing
+    // Use same height calculation as layoutTarget to determine spacing
     const float x0          = 0.0f;
     const float blockHeight = 1.0f;
     const float blockTopPad = 0.3f;
-    const float textHang    = 1.2f; // Match typstTarget
+    const float textHang    = 1.2f; // Match layoutTarget
     const float stubHeight  = 0.5f;
-    const float compGap     = 1.5f; // Match typstTarget
-    const float stubGap     = 0.8f; // Match typstTarget
+    const float compGap     = 1.5f; // Match layoutTarget
+    const float stubGap     = 0.8f; // Match layoutTarget
     const float extraMargin = 2.0f; // Extra margin between targets
 
     float currentY = bottomY - 3.0f;
@@ -1498,7 +1390,7 @@ bool QSocResetPrimitive::generateTypstDiagram(
     for (int idx = 0; idx < config.targets.size(); ++idx) {
         const ResetTarget &target = config.targets[idx];
 
-        // Calculate this target's AND height using same logic as typstTarget
+        // Calculate this target's AND height using same logic as layoutTarget
         int  numLinks       = target.links.size();
         bool hasTargetAsync = !target.async.clock.isEmpty() || !target.sync.clock.isEmpty()
                               || !target.count.clock.isEmpty();
@@ -1533,16 +1425,36 @@ bool QSocResetPrimitive::generateTypstDiagram(
 
         // Position target center, then move down for next target
         float targetCenterY = currentY - targetHeight / 2;
-        out << typstTarget(target, sourceIsHighActive, x0, targetCenterY);
+        layoutTarget(diagram, target, sourceIsHighActive, x0, targetCenterY);
 
         // Move to next target position
         currentY = targetCenterY - targetHeight / 2 - extraMargin;
     }
 
-    // Close circuit
-    out << "})\n";
+    return diagram;
+}
+
+bool QSocResetPrimitive::generateTypstDiagram(const QSocDiagram &diagram, const QString &outputPath)
+{
+    if (!diagram.writeTypst(outputPath)) {
+        qWarning() << "Failed to open Typst output file:" << outputPath;
+        return false;
+    }
 
-    file.close();
     qInfo() << "Generated Typst reset diagram:" << outputPath;
     return true;
 }
+
+bool QSocResetPrimitive::generateSvgDiagram(const QSocDiagram &diagram, const QString &outputPath)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!diagram.writeSvg(outputPath)) {
+        qWarning() << "Failed to open SVG output file:" << outputPath;
+        return false;
+    }
+
+    qInfo() << "Generated SVG reset diagram:" << outputPath << timer.elapsed() << "ms";
+    return true;
+}
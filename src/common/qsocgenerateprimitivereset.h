@@ -1,6 +1,8 @@
 #ifndef QSOCGENERATEPRIMITIVERESET_H
 #define QSOCGENERATEPRIMITIVERESET_H
 
+#include "common/qsocdiagram.h"
+
 #include <yaml-cpp/yaml.h>
 #include <QMap>
 #include <QString>
@@ -142,12 +144,23 @@ public:
     void setForceOverwrite(bool force);
 
     /**
-     * @brief Generate Typst reset tree diagram from configuration
-     * @param config Reset controller configuration
+     * @brief Write Typst reset tree diagram
+     * @param diagram Diagram laid out by layoutDiagram()
      * @param outputPath Output path for .typ file
      * @return true if generation successful, false otherwise
      */
-    bool generateTypstDiagram(const ResetControllerConfig &config, const QString &outputPath);
+    bool generateTypstDiagram(const QSocDiagram &diagram, const QString &outputPath);
+
+    /**
+     * @brief Render SVG reset tree diagram
+     * @details Same diagram as the Typst output, rendered in process without
+     *          an external Typst compiler. The render time is logged, the
+     *          layout is not part of it.
+     * @param diagram Diagram laid out by layoutDiagram()
+     * @param outputPath Output path for .svg file
+     * @return true if generation successful, false otherwise
+     */
+    bool generateSvgDiagram(const QSocDiagram &diagram, const QString &outputPath);
 
 private:
     /**
@@ -247,16 +260,19 @@ private:
      */
     QString getNormalizedSource(const QString &sourceName, const ResetControllerConfig &config);
 
-    // Typst generation helper functions
-    QString typstHeader() const;
-    QString typstLegend() const;
-    QString typstSourceTable(const QList<ResetSource> &sources, float x, float &bottomY) const;
-    QString typstTarget(
+    // Diagram layout helper functions, shared by the Typst and SVG output
+    QSocDiagram layoutDiagram(const ResetControllerConfig &config) const;
+    QString     escapeTypstId(const QString &str) const;
+
+    void layoutLegend(QSocDiagram &diagram) const;
+    void layoutSourceTable(
+        QSocDiagram &diagram, const QList<ResetSource> &sources, float &bottomY) const;
+    void layoutTarget(
+        QSocDiagram               &diagram,
         const ResetTarget         &target,
         const QMap<QString, bool> &sourceIsHighActive,
         float                      x,
         float                      y) const;
-    QString escapeTypstId(const QString &str) const;
 
 private:
     QSocGenerateManager *m_parent;                 // Parent manager for accessing utilities
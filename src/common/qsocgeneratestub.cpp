@@ -2,88 +2,331 @@
 // SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
 
 #include "common/qsocgeneratemanager.h"
+#include "common/qstaticregex.h"
 
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QRegularExpression>
+#include <QSet>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
 
-#include <fstream>
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <rapidcsv.h>
+#include <vector>
 
-bool QSocGenerateManager::generateStub(
-    const QString            &stubName,
-    const QRegularExpression &libraryRegex,
-    const QRegularExpression &moduleRegex)
+namespace {
+
+/* Minimum modules per pool thread, smaller sets render on the calling thread */
+constexpr qsizetype stubParallelThreshold = 64;
+
+/* Parameter of a stub module */
+struct StubParameter
 {
-    /* Check if project manager is valid */
-    if (!projectManager) {
-        qCritical() << "Error: Project manager is null";
+    QString name;
+    QString description;
+    QString type;             /* Cleaned for Verilog 2001, with a trailing space */
+    QString value;
+    bool    declared = false; /* Only parameters with a map body are declared */
+};
+
+/* Liberty timing defaults of a port, empty values are not emitted */
+struct StubTiming
+{
+    QString clock; /* Related clock pin of the arcs */
+    QString capacitance;
+    QString maxTransition;
+    QString setup;
+    QString hold;
+    QString clockToQ;
+};
+
+/* One row of a timing CSV file */
+struct StubTimingRow
+{
+    QString                                module;
+    QString                                port; /* Empty for the module timing */
+    QList<QPair<std::string, std::string>> valueList;
+};
+
+/* Read the rows of a timing CSV file, grouped by module name */
+bool readStubTimingFile(const QString &filePath, QHash<QString, QList<StubTimingRow>> &rowMap)
+{
+    static const QStringList timingKeys
+        = {"clock", "capacitance", "max_transition", "setup", "hold", "clk_to_q"};
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical() << "Error: Could not open timing file:" << filePath;
         return false;
     }
+    QTextStream   inputStream(&file);
+    const QString firstLine = inputStream.readLine();
+    file.close();
+
+    /* Determine delimiter based on count of commas vs semicolons */
+    const QChar delimiter = firstLine.count(',') >= firstLine.count(';') ? ',' : ';';
+
+    try {
+        const rapidcsv::SeparatorParams separatorParams(static_cast<char>(delimiter.unicode()));
+        const rapidcsv::Document
+            doc(filePath.toStdString(), rapidcsv::LabelParams(0, -1), separatorParams);
+
+        /* Locate the columns by name, the timing columns are all optional */
+        const std::vector<std::string> columnNames = doc.GetColumnNames();
+        qsizetype moduleColumn = -1;
+        qsizetype portColumn   = -1;
+        QList<QPair<std::string, std::size_t>> valueColumnList;
+        for (std::size_t column = 0; column < columnNames.size(); ++column) {
+            const QString name = QString::fromStdString(columnNames[column]).trimmed().toLower();
+            if (name == "module") {
+                moduleColumn = static_cast<qsizetype>(column);
+            } else if (name == "port") {
+                portColumn = static_cast<qsizetype>(column);
+            } else if (timingKeys.contains(name)) {
+                valueColumnList.append({name.toStdString(), column});
+            }
+        }
+        if (moduleColumn < 0) {
+            qCritical() << "Error: Timing file has no module column:" << filePath;
+            return false;
+        }
 
-    if (!projectManager->isValidOutputPath(true)) {
-        qCritical() << "Error: Invalid output path: " << projectManager->getOutputPath();
+        const auto cell = [&doc](std::size_t column, std::size_t row) {
+            return QString::fromStdString(doc.GetCell<std::string>(column, row)).trimmed();
+        };
+        for (std::size_t row = 0; row < doc.GetRowCount(); ++row) {
+            StubTimingRow timingRow;
+            timingRow.module = cell(static_cast<std::size_t>(moduleColumn), row);
+            if (timingRow.module.isEmpty()) {
+                continue;
+            }
+            if (portColumn >= 0) {
+                timingRow.port = cell(static_cast<std::size_t>(portColumn), row);
+                if (timingRow.port == "*") {
+                    timingRow.port.clear();
+                }
+            }
+            for (const auto &[key, column] : valueColumnList) {
+                const QString value = cell(column, row);
+                if (!value.isEmpty()) {
+                    timingRow.valueList.append({key, value.toStdString()});
+                }
+            }
+            rowMap[timingRow.module].append(timingRow);
+        }
+    } catch (const std::exception &e) {
+        qCritical() << "Error: Failed to parse timing file" << filePath << ":" << e.what();
         return false;
     }
+    return true;
+}
 
-    /* Check if module manager is valid */
-    if (!moduleManager) {
-        qCritical() << "Error: Module manager is null";
-        return false;
+/* Port of a stub module */
+struct StubPort
+{
+    QString    name;
+    QString    direction;
+    QString    type; /* Cleaned for Verilog 2001 */
+    QString    description;
+    int        width   = 0;     /* Width of a [N:0] bus, 0 for other types */
+    bool       isClock = false; /* Related clock of another port */
+    StubTiming timing;
+};
+
+/* Everything the stub writers need from one module descriptor */
+struct StubModule
+{
+    QString              name;
+    bool                 hasParameter = false;
+    QList<StubParameter> parameterList;
+    QList<StubPort>      portList;
+};
+
+/* Override timing values with the ones in the timing section of a node */
+void readStubTiming(const YAML::Node &node, const QString &context, StubTiming &timing)
+{
+    const YAML::Node section = node["timing"];
+    if (!section || !section.IsMap()) {
+        return;
     }
 
-    /* Get all module names that match the library and module regex */
-    const QStringList allModuleNames = moduleManager->listModule(libraryRegex);
-    QStringList       selectedModules;
+    if (section["clock"] && section["clock"].IsScalar()) {
+        timing.clock = QString::fromStdString(section["clock"].as<std::string>());
+    }
 
-    for (const QString &moduleName : allModuleNames) {
-        if (moduleRegex.match(moduleName).hasMatch()) {
-            selectedModules.append(moduleName);
+    const QList<QPair<const char *, QString StubTiming::*>> valueList
+        = {{"capacitance", &StubTiming::capacitance},
+           {"max_transition", &StubTiming::maxTransition},
+           {"setup", &StubTiming::setup},
+           {"hold", &StubTiming::hold},
+           {"clk_to_q", &StubTiming::clockToQ}};
+    for (const auto &[key, member] : valueList) {
+        const YAML::Node value = section[key];
+        if (!value) {
+            continue;
         }
+        const QString text = value.IsScalar() ? QString::fromStdString(value.as<std::string>())
+                                              : QString();
+        bool ok = false;
+        text.toDouble(&ok);
+        if (!ok) {
+            qWarning() << "Warning: Timing value" << key << "of" << context
+                       << "is not a number, skipping";
+            continue;
+        }
+        timing.*member = text.trimmed();
     }
+}
 
-    if (selectedModules.isEmpty()) {
-        qCritical() << "Error: No modules found matching the specified criteria";
-        return false;
+QString stubDirection(const YAML::Node &node)
+{
+    if (!node["direction"] || !node["direction"].IsScalar()) {
+        return "input";
+    }
+    /* Handle both full and abbreviated forms */
+    const QString direction = QString::fromStdString(node["direction"].as<std::string>()).toLower();
+    if (direction == "out" || direction == "output") {
+        return "output";
+    }
+    if (direction == "inout") {
+        return "inout";
     }
+    return "input";
+}
 
-    qInfo() << "Found" << selectedModules.size()
-            << "modules matching criteria:" << selectedModules.join(", ");
+/* Read a module descriptor once, YAML nodes are not touched after this */
+StubModule readStubModule(const QString &moduleName, const YAML::Node &moduleData)
+{
+    static const QRegularExpression busRegex(R"(\[(\d+):0\])");
+
+    StubModule module;
+    module.name = moduleName;
+
+    const YAML::Node parameters = moduleData["parameter"];
+    if (parameters && parameters.IsMap() && parameters.size() > 0) {
+        module.hasParameter = true;
+        for (auto paramIter = parameters.begin(); paramIter != parameters.end(); ++paramIter) {
+            if (!paramIter->first.IsScalar()) {
+                qWarning() << "Warning: Invalid parameter name, skipping";
+                continue;
+            }
 
-    /* Generate Verilog stub file */
-    if (!generateVerilogStub(stubName, selectedModules)) {
-        qCritical() << "Error: Failed to generate Verilog stub file";
-        return false;
-    }
+            StubParameter parameter;
+            parameter.name        = QString::fromStdString(paramIter->first.as<std::string>());
+            parameter.description = parameter.name;
 
-    /* Generate Lib stub file */
-    if (!generateLibStub(stubName, selectedModules)) {
-        qCritical() << "Error: Failed to generate Lib stub file";
-        return false;
+            const YAML::Node body = paramIter->second;
+            if (!body.IsMap()) {
+                qWarning() << "Warning: Parameter" << parameter.name
+                           << "has invalid format, skipping";
+                module.parameterList.append(parameter);
+                continue;
+            }
+            parameter.declared = true;
+
+            if (body["description"] && body["description"].IsScalar()) {
+                parameter.description = QString::fromStdString(
+                    body["description"].as<std::string>());
+            }
+            if (body["type"] && body["type"].IsScalar()) {
+                parameter.type = QSocGenerateManager::cleanTypeForWireDeclaration(
+                    QString::fromStdString(body["type"].as<std::string>()));
+                /* Add a space if type isn't empty after processing */
+                if (!parameter.type.isEmpty() && !parameter.type.endsWith(" ")) {
+                    parameter.type += " ";
+                }
+            }
+            if (body["value"] && body["value"].IsScalar()) {
+                parameter.value = QString::fromStdString(body["value"].as<std::string>());
+            }
+            module.parameterList.append(parameter);
+        }
     }
 
-    return true;
-}
+    /* Module timing applies to every port without its own value */
+    StubTiming moduleTiming;
+    readStubTiming(moduleData, moduleName, moduleTiming);
 
-bool QSocGenerateManager::generateVerilogStub(const QString &stubName, const QStringList &moduleNames)
-{
-    /* Prepare output file path */
-    const QString outputFilePath = QDir(projectManager->getOutputPath()).filePath(stubName + ".v");
+    const YAML::Node ports = moduleData["port"];
+    if (ports && ports.IsMap()) {
+        for (auto portIter = ports.begin(); portIter != ports.end(); ++portIter) {
+            if (!portIter->first.IsScalar()) {
+                qWarning() << "Warning: Invalid port name, skipping";
+                continue;
+            }
 
-    /* Open output file for writing */
-    QFile outputFile(outputFilePath);
-    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qCritical() << "Error: Failed to open output file for writing:" << outputFilePath;
-        return false;
+            StubPort port;
+            port.name = QString::fromStdString(portIter->first.as<std::string>());
+
+            const YAML::Node body = portIter->second;
+            if (!body.IsMap()) {
+                qWarning() << "Warning: Port" << port.name << "has invalid format, skipping";
+                continue;
+            }
+
+            port.direction   = stubDirection(body);
+            port.description = port.name;
+            if (body["type"] && body["type"].IsScalar()) {
+                port.type = QSocGenerateManager::cleanTypeForWireDeclaration(
+                    QString::fromStdString(body["type"].as<std::string>()));
+                const QRegularExpressionMatch match = busRegex.match(port.type);
+                if (match.hasMatch()) {
+                    port.width = match.captured(1).toInt() + 1;
+                }
+            }
+            if (body["description"] && body["description"].IsScalar()) {
+                port.description = QString::fromStdString(body["description"].as<std::string>());
+            }
+            port.timing = moduleTiming;
+            readStubTiming(body, moduleName + "." + port.name, port.timing);
+            module.portList.append(port);
+        }
     }
 
-    QTextStream out(&outputFile);
+    /* A related clock must be a port, else its timing groups are dropped */
+    QSet<QString> portNameSet;
+    for (const StubPort &port : module.portList) {
+        portNameSet.insert(port.name);
+    }
+    QSet<QString> unknownClockSet;
+    for (StubPort &port : module.portList) {
+        if (port.timing.clock.isEmpty() || portNameSet.contains(port.timing.clock)) {
+            continue;
+        }
+        if (!unknownClockSet.contains(port.timing.clock)) {
+            unknownClockSet.insert(port.timing.clock);
+            qWarning() << "Warning: Timing clock" << port.timing.clock << "of module" << moduleName
+                       << "is not a port, skipping its timing arcs";
+        }
+        port.timing.clock.clear();
+    }
+
+    /* Ports referenced as a related clock are clock pins */
+    QSet<QString> clockSet;
+    for (const StubPort &port : module.portList) {
+        if (!port.timing.clock.isEmpty()) {
+            clockSet.insert(port.timing.clock);
+        }
+    }
+    for (StubPort &port : module.portList) {
+        port.isClock = clockSet.contains(port.name);
+    }
+
+    return module;
+}
+
+QString verilogStubHeader(const QString &stubName)
+{
+    QString     text;
+    QTextStream out(&text);
 
-    /* Generate file header */
     out << "/**\n";
     out << " * @file " << stubName << ".v\n";
     out << " * @brief Verilog stub file for multiple modules\n";
@@ -95,203 +338,160 @@ bool QSocGenerateManager::generateVerilogStub(const QString &stubName, const QSt
     out << " * NOTE: Auto-generated file, do not edit manually.\n";
     out << " */\n\n";
 
-    /* Generate stub for each module */
-    for (const QString &moduleName : moduleNames) {
-        if (!moduleManager->isModuleExist(moduleName)) {
-            qWarning() << "Warning: Module" << moduleName << "does not exist, skipping";
-            continue;
-        }
-
-        YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
+    out.flush();
+    return text;
+}
 
-        /* Generate module header comment */
-        out << "/**\n";
-        out << " * @brief " << moduleName << " module stub\n";
-        out << " *\n";
-        out << " * @details Stub implementation of " << moduleName << " module.\n";
-
-        /* Add parameter documentation if they exist */
-        if (moduleData["parameter"] && moduleData["parameter"].IsMap()
-            && moduleData["parameter"].size() > 0) {
-            out << " *\n";
-            out << " * Parameters:\n";
-            for (auto paramIter = moduleData["parameter"].begin();
-                 paramIter != moduleData["parameter"].end();
-                 ++paramIter) {
-                if (!paramIter->first.IsScalar()) {
-                    continue;
-                }
-                const QString paramName = QString::fromStdString(paramIter->first.as<std::string>());
+QString verilogStubModule(const StubModule &module)
+{
+    QString     text;
+    QTextStream out(&text);
 
-                QString paramDescription = paramName;
-                if (paramIter->second.IsMap() && paramIter->second["description"]
-                    && paramIter->second["description"].IsScalar()) {
-                    paramDescription = QString::fromStdString(
-                        paramIter->second["description"].as<std::string>());
-                }
+    /* Generate module header comment */
+    out << "/**\n";
+    out << " * @brief " << module.name << " module stub\n";
+    out << " *\n";
+    out << " * @details Stub implementation of " << module.name << " module.\n";
 
-                out << " * - " << paramName << ": " << paramDescription << "\n";
-            }
+    /* Add parameter documentation if they exist */
+    if (module.hasParameter) {
+        out << " *\n";
+        out << " * Parameters:\n";
+        for (const StubParameter &parameter : module.parameterList) {
+            out << " * - " << parameter.name << ": " << parameter.description << "\n";
         }
+    }
 
-        out << " */\n";
-
-        /* Generate module declaration */
-        out << "module " << moduleName;
-
-        /* Add module parameters if they exist */
-        if (moduleData["parameter"] && moduleData["parameter"].IsMap()
-            && moduleData["parameter"].size() > 0) {
-            out << " #(\n";
-            QStringList paramDeclarations;
-
-            for (auto paramIter = moduleData["parameter"].begin();
-                 paramIter != moduleData["parameter"].end();
-                 ++paramIter) {
-                if (!paramIter->first.IsScalar()) {
-                    qWarning() << "Warning: Invalid parameter name, skipping";
-                    continue;
-                }
-
-                const QString paramName = QString::fromStdString(paramIter->first.as<std::string>());
-
-                if (!paramIter->second.IsMap()) {
-                    qWarning() << "Warning: Parameter" << paramName
-                               << "has invalid format, skipping";
-                    continue;
-                }
-
-                /* Default to empty for Verilog 2001 */
-                QString paramType  = "";
-                QString paramValue = "";
-
-                if (paramIter->second["type"] && paramIter->second["type"].IsScalar()) {
-                    paramType = QString::fromStdString(paramIter->second["type"].as<std::string>());
-                    /* Clean type for Verilog 2001 compatibility */
-                    paramType = QSocGenerateManager::cleanTypeForWireDeclaration(paramType);
-
-                    /* Add a space if type isn't empty after processing */
-                    if (!paramType.isEmpty() && !paramType.endsWith(" ")) {
-                        paramType += " ";
-                    }
-                }
-
-                if (paramIter->second["value"] && paramIter->second["value"].IsScalar()) {
-                    paramValue = QString::fromStdString(
-                        paramIter->second["value"].as<std::string>());
-                }
+    out << " */\n";
 
-                paramDeclarations.append(QString("    parameter %1%2 = %3  /**< %4 */")
-                                             .arg(paramType)
-                                             .arg(paramName)
-                                             .arg(paramValue.isEmpty() ? "0" : paramValue)
-                                             .arg(paramName));
-            }
+    /* Generate module declaration */
+    out << "module " << module.name;
 
-            if (!paramDeclarations.isEmpty()) {
-                out << paramDeclarations.join(",\n") << "\n";
+    /* Add module parameters if they exist */
+    if (module.hasParameter) {
+        out << " #(\n";
+        QStringList paramDeclarations;
+        for (const StubParameter &parameter : module.parameterList) {
+            if (!parameter.declared) {
+                continue;
             }
-            out << ")";
+            /* Default to zero for Verilog 2001 */
+            paramDeclarations.append(QString("    parameter %1%2 = %3  /**< %4 */")
+                                         .arg(parameter.type)
+                                         .arg(parameter.name)
+                                         .arg(parameter.value.isEmpty() ? "0" : parameter.value)
+                                         .arg(parameter.name));
         }
+        if (!paramDeclarations.isEmpty()) {
+            out << paramDeclarations.join(",\n") << "\n";
+        }
+        out << ")";
+    }
 
-        /* Start port list */
-        out << " (\n";
-
-        /* Collect all ports for module interface */
-        QStringList ports;
-
-        /* Process port section if it exists */
-        if (moduleData["port"] && moduleData["port"].IsMap()) {
-            for (auto portIter = moduleData["port"].begin(); portIter != moduleData["port"].end();
-                 ++portIter) {
-                if (!portIter->first.IsScalar()) {
-                    qWarning() << "Warning: Invalid port name, skipping";
-                    continue;
-                }
-
-                const QString portName = QString::fromStdString(portIter->first.as<std::string>());
+    /* Start port list */
+    out << " (\n";
+
+    QStringList ports;
+    for (const StubPort &port : module.portList) {
+        const QString portDeclaration = port.type.isEmpty() ? port.name
+                                                            : port.type + " " + port.name;
+        ports.append(QString("    %1 %2    /**< %3 */")
+                         .arg(port.direction)
+                         .arg(portDeclaration)
+                         .arg(port.description));
+    }
 
-                if (!portIter->second.IsMap()) {
-                    qWarning() << "Warning: Port" << portName << "has invalid format, skipping";
-                    continue;
-                }
+    /* Close module declaration */
+    if (!ports.isEmpty()) {
+        out << ports.join(",\n") << "\n";
+    }
+    out << ");\n";
 
-                QString direction = "input";
-                QString type      = ""; /* Empty type by default for Verilog 2001 */
-
-                if (portIter->second["direction"] && portIter->second["direction"].IsScalar()) {
-                    const QString dirStr = QString::fromStdString(
-                                               portIter->second["direction"].as<std::string>())
-                                               .toLower();
-
-                    /* Handle both full and abbreviated forms */
-                    if (dirStr == "out" || dirStr == "output") {
-                        direction = "output";
-                    } else if (dirStr == "in" || dirStr == "input") {
-                        direction = "input";
-                    } else if (dirStr == "inout") {
-                        direction = "inout";
-                    }
-                }
+    /* Add stub comment */
+    out << "/* It is a stub, not a complete implementation */\n";
 
-                /* Get port type/width information if present */
-                if (portIter->second["type"] && portIter->second["type"].IsScalar()) {
-                    type = QString::fromStdString(portIter->second["type"].as<std::string>());
-                    /* Clean type for Verilog 2001 compatibility */
-                    type = QSocGenerateManager::cleanTypeForWireDeclaration(type);
-                }
+    /* Close module */
+    out << "endmodule\n\n";
 
-                /* Get port description if available */
-                QString description = portName;
-                if (portIter->second["description"] && portIter->second["description"].IsScalar()) {
-                    description = QString::fromStdString(
-                        portIter->second["description"].as<std::string>());
-                }
+    out.flush();
+    return text;
+}
 
-                /* Add port declaration */
-                QString portDeclaration = portName;
-                if (!type.isEmpty()) {
-                    portDeclaration = type + " " + portName;
-                }
-                ports.append(QString("    %1 %2    /**< %3 */")
-                                 .arg(direction)
-                                 .arg(portDeclaration)
-                                 .arg(description));
-            }
-        }
+/* Setup and hold arcs apply to inputs, clock to output arcs to outputs */
+bool hasConstraintArc(const StubPort &port)
+{
+    return !port.isClock && !port.timing.clock.isEmpty() && port.direction != "output"
+           && (!port.timing.setup.isEmpty() || !port.timing.hold.isEmpty());
+}
 
-        /* Close module declaration */
-        if (!ports.isEmpty()) {
-            out << ports.join(",\n") << "\n";
-        }
-        out << ");\n";
+bool hasDelayArc(const StubPort &port)
+{
+    return !port.isClock && !port.timing.clock.isEmpty() && port.direction != "input"
+           && !port.timing.clockToQ.isEmpty();
+}
 
-        /* Add stub comment */
-        out << "/* It is a stub, not a complete implementation */\n";
+/* Named single point tables of a timing group */
+using StubTableList = QList<QPair<const char *, QString>>;
 
-        /* Close module */
-        out << "endmodule\n\n";
+void writeLibTimingGroup(
+    QTextStream         &out,
+    const StubPort      &port,
+    const QString       &indent,
+    const char          *timingType,
+    const char          *templateName,
+    const StubTableList &tableList)
+{
+    out << indent << "timing ()  {\n";
+    out << indent << "    related_pin : \"" << port.timing.clock << "\";\n";
+    out << indent << "    timing_type : " << timingType << ";\n";
+    for (const auto &[table, value] : tableList) {
+        out << indent << "    " << table << " (" << templateName << ")  {\n";
+        out << indent << "        values (\"" << value << "\");\n";
+        out << indent << "    }\n";
     }
-
-    outputFile.close();
-    qInfo() << "Successfully generated Verilog stub file:" << outputFilePath;
-
-    return true;
+    out << indent << "}\n";
 }
 
-bool QSocGenerateManager::generateLibStub(const QString &stubName, const QStringList &moduleNames)
+/* Timing groups of a pin or bus, each value is a single point NLDM table */
+void writeLibTiming(QTextStream &out, const StubPort &port, const QString &indent)
 {
-    /* Prepare output file path */
-    const QString outputFilePath = QDir(projectManager->getOutputPath()).filePath(stubName + ".lib");
+    if (hasConstraintArc(port)) {
+        if (!port.timing.setup.isEmpty()) {
+            writeLibTimingGroup(
+                out,
+                port,
+                indent,
+                "setup_rising",
+                "qsoc_constraint_template",
+                {{"rise_constraint", port.timing.setup}, {"fall_constraint", port.timing.setup}});
+        }
+        if (!port.timing.hold.isEmpty()) {
+            writeLibTimingGroup(
+                out,
+                port,
+                indent,
+                "hold_rising",
+                "qsoc_constraint_template",
+                {{"rise_constraint", port.timing.hold}, {"fall_constraint", port.timing.hold}});
+        }
+    }
 
-    /* Open output file for writing */
-    QFile outputFile(outputFilePath);
-    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qCritical() << "Error: Failed to open output file for writing:" << outputFilePath;
-        return false;
+    if (hasDelayArc(port)) {
+        StubTableList tableList
+            = {{"cell_rise", port.timing.clockToQ}, {"cell_fall", port.timing.clockToQ}};
+        /* The transition limit bounds the output slew */
+        if (!port.timing.maxTransition.isEmpty()) {
+            tableList.append({"rise_transition", port.timing.maxTransition});
+            tableList.append({"fall_transition", port.timing.maxTransition});
+        }
+        writeLibTimingGroup(out, port, indent, "rising_edge", "qsoc_delay_template", tableList);
     }
+}
 
-    QTextStream out(&outputFile);
+QString libStubHeader(const QString &stubName, const QList<StubModule> &moduleList)
+{
+    QString     text;
+    QTextStream out(&text);
 
     /* Generate library header */
     out << "library (" << stubName << ")  {\n\n";
@@ -356,32 +556,13 @@ bool QSocGenerateManager::generateLibStub(const QString &stubName, const QString
 
     /* Generate type declarations for bus widths */
     QSet<int> busWidths;
-    for (const QString &moduleName : moduleNames) {
-        if (!moduleManager->isModuleExist(moduleName)) {
-            continue;
-        }
-
-        YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
-        if (moduleData["port"] && moduleData["port"].IsMap()) {
-            for (auto portIter = moduleData["port"].begin(); portIter != moduleData["port"].end();
-                 ++portIter) {
-                if (!portIter->second.IsMap())
-                    continue;
-
-                if (portIter->second["type"] && portIter->second["type"].IsScalar()) {
-                    QString type = QString::fromStdString(
-                        portIter->second["type"].as<std::string>());
-                    type = QSocGenerateManager::cleanTypeForWireDeclaration(type);
-
-                    /* Extract width from [N:0] format */
-                    const QRegularExpression      widthRegex(R"(\[(\d+):0\])");
-                    const QRegularExpressionMatch match = widthRegex.match(type);
-                    if (match.hasMatch()) {
-                        const int width = match.captured(1).toInt() + 1;
-                        busWidths.insert(width);
-                    }
-                }
+    bool      hasArc = false;
+    for (const StubModule &module : moduleList) {
+        for (const StubPort &port : module.portList) {
+            if (port.width > 0) {
+                busWidths.insert(port.width);
             }
+            hasArc = hasArc || hasConstraintArc(port) || hasDelayArc(port);
         }
     }
 
@@ -406,6 +587,23 @@ bool QSocGenerateManager::generateLibStub(const QString &stubName, const QString
         out << "\n\n";
     }
 
+    /* Timing arcs share two single point templates */
+    if (hasArc) {
+        out << "/* Timing templates */\n\n";
+        out << "  lu_table_template (qsoc_delay_template)  {\n";
+        out << "    variable_1 : input_net_transition;\n";
+        out << "    variable_2 : total_output_net_capacitance;\n";
+        out << "    index_1 (\"0.0\");\n";
+        out << "    index_2 (\"0.0\");\n";
+        out << "  }\n\n";
+        out << "  lu_table_template (qsoc_constraint_template)  {\n";
+        out << "    variable_1 : related_pin_transition;\n";
+        out << "    variable_2 : constrained_pin_transition;\n";
+        out << "    index_1 (\"0.0\");\n";
+        out << "    index_2 (\"0.0\");\n";
+        out << "  }\n\n\n";
+    }
+
     /* Cell descriptions */
     out << "/* **************************** */\n";
     out << "/* ****  Cell Description  **** */\n";
@@ -417,111 +615,327 @@ bool QSocGenerateManager::generateLibStub(const QString &stubName, const QString
     out << "    voltage_map(DVSS   , 0);\n";
     out << "    voltage_map(AVSS   , 0);\n\n";
 
-    /* Generate cell for each module */
+    out.flush();
+    return text;
+}
+
+QString libStubModule(const StubModule &module)
+{
+    QString     text;
+    QTextStream out(&text);
+
+    out << "cell (" << module.name << ")  {\n\n";
+
+    out << "   area            : 100;\n";
+    out << "   dont_touch      : true;\n";
+    out << "   dont_use        : true;\n";
+    out << "   map_only        : true;\n\n";
+
+    /* Standard power pins */
+    out << "   pg_pin(AVDD)  {\n";
+    out << "           voltage_name : AVDD ;\n";
+    out << "           pg_type : primary_power ;\n";
+    out << "   }\n\n";
+
+    out << "   pg_pin(AVSS)  {\n";
+    out << "           voltage_name : AVSS ;\n";
+    out << "           pg_type : primary_ground ;\n";
+    out << "   }\n\n";
+
+    out << "   pg_pin(DVDD)  {\n";
+    out << "           voltage_name : DVDD ;\n";
+    out << "           pg_type : primary_power ;\n";
+    out << "   }\n\n";
+
+    out << "   pg_pin(DVSS)  {\n";
+    out << "           voltage_name : DVSS ;\n";
+    out << "           pg_type : primary_ground ;\n";
+    out << "   }\n\n";
+
+    for (const StubPort &port : module.portList) {
+        /* Pin capacitance defaults to the library input pin capacitance */
+        const QString capacitance = port.timing.capacitance.isEmpty() ? QString("0.02")
+                                                                      : port.timing.capacitance;
+        if (port.width > 0) {
+            out << "   bus(" << port.name << ") {\n";
+            out << "        bus_type       : \"DATA" << port.width << "B\";\n";
+            out << "        related_power_pin : DVDD ;\n";
+            out << "        related_ground_pin  : DVSS ;\n";
+            if (!port.timing.maxTransition.isEmpty()) {
+                out << "        max_transition : " << port.timing.maxTransition << ";\n";
+            }
+            out << "\n";
+
+            for (int i = 0; i < port.width; i++) {
+                out << "        pin (" << port.name << "[" << i << "]) {\n";
+                out << "        direction      : " << port.direction << ";\n";
+                out << "        capacitance    : " << capacitance << ";\n";
+                out << "        }\n\n";
+            }
+
+            writeLibTiming(out, port, "        ");
+            out << "}  /* end of bus " << port.name << " */\n\n";
+        } else {
+            /* Single bit port */
+            out << "   pin(" << port.name << ")  {\n";
+            out << "           direction : " << port.direction << ";\n";
+            if (port.isClock) {
+                out << "           clock : true;\n";
+            }
+            out << "           capacitance : " << capacitance << ";\n";
+            if (!port.timing.maxTransition.isEmpty()) {
+                out << "           max_transition : " << port.timing.maxTransition << ";\n";
+            }
+            out << "           related_power_pin : DVDD ;\n";
+            out << "           related_ground_pin  : DVSS ;\n";
+            writeLibTiming(out, port, "           ");
+            out << "   }\n\n";
+        }
+    }
+
+    out << "}  /* end of cell " << module.name << " */\n\n";
+
+    out.flush();
+    return text;
+}
+
+/* Render modules on pool threads, text lists keep the module order */
+void renderStubModules(
+    const QList<StubModule> &moduleList,
+    std::vector<QString>    *verilogTextList,
+    std::vector<QString>    *libTextList)
+{
+    if (verilogTextList) {
+        verilogTextList->assign(moduleList.size(), QString());
+    }
+    if (libTextList) {
+        libTextList->assign(moduleList.size(), QString());
+    }
+
+    std::atomic<qsizetype> nextIndex{0};
+    const auto             render = [&]() {
+        qsizetype index = 0;
+        while ((index = nextIndex++) < moduleList.size()) {
+            const StubModule &module = moduleList.at(index);
+            if (verilogTextList) {
+                (*verilogTextList)[index] = verilogStubModule(module);
+            }
+            if (libTextList) {
+                (*libTextList)[index] = libStubModule(module);
+            }
+        }
+    };
+
+    const int jobs = static_cast<int>(qMin<qsizetype>(
+        QThread::idealThreadCount(), moduleList.size() / stubParallelThreshold));
+    if (jobs <= 1) {
+        render();
+        return;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    for (int job = 0; job < jobs; ++job) {
+        pool.start(render);
+    }
+    pool.waitForDone();
+}
+
+bool writeStubFile(
+    const QString              &filePath,
+    const QString              &header,
+    const std::vector<QString> &textList,
+    const QString              &footer)
+{
+    QFile outputFile(filePath);
+    if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCritical() << "Error: Failed to open output file for writing:" << filePath;
+        return false;
+    }
+
+    /* QFile buffers the writes, module text is already rendered */
+    outputFile.write(header.toUtf8());
+    for (const QString &text : textList) {
+        outputFile.write(text.toUtf8());
+    }
+    outputFile.write(footer.toUtf8());
+    outputFile.close();
+    return true;
+}
+
+} /* namespace */
+
+bool QSocGenerateManager::generateStub(
+    const QString            &stubName,
+    const QRegularExpression &libraryRegex,
+    const QRegularExpression &moduleRegex,
+    const QStringList        &timingFiles)
+{
+    /* Check if project manager is valid */
+    if (!projectManager) {
+        qCritical() << "Error: Project manager is null";
+        return false;
+    }
+
+    if (!projectManager->isValidOutputPath(true)) {
+        qCritical() << "Error: Invalid output path: " << projectManager->getOutputPath();
+        return false;
+    }
+
+    /* Check if module manager is valid */
+    if (!moduleManager) {
+        qCritical() << "Error: Module manager is null";
+        return false;
+    }
+
+    /* Select the modules of matching libraries in one pass over the library data */
+    const YAML::Node moduleYamls = moduleManager->getModuleYamls();
+    YAML::Node       selectedYamls;
+    QStringList      selectedModules;
+
+    for (auto moduleIter = moduleYamls.begin(); moduleIter != moduleYamls.end(); ++moduleIter) {
+        const QString moduleName = QString::fromStdString(moduleIter->first.as<std::string>());
+        if (!moduleRegex.match(moduleName).hasMatch()) {
+            continue;
+        }
+        const YAML::Node library = moduleIter->second["library"];
+        if (library && library.IsScalar()
+            && !QStaticRegex::isNameExactMatch(
+                QString::fromStdString(library.as<std::string>()), libraryRegex)) {
+            continue;
+        }
+        selectedYamls.force_insert(moduleIter->first, moduleIter->second);
+        selectedModules.append(moduleName);
+    }
+
+    if (selectedModules.isEmpty()) {
+        qCritical() << "Error: No modules found matching the specified criteria";
+        return false;
+    }
+
+    if (!applyStubTimingFiles(timingFiles, selectedYamls)) {
+        return false;
+    }
+
+    qInfo() << "Found" << selectedModules.size()
+            << "modules matching criteria:" << selectedModules.join(", ");
+
+    /* Generate Verilog and Lib stub files from the same descriptors */
+    return generateStubFiles(stubName, selectedYamls, true, true);
+}
+
+bool QSocGenerateManager::generateVerilogStub(const QString &stubName, const QStringList &moduleNames)
+{
+    return generateStubFiles(stubName, getStubModuleYamls(moduleNames), true, false);
+}
+
+bool QSocGenerateManager::generateLibStub(const QString &stubName, const QStringList &moduleNames)
+{
+    return generateStubFiles(stubName, getStubModuleYamls(moduleNames), false, true);
+}
+
+YAML::Node QSocGenerateManager::getStubModuleYamls(const QStringList &moduleNames)
+{
+    YAML::Node result;
     for (const QString &moduleName : moduleNames) {
         if (!moduleManager->isModuleExist(moduleName)) {
+            qWarning() << "Warning: Module" << moduleName << "does not exist, skipping";
             continue;
         }
+        result.force_insert(moduleName.toStdString(), moduleManager->getModuleYaml(moduleName));
+    }
+    return result;
+}
 
-        YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
-
-        out << "cell (" << moduleName << ")  {\n\n";
-
-        out << "   area            : 100;\n";
-        out << "   dont_touch      : true;\n";
-        out << "   dont_use        : true;\n";
-        out << "   map_only        : true;\n\n";
-
-        /* Standard power pins */
-        out << "   pg_pin(AVDD)  {\n";
-        out << "           voltage_name : AVDD ;\n";
-        out << "           pg_type : primary_power ;\n";
-        out << "   }\n\n";
-
-        out << "   pg_pin(AVSS)  {\n";
-        out << "           voltage_name : AVSS ;\n";
-        out << "           pg_type : primary_ground ;\n";
-        out << "   }\n\n";
-
-        out << "   pg_pin(DVDD)  {\n";
-        out << "           voltage_name : DVDD ;\n";
-        out << "           pg_type : primary_power ;\n";
-        out << "   }\n\n";
-
-        out << "   pg_pin(DVSS)  {\n";
-        out << "           voltage_name : DVSS ;\n";
-        out << "           pg_type : primary_ground ;\n";
-        out << "   }\n\n";
-
-        /* Process port section if it exists */
-        if (moduleData["port"] && moduleData["port"].IsMap()) {
-            for (auto portIter = moduleData["port"].begin(); portIter != moduleData["port"].end();
-                 ++portIter) {
-                if (!portIter->first.IsScalar() || !portIter->second.IsMap()) {
-                    continue;
-                }
-
-                const QString portName  = QString::fromStdString(portIter->first.as<std::string>());
-                QString       direction = "input";
-                QString       type      = "";
-
-                if (portIter->second["direction"] && portIter->second["direction"].IsScalar()) {
-                    const QString dirStr = QString::fromStdString(
-                                               portIter->second["direction"].as<std::string>())
-                                               .toLower();
-                    if (dirStr == "out" || dirStr == "output") {
-                        direction = "output";
-                    } else if (dirStr == "in" || dirStr == "input") {
-                        direction = "input";
-                    } else if (dirStr == "inout") {
-                        direction = "inout";
-                    }
-                }
+bool QSocGenerateManager::applyStubTimingFiles(
+    const QStringList &timingFiles, YAML::Node &moduleYamls)
+{
+    QHash<QString, QList<StubTimingRow>> rowMap;
+    for (const QString &filePath : timingFiles) {
+        if (!readStubTimingFile(filePath, rowMap)) {
+            return false;
+        }
+    }
+    if (rowMap.isEmpty()) {
+        return true;
+    }
 
-                if (portIter->second["type"] && portIter->second["type"].IsScalar()) {
-                    type = QString::fromStdString(portIter->second["type"].as<std::string>());
-                    type = QSocGenerateManager::cleanTypeForWireDeclaration(type);
-                }
+    YAML::Node result;
+    for (auto moduleIter = moduleYamls.begin(); moduleIter != moduleYamls.end(); ++moduleIter) {
+        const QString moduleName = QString::fromStdString(moduleIter->first.as<std::string>());
+        const QList<StubTimingRow> rowList = rowMap.value("*") + rowMap.value(moduleName);
+        if (rowList.isEmpty()) {
+            result.force_insert(moduleIter->first, moduleIter->second);
+            continue;
+        }
 
-                /* Check if this is a bus port */
-                const QRegularExpression      busRegex(R"(\[(\d+):0\])");
-                const QRegularExpressionMatch busMatch = busRegex.match(type);
-
-                if (busMatch.hasMatch()) {
-                    const int width = busMatch.captured(1).toInt() + 1;
-                    out << "   bus(" << portName << ") {\n";
-                    out << "        bus_type       : \"DATA" << width << "B\";\n";
-                    out << "        related_power_pin : DVDD ;\n";
-                    out << "        related_ground_pin  : DVSS ;\n\n";
-
-                    for (int i = 0; i < width; i++) {
-                        out << "        pin (" << portName << "[" << i << "]) {\n";
-                        out << "        direction      : " << direction << ";\n";
-                        out << "        capacitance    : 0.02;\n";
-                        out << "        }\n\n";
-                    }
-
-                    out << "}  /* end of bus " << portName << " */\n\n";
-                } else {
-                    /* Single bit port */
-                    out << "   pin(" << portName << ")  {\n";
-                    out << "           direction : " << direction << ";\n";
-                    out << "           capacitance : 0.02;\n";
-                    out << "           related_power_pin : DVDD ;\n";
-                    out << "           related_ground_pin  : DVSS ;\n";
-                    out << "   }\n\n";
+        /* Later rows override earlier ones, and both override the module YAML */
+        YAML::Node        module = YAML::Clone(moduleIter->second);
+        const YAML::Node &view   = module;
+        for (const StubTimingRow &row : rowList) {
+            const std::string portName = row.port.toStdString();
+            if (!row.port.isEmpty() && !view["port"][portName].IsMap()) {
+                if (row.module != "*") {
+                    qWarning() << "Warning: Timing row for unknown port" << row.port << "of module"
+                               << moduleName << ", skipping";
                 }
+                continue;
+            }
+            YAML::Node timing = row.port.isEmpty() ? module["timing"]
+                                                   : module["port"][portName]["timing"];
+            if (timing && !timing.IsMap()) {
+                qWarning() << "Warning: Timing section of" << moduleName
+                           << "is not a map, skipping";
+                continue;
+            }
+            for (const auto &[key, value] : row.valueList) {
+                timing[key] = value;
             }
         }
+        result.force_insert(moduleIter->first, module);
+    }
+    moduleYamls = result;
+    return true;
+}
 
-        out << "}  /* end of cell " << moduleName << " */\n\n";
+bool QSocGenerateManager::generateStubFiles(
+    const QString &stubName, const YAML::Node &moduleYamls, bool verilog, bool lib)
+{
+    /* Pull each descriptor once, rendering never touches YAML */
+    QList<StubModule> moduleList;
+    for (auto moduleIter = moduleYamls.begin(); moduleIter != moduleYamls.end(); ++moduleIter) {
+        moduleList.append(readStubModule(
+            QString::fromStdString(moduleIter->first.as<std::string>()), moduleIter->second));
     }
 
-    /* Close library */
-    out << "}  /* end of library */\n";
+    std::vector<QString> verilogTextList;
+    std::vector<QString> libTextList;
+    renderStubModules(
+        moduleList, verilog ? &verilogTextList : nullptr, lib ? &libTextList : nullptr);
 
-    outputFile.close();
-    qInfo() << "Successfully generated Lib stub file:" << outputFilePath;
+    const QDir outputDir(projectManager->getOutputPath());
+
+    if (verilog) {
+        const QString outputFilePath = outputDir.filePath(stubName + ".v");
+        if (!writeStubFile(outputFilePath, verilogStubHeader(stubName), verilogTextList, {})) {
+            qCritical() << "Error: Failed to generate Verilog stub file";
+            return false;
+        }
+        qInfo() << "Successfully generated Verilog stub file:" << outputFilePath;
+    }
+
+    if (lib) {
+        const QString outputFilePath = outputDir.filePath(stubName + ".lib");
+        if (!writeStubFile(
+                outputFilePath,
+                libStubHeader(stubName, moduleList),
+                libTextList,
+                "}  /* end of library */\n")) {
+            qCritical() << "Error: Failed to generate Lib stub file";
+            return false;
+        }
+        qInfo() << "Successfully generated Lib stub file:" << outputFilePath;
+    }
 
     return true;
 }
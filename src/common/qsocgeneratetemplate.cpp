@@ -9,17 +9,205 @@
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QRegularExpression>
+#include <QSaveFile>
 #include <QTextStream>
 
 #include <systemrdl_api.h>
 
+#include <algorithm>
 #include <charconv>
 #include <fmt/format.h>
 #include <fstream>
+#include <iomanip>
 #include <inja/inja.hpp>
+#include <map>
 #include <nlohmann/json.hpp>
+#include <numeric>
+#include <optional>
 #include <rapidcsv.h>
 #include <sstream>
+#include <streambuf>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+/* Write-only stream buffer over a device, the output never has to fit in memory */
+class DeviceStreamBuffer : public std::streambuf
+{
+public:
+    explicit DeviceStreamBuffer(QIODevice *device)
+        : device(device)
+        , buffer(bufferSize)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    ~DeviceStreamBuffer() override { sync(); }
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        if (!writeBuffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(character, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(character);
+            pbump(1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    int sync() override { return writeBuffer() ? 0 : -1; }
+
+private:
+    static constexpr std::size_t bufferSize = 1 << 20;
+
+    bool writeBuffer()
+    {
+        const qint64 size = pptr() - pbase();
+        if (size > 0 && device->write(pbase(), size) != size) {
+            return false;
+        }
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return true;
+    }
+
+    QIODevice        *device;
+    std::vector<char> buffer;
+};
+
+/* Hash indexes over the arrays of one render's data, each built on first use */
+class TemplateIndexCache
+{
+public:
+    using json        = nlohmann::json;
+    using PositionMap = std::unordered_map<std::string, std::size_t>;
+
+    /* Arrays of the data keep their address for the whole render, others may not */
+    explicit TemplateIndexCache(const json &data) { collectArrays(data); }
+
+    /* Text of a value as an index key, so 5 and "5" match, empty for containers */
+    static std::optional<std::string> keyText(const json &value)
+    {
+        if (value.is_string()) {
+            return value.get<std::string>();
+        }
+        if (value.is_number() || value.is_boolean()) {
+            return value.dump();
+        }
+        return std::nullopt;
+    }
+
+    /* Field of an element by name, a dotted name walks nested objects */
+    static const json *field(const json &element, const std::string &key)
+    {
+        const json *current = &element;
+        std::size_t start   = 0;
+        while (current->is_object()) {
+            const std::size_t end  = key.find('.', start);
+            const auto        iter = current->find(key.substr(start, end - start));
+            if (iter == current->end()) {
+                return nullptr;
+            }
+            current = &iter.value();
+            if (end == std::string::npos) {
+                return current;
+            }
+            start = end + 1;
+        }
+        return nullptr;
+    }
+
+    /* Position of the first element for every key value of an array */
+    const PositionMap &positionMap(const json &array, const std::string &key)
+    {
+        const bool cached = dataArraySet.count(&array) > 0;
+        if (cached) {
+            const auto iter = positionCache.find({&array, key});
+            if (iter != positionCache.end()) {
+                return iter->second;
+            }
+        }
+        PositionMap positions;
+        positions.reserve(array.size());
+        for (std::size_t index = 0; index < array.size(); ++index) {
+            const json *value = field(array[index], key);
+            if (const auto text = value ? keyText(*value) : std::nullopt) {
+                positions.try_emplace(*text, index);
+            }
+        }
+        if (!cached) {
+            scratchPositions = std::move(positions);
+            return scratchPositions;
+        }
+        return positionCache[{&array, key}] = std::move(positions);
+    }
+
+    /* Object of the first element by key value */
+    json indexBy(const json &array, const std::string &key)
+    {
+        warnRepeatedCall("index_by", array, key);
+        json result = json::object();
+        for (const auto &[text, index] : positionMap(array, key)) {
+            result[text] = array[index];
+        }
+        return result;
+    }
+
+    /* Object of the element arrays by key value, in array order */
+    json groupBy(const json &array, const std::string &key)
+    {
+        warnRepeatedCall("group_by", array, key);
+        json result = json::object();
+        for (const auto &element : array) {
+            const json *value = field(element, key);
+            if (const auto text = value ? keyText(*value) : std::nullopt) {
+                result[*text].push_back(element);
+            }
+        }
+        return result;
+    }
+
+private:
+    using CacheKey = std::pair<const json *, std::string>;
+
+    void collectArrays(const json &node)
+    {
+        if (node.is_array()) {
+            dataArraySet.insert(&node);
+        }
+        if (node.is_structured()) {
+            for (const auto &child : node) {
+                collectArrays(child);
+            }
+        }
+    }
+
+    /* Every call returns a new object, so a call inside a loop is as slow as a nested loop */
+    void warnRepeatedCall(const std::string &filter, const json &array, const std::string &key)
+    {
+        if (dataArraySet.count(&array) == 0) {
+            return;
+        }
+        if (++callCount[{filter, {&array, key}}] == 2) {
+            qWarning() << QCoreApplication::translate(
+                              "generate",
+                              "Warning: %1 on key \"%2\" is called again on the same array, "
+                              "keep its result with set")
+                              .arg(QString::fromStdString(filter), QString::fromStdString(key));
+        }
+    }
+
+    std::unordered_set<const json *>                dataArraySet;
+    std::map<CacheKey, PositionMap>                 positionCache;
+    std::map<std::pair<std::string, CacheKey>, int> callCount;
+    PositionMap                                     scratchPositions;
+};
+
+} /* namespace */
 
 bool QSocGenerateManager::renderTemplate(
     const QString     &templateFilePath,
@@ -33,6 +221,13 @@ bool QSocGenerateManager::renderTemplate(
     using json      = nlohmann::json;
     json dataObject = json::object();
 
+    /* Every data file is an input of the rendered output */
+    for (const QStringList *fileList : {&csvFiles, &yamlFiles, &jsonFiles, &rdlFiles, &rcsvFiles}) {
+        for (const QString &filePath : *fileList) {
+            addDependency(filePath);
+        }
+    }
+
     /* Create a global data array for all CSV data */
     json globalDataArray = json::array();
 
@@ -424,9 +619,33 @@ bool QSocGenerateManager::renderTemplate(
         const QByteArray templateData = templateFile.readAll();
         templateFile.close();
 
+        /* Included templates are read relative to the working directory */
+        addDependency(templateFilePath);
+        static const QRegularExpression includeRegex(
+            R"re(\{%-?\s*(?:include|extends)\s+"([^"]+)")re");
+        QStringList pendingList = {QString::fromUtf8(templateData)};
+        while (!pendingList.isEmpty()) {
+            auto matchIterator = includeRegex.globalMatch(pendingList.takeLast());
+            while (matchIterator.hasNext()) {
+                const QString includePath = matchIterator.next().captured(1);
+                if (!QFile::exists(includePath)
+                    || dependencyList.contains(QFileInfo(includePath).absoluteFilePath())) {
+                    continue;
+                }
+                addDependency(includePath);
+                QFile includeFile(includePath);
+                if (includeFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                    pendingList.append(QString::fromUtf8(includeFile.readAll()));
+                }
+            }
+        }
+
         /* Setup inja environment */
         inja::Environment env;
 
+        /* Indexes for the join callbacks, the data stays unchanged while rendering */
+        TemplateIndexCache indexCache(dataObject);
+
         /* Disable line statements */
         env.set_line_statement("");
 
@@ -650,14 +869,97 @@ bool QSocGenerateManager::renderTemplate(
             }
         });
 
-        /* Render template */
-        const std::string templateStr = templateData.toStdString();
-        const std::string result      = env.render(templateStr, dataObject);
+        /* Add index_by filter - object of the first element by key value */
+        env.add_callback("index_by", [&indexCache](inja::Arguments &args) -> nlohmann::json {
+            if (args.size() < 2 || !args.at(0)->is_array() || !args.at(1)->is_string()) {
+                qWarning() << QCoreApplication::translate(
+                    "generate", "Warning: index_by requires 2 arguments (array, key)");
+                return nlohmann::json::object();
+            }
+            return indexCache.indexBy(*args.at(0), args.at(1)->get<std::string>());
+        });
+
+        /* Add group_by filter - object of the element arrays by key value */
+        env.add_callback("group_by", [&indexCache](inja::Arguments &args) -> nlohmann::json {
+            if (args.size() < 2 || !args.at(0)->is_array() || !args.at(1)->is_string()) {
+                qWarning() << QCoreApplication::translate(
+                    "generate", "Warning: group_by requires 2 arguments (array, key)");
+                return nlohmann::json::object();
+            }
+            return indexCache.groupBy(*args.at(0), args.at(1)->get<std::string>());
+        });
+
+        /* Add lookup filter - one element by key value, null when there is none */
+        env.add_callback("lookup", [&indexCache](inja::Arguments &args) -> nlohmann::json {
+            /* lookup(index, value) on an index_by or group_by object */
+            if (args.size() == 2 && args.at(0)->is_object()) {
+                const auto text = TemplateIndexCache::keyText(*args.at(1));
+                if (!text) {
+                    return nullptr;
+                }
+                const auto iter = args.at(0)->find(*text);
+                return iter != args.at(0)->end() ? *iter : nlohmann::json();
+            }
+            /* lookup(array, key, value) through a hash index kept for the render */
+            if (args.size() == 3 && args.at(0)->is_array() && args.at(1)->is_string()) {
+                const auto text = TemplateIndexCache::keyText(*args.at(2));
+                if (!text) {
+                    return nullptr;
+                }
+                const auto &positionMap
+                    = indexCache.positionMap(*args.at(0), args.at(1)->get<std::string>());
+                const auto iter = positionMap.find(*text);
+                return iter != positionMap.end() ? (*args.at(0))[iter->second] : nlohmann::json();
+            }
+            qWarning() << QCoreApplication::translate(
+                "generate",
+                "Warning: lookup requires 2 arguments (index, value) or 3 arguments (array, "
+                "key, value)");
+            return nullptr;
+        });
+
+        /* Add sort_by filter - stable sort of an array by key value */
+        env.add_callback("sort_by", [](inja::Arguments &args) -> nlohmann::json {
+            if (args.size() < 2 || !args.at(0)->is_array() || !args.at(1)->is_string()) {
+                qWarning() << QCoreApplication::translate(
+                    "generate", "Warning: sort_by requires at least 2 arguments (array, key)");
+                return nlohmann::json::array();
+            }
+
+            const nlohmann::json &array   = *args.at(0);
+            const std::string     key     = args.at(1)->get<std::string>();
+            const bool            reverse = args.size() > 2 && args.at(2)->is_boolean()
+                                            && args.at(2)->get<bool>();
+
+            /* Elements without the key sort as null, before every value */
+            static const nlohmann::json         nullValue;
+            std::vector<const nlohmann::json *> valueList;
+            valueList.reserve(array.size());
+            for (const auto &element : array) {
+                const nlohmann::json *value = TemplateIndexCache::field(element, key);
+                valueList.push_back(value ? value : &nullValue);
+            }
+            std::vector<std::size_t> order(array.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t left, std::size_t right) {
+                return reverse ? *valueList[right] < *valueList[left]
+                               : *valueList[left] < *valueList[right];
+            });
+
+            nlohmann::json result = nlohmann::json::array();
+            for (const std::size_t index : order) {
+                result.push_back(array[index]);
+            }
+            return result;
+        });
+
+        /* Parse first, a syntax error leaves no output file behind */
+        const inja::Template parsedTemplate = env.parse(templateData.toStdString());
 
         /* Create output file */
         const QString outputPath = projectManager->getOutputPath() + QDir::separator()
                                    + outputFileName;
-        QFile outputFile(outputPath);
+        QSaveFile outputFile(outputPath);
         if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
             qCritical() << QCoreApplication::translate(
                                "generate", "Error: Could not create output file \"%1\"")
@@ -665,9 +967,22 @@ bool QSocGenerateManager::renderTemplate(
             return false;
         }
 
-        QTextStream stream(&outputFile);
-        stream << QString::fromStdString(result);
-        outputFile.close();
+        /* Render straight into the file, a render error discards the partial output */
+        {
+            DeviceStreamBuffer outputBuffer(&outputFile);
+            std::ostream       outputStream(&outputBuffer);
+            env.render_to(outputStream, parsedTemplate, dataObject);
+            outputStream.flush();
+            if (!outputStream) {
+                outputFile.cancelWriting();
+            }
+        }
+        if (!outputFile.commit()) {
+            qCritical() << QCoreApplication::translate(
+                               "generate", "Error: Could not write output file \"%1\"")
+                               .arg(outputPath);
+            return false;
+        }
 
         /* Generate corresponding JSON data file for debugging/third-party tools */
         const QFileInfo outputFileInfo(outputFileName);
@@ -680,12 +995,11 @@ bool QSocGenerateManager::renderTemplate(
                               .arg(jsonPath);
         } else {
             try {
-                /* Serialize dataObject to formatted JSON */
-                const std::string formattedJson = dataObject.dump(4); /* 4 spaces indentation */
-
-                QTextStream stream(&jsonFile);
-                stream.setEncoding(QStringConverter::Utf8);
-                stream << QString::fromStdString(formattedJson);
+                /* Serialize dataObject to formatted JSON, 4 spaces indentation */
+                DeviceStreamBuffer jsonBuffer(&jsonFile);
+                std::ostream       jsonStream(&jsonBuffer);
+                jsonStream << std::setw(4) << dataObject;
+                jsonStream.flush();
                 jsonFile.close();
             } catch (const std::exception &e) {
                 qWarning() << QCoreApplication::translate(
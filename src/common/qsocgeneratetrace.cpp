@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocgeneratemanager.h"
+
+#include <QSet>
+
+namespace {
+
+/* Graph direction of a module port, unknown directions are taken as inout */
+QSocNetlistGraph::Direction pinDirection(const YAML::Node &portNode)
+{
+    if (!portNode || !portNode.IsMap() || !portNode["direction"]
+        || !portNode["direction"].IsScalar()) {
+        return QSocNetlistGraph::Direction::Inout;
+    }
+    const QString direction
+        = QString::fromStdString(portNode["direction"].as<std::string>()).trimmed().toLower();
+    if (direction == "in" || direction == "input") {
+        return QSocNetlistGraph::Direction::Input;
+    }
+    if (direction == "out" || direction == "output") {
+        return QSocNetlistGraph::Direction::Output;
+    }
+    return QSocNetlistGraph::Direction::Inout;
+}
+
+} /* namespace */
+
+QSocNetlistGraph QSocGenerateManager::buildNetlistGraph()
+{
+    QSocNetlistGraph  graph;
+    const YAML::Node &netlist = netlistData;
+    if (!netlist["net"] || !netlist["net"].IsMap()) {
+        return graph;
+    }
+
+    const YAML::Node portSection = (netlist["port"] && netlist["port"].IsMap()) ? netlist["port"]
+                                                                                : YAML::Node();
+    QSet<QString> topPinSet;
+    QSet<QString> netNameSet;
+
+    /* Top-level ports are seen from inside: an input port drives its net */
+    const auto addTopPin = [&](const QString &netName,
+                               const QString &portName,
+                               const QString &bits) {
+        if (topPinSet.contains(netName + "." + portName + bits)) {
+            return;
+        }
+        topPinSet.insert(netName + "." + portName + bits);
+
+        const YAML::Node portNode  = portSection.IsMap() ? portSection[portName.toStdString()]
+                                                         : YAML::Node();
+        auto             direction = pinDirection(portNode);
+        if (direction == QSocNetlistGraph::Direction::Input) {
+            direction = QSocNetlistGraph::Direction::Output;
+        } else if (direction == QSocNetlistGraph::Direction::Output) {
+            direction = QSocNetlistGraph::Direction::Input;
+        }
+
+        int width = 0;
+        if (portNode && portNode.IsMap()) {
+            const QString type = (portNode["type"] && portNode["type"].IsScalar())
+                                     ? QString::fromStdString(portNode["type"].as<std::string>())
+                                     : QString();
+            width = QSocWidthEvaluator::typeWidth(type, getNetlistParameters()).value_or(0);
+        }
+        graph.addPin(netName, "top", portName, direction, bits, width);
+    };
+
+    for (const auto &netIter : netlist["net"]) {
+        if (!netIter.first.IsScalar() || !netIter.second.IsSequence()) {
+            continue;
+        }
+        const QString netName = QString::fromStdString(netIter.first.as<std::string>());
+        netNameSet.insert(netName);
+
+        for (const auto &connectionNode : netIter.second) {
+            if (!connectionNode.IsMap() || !connectionNode["instance"]
+                || !connectionNode["instance"].IsScalar() || !connectionNode["port"]
+                || !connectionNode["port"].IsScalar()) {
+                continue;
+            }
+            const QString instanceName = QString::fromStdString(
+                connectionNode["instance"].as<std::string>());
+            const QString portName = QString::fromStdString(
+                connectionNode["port"].as<std::string>());
+            QString bits;
+            if (connectionNode["bits"] && connectionNode["bits"].IsScalar()) {
+                bits = QString::fromStdString(connectionNode["bits"].as<std::string>());
+            }
+
+            if (instanceName == "top") {
+                addTopPin(netName, portName, bits);
+                continue;
+            }
+
+            const YAML::Node moduleData = getModuleData(
+                getInstanceParameters(instanceName).moduleName);
+            const YAML::Node portNode = (moduleData.IsMap() && moduleData["port"]
+                                         && moduleData["port"].IsMap())
+                                            ? moduleData["port"][portName.toStdString()]
+                                            : YAML::Node();
+            graph.addPin(
+                netName,
+                instanceName,
+                portName,
+                pinDirection(portNode),
+                bits,
+                getInstancePortWidth(instanceName, portName));
+        }
+    }
+
+    /* Top-level ports bound with the connect attribute, or by the net name */
+    if (portSection.IsMap()) {
+        for (const auto &portIter : portSection) {
+            if (!portIter.first.IsScalar() || !portIter.second.IsMap()) {
+                continue;
+            }
+            const QString portName = QString::fromStdString(portIter.first.as<std::string>());
+            if (portIter.second["connect"] && portIter.second["connect"].IsScalar()) {
+                addTopPin(
+                    QString::fromStdString(portIter.second["connect"].as<std::string>()),
+                    portName,
+                    QString());
+            } else if (netNameSet.contains(portName)) {
+                addTopPin(portName, portName, QString());
+            }
+        }
+    }
+
+    return graph;
+}
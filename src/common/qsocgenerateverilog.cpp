@@ -37,8 +37,9 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
     }
 
     // Allow empty or missing instance section if comb, seq, or fsm section exists
-    bool hasInstances = netlistData["instance"] && netlistData["instance"].IsMap()
-                        && netlistData["instance"].size() > 0;
+    bool hasInstances = (netlistData["instance"] && netlistData["instance"].IsMap()
+                         && netlistData["instance"].size() > 0)
+                        || !instanceArrayList.isEmpty();
     bool hasCombSeqFsm = netlistData["comb"] || netlistData["seq"] || netlistData["fsm"];
     bool hasReset      = netlistData["reset"] && netlistData["reset"].IsSequence()
                     && netlistData["reset"].size() > 0;
@@ -59,6 +60,14 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
         return false;
     }
 
+    /* Logic sections only know flat nets, not interface signals */
+    if (!checkBusInterfaceReferences()) {
+        return false;
+    }
+
+    /* Module and bus libraries read by this netlist */
+    addLibraryDependencies();
+
     /* Check if project manager is valid */
     if (!projectManager) {
         qCritical() << "Error: Project manager is null";
@@ -449,9 +458,9 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
                                                   .arg(bitSelect.isEmpty() ? "" : bitSelect);
                         } else {
                             instancePortConnections[instanceName][portName]
-                                = hasInvert ? QString("~%1%2").arg(netName).arg(
+                                = hasInvert ? QString("~%1%2").arg(netReference(netName)).arg(
                                                   bitSelect.isEmpty() ? "" : bitSelect)
-                                            : QString("%1%2").arg(netName).arg(
+                                            : QString("%1%2").arg(netReference(netName)).arg(
                                                   bitSelect.isEmpty() ? "" : bitSelect);
                         }
                     }
@@ -468,6 +477,11 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
     /* Add connections (wires) section comment */
     out << "    /* Wire declarations */\n";
 
+    /* Ranges of bus signals declared by their interface instead of a wire */
+    QMap<QString, QString> busSignalWidthMap;
+    /* Declared width of each net, checked against instance array selects */
+    QMap<QString, int> netDeclaredWidthMap;
+
     /* Generate wire declarations FIRST */
     if (netlistData["net"]) {
         if (!netlistData["net"].IsMap()) {
@@ -667,8 +681,8 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
                                     .as<std::string>());
 
                             /* Get module definition */
-                            if (moduleManager && moduleManager->isModuleExist(moduleName)) {
-                                YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
+                            if (isModuleAvailable(moduleName)) {
+                                YAML::Node moduleData = getModuleData(moduleName);
 
                                 if (moduleData["port"] && moduleData["port"].IsMap()
                                     && moduleData["port"][portName.toStdString()]) {
@@ -1059,6 +1073,18 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
                                         if (msb_ok) {
                                             requiredMaxBit = msb;
                                         }
+                                    } else {
+                                        /* Parameterized range such as [DATA_W-1:0] */
+                                        const int width
+                                            = detail.type == PortType::Module
+                                                  ? getInstancePortWidth(
+                                                        detail.instanceName, detail.portName)
+                                                  : QSocWidthEvaluator::typeWidth(
+                                                        detail.width, getNetlistParameters())
+                                                        .value_or(0);
+                                        if (width > 0) {
+                                            requiredMaxBit = width - 1;
+                                        }
                                     }
                                 }
                             }
@@ -1114,8 +1140,16 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
                             netlistData["net"][netName.toStdString()]["type"].as<std::string>());
                     }
 
+                    netDeclaredWidthMap.insert(
+                        netName,
+                        QSocWidthEvaluator::typeWidth(netWidth, getNetlistParameters())
+                            .value_or(-1));
+
                     /* Add wire declaration for this net with width information if available */
-                    if (!netWidth.isEmpty()) {
+                    if (busInterfaceNetMap.contains(netName)) {
+                        busSignalWidthMap.insert(
+                            netName, QSocGenerateManager::cleanTypeForWireDeclaration(netWidth));
+                    } else if (!netWidth.isEmpty()) {
                         /* Clean the type string to remove unwanted keywords like 'reg', 'logic', etc. */
                         const QString cleanedWidth
                             = QSocGenerateManager::cleanTypeForWireDeclaration(netWidth);
@@ -1189,6 +1223,13 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
             << "Warning: No 'net' section in netlist, no wire declarations will be generated";
     }
 
+    /* Nets used only by instance arrays */
+    generateInstanceArrayWires(out, netDeclaredWidthMap);
+
+    /* Bus links as interface instances, defined after the module */
+    const QString busInterfaceDefinitions
+        = generateBusInterfaces(out, outputFileName, busSignalWidthMap);
+
     /* Add instances section comment */
     out << "    /* Module instantiations */\n";
 
@@ -1286,8 +1327,8 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
             QStringList portConnections;
 
             /* Get module definition to ensure all ports are listed */
-            if (moduleManager && moduleManager->isModuleExist(moduleName)) {
-                YAML::Node moduleData = moduleManager->getModuleYaml(moduleName);
+            if (isModuleAvailable(moduleName)) {
+                YAML::Node moduleData = getModuleData(moduleName);
 
                 if (moduleData["port"] && moduleData["port"].IsMap()) {
                     /* Get the existing connections map for this instance */
@@ -1603,6 +1644,9 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
         }
     }
 
+    /* Instance arrays as generate loops */
+    generateInstanceArrays(out);
+
     /* Generate combinational logic after module instantiations */
     if (!generateCombPrimitive(netlistData, out)) {
         qWarning() << "Failed to generate combinational logic primitives";
@@ -1621,6 +1665,10 @@ bool QSocGenerateManager::generateVerilog(const QString &outputFileName)
     /* Close module */
     out << "\nendmodule\n";
 
+    if (!busInterfaceDefinitions.isEmpty()) {
+        out << "\n" << busInterfaceDefinitions;
+    }
+
     outputFile.close();
     qInfo() << "Successfully generated Verilog file:" << outputFilePath;
 
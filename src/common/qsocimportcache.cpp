@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocimportcache.h"
+#include "common/config.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+
+/* Source entry as it enters the key, relative paths resolved against the working directory */
+QString keyEntry(const QString &entry)
+{
+    static const QString incdirPrefix = "+incdir+";
+    if (entry.startsWith(incdirPrefix)) {
+        QStringList dirList = entry.mid(incdirPrefix.size()).split('+', Qt::SkipEmptyParts);
+        for (QString &dir : dirList) {
+            dir = QFileInfo(dir).absoluteFilePath();
+        }
+        return incdirPrefix + dirList.join('+');
+    }
+    if (entry.startsWith('+') || entry.startsWith('-')) {
+        return entry;
+    }
+    return QFileInfo(entry).absoluteFilePath();
+}
+
+} /* namespace */
+
+QSocImportCache::QSocImportCache(const QString &cacheDir)
+    : cacheDir(cacheDir)
+{
+    /* All private members set by constructor */
+}
+
+QString QSocImportCache::defaultCacheDir()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation))
+        .filePath("qsoc/import");
+}
+
+void QSocImportCache::setCacheDir(const QString &cacheDir)
+{
+    this->cacheDir = cacheDir;
+}
+
+const QString &QSocImportCache::getCacheDir() const
+{
+    return cacheDir;
+}
+
+QString QSocImportCache::unitKey(
+    const QStringList &sourceList,
+    const QStringList &macroDefines,
+    const QStringList &macroUndefines)
+{
+    /* Sections are separated by a byte that cannot appear in entries */
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QString("qsoc %1 import %2\n").arg(QSOC_VERSION).arg(formatVersion).toUtf8());
+    /* Options slang resolves later, such as -I, are relative to the working directory */
+    hash.addData((QDir::currentPath() + '\n').toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    for (const QString &entry : sourceList) {
+        hash.addData(keyEntry(entry).toUtf8());
+        hash.addData(QByteArray(1, '\n'));
+    }
+    hash.addData(QByteArray(1, '\0'));
+    for (const QString &macro : macroDefines) {
+        hash.addData(("D" + macro + "\n").toUtf8());
+    }
+    for (const QString &macro : macroUndefines) {
+        hash.addData(("U" + macro + "\n").toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QByteArray QSocImportCache::fileHash(const QString &filePath)
+{
+    const QFileInfo fileInfo(filePath);
+    if (!fileInfo.isFile()) {
+        return QByteArray();
+    }
+    const QString absolutePath = fileInfo.absoluteFilePath();
+    FileStamp    &stamp        = fileStampMap[absolutePath];
+    if (stamp.size == fileInfo.size() && stamp.modified == fileInfo.lastModified()
+        && !stamp.hash.isEmpty()) {
+        return stamp.hash;
+    }
+
+    QFile file(absolutePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        fileStampMap.remove(absolutePath);
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(&file);
+    stamp.modified = fileInfo.lastModified();
+    stamp.size     = fileInfo.size();
+    stamp.hash     = hash.result();
+    return stamp.hash;
+}
+
+bool QSocImportCache::isRecordValid(const UnitRecord &record)
+{
+    for (auto iter = record.fileHashMap.constBegin(); iter != record.fileHashMap.constEnd();
+         ++iter) {
+        if (fileHash(iter.key()) != iter.value()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QSocImportCache::lookup(const QString &key, Entry &entry)
+{
+    auto iter = recordMap.find(key);
+    if (iter == recordMap.end()) {
+        UnitRecord record;
+        if (!readRecord(key, record)) {
+            return false;
+        }
+        iter = recordMap.insert(key, record);
+    }
+    if (!isRecordValid(iter.value())) {
+        recordMap.erase(iter);
+        return false;
+    }
+    entry = iter.value().entry;
+    return true;
+}
+
+bool QSocImportCache::store(const QString &key, const QStringList &fileList, const Entry &entry)
+{
+    UnitRecord record;
+    for (const QString &filePath : fileList) {
+        const QByteArray hash = fileHash(filePath);
+        if (hash.isEmpty()) {
+            return false;
+        }
+        record.fileHashMap.insert(QFileInfo(filePath).absoluteFilePath(), hash);
+    }
+    record.entry = entry;
+    recordMap.insert(key, record);
+    return cacheDir.isEmpty() || writeRecord(key, record);
+}
+
+void QSocImportCache::clear()
+{
+    recordMap.clear();
+    fileStampMap.clear();
+}
+
+bool QSocImportCache::readRecord(const QString &key, UnitRecord &record) const
+{
+    if (cacheDir.isEmpty()) {
+        return false;
+    }
+    const QString filePath = QDir(cacheDir).filePath(key + ".yml");
+    if (!QFile::exists(filePath)) {
+        return false;
+    }
+
+    YAML::Node node;
+    try {
+        node = YAML::LoadFile(filePath.toStdString());
+    } catch (const YAML::Exception &) {
+        return false;
+    }
+    if (!node.IsMap() || !node["file"] || !node["file"].IsMap() || !node["module"]
+        || !node["module"].IsSequence() || !node["descriptor"] || !node["descriptor"].IsMap()) {
+        return false;
+    }
+    for (const auto &fileIter : node["file"]) {
+        if (!fileIter.first.IsScalar() || !fileIter.second.IsScalar()) {
+            return false;
+        }
+        record.fileHashMap.insert(
+            QString::fromStdString(fileIter.first.as<std::string>()),
+            QByteArray::fromHex(QByteArray::fromStdString(fileIter.second.as<std::string>())));
+    }
+    const YAML::Node &descriptorMap = node["descriptor"];
+    for (const auto &moduleNode : node["module"]) {
+        if (!moduleNode.IsScalar() || !descriptorMap[moduleNode.as<std::string>()]) {
+            return false;
+        }
+        record.entry.moduleList.append(QString::fromStdString(moduleNode.as<std::string>()));
+    }
+    record.entry.descriptorMap = descriptorMap;
+    return true;
+}
+
+bool QSocImportCache::writeRecord(const QString &key, const UnitRecord &record) const
+{
+    YAML::Node node;
+    node["file"] = YAML::Node(YAML::NodeType::Map);
+    for (auto iter = record.fileHashMap.constBegin(); iter != record.fileHashMap.constEnd();
+         ++iter) {
+        node["file"][iter.key().toStdString()] = iter.value().toHex().toStdString();
+    }
+    node["module"] = YAML::Node(YAML::NodeType::Sequence);
+    for (const QString &moduleName : record.entry.moduleList) {
+        node["module"].push_back(moduleName.toStdString());
+    }
+    node["descriptor"] = record.entry.descriptorMap.IsMap()
+                             ? record.entry.descriptorMap
+                             : YAML::Node(YAML::NodeType::Map);
+
+    /* Readers never see a partial record, concurrent runs each write whole files */
+    if (!QDir().mkpath(cacheDir)) {
+        return false;
+    }
+    YAML::Emitter emitter;
+    emitter << node;
+    QSaveFile file(QDir(cacheDir).filePath(key + ".yml"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    file.write(emitter.c_str());
+    return file.commit();
+}
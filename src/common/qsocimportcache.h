@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCIMPORTCACHE_H
+#define QSOCIMPORTCACHE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QSocImportCache class.
+ * @details Remembers the module descriptors extracted from one slang
+ *          compilation unit, so importing the same sources again skips
+ *          preprocessing and elaboration. A unit is keyed by its source
+ *          entries in order and the active macro defines and undefines.
+ *          Every entry records the content hash of each file slang read
+ *          for it, sources and included headers alike, and is only used
+ *          while all of them are unchanged. Since macros defined by one
+ *          file stay visible to the following files of a unit, the unit is
+ *          the smallest piece that can be reused safely.
+ *
+ *          Entries are kept in memory for the lifetime of the cache and,
+ *          when a cache directory is set, written there as one YAML file
+ *          per key so later runs reuse them. File hashes are shared by all
+ *          entries and recomputed only when a file's size or modification
+ *          time changes, so a header included by many units is read once.
+ *
+ *          Only the files a unit read are checked. A header added to an
+ *          include directory searched earlier, which would now shadow the
+ *          one read, goes unnoticed until the entry is dropped.
+ */
+class QSocImportCache
+{
+public:
+    /**
+     * @brief Version of the record format, part of every unit key.
+     * @details Bump it when the descriptors extracted from a unit change
+     *          shape, so records of the old format are no longer used.
+     */
+    static constexpr int formatVersion = 1;
+
+    /**
+     * @brief Descriptors of one compilation unit.
+     */
+    struct Entry
+    {
+        QStringList moduleList;    /**< Module names in compilation order */
+        YAML::Node  descriptorMap; /**< Module descriptor by module name */
+    };
+
+    /**
+     * @brief Constructor for QSocImportCache.
+     * @param cacheDir Directory for persistent entries, empty keeps
+     *        entries in memory only.
+     */
+    explicit QSocImportCache(const QString &cacheDir = QString());
+
+    /**
+     * @brief Default directory for persistent entries.
+     * @return QString The qsoc directory below the user cache directory.
+     */
+    static QString defaultCacheDir();
+
+    /**
+     * @brief Set the directory for persistent entries.
+     * @param cacheDir Directory, empty keeps entries in memory only.
+     */
+    void setCacheDir(const QString &cacheDir);
+
+    /**
+     * @brief Get the directory for persistent entries.
+     * @return const QString & The directory, empty when not persistent.
+     */
+    const QString &getCacheDir() const;
+
+    /**
+     * @brief Compute the key of a compilation unit.
+     * @details Source files and `+incdir+` directories are taken by
+     *          absolute path, other option entries as they are. The key is
+     *          salted with formatVersion, the qsoc version and the working
+     *          directory, which relative options such as `-I` depend on.
+     * @param sourceList Source entries of the unit, in order.
+     * @param macroDefines Macro definitions in KEY or KEY=VALUE format.
+     * @param macroUndefines Macro names to undefine.
+     * @return QString Hex encoded SHA-256 key.
+     */
+    static QString unitKey(
+        const QStringList &sourceList,
+        const QStringList &macroDefines,
+        const QStringList &macroUndefines);
+
+    /**
+     * @brief Look up the descriptors of a unit.
+     * @param key Key from unitKey().
+     * @param entry Set to the cached descriptors on a hit.
+     * @retval true Entry found and every file it read is unchanged.
+     * @retval false No usable entry.
+     */
+    bool lookup(const QString &key, Entry &entry);
+
+    /**
+     * @brief Remember the descriptors of a unit.
+     * @param key Key from unitKey().
+     * @param fileList Every file read for the unit, sources and includes.
+     * @param entry Descriptors extracted from the unit.
+     * @retval true Entry stored, and written when persistent.
+     * @retval false A file could not be hashed or the entry not written.
+     */
+    bool store(const QString &key, const QStringList &fileList, const Entry &entry);
+
+    /**
+     * @brief Content hash of a file, memoized by size and modification time.
+     * @param filePath Path of the file.
+     * @return QByteArray SHA-256 of the content, empty if unreadable.
+     */
+    QByteArray fileHash(const QString &filePath);
+
+    /**
+     * @brief Drop the in-memory entries and file hashes.
+     * @details Persistent entries are kept.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Content hash of a file with the stamp it was computed for.
+     */
+    struct FileStamp
+    {
+        QDateTime  modified;
+        qint64     size = -1;
+        QByteArray hash;
+    };
+
+    /**
+     * @brief A unit entry with the file hashes it depends on.
+     */
+    struct UnitRecord
+    {
+        QHash<QString, QByteArray> fileHashMap;
+        Entry                      entry;
+    };
+
+    /**
+     * @brief Check that every file of a record still has its hash.
+     * @param record Record to check.
+     * @return bool All files are unchanged.
+     */
+    bool isRecordValid(const UnitRecord &record);
+
+    /**
+     * @brief Read a persistent record.
+     * @param key Key of the record.
+     * @param record Set to the record read.
+     * @return bool The record exists and is well formed.
+     */
+    bool readRecord(const QString &key, UnitRecord &record) const;
+
+    /**
+     * @brief Write a persistent record atomically.
+     * @param key Key of the record.
+     * @param record Record to write.
+     * @return bool The record was written.
+     */
+    bool writeRecord(const QString &key, const UnitRecord &record) const;
+
+    /* Directory of persistent records, empty when memory only */
+    QString cacheDir;
+    /* Records by unit key */
+    QHash<QString, UnitRecord> recordMap;
+    /* Content hashes by absolute file path */
+    QHash<QString, FileStamp> fileStampMap;
+};
+
+#endif // QSOCIMPORTCACHE_H
@@ -2,11 +2,22 @@
 // SPDX-FileCopyrightText: 2023-2025 Huang Rui <vowstar@gmail.com>
 
 #include "common/qsocmodulemanager.h"
+#include "common/qsocwidthevaluator.h"
+#include "common/qsocyamlutils.h"
 #include "common/qstaticregex.h"
 #include "common/qstaticstringweaver.h"
 
 #include <fstream>
 #include <QDebug>
+#include <QFileInfo>
+#include <QLockFile>
+
+namespace {
+
+/* How long a save waits for another process writing the same library */
+constexpr int libraryLockTimeout = 60000;
+
+} // namespace
 
 QSocModuleManager::QSocModuleManager(
     QObject            *parent,
@@ -22,7 +33,13 @@ QSocModuleManager::QSocModuleManager(
     /* All private members set by constructor */
 }
 
-QSocModuleManager::~QSocModuleManager() = default;
+QSocModuleManager::~QSocModuleManager()
+{
+    /* Deferred saves still reach the disk when the owner forgets to flush */
+    if (!dirtyLibrarySet.isEmpty()) {
+        flush();
+    }
+}
 
 YAML::Node QSocModuleManager::mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml)
 {
@@ -90,11 +107,27 @@ void QSocModuleManager::libraryMapRemove(const QString &libraryName, const QStri
     }
 }
 
+void QSocModuleManager::unloadLibrary(const QString &libraryName)
+{
+    const YAML::Node &data    = moduleData;
+    const std::string library = libraryName.toStdString();
+    for (const QString &moduleName : libraryMap.value(libraryName)) {
+        const YAML::Node moduleYaml = data[moduleName.toStdString()];
+        if (moduleYaml && moduleYaml["library"] && moduleYaml["library"].Scalar() == library) {
+            moduleData.remove(moduleName.toStdString());
+        }
+    }
+    libraryMap.remove(libraryName);
+    libraryDigest.remove(libraryName);
+}
+
 void QSocModuleManager::setProjectManager(QSocProjectManager *projectManager)
 {
     /* Set projectManager */
     if (projectManager) {
         this->projectManager = projectManager;
+        /* Keep the slang driver on the same project */
+        slangDriver->setProjectManager(projectManager);
     }
 }
 
@@ -145,19 +178,81 @@ void QSocModuleManager::resetModuleData()
 {
     /* Clear the library map */
     libraryMap.clear();
+    libraryDigest.clear();
+    dirtyLibrarySet.clear();
+    changedModuleMap.clear();
     /* Reset the module data by creating a new empty YAML node */
     moduleData = YAML::Node();
 
     qDebug() << "Module data has been reset.";
 }
 
+void QSocModuleManager::copyLibraryData(const QSocModuleManager &other)
+{
+    libraryMap       = other.libraryMap;
+    libraryDigest    = other.libraryDigest;
+    libraryCachePath = other.libraryCachePath;
+    /* Clone, so that node lookups never touch the original */
+    moduleData = YAML::Clone(other.moduleData);
+}
+
+void QSocModuleManager::setLibraryCache(bool enable)
+{
+    libraryCache = enable;
+}
+
+bool QSocModuleManager::isLibraryCache() const
+{
+    return libraryCache;
+}
+
+void QSocModuleManager::setDeferredSave(bool enable)
+{
+    deferredSave = enable;
+    if (enable) {
+        libraryCache = true;
+    }
+}
+
+bool QSocModuleManager::isDeferredSave() const
+{
+    return deferredSave;
+}
+
+void QSocModuleManager::setImportCache(bool enable)
+{
+    importCacheEnabled = enable;
+}
+
+void QSocModuleManager::setImportCacheDir(const QString &cacheDir)
+{
+    importCache.setCacheDir(cacheDir);
+}
+
+bool QSocModuleManager::flush()
+{
+    bool result = true;
+    /* Write pending libraries to the directory they were loaded from */
+    for (const QString &libraryName : std::as_const(dirtyLibrarySet)) {
+        if (libraryMap.contains(libraryName) && !writeLibrary(libraryName, libraryCachePath)) {
+            qCritical() << "Error: Failed to flush library:" << libraryName;
+            result = false;
+        }
+    }
+    dirtyLibrarySet.clear();
+    return result;
+}
+
 bool QSocModuleManager::importFromFileList(
-    const QString            &libraryName,
-    const QRegularExpression &moduleNameRegex,
-    const QString            &fileListPath,
-    const QStringList        &filePathList,
-    const QStringList        &macroDefines,
-    const QStringList        &macroUndefines)
+    const QString                               &libraryName,
+    const QRegularExpression                    &moduleNameRegex,
+    const QString                               &fileListPath,
+    const QStringList                           &filePathList,
+    const QStringList                           &macroDefines,
+    const QStringList                           &macroUndefines,
+    int                                          chunkSize,
+    const QList<QSlangDriver::Parameterization> &parameterizationList,
+    int                                          jobs)
 {
     /* Validate projectManager and its path */
     if (!isModulePathValid()) {
@@ -170,55 +265,194 @@ bool QSocModuleManager::importFromFileList(
         return false;
     }
 
-    if (slangDriver->parseFileList(fileListPath, filePathList, macroDefines, macroUndefines)) {
-        /* Parse success */
-        QStringList moduleList = slangDriver->getModuleList();
-        if (moduleList.isEmpty()) {
-            /* No module found */
-            qCritical() << "Error: no module found.";
-            return false;
+    /* Only files are split into chunks, options apply to every chunk */
+    QStringList optionList;
+    QStringList sourceList;
+    for (const QString &entry : slangDriver->resolveFileList(fileListPath, filePathList)) {
+        if (entry.startsWith('+') || entry.startsWith('-')) {
+            optionList.append(entry);
+        } else {
+            sourceList.append(entry);
+        }
+    }
+    if (sourceList.isEmpty()) {
+        qCritical() << "Error: no module found.";
+        return false;
+    }
+
+    /* Without chunking, all files are parsed as one compilation unit */
+    const qsizetype step       = chunkSize > 0 ? chunkSize : sourceList.size();
+    const qsizetype chunkCount = (sourceList.size() + step - 1) / step;
+    /* Pick first module if pattern is empty */
+    const bool pickFirst     = moduleNameRegex.pattern().isEmpty();
+    bool       hasMatch      = false;
+    QString    effectiveName = libraryName;
+    YAML::Node libraryYaml;
+    /* Offset of the unit each imported module was found in */
+    QHash<QString, qsizetype> moduleOffsetMap;
+
+    for (qsizetype offset = 0; offset < sourceList.size() && !(pickFirst && hasMatch);
+         offset += step) {
+        if (chunkCount > 1) {
+            qDebug() << "Import chunk" << offset / step + 1 << "of" << chunkCount;
+        }
+        const QStringList unitList = optionList + sourceList.mid(offset, step);
+        const QString     unitKey
+            = QSocImportCache::unitKey(unitList, macroDefines, macroUndefines);
+        QSocImportCache::Entry unit;
+        if (importCacheEnabled && importCache.lookup(unitKey, unit)) {
+            qDebug() << "Import cache hit:" << unitKey;
+        } else {
+            if (!slangDriver->parseSourceList(unitList, macroDefines, macroUndefines)) {
+                slangDriver->release();
+                qCritical() << "Error: no module found.";
+                return false;
+            }
+            /* The cache keeps every module of the unit, it must not depend on the pattern */
+            unit.moduleList    = slangDriver->getModuleList();
+            unit.descriptorMap = YAML::Node(YAML::NodeType::Map);
+            for (const QString &moduleName : unit.moduleList) {
+                const bool imported = pickFirst
+                                          ? moduleName == unit.moduleList.first()
+                                          : QStaticRegex::isNameExactMatch(
+                                                moduleName, moduleNameRegex);
+                if (!importCacheEnabled && !imported) {
+                    continue;
+                }
+                unit.descriptorMap[moduleName.toStdString()] = getModuleYaml(
+                    slangDriver->getModuleAst(moduleName));
+            }
+            const QStringList readFileList = slangDriver->getSourceFileList();
+            /* Descriptors are plain YAML now, nothing needs the compilation any more */
+            slangDriver->release();
+            if (importCacheEnabled && !importCache.store(unitKey, readFileList, unit)) {
+                qWarning() << "Warning: unable to cache import unit:" << unitKey;
+            }
         }
-        YAML::Node libraryYaml;
-        QString    effectiveName = libraryName;
 
-        if (moduleNameRegex.pattern().isEmpty()) {
-            /* Pick first module if pattern is empty */
-            const QString &moduleName = moduleList.first();
-            qDebug() << "Pick first module:" << moduleName;
+        const YAML::Node &descriptorMap = unit.descriptorMap;
+        for (const QString &moduleName : unit.moduleList) {
+            if (!pickFirst && !QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
+                continue;
+            }
+            qDebug() << "Found module:" << moduleName;
             if (effectiveName.isEmpty()) {
+                /* Use first module name as library filename */
                 effectiveName = moduleName.toLower();
                 qDebug() << "Pick library filename:" << effectiveName;
             }
-            const json       &moduleAst  = slangDriver->getModuleAst(moduleName);
-            const YAML::Node &moduleYaml = getModuleYaml(moduleAst);
-            /* Add module to library yaml */
-            libraryYaml[moduleName.toStdString()] = moduleYaml;
-            saveLibraryYaml(effectiveName, libraryYaml);
-            return true;
+            /* Clone, the cache keeps its own copy */
+            libraryYaml[moduleName.toStdString()] = YAML::Clone(
+                descriptorMap[moduleName.toStdString()]);
+            moduleOffsetMap.insert(moduleName, offset);
+            hasMatch = true;
+            if (pickFirst) {
+                break;
+            }
         }
-        /* Find module by pattern */
-        bool hasMatch = false;
-        for (const QString &moduleName : moduleList) {
-            if (QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
-                qDebug() << "Found module:" << moduleName;
-                if (effectiveName.isEmpty()) {
-                    /* Use first module name as library filename */
-                    effectiveName = moduleName.toLower();
-                    qDebug() << "Pick library filename:" << effectiveName;
-                }
-                const json       &moduleAst           = slangDriver->getModuleAst(moduleName);
-                const YAML::Node &moduleYaml          = getModuleYaml(moduleAst);
-                libraryYaml[moduleName.toStdString()] = moduleYaml;
-                hasMatch                              = true;
+    }
+
+    if (!hasMatch) {
+        qCritical() << "Error: no module found.";
+        return false;
+    }
+
+    /* Group the new parameterizations of imported modules by their unit */
+    QMap<qsizetype, QList<QSlangDriver::Parameterization>> unitParameterizationMap;
+    QMap<qsizetype, QStringList>                           unitKeyMap;
+    QSet<QString>                                          parameterizationSet;
+    for (const QSlangDriver::Parameterization &parameterization : parameterizationList) {
+        const auto offset = moduleOffsetMap.constFind(parameterization.moduleName);
+        if (offset == moduleOffsetMap.constEnd()) {
+            continue;
+        }
+        const YAML::Node &moduleYaml = libraryYaml[parameterization.moduleName.toStdString()];
+        const QString     key = parameterizationKey(moduleYaml, parameterization.overrideMap);
+        /* Defaults are the module descriptor itself */
+        if (key == parameterizationKey(moduleYaml, {})
+            || parameterizationSet.contains(parameterization.moduleName + "#" + key)) {
+            continue;
+        }
+        parameterizationSet.insert(parameterization.moduleName + "#" + key);
+        unitParameterizationMap[offset.value()].append(parameterization);
+        unitKeyMap[offset.value()].append(key);
+    }
+    for (auto iter = unitParameterizationMap.constBegin();
+         iter != unitParameterizationMap.constEnd();
+         ++iter) {
+        const QList<QSlangDriver::Parameterization> &unitParameterizationList = iter.value();
+        qDebug() << "Elaborate" << unitParameterizationList.size() << "parameterizations";
+        const QList<json> astList = slangDriver->elaborateParameterizations(
+            optionList + sourceList.mid(iter.key(), step),
+            macroDefines,
+            macroUndefines,
+            unitParameterizationList,
+            jobs);
+        for (qsizetype index = 0; index < unitParameterizationList.size(); ++index) {
+            const QString    &moduleName = unitParameterizationList.at(index).moduleName;
+            const QString    &key        = unitKeyMap[iter.key()].at(index);
+            const YAML::Node  descriptor = getModuleYaml(astList.at(index));
+            if (!descriptor.IsMap()) {
+                qWarning() << "Warning: unable to elaborate" << moduleName << "with" << key;
+                continue;
             }
+            libraryYaml[moduleName.toStdString()]["parameterization"][key.toStdString()]
+                = descriptor;
         }
-        if (hasMatch) {
-            saveLibraryYaml(effectiveName, libraryYaml);
-            return true;
+    }
+
+    saveLibraryYaml(effectiveName, libraryYaml);
+    return true;
+}
+
+QString QSocModuleManager::parameterizationKey(
+    const YAML::Node &moduleYaml, const QMap<QString, QString> &overrideMap)
+{
+    YAML::Node overrides(YAML::NodeType::Map);
+    for (auto iter = overrideMap.constBegin(); iter != overrideMap.constEnd(); ++iter) {
+        overrides[iter.key().toStdString()] = iter.value().toStdString();
+    }
+    const YAML::Node &parameters = moduleYaml["parameter"];
+    return QSocWidthEvaluator::parameterKey(
+        QSocWidthEvaluator::resolveParameters(parameters, overrides));
+}
+
+QList<QSlangDriver::Parameterization> QSocModuleManager::parameterizationsFromNetlist(
+    const YAML::Node &netlist)
+{
+    QList<QSlangDriver::Parameterization> result;
+    const YAML::Node                     &instanceMap = netlist["instance"];
+    if (!instanceMap || !instanceMap.IsMap()) {
+        return result;
+    }
+    const QSocWidthEvaluator::ParameterMap netlistParameters
+        = QSocWidthEvaluator::resolveParameters(netlist["parameter"]);
+    for (const auto &instanceIter : instanceMap) {
+        const YAML::Node &instance = instanceIter.second;
+        if (!instance.IsMap() || !instance["module"] || !instance["module"].IsScalar()
+            || !instance["parameter"] || !instance["parameter"].IsMap()) {
+            continue;
+        }
+        /* Overrides may use netlist parameters, slang only sees numbers */
+        const YAML::Node                      &parameterMap = instance["parameter"];
+        const QSocWidthEvaluator::ParameterMap valueMap
+            = QSocWidthEvaluator::resolveParameters(YAML::Node(), parameterMap, netlistParameters);
+        QSlangDriver::Parameterization parameterization;
+        parameterization.moduleName = QString::fromStdString(instance["module"].as<std::string>());
+        for (const auto &parameterIter : parameterMap) {
+            const QString name = QString::fromStdString(parameterIter.first.as<std::string>());
+            if (valueMap.contains(name)) {
+                parameterization.overrideMap.insert(name, QString::number(valueMap.value(name)));
+            } else if (parameterIter.second.IsScalar()) {
+                parameterization.overrideMap.insert(
+                    name, QString::fromStdString(parameterIter.second.as<std::string>()));
+            }
+        }
+        if (!parameterization.overrideMap.isEmpty()) {
+            result.append(parameterization);
         }
     }
-    qCritical() << "Error: no module found.";
-    return false;
+    return result;
 }
 
 YAML::Node QSocModuleManager::getModuleYaml(const json &moduleAst)
@@ -298,6 +532,16 @@ bool QSocModuleManager::saveLibraryYaml(const QString &libraryName, const YAML::
     /* Check file path */
     const QString &modulePath = projectManager->getModulePath();
     const QString &filePath   = QDir(modulePath).filePath(QString("%1.soc_mod").arg(libraryName));
+    /* Pending edits must reach the file before it is merged */
+    if (dirtyLibrarySet.remove(libraryName) && !writeLibrary(libraryName, libraryCachePath)) {
+        return false;
+    }
+    /* Merge under the lock, so concurrent imports into one library all land */
+    QLockFile lockFile(filePath + ".lock");
+    if (!lockFile.tryLock(libraryLockTimeout)) {
+        qCritical() << "Error: Unable to lock library:" << filePath;
+        return false;
+    }
     if (QFile::exists(filePath)) {
         /* Load library YAML file */
         std::ifstream inputFileStream(filePath.toStdString());
@@ -308,12 +552,10 @@ bool QSocModuleManager::saveLibraryYaml(const QString &libraryName, const YAML::
     }
 
     /* Save YAML file */
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
+    if (!QSocYamlUtils::saveFile(filePath, localLibraryYaml)) {
+        qCritical() << "Error: Unable to write file:" << filePath;
         return false;
     }
-    outputFileStream << localLibraryYaml;
     return true;
 }
 
@@ -391,16 +633,32 @@ bool QSocModuleManager::load(const QString &libraryName)
     const QString filePath
         = QDir(projectManager->getModulePath()).filePath(libraryName + ".soc_mod");
 
-    /* Open the YAML file */
-    std::ifstream fileStream(filePath.toStdString());
-    if (!fileStream.is_open()) {
+    /* Drop resident libraries that belong to another module directory */
+    if (libraryCache && libraryCachePath != projectManager->getModulePath()) {
+        flush();
+        resetModuleData();
+        libraryCachePath = projectManager->getModulePath();
+    }
+
+    /* Keep the resident copy when the library file is unchanged */
+    const QByteArray digest = QSocYamlUtils::fileDigest(filePath);
+    if (libraryCache && libraryMap.contains(libraryName)
+        && libraryDigest.value(libraryName) == digest) {
+        return true;
+    }
+
+    /* Check if the file can be read */
+    if (!QFileInfo(filePath).isReadable()) {
         qCritical() << "Error: Unable to open file:" << filePath;
         return false;
     }
 
     try {
         /* Load YAML content into a temporary node */
-        YAML::Node tempNode = YAML::Load(fileStream);
+        YAML::Node tempNode = QSocYamlUtils::loadFile(filePath);
+
+        /* A reload replaces the library, modules removed from the file go too */
+        unloadLibrary(libraryName);
 
         /* Iterate through the temporary node and add to moduleData */
         for (YAML::const_iterator it = tempNode.begin(); it != tempNode.end(); ++it) {
@@ -418,6 +676,7 @@ bool QSocModuleManager::load(const QString &libraryName)
         return false;
     }
 
+    libraryDigest.insert(libraryName, digest);
     return true;
 }
 
@@ -434,6 +693,13 @@ bool QSocModuleManager::load(const QRegularExpression &libraryNameRegex)
         return false;
     }
 
+    /* Drop libraries loaded earlier whose file has since been deleted */
+    for (const QString &libraryName : libraryDigest.keys()) {
+        if (!dirtyLibrarySet.contains(libraryName) && !isLibraryFileExist(libraryName)) {
+            unloadLibrary(libraryName);
+        }
+    }
+
     /* Get the list of library basenames matching the regex */
     const QStringList matchingBasenames = listLibrary(libraryNameRegex);
 
@@ -481,30 +747,104 @@ bool QSocModuleManager::save(const QString &libraryName)
         return false;
     }
 
-    /* Extract modules from moduleData */
-    YAML::Node dataToSave;
-    /* Iterate through each module in libraryMap */
-    for (const auto &moduleItem : libraryMap[libraryName]) {
-        const std::string moduleNameStd = moduleItem.toStdString();
-        if (!moduleData[moduleNameStd]) {
+    /* Only mark the library, flush() writes it later */
+    if (deferredSave) {
+        /* Libraries loaded before saves were deferred come from the current directory */
+        if (libraryCachePath.isEmpty()) {
+            libraryCachePath = projectManager->getModulePath();
+        }
+        dirtyLibrarySet.insert(libraryName);
+        return true;
+    }
+
+    return writeLibrary(libraryName, projectManager->getModulePath());
+}
+
+bool QSocModuleManager::writeLibrary(const QString &libraryName, const QString &modulePath)
+{
+    const QString filePath = QDir(modulePath).filePath(libraryName + ".soc_mod");
+    /* Other processes may save the same library, the read-modify-write is theirs too */
+    QLockFile lockFile(filePath + ".lock");
+    if (!lockFile.tryLock(libraryLockTimeout)) {
+        qCritical() << "Error: Unable to lock library:" << filePath;
+        return false;
+    }
+
+    /* Start from the file as other processes left it, unless it is still the resident one */
+    const bool fileResident = libraryCache && modulePath == libraryCachePath
+                              && libraryDigest.contains(libraryName)
+                              && libraryDigest.value(libraryName)
+                                     == QSocYamlUtils::fileDigest(filePath);
+    YAML::Node dataToSave(YAML::NodeType::Map);
+    if (!fileResident && QFile::exists(filePath)) {
+        try {
+            const YAML::Node diskYaml = QSocYamlUtils::loadFile(filePath);
+            if (diskYaml.IsMap()) {
+                for (const auto &entry : diskYaml) {
+                    dataToSave[entry.first] = entry.second;
+                }
+            }
+        } catch (const YAML::Exception &e) {
+            qWarning() << "Warning: Replacing unreadable library:" << filePath << e.what();
+        }
+    }
+
+    /* Apply the modules changed here, every resident module when changes are not tracked */
+    const QSet<QString> residentSet = libraryMap.value(libraryName);
+    const auto          changed     = changedModuleMap.constFind(libraryName);
+    const QSet<QString> changedSet  = (fileResident || changed == changedModuleMap.constEnd())
+                                          ? residentSet
+                                          : changed.value();
+    const YAML::Node   &constData   = moduleData;
+    for (const QString &moduleName : changedSet) {
+        const std::string moduleNameStd = moduleName.toStdString();
+        if (!residentSet.contains(moduleName)) {
+            /* Removed by this process */
+            dataToSave.remove(moduleNameStd);
+            continue;
+        }
+        const YAML::Node &moduleNode = constData[moduleNameStd];
+        if (!moduleNode) {
             qCritical() << "Error: Module data is not exist: " << moduleNameStd;
             return false;
         }
-        dataToSave[moduleNameStd] = moduleData[moduleNameStd];
-        if (dataToSave[moduleNameStd]["library"]) {
-            dataToSave[moduleNameStd].remove("library");
+        /* Share the entries except the library key, no deep copy of the module */
+        YAML::Node moduleYaml(YAML::NodeType::Map);
+        for (const auto &entry : moduleNode) {
+            if (entry.first.Scalar() != "library") {
+                moduleYaml[entry.first] = entry.second;
+            }
         }
+        dataToSave[moduleNameStd] = moduleYaml;
     }
 
-    /* Serialize and save to file */
-    const QString filePath
-        = QDir(projectManager->getModulePath()).filePath(libraryName + ".soc_mod");
-    std::ofstream outputFileStream(filePath.toStdString());
-    if (!outputFileStream.is_open()) {
-        qCritical() << "Error: Unable to open file for writing:" << filePath;
+    /* Replace the file in one rename, a failed write keeps the old library */
+    if (!QSocYamlUtils::saveFile(filePath, dataToSave)) {
+        qCritical() << "Error: Unable to write file:" << filePath;
         return false;
     }
-    outputFileStream << dataToSave;
+    changedModuleMap.remove(libraryName);
+
+    /* Take over what other processes changed, the resident library matches the file */
+    const YAML::Node &savedData = dataToSave;
+    for (const QString &moduleName : residentSet) {
+        if (!savedData[moduleName.toStdString()]) {
+            libraryMapRemove(libraryName, moduleName);
+            moduleData.remove(moduleName.toStdString());
+        }
+    }
+    for (const auto &entry : savedData) {
+        const QString moduleName = QString::fromStdString(entry.first.Scalar());
+        if (!changedSet.contains(moduleName)) {
+            /* Freshly parsed from the file, nothing else refers to the node */
+            moduleData[entry.first.Scalar()]            = entry.second;
+            moduleData[entry.first.Scalar()]["library"] = libraryName.toStdString();
+            libraryMapAdd(libraryName, moduleName);
+        }
+    }
+    if (libraryCache && modulePath == libraryCachePath) {
+        libraryDigest.insert(libraryName, QSocYamlUtils::fileDigest(filePath));
+    }
     return true;
 }
 
@@ -589,6 +929,8 @@ bool QSocModuleManager::remove(const QString &libraryName)
     /* Remove from moduleData and libraryMap */
     moduleData.remove(libraryName.toStdString());
     libraryMap.remove(libraryName);
+    dirtyLibrarySet.remove(libraryName);
+    changedModuleMap.remove(libraryName);
 
     return true;
 }
@@ -711,8 +1053,8 @@ YAML::Node QSocModuleManager::getModuleYamls(const QRegularExpression &moduleNam
 
         /* Check if the module name matches the regex */
         if (QStaticRegex::isNameExactMatch(moduleName, moduleNameRegex)) {
-            /* Add the module node to the result */
-            result[moduleName.toStdString()] = it->second;
+            /* Module names are unique, append without a key lookup */
+            result.force_insert(it->first, it->second);
         }
     }
 
@@ -737,6 +1079,7 @@ bool QSocModuleManager::updateModuleYaml(const QString &moduleName, const YAML::
     /* Update module data */
     moduleData[moduleName.toStdString()]            = moduleYaml;
     moduleData[moduleName.toStdString()]["library"] = libraryName.toStdString();
+    changedModuleMap[libraryName].insert(moduleName);
 
     /* Save the updated library */
     return save(libraryName);
@@ -775,6 +1118,7 @@ bool QSocModuleManager::removeModule(const QRegularExpression &moduleNameRegex)
         const QString libraryName = QString::fromStdString(
             moduleData[moduleName.toStdString()]["library"].as<std::string>());
         libraryMapRemove(libraryName, moduleName);
+        changedModuleMap[libraryName].insert(moduleName);
         if (!libraryMap.contains(libraryName)) {
             libraryToRemove.insert(libraryName);
         }
@@ -7,8 +7,10 @@
 #include "common/qllmservice.h"
 #include "common/qslangdriver.h"
 #include "common/qsocbusmanager.h"
+#include "common/qsocimportcache.h"
 #include "common/qsocprojectmanager.h"
 
+#include <QByteArray>
 #include <QObject>
 #include <QRegularExpression>
 
@@ -106,10 +108,83 @@ public slots:
      * @details Clears the libraryMap and moduleData members, providing a fresh
      *          environment for the next load operation. This method does not
      *          physically delete any files on disk, only clearing the in-memory
-     *          representation of module data.
+     *          representation of module data. Deferred saves are discarded.
      */
     void resetModuleData();
 
+    /**
+     * @brief Copy the loaded module data of another module manager.
+     * @details Deep copies the library map and moduleData, so that the copy can
+     *          be read from another thread while the original is in use.
+     *          Lookups on YAML nodes may insert entries, so sharing one
+     *          manager between threads is not safe even for reading.
+     * @param[in] other The module manager to copy from.
+     */
+    void copyLibraryData(const QSocModuleManager &other);
+
+    /**
+     * @brief Enable or disable reuse of already loaded libraries.
+     * @details When enabled, load() skips a library whose file has not been
+     *          modified since it was last read and keeps the in-memory copy.
+     *          Resident data is dropped when the module directory changes.
+     *          Long-lived hosts such as the serve daemon turn this on, the
+     *          one-shot command line leaves it off.
+     * @param enable true to reuse unchanged libraries.
+     */
+    void setLibraryCache(bool enable);
+
+    /**
+     * @brief Check whether already loaded libraries are reused.
+     * @retval true Unchanged libraries are reused on load.
+     * @retval false Every load() reads the library file.
+     */
+    bool isLibraryCache() const;
+
+    /**
+     * @brief Enable or disable the import cache.
+     * @details When enabled, importFromFileList() reuses the module
+     *          descriptors of a compilation unit whose sources, included
+     *          files and macros are unchanged since it was last imported,
+     *          without running slang. Enabled by default.
+     * @param enable true to reuse unchanged compilation units.
+     */
+    void setImportCache(bool enable);
+
+    /**
+     * @brief Set the directory of the persistent import cache.
+     * @details Empty by default, which keeps entries for the lifetime of
+     *          this manager only. Persisting is opt-in, usually in
+     *          QSocImportCache::defaultCacheDir().
+     * @param cacheDir The cache directory.
+     */
+    void setImportCacheDir(const QString &cacheDir);
+
+    /**
+     * @brief Enable or disable deferred library saves.
+     * @details While enabled, save() only marks the library as dirty and
+     *          flush() writes every dirty library at once. Enabling also
+     *          turns on the library cache, so pending edits survive later
+     *          load() calls on the same library.
+     * @param enable true to defer saves until flush().
+     */
+    void setDeferredSave(bool enable);
+
+    /**
+     * @brief Check whether library saves are deferred.
+     * @retval true save() waits for flush().
+     * @retval false save() writes the library at once.
+     */
+    bool isDeferredSave() const;
+
+    /**
+     * @brief Write all libraries with deferred saves.
+     * @details Writes every dirty library to the module directory it was
+     *          loaded from. Does nothing when no save is pending.
+     * @retval true All pending libraries were written.
+     * @retval false Writing any library failed.
+     */
+    bool flush();
+
     /**
      * @brief Import verilog files from file list.
      * @details This function will import verilog files from file list, and
@@ -125,16 +200,54 @@ public slots:
      * @param filePathList The list of verilog files.
      * @param macroDefines The list of macro definitions in KEY=VALUE format.
      * @param macroUndefines The list of macro names to undefine.
+     * @param chunkSize Number of files parsed per compilation, 0 parses all
+     *        files at once. Chunks bound the peak memory of large libraries,
+     *        but a chunk cannot see packages, macros or includes defined by
+     *        files of another chunk.
+     * @param parameterizationList Parameter overrides to elaborate imported
+     *        modules under. Each distinct parameter set is elaborated once,
+     *        concurrently, and its descriptor stored below the module's
+     *        `parameterization` key, keyed by parameterizationKey().
+     *        Overrides of modules not imported are ignored.
+     * @param jobs Maximum number of parallel elaborations, 0 uses all cores.
      * @retval true Import successfully.
      * @retval false Import failed.
+     * @note The slang compilation and AST are released once the module
+     *       descriptors have been extracted, also between chunks.
      */
     bool importFromFileList(
-        const QString            &libraryName,
-        const QRegularExpression &moduleNameRegex,
-        const QString            &fileListPath,
-        const QStringList        &filePathList,
-        const QStringList        &macroDefines   = QStringList(),
-        const QStringList        &macroUndefines = QStringList());
+        const QString                               &libraryName,
+        const QRegularExpression                    &moduleNameRegex,
+        const QString                               &fileListPath,
+        const QStringList                           &filePathList,
+        const QStringList                           &macroDefines         = QStringList(),
+        const QStringList                           &macroUndefines       = QStringList(),
+        int                                          chunkSize            = 0,
+        const QList<QSlangDriver::Parameterization> &parameterizationList = {},
+        int                                          jobs                 = 0);
+
+    /**
+     * @brief Get the key of a module parameterization.
+     * @details The module defaults with the overrides applied, as the
+     *          generator resolves the parameters of an instance, so that an
+     *          instance finds the descriptor elaborated for its parameters.
+     * @param moduleYaml The module descriptor.
+     * @param overrideMap Override value by parameter name.
+     * @return QString The key, for example "DEPTH=16,WIDTH=32".
+     */
+    static QString parameterizationKey(
+        const YAML::Node &moduleYaml, const QMap<QString, QString> &overrideMap);
+
+    /**
+     * @brief Collect the parameter overrides of netlist instances.
+     * @details Overrides are evaluated against the netlist parameters where
+     *          possible, others are passed on as written. Instances without
+     *          overrides are skipped.
+     * @param netlist The netlist YAML.
+     * @return QList<QSlangDriver::Parameterization> One entry per instance.
+     */
+    static QList<QSlangDriver::Parameterization> parameterizationsFromNetlist(
+        const YAML::Node &netlist);
 
     /**
      * @brief Get the Module Yaml object.
@@ -536,6 +649,46 @@ private:
     /* Module library YAML node. */
     YAML::Node moduleData;
 
+    /* Reuse unchanged libraries on load. */
+    bool libraryCache = false;
+
+    /* Content digest of each library file when it was last loaded. */
+    QMap<QString, QByteArray> libraryDigest;
+
+    /* The module directory the resident libraries were loaded from. */
+    QString libraryCachePath;
+
+    /* Defer save() until flush(). */
+    bool deferredSave = false;
+
+    /* Libraries with deferred saves. */
+    QSet<QString> dirtyLibrarySet;
+
+    /* Modules changed or removed by this process, by library. */
+    QMap<QString, QSet<QString>> changedModuleMap;
+
+    /* Reuse the descriptors of unchanged compilation units on import. */
+    bool importCacheEnabled = true;
+
+    /* Descriptors of imported compilation units. */
+    QSocImportCache importCache;
+
+    /**
+     * @brief Serialize one library into a module directory.
+     * @details Holds the library lock file while it rereads the library,
+     *          applies the modules this process changed or removed and
+     *          replaces the file, so concurrent processes keep each other's
+     *          changes. Modules other processes changed are taken over.
+     *          The whole file is rewritten; modules are not spliced into
+     *          hand-edited YAML, so large libraries should be split.
+     * @param libraryName The basename of the library, excluding extension.
+     * @param modulePath The module directory to write to.
+     * @retval true The library file was written.
+     * @retval false Module data is missing, the lock is held elsewhere or
+     *         the file cannot be written.
+     */
+    bool writeLibrary(const QString &libraryName, const QString &modulePath);
+
     /**
      * @brief Merge two YAML nodes.
      * @details This function will merge two YAML nodes. It returns a new map
@@ -575,6 +728,15 @@ private:
      */
     void libraryMapRemove(const QString &libraryName, const QString &moduleName);
 
+    /**
+     * @brief Forget a resident library.
+     * @details Removes the modules loaded from the library, its library map
+     *          entry and its file stamp. Modules another library has since
+     *          redefined are kept.
+     * @param libraryName The basename of the library, excluding extension.
+     */
+    void unloadLibrary(const QString &libraryName);
+
 signals:
 };
 
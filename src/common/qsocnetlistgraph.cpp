@@ -0,0 +1,389 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocnetlistgraph.h"
+
+#include <QRegularExpression>
+#include <QSet>
+
+#include <algorithm>
+
+namespace {
+
+/* Bit range text, a single bit is written without the colon */
+QString rangeText(int high, int low)
+{
+    return high == low ? QString("[%1]").arg(high) : QString("[%1:%2]").arg(high).arg(low);
+}
+
+} /* namespace */
+
+void QSocNetlistGraph::addPin(
+    const QString &netName,
+    const QString &instanceName,
+    const QString &portName,
+    Direction      direction,
+    const QString &bits,
+    int            width)
+{
+    auto netIndex = netIndexMap.constFind(netName);
+    if (netIndex == netIndexMap.constEnd()) {
+        Net net;
+        net.name = netName;
+        netList.append(net);
+        netIndex = netIndexMap.insert(netName, static_cast<int>(netList.size()) - 1);
+    }
+
+    Pin pin;
+    pin.instanceName = instanceName;
+    pin.portName     = portName;
+    pin.bits         = bits;
+    pin.direction    = direction;
+    pin.net          = netIndex.value();
+    pin.width        = width;
+    pinList.append(pin);
+
+    const int pinIndex = static_cast<int>(pinList.size()) - 1;
+    netList[pin.net].pinList.append(pinIndex);
+    pinIndexMap[instanceName + "." + portName].append(pinIndex);
+    instancePinMap[instanceName].append(pinIndex);
+}
+
+void QSocNetlistGraph::clear()
+{
+    pinList.clear();
+    netList.clear();
+    netIndexMap.clear();
+    pinIndexMap.clear();
+    instancePinMap.clear();
+}
+
+int QSocNetlistGraph::netCount() const
+{
+    return static_cast<int>(netList.size());
+}
+
+int QSocNetlistGraph::pinCount() const
+{
+    return static_cast<int>(pinList.size());
+}
+
+bool QSocNetlistGraph::contains(const QString &target) const
+{
+    return netIndexMap.contains(target) || pinIndexMap.contains(target)
+           || instancePinMap.contains(target);
+}
+
+bool QSocNetlistGraph::isDriver(const Pin &pin)
+{
+    return pin.direction != Direction::Input;
+}
+
+bool QSocNetlistGraph::isLoad(const Pin &pin)
+{
+    return pin.direction != Direction::Output;
+}
+
+QString QSocNetlistGraph::pinLabel(int pin) const
+{
+    const Pin &node = pinList.at(pin);
+    return node.instanceName + "." + node.portName + node.bits;
+}
+
+QList<int> QSocNetlistGraph::startNets(
+    const QString &target, bool downstream, QList<int> &startPins) const
+{
+    startPins.clear();
+
+    const auto netIndex = netIndexMap.constFind(target);
+    if (netIndex != netIndexMap.constEnd()) {
+        return {netIndex.value()};
+    }
+
+    if (pinIndexMap.contains(target)) {
+        startPins = pinIndexMap.value(target);
+    } else {
+        /* An instance starts from its outputs downstream, its inputs upstream */
+        for (const int pin : instancePinMap.value(target)) {
+            if (downstream ? isDriver(pinList.at(pin)) : isLoad(pinList.at(pin))) {
+                startPins.append(pin);
+            }
+        }
+    }
+
+    QList<int> result;
+    for (const int pin : startPins) {
+        if (!result.contains(pinList.at(pin).net)) {
+            result.append(pinList.at(pin).net);
+        }
+    }
+    return result;
+}
+
+QStringList QSocNetlistGraph::drivers(const QString &target) const
+{
+    QList<int>       startPins;
+    const QList<int> nets = startNets(target, false, startPins);
+
+    QStringList result;
+    for (const int net : nets) {
+        bool driven = false;
+        for (const int pin : netList.at(net).pinList) {
+            if (isDriver(pinList.at(pin)) && !startPins.contains(pin)) {
+                result.append(netList.at(net).name + " <- " + pinLabel(pin));
+                driven = true;
+            }
+        }
+        if (!driven) {
+            result.append(netList.at(net).name + " undriven");
+        }
+    }
+    return result;
+}
+
+QStringList QSocNetlistGraph::fanout(const QString &target, int depth) const
+{
+    return traverse(target, depth, true);
+}
+
+QStringList QSocNetlistGraph::fanin(const QString &target, int depth) const
+{
+    return traverse(target, depth, false);
+}
+
+QStringList QSocNetlistGraph::traverse(const QString &target, int depth, bool downstream) const
+{
+    QList<int> startPins;
+    QList<int> frontier = startNets(target, downstream, startPins);
+
+    QSet<int>     visitedNets;
+    QSet<QString> visitedInstances;
+    for (const int net : frontier) {
+        visitedNets.insert(net);
+    }
+    if (!netIndexMap.contains(target) && !pinIndexMap.contains(target)) {
+        visitedInstances.insert(target);
+    }
+
+    QStringList result;
+    for (int level = 1; level <= depth && !frontier.isEmpty(); ++level) {
+        QList<int> next;
+        for (const int net : frontier) {
+            for (const int pin : netList.at(net).pinList) {
+                const Pin &node = pinList.at(pin);
+                if ((downstream ? !isLoad(node) : !isDriver(node)) || startPins.contains(pin)) {
+                    continue;
+                }
+                result.append(
+                    QString::number(level) + " " + netList.at(net).name
+                    + (downstream ? " -> " : " <- ") + pinLabel(pin));
+
+                /* Top-level ports end the search, other instances pass it on */
+                if (node.instanceName == "top" || visitedInstances.contains(node.instanceName)) {
+                    continue;
+                }
+                visitedInstances.insert(node.instanceName);
+                for (const int other : instancePinMap.value(node.instanceName)) {
+                    const Pin &otherNode = pinList.at(other);
+                    if ((downstream ? isDriver(otherNode) : isLoad(otherNode))
+                        && !visitedNets.contains(otherNode.net)) {
+                        visitedNets.insert(otherNode.net);
+                        next.append(otherNode.net);
+                    }
+                }
+            }
+        }
+        frontier = next;
+    }
+    return result;
+}
+
+QStringList QSocNetlistGraph::path(const QString &from, const QString &to) const
+{
+    QList<int> startPins;
+    QList<int> queue = startNets(from, true, startPins);
+    if (queue.isEmpty() || !contains(to)) {
+        return {};
+    }
+
+    /* How each net was reached: previous net, its load pin and the driver pin */
+    struct Step
+    {
+        int net    = -1;
+        int load   = -1;
+        int driver = -1;
+    };
+    QHash<int, Step> stepMap;
+    for (const int net : queue) {
+        stepMap.insert(net, Step());
+    }
+    QSet<QString> visitedInstances;
+    if (!netIndexMap.contains(from) && !pinIndexMap.contains(from)) {
+        visitedInstances.insert(from);
+    }
+
+    for (int head = 0; head < queue.size(); ++head) {
+        const int net = queue.at(head);
+
+        /* The target is this net, or a pin or an instance reading it */
+        int  endPin = -1;
+        bool found  = netList.at(net).name == to;
+        for (int i = 0; !found && i < netList.at(net).pinList.size(); ++i) {
+            const int  pin  = netList.at(net).pinList.at(i);
+            const Pin &node = pinList.at(pin);
+            if (isLoad(node) && !startPins.contains(pin)
+                && (node.instanceName == to || node.instanceName + "." + node.portName == to)) {
+                endPin = pin;
+                found  = true;
+            }
+        }
+        if (found) {
+            QStringList result;
+            if (endPin >= 0) {
+                result.append(pinLabel(endPin));
+            }
+            for (int current = net; current >= 0;) {
+                result.prepend(netList.at(current).name);
+                const Step step = stepMap.value(current);
+                if (step.net >= 0) {
+                    result.prepend(pinLabel(step.driver));
+                    result.prepend(pinLabel(step.load));
+                }
+                current = step.net;
+            }
+            if (!netIndexMap.contains(from)) {
+                result.prepend(from);
+            }
+            return result;
+        }
+
+        for (const int pin : netList.at(net).pinList) {
+            const Pin &node = pinList.at(pin);
+            if (!isLoad(node) || node.instanceName == "top"
+                || visitedInstances.contains(node.instanceName)) {
+                continue;
+            }
+            visitedInstances.insert(node.instanceName);
+            for (const int other : instancePinMap.value(node.instanceName)) {
+                const Pin &otherNode = pinList.at(other);
+                if (isDriver(otherNode) && !stepMap.contains(otherNode.net)) {
+                    stepMap.insert(otherNode.net, Step{net, pin, other});
+                    queue.append(otherNode.net);
+                }
+            }
+        }
+    }
+    return {};
+}
+
+QStringList QSocNetlistGraph::bitSlices(const QString &netName) const
+{
+    const auto netIndex = netIndexMap.constFind(netName);
+    if (netIndex == netIndexMap.constEnd()) {
+        return {};
+    }
+
+    static const QRegularExpression bitsRegex(R"(^\s*\[\s*(\d+)\s*(?::\s*(\d+))?\s*\]\s*$)");
+
+    QStringList result;
+    QList<int>  driverCount;
+    for (const int pin : netList.at(netIndex.value()).pinList) {
+        const Pin    &node = pinList.at(pin);
+        const QString role = node.direction == Direction::Output  ? "driver"
+                             : node.direction == Direction::Input ? "load"
+                                                                  : "inout";
+
+        int high = -1;
+        int low  = -1;
+        if (!node.bits.isEmpty()) {
+            const QRegularExpressionMatch match = bitsRegex.match(node.bits);
+            if (match.hasMatch()) {
+                high = match.captured(1).toInt();
+                low  = match.captured(2).isEmpty() ? high : match.captured(2).toInt();
+                if (high < low) {
+                    std::swap(high, low);
+                }
+            }
+        } else if (node.width > 0) {
+            high = node.width - 1;
+            low  = 0;
+        }
+        if (high < 0) {
+            result.append(QString("[?] %1 %2").arg(role, pinLabel(pin)));
+            continue;
+        }
+        result.append(QString("%1 %2 %3").arg(rangeText(high, low), role, pinLabel(pin)));
+
+        while (driverCount.size() <= high) {
+            driverCount.append(0);
+        }
+        if (isDriver(node)) {
+            for (int bit = low; bit <= high; ++bit) {
+                driverCount[bit]++;
+            }
+        }
+    }
+
+    /* Runs of bits with no driver or with several drivers */
+    for (int bit = 0; bit < driverCount.size();) {
+        const int count = driverCount.at(bit);
+        int       end   = bit;
+        while (end + 1 < driverCount.size()
+               && (driverCount.at(end + 1) > 1) == (count > 1)
+               && (driverCount.at(end + 1) == 0) == (count == 0)) {
+            ++end;
+        }
+        if (count == 0) {
+            result.append(rangeText(end, bit) + " undriven");
+        } else if (count > 1) {
+            result.append(rangeText(end, bit) + " multiple drivers");
+        }
+        bit = end + 1;
+    }
+    return result;
+}
+
+const QStringList &QSocNetlistGraph::queryNames()
+{
+    static const QStringList nameList = {"driver", "fanout", "fanin", "path", "bits"};
+    return nameList;
+}
+
+QSocNetlistGraph::QueryStatus QSocNetlistGraph::query(
+    const QString &name,
+    const QString &target,
+    const QString &endTarget,
+    int            depth,
+    QStringList   &result) const
+{
+    result.clear();
+    if (!queryNames().contains(name)) {
+        return QueryStatus::UnknownQuery;
+    }
+    if (!contains(target)) {
+        return QueryStatus::UnknownTarget;
+    }
+
+    if (name == "driver") {
+        result = drivers(target);
+    } else if (name == "fanout") {
+        result = fanout(target, depth);
+    } else if (name == "fanin") {
+        result = fanin(target, depth);
+    } else if (name == "path") {
+        if (!contains(endTarget)) {
+            return QueryStatus::UnknownEndTarget;
+        }
+        const QStringList stepList = path(target, endTarget);
+        if (stepList.isEmpty()) {
+            return QueryStatus::NoPath;
+        }
+        result.append(stepList.join(" -> "));
+    } else {
+        result = bitSlices(target);
+        if (result.isEmpty()) {
+            return QueryStatus::NotNet;
+        }
+    }
+    return QueryStatus::Ok;
+}
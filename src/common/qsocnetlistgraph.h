@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCNETLISTGRAPH_H
+#define QSOCNETLISTGRAPH_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The QSocNetlistGraph class.
+ * @details Connectivity index of a processed netlist, for answering driver,
+ *          fanout, fanin, path and bit slice queries. Pins are the instance
+ *          ports connected to each net, top-level ports use the instance
+ *          name `top`. Instances are black boxes: every input of an
+ *          instance is assumed to reach every output. All queries are
+ *          breadth-first searches over hash indexes, so each one visits a
+ *          net or an instance at most once.
+ *
+ *          A query target is a net name, a pin as `instance.port`, or an
+ *          instance name, looked up in that order.
+ */
+class QSocNetlistGraph
+{
+public:
+    /**
+     * @brief Pin direction, as seen from the net.
+     */
+    enum class Direction {
+        Input,  /**< The pin is driven by the net */
+        Output, /**< The pin drives the net */
+        Inout,  /**< The pin both drives and is driven by the net */
+    };
+
+    /**
+     * @brief Outcome of query().
+     */
+    enum class QueryStatus {
+        Ok,               /**< The query ran, its result may be empty */
+        UnknownQuery,     /**< The query name is not one of queryNames() */
+        UnknownTarget,    /**< The target is not a net, pin or instance */
+        UnknownEndTarget, /**< The path end target is not a net, pin or instance */
+        NoPath,           /**< No path leads from the target to the end target */
+        NotNet,           /**< A bits query target is not a net */
+    };
+
+    /**
+     * @brief Add a pin connection.
+     * @param netName Name of the net.
+     * @param instanceName Name of the instance, `top` for top-level ports.
+     * @param portName Name of the port.
+     * @param direction Direction of the pin, seen from the net.
+     * @param bits Net bits the pin connects to, like "[7:4]". Empty for
+     *        the whole pin width.
+     * @param width Width of the pin in bits, 0 when unknown.
+     */
+    void addPin(
+        const QString &netName,
+        const QString &instanceName,
+        const QString &portName,
+        Direction      direction,
+        const QString &bits  = QString(),
+        int            width = 0);
+
+    /**
+     * @brief Remove all nets and pins.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of nets.
+     * @return The number of nets.
+     */
+    int netCount() const;
+
+    /**
+     * @brief Get the number of pin connections.
+     * @return The number of pin connections.
+     */
+    int pinCount() const;
+
+    /**
+     * @brief Check whether a target is a known net, pin or instance.
+     * @param target The query target.
+     * @return Whether the target is known.
+     */
+    bool contains(const QString &target) const;
+
+    /**
+     * @brief Get the drivers of a net.
+     * @details For a pin or instance target, the drivers of each net it
+     *          reads.
+     * @param target The query target.
+     * @return One `net <- pin` line per driver.
+     */
+    QStringList drivers(const QString &target) const;
+
+    /**
+     * @brief Get the loads reached from a target.
+     * @details Level 1 lists the loads of the target nets, each further
+     *          level continues through the outputs of the instances found.
+     *          Top-level ports end the search.
+     * @param target The query target.
+     * @param depth Number of levels, at least 1.
+     * @return One `level net -> pin` line per load.
+     */
+    QStringList fanout(const QString &target, int depth = 1) const;
+
+    /**
+     * @brief Get the drivers reaching a target.
+     * @details The reverse of fanout(), through the inputs of the
+     *          instances found.
+     * @param target The query target.
+     * @param depth Number of levels, at least 1.
+     * @return One `level net <- pin` line per driver.
+     */
+    QStringList fanin(const QString &target, int depth = 1) const;
+
+    /**
+     * @brief Get a shortest path from one target to another.
+     * @details The path follows the signal flow, from drivers to loads.
+     * @param from The start target.
+     * @param to The end target.
+     * @return Nets and pins along the path, empty when there is none.
+     */
+    QStringList path(const QString &from, const QString &to) const;
+
+    /**
+     * @brief Get the bit slices of a net and the pins owning them.
+     * @details Lists the bit range of every pin on the net, followed by
+     *          the ranges without a driver and the ranges with more than
+     *          one driver. Pins of unknown width without a bit select are
+     *          listed with a `[?]` range and not checked.
+     * @param netName Name of the net.
+     * @return One line per bit range.
+     */
+    QStringList bitSlices(const QString &netName) const;
+
+    /**
+     * @brief Get the query names accepted by query().
+     * @return `driver`, `fanout`, `fanin`, `path` and `bits`.
+     */
+    static const QStringList &queryNames();
+
+    /**
+     * @brief Run a query by name.
+     * @details Front end shared by the command line and the agent tool. A
+     *          path query yields a single line, its steps joined by ` -> `.
+     * @param name The query name, one of queryNames().
+     * @param target The query target.
+     * @param endTarget The path end target, unused by other queries.
+     * @param depth Number of levels for fanout and fanin, at least 1.
+     * @param result Set to the result lines.
+     * @return The query status.
+     */
+    QueryStatus query(
+        const QString &name,
+        const QString &target,
+        const QString &endTarget,
+        int            depth,
+        QStringList   &result) const;
+
+private:
+    /**
+     * @brief Pin connection of a net
+     */
+    struct Pin
+    {
+        QString   instanceName;                 /**< Instance name, `top` for top-level ports */
+        QString   portName;                     /**< Port name */
+        QString   bits;                         /**< Net bits, empty for the whole width */
+        Direction direction = Direction::Input; /**< Direction seen from the net */
+        int       net       = 0;                /**< Index of the net */
+        int       width     = 0;                /**< Pin width, 0 when unknown */
+    };
+
+    /**
+     * @brief Net with its pin connections
+     */
+    struct Net
+    {
+        QString    name;    /**< Net name */
+        QList<int> pinList; /**< Indexes of the connected pins */
+    };
+
+    QList<Pin>                 pinList;
+    QList<Net>                 netList;
+    QHash<QString, int>        netIndexMap;    /**< By net name */
+    QHash<QString, QList<int>> pinIndexMap;    /**< By `instance.port` */
+    QHash<QString, QList<int>> instancePinMap; /**< By instance name */
+
+    /**
+     * @brief Check whether a pin drives its net
+     * @param pin The pin
+     * @return Whether the pin is an output or inout
+     */
+    static bool isDriver(const Pin &pin);
+
+    /**
+     * @brief Check whether a pin is driven by its net
+     * @param pin The pin
+     * @return Whether the pin is an input or inout
+     */
+    static bool isLoad(const Pin &pin);
+
+    /**
+     * @brief Get the printable name of a pin
+     * @param pin Index of the pin
+     * @return `instance.port` with the net bits, if any
+     */
+    QString pinLabel(int pin) const;
+
+    /**
+     * @brief Get the nets a search starts from
+     * @param target The query target
+     * @param downstream Search towards the loads
+     * @param startPins Set to the pins the target stands for
+     * @return Indexes of the start nets
+     */
+    QList<int> startNets(const QString &target, bool downstream, QList<int> &startPins) const;
+
+    /**
+     * @brief Breadth-first search for fanout() and fanin()
+     * @param target The query target
+     * @param depth Number of levels
+     * @param downstream Search towards the loads
+     * @return One line per pin found
+     */
+    QStringList traverse(const QString &target, int depth, bool downstream) const;
+};
+
+#endif // QSOCNETLISTGRAPH_H
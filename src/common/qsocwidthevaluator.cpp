@@ -0,0 +1,447 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocwidthevaluator.h"
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QStringView>
+
+#include <array>
+
+namespace {
+
+/* Binary operators from the lowest to the highest precedence */
+const std::array<QStringList, 11> &binaryLevelList()
+{
+    static const std::array<QStringList, 11> levelList
+        = {QStringList{"||"},
+           QStringList{"&&"},
+           QStringList{"|"},
+           QStringList{"^"},
+           QStringList{"&"},
+           QStringList{"==", "!="},
+           QStringList{"<", "<=", ">", ">="},
+           QStringList{"<<", ">>"},
+           QStringList{"+", "-"},
+           QStringList{"*", "/", "%"},
+           QStringList{"**"}};
+    return levelList;
+}
+
+/* Two-character operators are matched before their one-character prefixes */
+const QStringList &operatorList()
+{
+    static const QStringList list
+        = {"**", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||", "+", "-", "*", "/", "%",
+           "<",  ">",  "&",  "^",  "|",  "!",  "~",  "?",  ":",  "(", ")"};
+    return list;
+}
+
+qint64 clog2(qint64 value)
+{
+    qint64 result = 0;
+    for (quint64 rest = static_cast<quint64>(value) - 1; value > 1 && rest > 0; rest >>= 1) {
+        ++result;
+    }
+    return result;
+}
+
+std::optional<qint64> applyBinary(const QString &op, qint64 lhs, qint64 rhs)
+{
+    if (op == "||") {
+        return (lhs || rhs) ? 1 : 0;
+    }
+    if (op == "&&") {
+        return (lhs && rhs) ? 1 : 0;
+    }
+    if (op == "|") {
+        return lhs | rhs;
+    }
+    if (op == "^") {
+        return lhs ^ rhs;
+    }
+    if (op == "&") {
+        return lhs & rhs;
+    }
+    if (op == "==") {
+        return lhs == rhs ? 1 : 0;
+    }
+    if (op == "!=") {
+        return lhs != rhs ? 1 : 0;
+    }
+    if (op == "<") {
+        return lhs < rhs ? 1 : 0;
+    }
+    if (op == "<=") {
+        return lhs <= rhs ? 1 : 0;
+    }
+    if (op == ">") {
+        return lhs > rhs ? 1 : 0;
+    }
+    if (op == ">=") {
+        return lhs >= rhs ? 1 : 0;
+    }
+    if (op == "<<" || op == ">>") {
+        if (rhs < 0) {
+            return std::nullopt;
+        }
+        if (rhs >= 64) {
+            return 0;
+        }
+        const quint64 bits = static_cast<quint64>(lhs);
+        return static_cast<qint64>(op == "<<" ? bits << rhs : bits >> rhs);
+    }
+    if (op == "+") {
+        return static_cast<qint64>(static_cast<quint64>(lhs) + static_cast<quint64>(rhs));
+    }
+    if (op == "-") {
+        return static_cast<qint64>(static_cast<quint64>(lhs) - static_cast<quint64>(rhs));
+    }
+    if (op == "*") {
+        return static_cast<qint64>(static_cast<quint64>(lhs) * static_cast<quint64>(rhs));
+    }
+    if (op == "/" || op == "%") {
+        if (rhs == 0) {
+            return std::nullopt;
+        }
+        return op == "/" ? lhs / rhs : lhs % rhs;
+    }
+    if (op == "**") {
+        if (rhs < 0) {
+            return std::nullopt;
+        }
+        quint64 result = 1;
+        for (qint64 count = 0; count < rhs && count < 64; ++count) {
+            result *= static_cast<quint64>(lhs);
+        }
+        return static_cast<qint64>(result);
+    }
+    return std::nullopt;
+}
+
+/*
+ * Recursive descent evaluator. Syntax errors abort the whole expression,
+ * while value errors (unknown names, division by zero) only poison the
+ * subexpression, so that an untaken `?:` branch or a short-circuited
+ * operand may still be invalid, as in `N == 0 ? 1 : 64 / N`.
+ */
+class ExpressionParser
+{
+public:
+    ExpressionParser(const QString &text, const QSocWidthEvaluator::ParameterMap &parameters)
+        : text(text)
+        , parameters(parameters)
+    {}
+
+    std::optional<qint64> parse()
+    {
+        const std::optional<qint64> value = parseTernary();
+        skipSpace();
+        if (syntaxError || pos != text.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+private:
+    const QString                          &text;
+    const QSocWidthEvaluator::ParameterMap &parameters;
+    qsizetype                               pos         = 0;
+    bool                                    syntaxError = false;
+
+    void skipSpace()
+    {
+        while (pos < text.size() && text.at(pos).isSpace()) {
+            ++pos;
+        }
+    }
+
+    QString peekOperator()
+    {
+        skipSpace();
+        const QStringView rest = QStringView(text).mid(pos);
+        for (const QString &op : operatorList()) {
+            if (rest.startsWith(op)) {
+                return op;
+            }
+        }
+        return QString();
+    }
+
+    bool accept(const QString &op)
+    {
+        if (peekOperator() != op) {
+            return false;
+        }
+        pos += op.size();
+        return true;
+    }
+
+    void expect(const QString &op)
+    {
+        if (!accept(op)) {
+            syntaxError = true;
+        }
+    }
+
+    std::optional<qint64> parseTernary()
+    {
+        const std::optional<qint64> condition = parseBinary(0);
+        if (syntaxError || !accept("?")) {
+            return condition;
+        }
+        const std::optional<qint64> whenTrue = parseTernary();
+        expect(":");
+        const std::optional<qint64> whenFalse = parseTernary();
+        if (!condition) {
+            return std::nullopt;
+        }
+        return *condition ? whenTrue : whenFalse;
+    }
+
+    std::optional<qint64> parseBinary(std::size_t level)
+    {
+        if (level == binaryLevelList().size()) {
+            return parseUnary();
+        }
+        std::optional<qint64> lhs = parseBinary(level + 1);
+        while (!syntaxError) {
+            const QString op = peekOperator();
+            if (!binaryLevelList()[level].contains(op)) {
+                break;
+            }
+            pos += op.size();
+            const std::optional<qint64> rhs = parseBinary(level + 1);
+            if (op == "&&" && lhs && *lhs == 0) {
+                lhs = 0;
+            } else if (op == "||" && lhs && *lhs != 0) {
+                lhs = 1;
+            } else if (lhs && rhs) {
+                lhs = applyBinary(op, *lhs, *rhs);
+            } else {
+                lhs = std::nullopt;
+            }
+        }
+        return lhs;
+    }
+
+    std::optional<qint64> parseUnary()
+    {
+        const QString op = peekOperator();
+        if (op == "+" || op == "-" || op == "!" || op == "~") {
+            pos += op.size();
+            const std::optional<qint64> value = parseUnary();
+            if (!value) {
+                return std::nullopt;
+            }
+            if (op == "-") {
+                return static_cast<qint64>(0 - static_cast<quint64>(*value));
+            }
+            if (op == "!") {
+                return *value == 0 ? 1 : 0;
+            }
+            return op == "~" ? ~*value : *value;
+        }
+        return parsePrimary();
+    }
+
+    std::optional<qint64> parsePrimary()
+    {
+        skipSpace();
+        if (pos >= text.size()) {
+            syntaxError = true;
+            return std::nullopt;
+        }
+        if (accept("(")) {
+            const std::optional<qint64> value = parseTernary();
+            expect(")");
+            return value;
+        }
+        const QChar head = text.at(pos);
+        if (head.isDigit() || head == '\'') {
+            return parseNumber();
+        }
+        if (head.isLetter() || head == '_' || head == '$') {
+            const qsizetype start = pos;
+            ++pos;
+            while (pos < text.size()
+                   && (text.at(pos).isLetterOrNumber() || text.at(pos) == '_'
+                       || text.at(pos) == '$')) {
+                ++pos;
+            }
+            const QString name = text.mid(start, pos - start);
+            if (name == "$clog2") {
+                expect("(");
+                const std::optional<qint64> value = parseTernary();
+                expect(")");
+                return value ? std::optional<qint64>(clog2(*value)) : std::nullopt;
+            }
+            if (name.startsWith('$')) {
+                syntaxError = true;
+                return std::nullopt;
+            }
+            const auto it = parameters.constFind(name);
+            return it != parameters.constEnd() ? std::optional<qint64>(*it) : std::nullopt;
+        }
+        syntaxError = true;
+        return std::nullopt;
+    }
+
+    /* Decimal literals and Verilog based literals such as 8'hff or 'd10 */
+    std::optional<qint64> parseNumber()
+    {
+        /* \G anchors the match at the current position */
+        static const QRegularExpression numberRegex(
+            R"(\G(\d[\d_]*)?\s*(?:'([sS]?)([bBoOdDhH])\s*([0-9a-fA-FxXzZ?_]+))?)");
+        const QRegularExpressionMatch match = numberRegex.match(text, pos);
+        if (!match.hasMatch() || match.capturedLength(0) == 0) {
+            syntaxError = true;
+            return std::nullopt;
+        }
+        pos += match.capturedLength(0);
+
+        QString size = match.captured(1);
+        size.remove('_');
+        if (match.capturedLength(3) == 0) {
+            bool         ok    = false;
+            const qint64 value = size.toLongLong(&ok);
+            return ok ? std::optional<qint64>(value) : std::nullopt;
+        }
+
+        QString digits = match.captured(4);
+        digits.remove('_');
+        const QChar baseChar = match.captured(3).at(0).toLower();
+        const int   radix    = baseChar == 'b'   ? 2
+                               : baseChar == 'o' ? 8
+                               : baseChar == 'd' ? 10
+                                                 : 16;
+        bool        ok       = false;
+        quint64     value    = digits.toULongLong(&ok, radix);
+        if (!ok) {
+            /* Unknown bits (x, z, ?) or out of range */
+            return std::nullopt;
+        }
+        if (!size.isEmpty()) {
+            const int width = size.toInt(&ok);
+            if (!ok || width <= 0) {
+                return std::nullopt;
+            }
+            if (width < 64) {
+                value &= (quint64(1) << width) - 1;
+            }
+        }
+        return static_cast<qint64>(value);
+    }
+};
+
+std::optional<qint64> evaluateNode(
+    const YAML::Node &node, const QSocWidthEvaluator::ParameterMap &parameters)
+{
+    /* Module parameters are maps with a value field, overrides are scalars */
+    const YAML::Node value = (node.IsMap() && node["value"]) ? node["value"] : node;
+    if (!value.IsScalar()) {
+        return std::nullopt;
+    }
+    return QSocWidthEvaluator::evaluate(QString::fromStdString(value.Scalar()), parameters);
+}
+
+} /* namespace */
+
+std::optional<qint64> QSocWidthEvaluator::evaluate(
+    const QString &expression, const ParameterMap &parameters)
+{
+    ExpressionParser parser(expression, parameters);
+    return parser.parse();
+}
+
+QSocWidthEvaluator::ParameterMap QSocWidthEvaluator::resolveParameters(
+    const YAML::Node &defaults, const YAML::Node &overrides, const ParameterMap &parentParameters)
+{
+    ParameterMap result;
+    if (defaults && defaults.IsMap()) {
+        for (const auto &item : defaults) {
+            const std::string name         = item.first.as<std::string>();
+            const YAML::Node  overrideNode = (overrides && overrides.IsMap()) ? overrides[name]
+                                                                              : YAML::Node();
+            const std::optional<qint64> value
+                = overrideNode ? evaluateNode(overrideNode, parentParameters)
+                               : evaluateNode(item.second, result);
+            if (value) {
+                result.insert(QString::fromStdString(name), *value);
+            }
+        }
+    }
+    /* Overrides of parameters the module does not declare still take effect */
+    if (overrides && overrides.IsMap()) {
+        for (const auto &item : overrides) {
+            const QString name = QString::fromStdString(item.first.as<std::string>());
+            if (!result.contains(name)) {
+                const std::optional<qint64> value = evaluateNode(item.second, parentParameters);
+                if (value) {
+                    result.insert(name, *value);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::optional<int> QSocWidthEvaluator::typeWidth(
+    const QString &type, const ParameterMap &parameters)
+{
+    const qsizetype open = type.indexOf('[');
+    if (open < 0) {
+        return 1;
+    }
+    const qsizetype close = type.indexOf(']', open);
+    if (close < open) {
+        return std::nullopt;
+    }
+
+    /* Split on the top-level colon, a ternary may contain colons too */
+    const QString range = type.mid(open + 1, close - open - 1);
+    qsizetype     split = -1;
+    int           depth = 0;
+    int           query = 0;
+    for (qsizetype index = 0; index < range.size(); ++index) {
+        const QChar ch = range.at(index);
+        if (ch == '(') {
+            ++depth;
+        } else if (ch == ')') {
+            --depth;
+        } else if (ch == '?' && depth == 0) {
+            ++query;
+        } else if (ch == ':' && depth == 0) {
+            if (query > 0) {
+                --query;
+            } else {
+                split = index;
+            }
+        }
+    }
+
+    if (split < 0) {
+        const std::optional<qint64> msb = evaluate(range, parameters);
+        if (!msb || *msb < 0) {
+            return std::nullopt;
+        }
+        return static_cast<int>(*msb + 1);
+    }
+    const std::optional<qint64> msb = evaluate(range.left(split), parameters);
+    const std::optional<qint64> lsb = evaluate(range.mid(split + 1), parameters);
+    if (!msb || !lsb) {
+        return std::nullopt;
+    }
+    return static_cast<int>(qAbs(*msb - *lsb) + 1);
+}
+
+QString QSocWidthEvaluator::parameterKey(const ParameterMap &parameters)
+{
+    /* QMap iterates in key order, so equal sets give equal keys */
+    QStringList itemList;
+    for (auto it = parameters.constBegin(); it != parameters.constEnd(); ++it) {
+        itemList.append(QString("%1=%2").arg(it.key()).arg(it.value()));
+    }
+    return itemList.join(',');
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#ifndef QSOCWIDTHEVALUATOR_H
+#define QSOCWIDTHEVALUATOR_H
+
+#include <QMap>
+#include <QString>
+
+#include <optional>
+
+#include <yaml-cpp/yaml.h>
+
+/**
+ * @brief The QSocWidthEvaluator class.
+ * @details Evaluates the constant expressions found in parameter values and
+ *          port ranges, such as `DATA_W-1` or `$clog2(DEPTH)`, so that port
+ *          widths like `logic[DATA_W-1:0]` can be resolved for a concrete
+ *          parameter set. Integer semantics follow Verilog constant
+ *          expressions on 64-bit signed values. It is not meant to be
+ *          instantiated but used directly through its static methods.
+ */
+class QSocWidthEvaluator
+{
+public:
+    /**
+     * @brief Resolved parameter values, keyed by parameter name.
+     */
+    using ParameterMap = QMap<QString, qint64>;
+
+    /**
+     * @brief Evaluate a constant expression.
+     * @details Supports decimal and based literals (`8'hff`), parameter
+     *          names, parentheses, `$clog2()`, the unary operators `+ - ! ~`,
+     *          the binary operators `** * / % + - << >> < <= > >= == != & ^ |
+     *          && ||` with Verilog precedence, and the `?:` operator.
+     * @param expression The expression text.
+     * @param parameters Values of the parameters the expression may use.
+     * @return The value, or std::nullopt when the expression is malformed,
+     *         uses an unknown name, or divides by zero.
+     */
+    static std::optional<qint64> evaluate(
+        const QString &expression, const ParameterMap &parameters = ParameterMap());
+
+    /**
+     * @brief Resolve a module parameter set.
+     * @details Defaults are evaluated in declaration order, so that a default
+     *          may refer to parameters declared before it. Overrides are
+     *          evaluated against the parent scope, as in a Verilog instance.
+     *          A parameter is either a scalar or a map with a `value` field.
+     *          Parameters that cannot be evaluated are left out.
+     * @param defaults The module `parameter` node.
+     * @param overrides The instance `parameter` node.
+     * @param parentParameters Values visible to override expressions.
+     * @return The resolved parameter values.
+     */
+    static ParameterMap resolveParameters(
+        const YAML::Node   &defaults,
+        const YAML::Node   &overrides        = YAML::Node(),
+        const ParameterMap &parentParameters = ParameterMap());
+
+    /**
+     * @brief Get the bit width of a port or net type.
+     * @details `[msb:lsb]` is |msb-lsb|+1 bits, `[n]` is n+1 bits as used by
+     *          the netlist format, and a type without a range is one bit.
+     * @param type The type, for example "logic[DATA_W-1:0]".
+     * @param parameters Values of the parameters used in the range.
+     * @return The width, or std::nullopt when the range cannot be evaluated.
+     */
+    static std::optional<int> typeWidth(
+        const QString &type, const ParameterMap &parameters = ParameterMap());
+
+    /**
+     * @brief Build a canonical key for a parameter set.
+     * @details Equal parameter sets give equal keys, which makes the key
+     *          suitable for memoizing per-parameterization results.
+     * @param parameters The parameter values.
+     * @return The key, for example "DEPTH=16,WIDTH=32".
+     */
+    static QString parameterKey(const ParameterMap &parameters);
+};
+
+#endif // QSOCWIDTHEVALUATOR_H
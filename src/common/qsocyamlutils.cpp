@@ -3,12 +3,215 @@
 
 #include "qsocyamlutils.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 
 #include <fstream>
 #include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/* Merge behaviour of a node, mergeNodes treats each kind differently */
+enum class MergeKind { Skip, Scalar, Sequence, Map };
+
+/* One node taking part in a merge level, with the index of its source */
+struct MergeSource
+{
+    YAML::Node node;
+    qsizetype  source = 0;
+};
+
+/* Children of all merged maps sharing one key */
+struct MergeGroup
+{
+    YAML::Node               key;
+    std::vector<MergeSource> sourceList;
+};
+
+MergeKind mergeKind(const YAML::Node &node)
+{
+    if (!node.IsDefined() || node.IsNull()) {
+        return MergeKind::Skip;
+    }
+    if (node.IsSequence()) {
+        return MergeKind::Sequence;
+    }
+    if (node.IsMap()) {
+        return MergeKind::Map;
+    }
+    return MergeKind::Scalar;
+}
+
+QString describeMergeNode(const YAML::Node &node)
+{
+    if (node.IsScalar()) {
+        return QString("\"%1\"").arg(QString::fromStdString(node.Scalar()));
+    }
+    return node.IsSequence() ? QString("a list") : QString("a map");
+}
+
+class NodeListMerger
+{
+public:
+    NodeListMerger(const QStringList &nameList, QStringList *conflictList)
+        : nameList(nameList)
+        , conflictList(conflictList)
+    {}
+
+    YAML::Node merge(const std::vector<MergeSource> &sourceList, const QString &path)
+    {
+        /* A later node of another kind, or a later scalar, replaces everything before it */
+        std::size_t start    = 0;
+        std::size_t previous = 0;
+        std::size_t count    = 0;
+        MergeKind   kind     = MergeKind::Skip;
+        for (std::size_t index = 0; index < sourceList.size(); ++index) {
+            const MergeKind current = mergeKind(sourceList[index].node);
+            if (current == MergeKind::Skip) {
+                continue;
+            }
+            if (current != kind || current == MergeKind::Scalar) {
+                if (kind != MergeKind::Skip) {
+                    reportConflict(sourceList[previous], sourceList[index], path);
+                }
+                start = index;
+                count = 0;
+            }
+            kind     = current;
+            previous = index;
+            ++count;
+        }
+
+        switch (kind) {
+        case MergeKind::Skip:
+            return sourceList.empty() ? YAML::Node() : sourceList.front().node;
+        case MergeKind::Scalar:
+            return sourceList[start].node;
+        case MergeKind::Sequence:
+            return count == 1 ? sourceList[start].node : mergeSequences(sourceList, start);
+        case MergeKind::Map:
+            return count == 1 ? sourceList[start].node : mergeMaps(sourceList, start, path);
+        }
+        return {};
+    }
+
+private:
+    const QStringList &nameList;
+    QStringList       *conflictList;
+
+    QString sourceName(qsizetype source) const
+    {
+        return source < nameList.size() ? nameList.at(source) : QString("#%1").arg(source + 1);
+    }
+
+    void reportConflict(const MergeSource &from, const MergeSource &to, const QString &path)
+    {
+        if (!conflictList) {
+            return;
+        }
+        if (from.node.IsScalar() && to.node.IsScalar() && from.node.Scalar() == to.node.Scalar()) {
+            return;
+        }
+        conflictList->append(QString("%1: %2 from %3 overridden by %4 from %5")
+                                 .arg(path.isEmpty() ? QString("<root>") : path)
+                                 .arg(describeMergeNode(from.node), sourceName(from.source))
+                                 .arg(describeMergeNode(to.node), sourceName(to.source)));
+    }
+
+    static YAML::Node mergeSequences(const std::vector<MergeSource> &sourceList, std::size_t start)
+    {
+        /* Sequences are concatenated in order */
+        YAML::Node result(YAML::NodeType::Sequence);
+        for (std::size_t index = start; index < sourceList.size(); ++index) {
+            if (mergeKind(sourceList[index].node) == MergeKind::Skip) {
+                continue;
+            }
+            for (const auto &item : sourceList[index].node) {
+                result.push_back(item);
+            }
+        }
+        return result;
+    }
+
+    YAML::Node mergeMaps(
+        const std::vector<MergeSource> &sourceList, std::size_t start, const QString &path)
+    {
+        /* Group the children of every map by key, in order of first appearance */
+        std::vector<MergeGroup>                      groupList;
+        std::unordered_map<std::string, std::size_t> groupIndex;
+        for (std::size_t index = start; index < sourceList.size(); ++index) {
+            const MergeSource &source = sourceList[index];
+            if (mergeKind(source.node) == MergeKind::Skip) {
+                continue;
+            }
+            for (auto iter : source.node) {
+                if (!iter.first.IsScalar()) {
+                    /* Non-scalar keys cannot be matched, keep them apart */
+                    groupList.push_back({iter.first, {{iter.second, source.source}}});
+                    continue;
+                }
+                const auto [found, inserted]
+                    = groupIndex.try_emplace(iter.first.Scalar(), groupList.size());
+                if (inserted) {
+                    groupList.push_back({iter.first, {}});
+                }
+                groupList[found->second].sourceList.push_back({iter.second, source.source});
+            }
+        }
+
+        /* Keys are unique by construction, insert without lookups */
+        YAML::Node result(YAML::NodeType::Map);
+        for (const MergeGroup &group : groupList) {
+            QString childPath = path;
+            if (group.key.IsScalar()) {
+                const QString key = QString::fromStdString(group.key.Scalar());
+                childPath         = path.isEmpty() ? key : path + '.' + key;
+            }
+            result.force_insert(group.key, merge(group.sourceList, childPath));
+        }
+        return result;
+    }
+};
+
+} /* namespace */
+
+YAML::Node QSocYamlUtils::loadFile(const QString &filePath)
+{
+    return YAML::LoadFile(filePath.toStdString());
+}
+
+bool QSocYamlUtils::saveFile(const QString &filePath, const YAML::Node &yamlNode)
+{
+    YAML::Emitter emitter;
+    emitter << yamlNode;
+    if (!emitter.good()) {
+        return false;
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    file.write(emitter.c_str(), static_cast<qint64>(emitter.size()));
+    return file.commit();
+}
+
+QByteArray QSocYamlUtils::fileDigest(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(&file);
+    return hash.result();
+}
 
 YAML::Node QSocYamlUtils::mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml)
 {
@@ -91,11 +294,28 @@ YAML::Node QSocYamlUtils::mergeNodes(const YAML::Node &toYaml, const YAML::Node
     return resultYaml;
 }
 
+YAML::Node QSocYamlUtils::mergeNodeList(
+    const QList<YAML::Node> &nodeList, const QStringList &sourceList, QStringList *conflictList)
+{
+    std::vector<MergeSource> mergeSourceList;
+    mergeSourceList.reserve(nodeList.size());
+    for (qsizetype index = 0; index < nodeList.size(); ++index) {
+        mergeSourceList.push_back({nodeList.at(index), index});
+    }
+    NodeListMerger merger(sourceList, conflictList);
+    return merger.merge(mergeSourceList, QString());
+}
+
 YAML::Node QSocYamlUtils::loadAndMergeFiles(
-    const QStringList &filePathList, const YAML::Node &baseNode)
+    const QStringList &filePathList, const YAML::Node &baseNode, QStringList *conflictList)
 {
-    YAML::Node mergedResult = baseNode;
-    bool       isFirstFile  = (baseNode.IsNull() || !baseNode.IsDefined());
+    /* Load every file first, then merge them all in one pass */
+    QList<YAML::Node> nodeList;
+    QStringList       sourceList;
+    if (baseNode.IsDefined() && !baseNode.IsNull()) {
+        nodeList.append(baseNode);
+        sourceList.append("<base>");
+    }
 
     for (const QString &filePath : filePathList) {
         /* Check if file exists */
@@ -105,26 +325,16 @@ YAML::Node QSocYamlUtils::loadAndMergeFiles(
         }
 
         /* Load the file */
-        std::ifstream fileStream(filePath.toStdString());
-        if (!fileStream.is_open()) {
+        if (!QFileInfo(filePath).isReadable()) {
             qCritical() << "Error: Unable to open YAML file:" << filePath;
             return {}; /* Return null node on error */
         }
 
         try {
-            const YAML::Node currentNode = YAML::Load(fileStream);
-            fileStream.close();
-
-            if (isFirstFile) {
-                /* For the first file (or if no base node), use it as the base */
-                mergedResult = currentNode;
-                isFirstFile  = false;
-            } else {
-                /* For subsequent files, merge them */
-                mergedResult = mergeNodes(mergedResult, currentNode);
-            }
+            nodeList.append(loadFile(filePath));
+            sourceList.append(filePath);
 
-            qDebug() << "Successfully loaded and merged YAML file:" << filePath;
+            qDebug() << "Successfully loaded YAML file:" << filePath;
 
         } catch (const YAML::Exception &e) {
             qCritical() << "Error parsing YAML file:" << filePath << ":" << e.what();
@@ -132,7 +342,7 @@ YAML::Node QSocYamlUtils::loadAndMergeFiles(
         }
     }
 
-    return mergedResult;
+    return mergeNodeList(nodeList, sourceList, conflictList);
 }
 
 bool QSocYamlUtils::validateNetlistStructure(const YAML::Node &yamlNode, QString &errorMessage)
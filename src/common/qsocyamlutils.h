@@ -35,6 +35,39 @@ public:
         return instance;
     }
 
+    /**
+     * @brief Load a YAML file.
+     * @details Netlist, module and bus files are all read through here, so
+     *          they share one error behaviour.
+     * @param filePath Path of the YAML file.
+     * @return The loaded YAML node.
+     * @throws YAML::Exception The file cannot be read or parsed.
+     */
+    static YAML::Node loadFile(const QString &filePath);
+
+    /**
+     * @brief Save a YAML node to a file atomically.
+     * @details The node is emitted into a temporary file next to the target,
+     *          which then replaces the target in one rename. Readers and a
+     *          crash mid-write see either the old or the new file, never a
+     *          truncated one.
+     * @param filePath Path of the YAML file.
+     * @param yamlNode The node to save.
+     * @retval true The file was replaced.
+     * @retval false The file cannot be written, the old file is kept.
+     */
+    static bool saveFile(const QString &filePath, const YAML::Node &yamlNode);
+
+    /**
+     * @brief Hash the content of a file.
+     * @details Library managers compare it to tell whether a file changed
+     *          since they read it. Unlike the modification time it also sees
+     *          rewrites within the timestamp resolution of the filesystem.
+     * @param filePath Path of the file.
+     * @return The SHA-256 digest, or an empty array if the file cannot be read.
+     */
+    static QByteArray fileDigest(const QString &filePath);
+
     /**
      * @brief Merge two YAML nodes recursively.
      * @details Merges fromYaml into toYaml, with fromYaml taking precedence.
@@ -46,15 +79,42 @@ public:
      */
     static YAML::Node mergeNodes(const YAML::Node &toYaml, const YAML::Node &fromYaml);
 
+    /**
+     * @brief Merge a list of YAML nodes in one pass.
+     * @details Produces the same result as folding the list with mergeNodes,
+     *          but walks every level of all nodes together instead of copying
+     *          the accumulated tree once per node. Map children are grouped by
+     *          key through a hash index, so merging many fragments is linear
+     *          in their total size. Nodes of the result may be shared with the
+     *          inputs.
+     *
+     *          A conflict is recorded whenever a later node replaces an earlier
+     *          one, that is a scalar with a different value or a value of a
+     *          different kind. Sequences are concatenated and never conflict.
+     * @param nodeList The YAML nodes in merge order, later ones take precedence.
+     * @param sourceList Names of the nodes, such as file paths, used in conflict
+     *        messages. Missing names are replaced by the node index.
+     * @param conflictList Optional output list of conflict messages.
+     * @return The merged YAML node.
+     */
+    static YAML::Node mergeNodeList(
+        const QList<YAML::Node> &nodeList,
+        const QStringList       &sourceList   = {},
+        QStringList             *conflictList = nullptr);
+
     /**
      * @brief Load and merge multiple YAML files.
-     * @details Loads multiple YAML files in order and merges them into a single node.
+     * @details Loads multiple YAML files in order and merges them into a single
+     *          node with mergeNodeList.
      * @param filePathList List of file paths to load and merge.
      * @param baseNode Optional base node to start merging from.
+     * @param conflictList Optional output list of merge conflict messages.
      * @return The merged YAML node, or null node on error.
      */
     static YAML::Node loadAndMergeFiles(
-        const QStringList &filePathList, const YAML::Node &baseNode = YAML::Node());
+        const QStringList &filePathList,
+        const YAML::Node  &baseNode     = YAML::Node(),
+        QStringList       *conflictList = nullptr);
 
     /**
      * @brief Validate basic YAML structure for netlist files.
@@ -33,11 +33,14 @@ bool              QStaticLog::colorConsole  = true;
 bool              QStaticLog::colorRichtext = true;
 
 /* Initialize static members */
-QtMessageHandler QStaticLog::originalHandler = nullptr;
+QtMessageHandler                    QStaticLog::originalHandler = nullptr;
+thread_local QStaticLog::OutputSink QStaticLog::outputSink;
+thread_local bool                   QStaticLog::threadLevelSet = false;
+thread_local QStaticLog::Level      QStaticLog::threadLevel    = QStaticLog::Level::Error;
 
 void QStaticLog::logE(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Error) {
+    if (getLevel() >= QStaticLog::Level::Error) {
         qCritical() << QString(strEConsole + func + ":" + message).toStdString().c_str();
         emit instance().log(strERichtext + func + ":" + message);
     }
@@ -45,7 +48,7 @@ void QStaticLog::logE(const QString &func, const QString &message)
 
 void QStaticLog::logW(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Warning) {
+    if (getLevel() >= QStaticLog::Level::Warning) {
         qWarning() << QString(strWConsole + func + ":" + message).toStdString().c_str();
         emit instance().log(strWRichtext + func + ":" + message);
     }
@@ -53,7 +56,7 @@ void QStaticLog::logW(const QString &func, const QString &message)
 
 void QStaticLog::logI(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Info) {
+    if (getLevel() >= QStaticLog::Level::Info) {
         qInfo() << QString(strIConsole + func + ":" + message).toStdString().c_str();
         emit instance().log(strIRichtext + func + ":" + message);
     }
@@ -61,7 +64,7 @@ void QStaticLog::logI(const QString &func, const QString &message)
 
 void QStaticLog::logD(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Debug) {
+    if (getLevel() >= QStaticLog::Level::Debug) {
         qDebug() << QString(strDConsole + func + ":" + message).toStdString().c_str();
         emit instance().log(strDRichtext + func + ":" + message);
     }
@@ -69,7 +72,7 @@ void QStaticLog::logD(const QString &func, const QString &message)
 
 void QStaticLog::logV(const QString &func, const QString &message)
 {
-    if (QStaticLog::level >= QStaticLog::Level::Verbose) {
+    if (getLevel() >= QStaticLog::Level::Verbose) {
         qDebug() << QString(strVConsole + func + ":" + message).toStdString().c_str();
         emit instance().log(strVRichtext + func + ":" + message);
     }
@@ -77,12 +80,27 @@ void QStaticLog::logV(const QString &func, const QString &message)
 
 void QStaticLog::setLevel(QStaticLog::Level level)
 {
-    QStaticLog::level = level;
+    if (threadLevelSet) {
+        QStaticLog::threadLevel = level;
+    } else {
+        QStaticLog::level = level;
+    }
 }
 
 QStaticLog::Level QStaticLog::getLevel()
 {
-    return QStaticLog::level;
+    return threadLevelSet ? QStaticLog::threadLevel : QStaticLog::level;
+}
+
+void QStaticLog::setThreadLevel(QStaticLog::Level level)
+{
+    threadLevelSet          = true;
+    QStaticLog::threadLevel = level;
+}
+
+void QStaticLog::clearThreadLevel()
+{
+    threadLevelSet = false;
 }
 
 void QStaticLog::setColorConsole(bool color)
@@ -149,10 +167,38 @@ void QStaticLog::restoreMessageHandler()
     qInstallMessageHandler(originalHandler);
 }
 
+void QStaticLog::setOutputSink(const OutputSink &sink)
+{
+    outputSink = sink;
+}
+
+void QStaticLog::replayMessage(QtMsgType type, const QString &message)
+{
+    switch (type) {
+    case QtDebugMsg:
+        qDebug().noquote() << message;
+        break;
+    case QtInfoMsg:
+        qInfo().noquote() << message;
+        break;
+    case QtWarningMsg:
+        qWarning().noquote() << message;
+        break;
+    default:
+        qCritical().noquote() << message;
+        break;
+    }
+}
+
 void QStaticLog::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
     /* Unused parameters */
     Q_UNUSED(context);
+    /* Forward to the sink when output is redirected */
+    if (outputSink) {
+        outputSink(type, msg);
+        return;
+    }
     /* Select output stream based on message type */
     switch (type) {
     case QtInfoMsg:
@@ -10,6 +10,8 @@
 #include <QtCore>
 #include <QtGlobal>
 
+#include <functional>
+
 /**
  * @brief The QStaticLog class.
  * @details This class is a static logging class that can be used to log
@@ -87,6 +89,53 @@ public:
      */
     static void restoreMessageHandler();
 
+    /**
+     * @brief Output sink receiving formatted messages.
+     * @details Receives the message type and text that would otherwise be
+     *          written to stdout or stderr by the installed message handler.
+     */
+    using OutputSink = std::function<void(QtMsgType type, const QString &message)>;
+
+    /**
+     * @brief Redirect handler output to a sink.
+     * @details While a sink is set, the installed message handler forwards
+     *          every message to it instead of the process streams. The sink
+     *          is per thread, so it only captures messages logged by the
+     *          thread that set it. The serve daemon uses this to stream
+     *          command output to its client. Pass an empty sink to restore
+     *          console output.
+     * @param sink The sink to forward messages to.
+     */
+    static void setOutputSink(const OutputSink &sink);
+
+    /**
+     * @brief Log a captured message again at its original severity.
+     * @details Messages collected by an output sink on a worker thread are
+     *          replayed through this on the main thread, so debug, warning
+     *          and error messages keep their type. Fatal messages are logged
+     *          as critical and do not abort.
+     * @param type The type the message was captured with.
+     * @param message The captured message text.
+     */
+    static void replayMessage(QtMsgType type, const QString &message);
+
+    /**
+     * @brief Give the current thread its own log level.
+     * @details Until clearThreadLevel() is called, getLevel() and setLevel()
+     *          on this thread read and write a level private to the thread,
+     *          starting at the given level, and other threads keep using
+     *          the process level. Batch workers on pool threads use this so
+     *          that a --verbose option of one command does not leak into
+     *          the commands running beside it.
+     * @param level The initial level of the thread.
+     */
+    static void setThreadLevel(QStaticLog::Level level);
+
+    /**
+     * @brief Return the current thread to the process log level.
+     */
+    static void clearThreadLevel();
+
 public slots:
     /**
      * @brief Log error message to console.
@@ -241,6 +290,10 @@ private:
     /* Log level. */
     static QStaticLog::Level level;
 
+    /* Log level of the current thread, used instead of level when set. */
+    static thread_local bool              threadLevelSet;
+    static thread_local QStaticLog::Level threadLevel;
+
     /* Color mode for console. */
     static bool colorConsole;
 
@@ -250,6 +303,9 @@ private:
     /* Original message handler pointer. */
     static QtMessageHandler originalHandler;
 
+    /* Sink replacing console output of the current thread when set. */
+    static thread_local OutputSink outputSink;
+
     /**
      * @brief Custom message handler function.
      * @details Routes QtInfoMsg to stdout and all other message types to stderr.
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: 2023-2025 Huang Rui <vowstar@gmail.com>
 
+#include "cli/qsoccliserver.h"
 #include "cli/qsoccliworker.h"
 #include "common/qstaticicontheme.h"
 #include "common/qstaticlog.h"
@@ -18,6 +19,16 @@ bool isGui(int &argc, char *argv[])
     }
     return false;
 }
+
+bool isLocalOnly(int &argc, char *argv[])
+{
+    /* Commands that must run in this process, never in the daemon */
+    for (int i = 1; i < argc; ++i) {
+        if (0 == qstrcmp(argv[i], "serve") || 0 == qstrcmp(argv[i], "agent"))
+            return true;
+    }
+    return false;
+}
 } /* namespace */
 
 int main(int argc, char *argv[])
@@ -38,9 +49,14 @@ int main(int argc, char *argv[])
     } else {
         const QCoreApplication app(argc, argv);
         QStaticTranslator::setup();
-        QSocCliWorker socCliWorker;
-        socCliWorker.setup(app.arguments(), false);
-        result = app.exec();
+        /* Forward to a running daemon when QSOC_SERVER names one */
+        const QString serverName = qEnvironmentVariable("QSOC_SERVER");
+        if (serverName.isEmpty() || isLocalOnly(argc, argv)
+            || !QSocCliServer::forward(serverName, app.arguments(), result)) {
+            QSocCliWorker socCliWorker;
+            socCliWorker.setup(app.arguments(), false);
+            result = app.exec();
+        }
     }
 
     /* Restore original message handler before exiting */
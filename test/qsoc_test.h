@@ -4,9 +4,51 @@
 #ifndef QSOC_TEST_H
 #define QSOC_TEST_H
 
+#include <QByteArray>
 #include <QCoreApplication>
+#include <QFile>
 #include <QtTest>
 
+/**
+ * @brief Resident memory readings for QSOC tests.
+ * @details Values come from /proc/self, so they are only available on Linux.
+ *          Tests skip their memory checks where a reading is missing.
+ */
+class QSocTestMemory
+{
+public:
+    /**
+     * @brief Read a field of /proc/self/status.
+     * @param field The field name, for example "VmRSS" or "VmHWM".
+     * @return The value in KiB, or -1 where it is not available.
+     */
+    static qint64 statusKiB(const QByteArray &field)
+    {
+        QFile status("/proc/self/status");
+        if (!status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return -1;
+        }
+        for (const QByteArray &line : status.readAll().split('\n')) {
+            if (line.startsWith(field + ":")) {
+                return line.mid(field.size() + 1).trimmed().split(' ').first().toLongLong();
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Reset the peak resident size of this process.
+     * @details The next VmHWM reading then covers what ran after the reset.
+     * @retval true The kernel reset the peak.
+     * @retval false The peak cannot be reset here.
+     */
+    static bool resetPeak()
+    {
+        QFile clearRefs("/proc/self/clear_refs");
+        return clearRefs.open(QIODevice::WriteOnly) && clearRefs.write("5") == 1;
+    }
+};
+
 /**
  * @brief QSOC_TEST_MAIN macro for QSOC test applications
  * @details This macro provides a custom main function for QSOC test applications
@@ -7,6 +7,7 @@
 
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QtTest>
@@ -41,6 +42,7 @@ private slots:
     void contentCleanComment_singleLine();
     void contentCleanComment_multiLine();
     void contentCleanComment_mixed();
+    void tokenizeFileList_entries();
 
     void contentValidFile_relativeAndAbsolute();
     void contentValidFile_nonExistentFiles();
@@ -50,6 +52,11 @@ private slots:
     void getModuleList_afterParse();
     void getModuleAst_validModule();
     void getModuleAst_invalidModule();
+
+    /* Test in-memory lint */
+    void lintVerilog_clean();
+    void lintVerilog_portWidth();
+    void lintVerilog_syntaxError();
 };
 
 void Test::initTestCase()
@@ -270,6 +277,19 @@ void Test::contentCleanComment_mixed()
     QVERIFY(result.contains("line4"));
 }
 
+void Test::tokenizeFileList_entries()
+{
+    /* Block comments may span lines, line endings may be CRLF */
+    const QString input
+        = "  a.v  // trailing\r\n\r\nb.v /* spans\nlines */ c.v\n"
+          "// whole line\n+incdir+inc\r\nd.v /* open";
+
+    const QStringList result = QSlangDriver::tokenizeFileList(input);
+
+    QCOMPARE(result, QStringList({"a.v", "b.v", "c.v", "+incdir+inc", "d.v"}));
+    QVERIFY(QSlangDriver::tokenizeFileList(QString()).isEmpty());
+}
+
 void Test::contentValidFile_relativeAndAbsolute()
 {
     /* Create a temporary file */
@@ -429,6 +449,72 @@ void Test::getModuleAst_invalidModule()
     QCOMPARE(moduleAst, driver.getAst());
 }
 
+void Test::lintVerilog_clean()
+{
+    const QString verilogFile = createTemporaryVerilogFile(R"(
+        module lint_clean(
+            input  wire [7:0] a,
+            output wire [7:0] y
+        );
+            assign y = a;
+        endmodule
+    )");
+    QVERIFY(!verilogFile.isEmpty());
+
+    QVERIFY(QSlangDriver::lintVerilog(verilogFile).isEmpty());
+}
+
+void Test::lintVerilog_portWidth()
+{
+    /* The instantiated module is found by name in the search directory */
+    QFile sourceFile(tempDir.filePath("lint_src.v"));
+    QVERIFY(sourceFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream(&sourceFile) << "module lint_src(output wire [7:0] dout);\n"
+                                "    assign dout = 8'hA5;\n"
+                                "endmodule\n";
+    sourceFile.close();
+
+    const QString verilogFile = createTemporaryVerilogFile(R"(
+        module lint_top(
+            output wire [3:0] narrow
+        );
+            lint_src u_src (
+                .dout(narrow)
+            );
+        endmodule
+    )");
+    QVERIFY(!verilogFile.isEmpty());
+
+    /* Unknown modules are black boxes, nothing to check without the search path */
+    QVERIFY(QSlangDriver::lintVerilog(verilogFile).isEmpty());
+
+    const QList<QSlangDriver::LintMessage> messageList
+        = QSlangDriver::lintVerilog(verilogFile, {}, {tempDir.path()});
+    QVERIFY(!messageList.isEmpty());
+    for (const QSlangDriver::LintMessage &message : messageList) {
+        QVERIFY(!message.error);
+        QCOMPARE(message.filePath, QFileInfo(verilogFile).absoluteFilePath());
+        QCOMPARE(message.entry, QString("instance u_src"));
+        QVERIFY(message.line >= 5 && message.line <= 7);
+    }
+}
+
+void Test::lintVerilog_syntaxError()
+{
+    const QString verilogFile = createTemporaryVerilogFile(R"(
+        module lint_broken;
+            wire [3:0] data
+        endmodule
+    )");
+    QVERIFY(!verilogFile.isEmpty());
+
+    const QList<QSlangDriver::LintMessage> messageList = QSlangDriver::lintVerilog(verilogFile);
+    QVERIFY(!messageList.isEmpty());
+    QVERIFY(messageList.first().error);
+    QVERIFY(messageList.first().line > 0);
+    QVERIFY(!messageList.first().message.isEmpty());
+}
+
 QSOC_TEST_MAIN(Test)
 
 #include "test_qslangdriver.moc"
@@ -422,6 +422,22 @@ private slots:
         QVERIFY(result.startsWith("Error:"));
     }
 
+    void testNetlistTraceMissingParams()
+    {
+        QSocToolNetlistTrace tool(this, generateManager);
+        json                 args = json::object();
+
+        QString result = tool.execute(args);
+
+        QVERIFY(result.startsWith("Error:"));
+
+        /* Path queries need an end target */
+        args   = {{"netlist_file", "missing.soc_net"}, {"query", "path"}, {"target", "clk"}};
+        result = tool.execute(args);
+        QVERIFY(result.startsWith("Error:"));
+        QVERIFY(result.contains("to"));
+    }
+
     /* Bash Timeout Tests */
     void testBashTimeout()
     {
@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "common/qsocyamlutils.h"
+#include "qsoc_test.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    QSocProjectManager projectManager;
+    QString            projectName;
+
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        messageList << msg;
+    }
+
+    static int runCommand(const QStringList &arguments)
+    {
+        messageList.clear();
+        QSocCliWorker socCliWorker;
+        return socCliWorker.execute(QStringList{"qsoc"} + arguments);
+    }
+
+    /* Print a measurement, bypassing the handler that collects CLI output */
+    static void report(const QString &line)
+    {
+        QTextStream(stdout) << "RESULT : " << line << Qt::endl;
+    }
+
+    /* Netlist fragments shaped like per-subsystem instance and net files */
+    static QList<YAML::Node> createFragmentList(int fragmentCount, int instanceCount)
+    {
+        QList<YAML::Node> fragmentList;
+        for (int fragment = 0; fragment < fragmentCount; ++fragment) {
+            QString     text;
+            QTextStream stream(&text);
+            stream << "port:\n  clk:\n    direction: input\n    type: logic\n";
+            stream << "instance:\n";
+            for (int instance = 0; instance < instanceCount; ++instance) {
+                stream << "  u_sub" << fragment << "_" << instance << ":\n"
+                       << "    module: sub_module\n"
+                       << "    port:\n      clk:\n        link: clk\n";
+            }
+            stream << "net:\n";
+            for (int instance = 0; instance < instanceCount; ++instance) {
+                stream << "  n_sub" << fragment << "_" << instance << ":\n"
+                       << "    - instance: u_sub" << fragment << "_" << instance << "\n"
+                       << "      port: data\n";
+            }
+            stream << "comb:\n  - out: o_sub" << fragment << "\n    expr: i_sub" << fragment
+                   << "\n";
+            stream.flush();
+            fragmentList.append(YAML::Load(text.toStdString()));
+        }
+        return fragmentList;
+    }
+
+    static YAML::Node foldFragmentList(const QList<YAML::Node> &fragmentList)
+    {
+        YAML::Node result = fragmentList.first();
+        for (qsizetype index = 1; index < fragmentList.size(); ++index) {
+            result = QSocYamlUtils::mergeNodes(result, fragmentList.at(index));
+        }
+        return result;
+    }
+
+    /* Verilog library of independent modules, one file each, with its file list */
+    QString createVerilogLibrary(int moduleCount)
+    {
+        const QDir  sourceDir(QDir(projectManager.getCurrentPath()).filePath("verilog"));
+        QStringList filePathList;
+        QDir().mkpath(sourceDir.path());
+        for (int module = 0; module < moduleCount; ++module) {
+            const QString filePath = sourceDir.filePath(QString("bench_ip%1.v").arg(module));
+            QFile         file(filePath);
+            if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                QTextStream stream(&file);
+                stream << "module bench_ip" << module << " #(parameter WIDTH = 32) (\n"
+                       << "  input  wire             clk,\n"
+                       << "  input  wire [WIDTH-1:0] din,\n"
+                       << "  output reg  [WIDTH-1:0] dout\n"
+                       << ");\n";
+                for (int stage = 0; stage < 32; ++stage) {
+                    stream << "  reg [WIDTH-1:0] stage" << stage << ";\n"
+                           << "  always @(posedge clk) stage" << stage << " <= "
+                           << (stage == 0 ? QString("din") : QString("stage%1").arg(stage - 1))
+                           << " ^ " << stage << ";\n";
+                }
+                stream << "  always @(posedge clk) dout <= stage31;\n"
+                       << "endmodule\n";
+                file.close();
+            }
+            filePathList.append(filePath);
+        }
+        const QString fileListPath = sourceDir.filePath("bench_ip.f");
+        QFile         fileList(fileListPath);
+        if (fileList.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream(&fileList) << filePathList.join("\n") << "\n";
+            fileList.close();
+        }
+        return fileListPath;
+    }
+
+    /* Module library of many small modules, written straight into the module directory */
+    QString createModuleLibrary(int moduleCount)
+    {
+        const QString filePath = QDir(projectManager.getModulePath()).filePath("bench_lib.soc_mod");
+        QFile         file(filePath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&file);
+            for (int module = 0; module < moduleCount; ++module) {
+                stream << "bench_mod" << module << ":\n"
+                       << "  parameter:\n    WIDTH:\n      type: int\n      value: 32\n"
+                       << "  port:\n"
+                       << "    clk:\n      direction: input\n      type: logic\n"
+                       << "    din:\n      direction: input\n      type: logic[31:0]\n"
+                       << "    dout:\n      direction: output\n      type: logic[31:0]\n";
+            }
+            file.close();
+        }
+        return filePath;
+    }
+
+    /* Bind interfaces to one module one update at a time, return the elapsed time */
+    qint64 updateModuleLibrary(bool deferred, int updateCount)
+    {
+        QSocModuleManager moduleManager(nullptr, &projectManager);
+        if (!moduleManager.load(QString("bench_lib"))) {
+            return -1;
+        }
+        moduleManager.setDeferredSave(deferred);
+        QElapsedTimer timer;
+        timer.start();
+        for (int update = 0; update < updateCount; ++update) {
+            YAML::Node moduleYaml = YAML::Clone(moduleManager.getModuleYaml(QString("bench_mod0")));
+            moduleYaml["bus"][QString("if%1").arg(update).toStdString()]["bus"] = "bench_bus";
+            if (!moduleManager.updateModuleYaml("bench_mod0", moduleYaml)) {
+                return -1;
+            }
+        }
+        if (!moduleManager.flush()) {
+            return -1;
+        }
+        return timer.elapsed();
+    }
+
+    /* Import the library, report peak and retained resident size */
+    bool importWithMemoryReport(const QString &fileListPath, const QStringList &extraArguments)
+    {
+        const qint64 before = QSocTestMemory::statusKiB("VmRSS");
+        QSocTestMemory::resetPeak();
+        QElapsedTimer timer;
+        timer.start();
+        const int exitCode = runCommand(
+            QStringList{
+                "module",
+                "import",
+                "-d",
+                QDir(projectManager.getCurrentPath()).absolutePath(),
+                "-l",
+                "bench_ip",
+                "-f",
+                fileListPath}
+            + extraArguments);
+        const qint64 elapsed = timer.elapsed();
+        const qint64 peak    = QSocTestMemory::statusKiB("VmHWM");
+        const qint64 after   = QSocTestMemory::statusKiB("VmRSS");
+        if (exitCode != 0) {
+            return false;
+        }
+        report(QString("import %1: %2 ms, peak %3 KiB, retained %4 KiB")
+                   .arg(extraArguments.isEmpty() ? QString("whole") : extraArguments.join(' '))
+                   .arg(elapsed)
+                   .arg(peak)
+                   .arg(after - before));
+        return true;
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        /* Re-enable message handler for collecting CLI output */
+        qInstallMessageHandler(messageOutput);
+        /* Set project name */
+        projectName = QFileInfo(__FILE__).baseName() + "_data";
+        /* Setup project manager */
+        projectManager.setProjectName(projectName);
+        projectManager.setCurrentPath(QDir::current().filePath(projectName));
+        projectManager.mkpath();
+        projectManager.save(projectName);
+        projectManager.load(projectName);
+    }
+
+    void cleanupTestCase()
+    {
+#ifdef ENABLE_TEST_CLEANUP
+        /* Clean up the test project directory */
+        QDir projectDir(projectManager.getCurrentPath());
+        if (projectDir.exists()) {
+            projectDir.removeRecursively();
+        }
+#endif // ENABLE_TEST_CLEANUP
+    }
+
+    void startup_version()
+    {
+        QBENCHMARK
+        {
+            runCommand({"--version"});
+        }
+    }
+
+    void startup_help()
+    {
+        QBENCHMARK
+        {
+            runCommand({"--help"});
+        }
+    }
+
+    void startup_projectList()
+    {
+        const QStringList arguments
+            = {"project", "list", "-d", QDir(projectManager.getCurrentPath()).absolutePath()};
+        QCOMPARE(runCommand(arguments), 0);
+        QBENCHMARK
+        {
+            runCommand(arguments);
+        }
+    }
+
+    void import_chunked()
+    {
+        const QString fileListPath = createVerilogLibrary(400);
+
+        /* Chunked first, so kernels without a peak reset still show its smaller peak */
+        QVERIFY(importWithMemoryReport(fileListPath, {"--chunk", "50"}));
+        QVERIFY(importWithMemoryReport(fileListPath, {}));
+
+        QSocModuleManager moduleManager(nullptr, &projectManager);
+        QVERIFY(moduleManager.load(QRegularExpression("bench_ip")));
+        QVERIFY(moduleManager.isModuleExist("bench_ip0"));
+        QVERIFY(moduleManager.isModuleExist("bench_ip399"));
+    }
+
+    void library_update()
+    {
+        const int     updateCount = 30;
+        const QString filePath    = createModuleLibrary(2000);
+
+        const qint64 immediate = updateModuleLibrary(false, updateCount);
+        QVERIFY(immediate >= 0);
+        createModuleLibrary(2000);
+        const qint64 deferred = updateModuleLibrary(true, updateCount);
+        QVERIFY(deferred >= 0);
+        report(QString("library update x%1: immediate %2 ms, deferred %3 ms")
+                   .arg(updateCount)
+                   .arg(immediate)
+                   .arg(deferred));
+
+        /* Every update reached the file, and only the library file is left */
+        const YAML::Node library = QSocYamlUtils::loadFile(filePath);
+        QCOMPARE(library.size(), std::size_t(2000));
+        QCOMPARE(library["bench_mod0"]["bus"].size(), std::size_t(updateCount));
+        QVERIFY(!library["bench_mod0"]["library"]);
+        QCOMPARE(
+            QDir(projectManager.getModulePath()).entryList({"bench_lib*"}, QDir::Files),
+            QStringList{"bench_lib.soc_mod"});
+    }
+
+    void template_largeOutput()
+    {
+        /* About 75 MB of output from a template and data of a few bytes */
+        const QDir    projectDir(projectManager.getCurrentPath());
+        const QString jsonFilePath = projectDir.filePath("large_output_data.json");
+        QFile         jsonFile(jsonFilePath);
+        QVERIFY(jsonFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        jsonFile.write(R"({"block": 1024, "word": 1024})");
+        jsonFile.close();
+
+        const QString templateFilePath = projectDir.filePath("large_output_template.j2");
+        QFile         templateFile(templateFilePath);
+        QVERIFY(templateFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        templateFile.write(
+            "{% for b in range(block) %}{% for w in range(word) %}"
+            "{{ b }}:{{ w }} 0123456789abcdef0123456789abcdef"
+            "0123456789abcdef0123456789abcdef\n"
+            "{% endfor %}{% endfor %}");
+        templateFile.close();
+
+        /* Peak resident size of this render only, where the kernel reports it */
+        const bool   peakReset = QSocTestMemory::resetPeak();
+        const qint64 before    = QSocTestMemory::statusKiB("VmRSS");
+
+        QElapsedTimer timer;
+        timer.start();
+        QCOMPARE(
+            runCommand(
+                {"generate",
+                 "template",
+                 "-d",
+                 projectDir.absolutePath(),
+                 "--json",
+                 jsonFilePath,
+                 templateFilePath}),
+            0);
+        const qint64 elapsed = timer.elapsed();
+        const qint64 peak    = QSocTestMemory::statusKiB("VmHWM");
+
+        const QFileInfo outputInfo(
+            QDir(projectManager.getOutputPath()).filePath("large_output_template"));
+        QVERIFY(outputInfo.size() > 64LL * 1024 * 1024);
+        report(QString("template %1 KiB output: %2 ms, peak growth %3")
+                   .arg(outputInfo.size() / 1024)
+                   .arg(elapsed)
+                   .arg(
+                       peakReset && before >= 0 && peak >= 0
+                           ? QString("%1 KiB").arg(peak - before)
+                           : QString("unknown")));
+    }
+
+    void merge_fold()
+    {
+        const QList<YAML::Node> fragmentList = createFragmentList(64, 40);
+        YAML::Node              result;
+        QBENCHMARK
+        {
+            result = foldFragmentList(fragmentList);
+        }
+        QCOMPARE(result["instance"].size(), std::size_t(64 * 40));
+    }
+
+    void merge_nodeList()
+    {
+        const QList<YAML::Node> fragmentList = createFragmentList(64, 40);
+        YAML::Node              result;
+        QBENCHMARK
+        {
+            result = QSocYamlUtils::mergeNodeList(fragmentList);
+        }
+        /* Same tree as the pairwise fold */
+        QCOMPARE(
+            QSocYamlUtils::yamlNodeToString(result),
+            QSocYamlUtils::yamlNodeToString(foldFragmentList(fragmentList)));
+        QCOMPARE(result["comb"].size(), std::size_t(64));
+    }
+};
+
+QStringList Test::messageList;
+
+QSOC_TEST_MAIN(Test)
+
+#include "test_qsocbenchmark.moc"
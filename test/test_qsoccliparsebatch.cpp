@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "common/qstaticlog.h"
+#include "qsoc_test.h"
+
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QStringList>
+#include <QTextStream>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    static QMutex      messageMutex;
+    QSocProjectManager projectManager;
+    QString            projectName;
+
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        /* Concurrent batch steps log from pool threads */
+        const QMutexLocker locker(&messageMutex);
+        messageList << msg;
+    }
+
+    bool messageListContains(const QString &message)
+    {
+        for (const QString &msg : messageList) {
+            if (msg.contains(message)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    QString createFile(const QString &fileName, const QString &content)
+    {
+        const QString filePath = QDir(projectManager.getCurrentPath()).filePath(fileName);
+        QFile         file(filePath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&file);
+            stream << content;
+            file.close();
+        }
+        return filePath;
+    }
+
+    QString createNetlist(const QString &moduleName)
+    {
+        return createFile(
+            moduleName + ".soc_net",
+            QString(R"(
+---
+version: "1.0"
+module: "%1"
+port:
+  clk:
+    direction: in
+    type: "logic"
+instance:
+  u_core:
+    module: "batch_core"
+    port:
+      clk:
+        link: clk
+)")
+                .arg(moduleName));
+    }
+
+    QString outputFilePath(const QString &baseName)
+    {
+        return QDir(projectManager.getOutputPath()).filePath(baseName + ".v");
+    }
+
+    int runBatch(const QStringList &arguments)
+    {
+        messageList.clear();
+        QSocCliWorker socCliWorker;
+        return socCliWorker.execute(QStringList{"qsoc", "batch"} + arguments);
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        /* Re-enable message handler for collecting CLI output */
+        qInstallMessageHandler(messageOutput);
+        /* Set project name */
+        projectName = QFileInfo(__FILE__).baseName() + "_data";
+        /* Setup project manager */
+        projectManager.setProjectName(projectName);
+        projectManager.setCurrentPath(QDir::current().filePath(projectName));
+        projectManager.mkpath();
+        projectManager.save(projectName);
+        projectManager.load(projectName);
+        /* Create a small module library */
+        QFile moduleFile(QDir(projectManager.getModulePath()).filePath("batch_core.soc_mod"));
+        if (moduleFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&moduleFile);
+            stream << "batch_core:\n"
+                   << "  port:\n"
+                   << "    clk:\n"
+                   << "      type: logic\n"
+                   << "      direction: in\n";
+            moduleFile.close();
+        }
+    }
+
+    void cleanupTestCase()
+    {
+#ifdef ENABLE_TEST_CLEANUP
+        /* Clean up the test project directory */
+        QDir projectDir(projectManager.getCurrentPath());
+        if (projectDir.exists()) {
+            projectDir.removeRecursively();
+        }
+#endif // ENABLE_TEST_CLEANUP
+    }
+
+    void batch_show_help()
+    {
+        QCOMPARE(runBatch({"--help"}), 0);
+        QVERIFY(messageListContains("batch"));
+    }
+
+    void batch_reject_missingScript()
+    {
+        QCOMPARE(runBatch({}), 1);
+        QVERIFY(messageListContains("Error: missing batch script."));
+    }
+
+    void batch_run_textScript()
+    {
+        const QString projectPath = projectManager.getCurrentPath();
+        const QString netlist1    = createNetlist("batch_text_1");
+        const QString netlist2    = createNetlist("batch_text_2");
+        const QString netlist3    = createNetlist("batch_text_3");
+        const QString script      = createFile(
+            "text.qsoc",
+            QString(
+                "# Comments and blank lines are ignored\n"
+                "\n"
+                "qsoc module list -d \"%1\"\n"
+                "generate verilog -d \"%1\" \"%2\"\n"
+                "generate verilog -d \"%1\" \"%3\"\n"
+                "generate verilog -d \"%1\" \"%4\"\n")
+                .arg(projectPath, netlist1, netlist2, netlist3));
+
+        QCOMPARE(runBatch({"-j", "2", script}), 0);
+        QVERIFY(messageListContains("batch_core"));
+        QVERIFY(QFile::exists(outputFilePath("batch_text_1")));
+        QVERIFY(QFile::exists(outputFilePath("batch_text_2")));
+        QVERIFY(QFile::exists(outputFilePath("batch_text_3")));
+    }
+
+    void batch_run_yamlScript()
+    {
+        const QString projectPath = projectManager.getCurrentPath();
+        const QString netlist     = createNetlist("batch_yaml");
+        const QString script      = createFile(
+            "list.yaml",
+            QString(
+                "- module list -d \"%1\"\n"
+                "- [generate, verilog, -d, \"%1\", \"%2\"]\n")
+                .arg(projectPath, netlist));
+
+        QCOMPARE(runBatch({script}), 0);
+        QVERIFY(QFile::exists(outputFilePath("batch_yaml")));
+    }
+
+    void batch_stop_firstFailure()
+    {
+        const QString projectPath = projectManager.getCurrentPath();
+        const QString netlist     = createNetlist("batch_after_failure");
+        const QString script      = createFile(
+            "failure.qsoc",
+            QString(
+                "module list -d \"%1\"\n"
+                "bogus\n"
+                "generate verilog -d \"%1\" \"%2\"\n")
+                .arg(projectPath, netlist));
+
+        QFile::remove(outputFilePath("batch_after_failure"));
+        QCOMPARE(runBatch({script}), 1);
+        QVERIFY(messageListContains("batch command failed at line 2"));
+        QVERIFY(!QFile::exists(outputFilePath("batch_after_failure")));
+    }
+
+    void batch_isolate_concurrentLevel()
+    {
+        const QString projectPath = projectManager.getCurrentPath();
+        const QString netlist1    = createNetlist("batch_level_1");
+        const QString netlist2    = createNetlist("batch_level_2");
+        const QString script      = createFile(
+            "level.qsoc",
+            QString(
+                "--verbose=5 generate verilog -d \"%1\" \"%2\"\n"
+                "--verbose 0 generate verilog -d \"%1\" \"%3\"\n"
+                "generate verilog -d \"%1\" \"%4\"\n")
+                .arg(projectPath, netlist1, netlist2, projectManager.getCurrentPath() + "/none"));
+
+        /* Options of one concurrent step do not change the level of the batch */
+        const QStaticLog::Level level = QStaticLog::getLevel();
+        QCOMPARE(runBatch({"-j", "3", script}), 1);
+        QCOMPARE(QStaticLog::getLevel(), level);
+        QVERIFY(QFile::exists(outputFilePath("batch_level_1")));
+        QVERIFY(QFile::exists(outputFilePath("batch_level_2")));
+        QVERIFY(messageListContains("batch command failed at line 3"));
+    }
+
+    void batch_defer_librarySave()
+    {
+        QSocModuleManager moduleManager;
+        moduleManager.setProjectManager(&projectManager);
+        moduleManager.setDeferredSave(true);
+        QVERIFY(moduleManager.isDeferredSave());
+        QVERIFY(moduleManager.isLibraryCache());
+        QVERIFY(moduleManager.load(QString("batch_core")));
+
+        const QString filePath
+            = QDir(projectManager.getModulePath()).filePath("batch_core.soc_mod");
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QByteArray before = file.readAll();
+        file.close();
+
+        YAML::Node moduleYaml = YAML::Clone(moduleManager.getModuleYaml(QString("batch_core")));
+
+        moduleYaml["port"]["rst_n"]["type"]      = "logic";
+        moduleYaml["port"]["rst_n"]["direction"] = "in";
+        QVERIFY(moduleManager.updateModuleYaml("batch_core", moduleYaml));
+
+        /* Nothing is written until flush */
+        QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        QCOMPARE(file.readAll(), before);
+        file.close();
+
+        QVERIFY(moduleManager.flush());
+        QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QByteArray after = file.readAll();
+        file.close();
+        QVERIFY(after.contains("rst_n"));
+        QVERIFY(!after.contains("library"));
+        /* In-memory data keeps its library after serialization */
+        QCOMPARE(moduleManager.getModuleLibrary("batch_core"), QString("batch_core"));
+    }
+};
+
+QStringList Test::messageList;
+QMutex      Test::messageMutex;
+
+QSOC_TEST_MAIN(Test)
+
+#include "test_qsoccliparsebatch.moc"
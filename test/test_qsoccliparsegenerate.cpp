@@ -922,6 +922,161 @@ instance:
         QVERIFY(verifyVerilogContent("example2", "endmodule"));
     }
 
+    void testGenerateWithParallelJobs()
+    {
+        messageList.clear();
+
+        QStringList filePathList;
+        for (int index = 1; index <= 3; ++index) {
+            const QString moduleName = QString("parallel%1").arg(index);
+            const QString content    = QString(R"(
+---
+version: "1.0"
+module: "%1"
+port:
+  clk:
+    direction: in
+    type: "logic"
+instance:
+  cpu0:
+    module: "c906"
+)")
+                                        .arg(moduleName);
+            filePathList << createTempFile(moduleName + ".soc_net", content);
+        }
+        /* A missing file fails alone, the other files are still generated */
+        filePathList.insert(1, QDir(projectManager.getCurrentPath()).filePath("missing.soc_net"));
+
+        QSocCliWorker socCliWorker;
+        const int     exitCode = socCliWorker.execute(
+            QStringList{"qsoc", "generate", "verilog", "-j", "3", "-d",
+                        projectManager.getCurrentPath()}
+            + filePathList);
+        QCOMPARE(exitCode, 1);
+
+        QVERIFY(verifyVerilogOutputExistence("parallel1"));
+        QVERIFY(verifyVerilogOutputExistence("parallel2"));
+        QVERIFY(verifyVerilogOutputExistence("parallel3"));
+        QVERIFY(verifyVerilogContent("parallel2", "module parallel2"));
+        QVERIFY(verifyVerilogContent("parallel3", "c906 cpu0"));
+
+        /* Messages are printed in command line order */
+        auto messageIndex = [](const QString &text) {
+            for (qsizetype index = 0; index < messageList.size(); ++index) {
+                if (messageList.at(index).contains(text)) {
+                    return index;
+                }
+            }
+            return qsizetype(-1);
+        };
+        const qsizetype first   = messageIndex("parallel1.v");
+        const qsizetype missing = messageIndex("missing.soc_net");
+        const qsizetype second  = messageIndex("parallel2.v");
+        const qsizetype third   = messageIndex("parallel3.v");
+        QVERIFY(first >= 0);
+        QVERIFY(first < missing);
+        QVERIFY(missing < second);
+        QVERIFY(second < third);
+        QVERIFY(messageIndex("failed to generate 1 of 4 netlist files") > third);
+    }
+
+    void testGenerateWithDepfile()
+    {
+        messageList.clear();
+
+        const QString content  = R"(
+---
+version: "1.0"
+module: "depfile_top"
+port:
+  clk:
+    direction: in
+    type: "logic"
+instance:
+  cpu0:
+    module: "c906"
+)";
+        const QString filePath = createTempFile("depfile_top.soc_net", content);
+        const QString depfilePath
+            = QDir(projectManager.getCurrentPath()).filePath("depfile_top.d");
+        QFile::remove(depfilePath);
+
+        QSocCliWorker socCliWorker;
+        QCOMPARE(
+            socCliWorker.execute(
+                {"qsoc",
+                 "generate",
+                 "verilog",
+                 "-d",
+                 projectManager.getCurrentPath(),
+                 "--depfile",
+                 depfilePath,
+                 filePath}),
+            0);
+
+        /* The output depends on the netlist and the library of every instance */
+        QFile depfile(depfilePath);
+        QVERIFY(depfile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString depfileContent = QString::fromUtf8(depfile.readAll());
+        depfile.close();
+        const QString target
+            = QDir(projectManager.getOutputPath()).absoluteFilePath("depfile_top.v");
+        QVERIFY(depfileContent.startsWith(target + ":"));
+        QVERIFY(depfileContent.contains(QFileInfo(filePath).absoluteFilePath()));
+        QVERIFY(depfileContent.contains(
+            QDir(projectManager.getModulePath()).absoluteFilePath("c906.soc_mod")));
+    }
+
+    void testGenerateWithLint()
+    {
+        messageList.clear();
+
+        const QString filePath = createTempFile("lint_top.soc_net", R"(
+---
+version: "1.0"
+module: "lint_top"
+port:
+  clk:
+    direction: in
+    type: "logic"
+instance:
+  cpu0:
+    module: "c906"
+)");
+
+        const QStringList arguments
+            = {"qsoc",
+               "generate",
+               "verilog",
+               "-d",
+               projectManager.getCurrentPath(),
+               "--lint",
+               filePath};
+
+        /* Library modules without sources are black boxes, the top itself is clean */
+        QSocCliWorker socCliWorker;
+        QCOMPARE(socCliWorker.execute(arguments), 0);
+        QVERIFY(messageList.join("\n").contains("Lint passed"));
+
+        /* A broken primitive cell file is linted as well and fails the command */
+        const QString cellPath = QDir(projectManager.getOutputPath()).filePath("power_cell.v");
+        QVERIFY(!QFile::exists(cellPath));
+        QFile cellFile(cellPath);
+        QVERIFY(cellFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream(&cellFile) << "module broken_cell;\n    wire [3:0] data\nendmodule\n";
+        cellFile.close();
+
+        messageList.clear();
+        QSocCliWorker lintWorker;
+        const int     exitCode = lintWorker.execute(arguments);
+        QFile::remove(cellPath);
+
+        QCOMPARE(exitCode, 1);
+        const QString output = messageList.join("\n");
+        QVERIFY(output.contains("power_cell.v:"));
+        QVERIFY(output.contains("Error: lint found"));
+    }
+
     void testGenerateWithBitsSelection()
     {
         messageList.clear();
@@ -1138,6 +1293,449 @@ wide_driver_module:
         QVERIFY(verifyVerilogContent("test_bits_mismatch", "Width: [31:0]"));
     }
 
+    void testGenerateWithParameterizedPortWidth()
+    {
+        messageList.clear();
+
+        /* Port ranges depend on module parameters and instance overrides */
+        const QString moduleContent = R"(
+param_fifo:
+  parameter:
+    DATA_W:
+      type: integer
+      value: 8
+    DEPTH:
+      type: integer
+      value: 16
+    ADDR_W:
+      type: integer
+      value: $clog2(DEPTH)
+  port:
+    wdata:
+      type: logic[DATA_W-1:0]
+      direction: in
+    rdata:
+      type: logic[DATA_W-1:0]
+      direction: out
+    level:
+      type: logic[ADDR_W:0]
+      direction: out
+)";
+        const QDir moduleDir(projectManager.getModulePath());
+        QFile      moduleFile(moduleDir.filePath("param_fifo.soc_mod"));
+        if (moduleFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&moduleFile);
+            stream << moduleContent;
+            moduleFile.close();
+        }
+
+        const QString content = R"(
+parameter:
+  BUS_W:
+    type: integer
+    value: 32
+instance:
+  u_fifo_a:
+    module: param_fifo
+    parameter:
+      DATA_W: BUS_W
+      DEPTH: 64
+  u_fifo_b:
+    module: param_fifo
+    parameter:
+      DATA_W: 32
+  u_fifo_c:
+    module: param_fifo
+net:
+  wide_data:
+    - instance: u_fifo_a
+      port: rdata
+    - instance: u_fifo_b
+      port: wdata
+  narrow_data:
+    - instance: u_fifo_b
+      port: rdata
+    - instance: u_fifo_c
+      port: wdata
+  fifo_level:
+    - instance: u_fifo_a
+      port: level
+)";
+        const QString filePath = createTempFile("test_param_width.soc_net", content);
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyVerilogOutputExistence("test_param_width"));
+
+        /* Widths come from the evaluated ranges, not a 1-bit fallback */
+        QVERIFY(verifyVerilogContent("test_param_width", "wire [31:0] wide_data;"));
+        QVERIFY(verifyVerilogContent("test_param_width", "wire [6:0] fifo_level;"));
+
+        /* 32-bit override against the 8-bit default is a real mismatch */
+        QVERIFY(!verifyVerilogContent("test_param_width", "FIXME: Net wide_data width mismatch"));
+        QVERIFY(verifyVerilogContent("test_param_width", "FIXME: Net narrow_data width mismatch"));
+    }
+
+    void testGenerateHierarchicalNetlist()
+    {
+        messageList.clear();
+
+        const QString cellContent = R"(
+hier_cell:
+  parameter:
+    W:
+      type: integer
+      value: 8
+  port:
+    clk:
+      type: logic
+      direction: in
+    d:
+      type: logic[W-1:0]
+      direction: in
+    q:
+      type: logic[W-1:0]
+      direction: out
+)";
+        const QDir moduleDir(projectManager.getModulePath());
+        QFile      cellFile(moduleDir.filePath("hier_cell.soc_mod"));
+        if (cellFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&cellFile);
+            stream << cellContent;
+            cellFile.close();
+        }
+
+        /* Sub-netlist with its own parameter, ports come straight from here */
+        createTempFile("hier_leaf.soc_net", R"(
+parameter:
+  W:
+    type: integer
+    value: 8
+port:
+  clk:
+    direction: input
+    type: logic
+  din:
+    direction: input
+    type: logic[W-1:0]
+  dout:
+    direction: output
+    type: logic[W-1:0]
+instance:
+  u_cell0:
+    module: hier_cell
+    parameter:
+      W: W
+    port:
+      clk:
+        link: clk
+      d:
+        link: din
+      q:
+        link: stage
+  u_cell1:
+    module: hier_cell
+    parameter:
+      W: W
+    port:
+      clk:
+        link: clk
+      d:
+        link: stage
+      q:
+        link: dout
+)");
+
+        /* Two instances of the same sub-netlist */
+        const QString topPath = createTempFile("hier_top.soc_net", R"(
+port:
+  clk:
+    direction: input
+    type: logic
+  din:
+    direction: input
+    type: logic[15:0]
+  dout:
+    direction: output
+    type: logic[15:0]
+instance:
+  u_leaf0:
+    netlist: hier_leaf.soc_net
+    parameter:
+      W: 16
+    port:
+      clk:
+        link: clk
+      din:
+        link: din
+      dout:
+        link: mid
+  u_leaf1:
+    netlist: hier_leaf.soc_net
+    parameter:
+      W: 16
+    port:
+      clk:
+        link: clk
+      din:
+        link: mid
+      dout:
+        link: dout
+)");
+        /* A second netlist in the same run reuses the specialized sub-netlist */
+        const QString otherPath = createTempFile("hier_other.soc_net", R"(
+port:
+  clk:
+    direction: input
+    type: logic
+instance:
+  u_leaf:
+    netlist: hier_leaf.soc_net
+    parameter:
+      W: 16
+    port:
+      clk:
+        link: clk
+  u_leaf_default:
+    netlist: hier_leaf.soc_net
+    port:
+      clk:
+        link: clk
+)");
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "verilog",
+               "-d",
+               projectManager.getCurrentPath(),
+               topPath,
+               otherPath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* Overrides generate a specialized module with its own defaults */
+        const QStringList specializedList = QDir(projectManager.getOutputPath())
+                                                .entryList({"hier_leaf_*.v"}, QDir::Files);
+        QCOMPARE(specializedList.size(), 1);
+        const QString specialized = QFileInfo(specializedList.first()).completeBaseName();
+
+        QVERIFY(verifyVerilogOutputExistence("hier_leaf"));
+        QVERIFY(verifyVerilogOutputExistence("hier_top"));
+        QVERIFY(verifyVerilogOutputExistence("hier_other"));
+        QVERIFY(verifyVerilogContent("hier_leaf", "module hier_leaf"));
+        QVERIFY(verifyVerilogContent(specialized, "module " + specialized));
+        QVERIFY(verifyVerilogContent("hier_top", specialized + " #("));
+        QVERIFY(verifyVerilogContent("hier_top", ".W(16)"));
+        QVERIFY(verifyVerilogContent("hier_top", ".dout(mid)"));
+        QVERIFY(verifyVerilogContent("hier_other", specialized + " #("));
+        QVERIFY(verifyVerilogContent("hier_other", "hier_leaf u_leaf_default"));
+
+        /* Port widths use the sub-netlist parameters with the overrides */
+        QVERIFY(verifyVerilogContent("hier_top", "wire [15:0] mid;"));
+        QVERIFY(!verifyVerilogContent("hier_top", "FIXME: Net mid width mismatch"));
+
+        /* Internal wires follow the overrides, not the sub-netlist defaults */
+        QVERIFY(verifyVerilogContent(specialized, "wire [15:0] stage;"));
+        QVERIFY(verifyVerilogContent("hier_leaf", "wire [7:0] stage;"));
+
+        /* Each parameter set of the sub-netlist is loaded and generated only once */
+        int loadCount = 0;
+        for (const QString &msg : messageList) {
+            if (msg.contains("Successfully loaded netlist file:") && msg.contains("hier_leaf")) {
+                ++loadCount;
+            }
+        }
+        QCOMPARE(loadCount, 2);
+        bool reused = false;
+        for (const QString &msg : messageList) {
+            reused = reused || msg.contains("Reusing generated sub-netlist:");
+        }
+        QVERIFY(reused);
+    }
+
+    void testGenerateHierarchicalNetlistRecursive()
+    {
+        messageList.clear();
+
+        const QString filePath = createTempFile("hier_loop.soc_net", R"(
+port:
+  clk:
+    direction: input
+    type: logic
+instance:
+  u_self:
+    netlist: hier_loop.soc_net
+    port:
+      clk:
+        link: clk
+)");
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        bool foundRecursion = false;
+        for (const QString &msg : messageList) {
+            foundRecursion = foundRecursion || msg.contains("Recursive sub-netlist:");
+        }
+        QVERIFY(foundRecursion);
+    }
+
+    void testGenerateInstanceArray()
+    {
+        messageList.clear();
+
+        const QString moduleContent = R"(
+arr_core:
+  parameter:
+    CORE_ID:
+      type: integer
+      value: 0
+  port:
+    clk:
+      type: logic
+      direction: in
+    irq:
+      type: logic
+      direction: out
+    data:
+      type: logic[7:0]
+      direction: out
+    cfg:
+      type: logic[3:0]
+      direction: in
+    dbg:
+      type: logic
+      direction: out
+)";
+        const QDir moduleDir(projectManager.getModulePath());
+        QFile      moduleFile(moduleDir.filePath("arr_core.soc_mod"));
+        if (moduleFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&moduleFile);
+            stream << moduleContent;
+            moduleFile.close();
+        }
+
+        const QString content = R"(
+port:
+  clk:
+    direction: input
+    type: logic
+instance:
+  u_core[0:63]:
+    module: arr_core
+    parameter:
+      CORE_ID: "{i}"
+    port:
+      clk:
+        link: clk
+      irq:
+        link: "core_irq[{i}]"
+      data:
+        link: "core_data[{i}*8 +: 8]"
+      cfg:
+        tie: "4'd5"
+)";
+        const QString filePath = createTempFile("test_instance_array.soc_net", content);
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyVerilogOutputExistence("test_instance_array"));
+
+        /* Nets cover every index of the array */
+        QVERIFY(verifyVerilogContent("test_instance_array", "wire [63:0] core_irq;"));
+        QVERIFY(verifyVerilogContent("test_instance_array", "wire [511:0] core_data;"));
+
+        /* One generate loop instead of 64 instances */
+        QVERIFY(verifyVerilogContent("test_instance_array", "genvar u_core_i;"));
+        QVERIFY(verifyVerilogContent(
+            "test_instance_array",
+            "for (u_core_i = 0; u_core_i <= 63; u_core_i = u_core_i + 1) begin : gen_u_core"));
+        QVERIFY(verifyVerilogContent("test_instance_array", "arr_core #("));
+        QVERIFY(verifyVerilogContent("test_instance_array", ".CORE_ID(u_core_i)"));
+        QVERIFY(verifyVerilogContent("test_instance_array", ".clk(clk)"));
+        QVERIFY(verifyVerilogContent("test_instance_array", ".irq(core_irq[u_core_i])"));
+        QVERIFY(verifyVerilogContent("test_instance_array", ".data(core_data[u_core_i*8 +: 8])"));
+        QVERIFY(verifyVerilogContent("test_instance_array", ".cfg(4'd5)"));
+        QVERIFY(verifyVerilogContent("test_instance_array", ".dbg(/* FIXME: out dbg missing */)"));
+        QVERIFY(!verifyVerilogContent("test_instance_array", "u_core_63"));
+    }
+
+    void testGenerateInstanceArrayPerIndexNet()
+    {
+        messageList.clear();
+
+        const QString filePath = createTempFile("test_instance_array_net.soc_net", R"(
+instance:
+  u_core[0:3]:
+    module: arr_core
+    port:
+      irq:
+        link: "irq_{i}"
+)");
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* Separate nets per index would need one declaration per copy */
+        bool foundError = false;
+        for (const QString &msg : messageList) {
+            foundError = foundError || msg.contains("links a different net per index");
+        }
+        QVERIFY(foundError);
+    }
+
+    void testGenerateInstanceArrayDeclaredWidth()
+    {
+        messageList.clear();
+
+        const QString filePath = createTempFile("test_instance_array_width.soc_net", R"(
+port:
+  core_data:
+    direction: output
+    type: logic[7:0]
+instance:
+  u_core[0:3]:
+    module: arr_core
+    port:
+      data:
+        link: "core_data[8*{i} +: 8]"
+)");
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* The port keeps its declaration, the wider select is reported */
+        QVERIFY(verifyVerilogOutputExistence("test_instance_array_width"));
+        QVERIFY(!verifyVerilogContent("test_instance_array_width", "wire [31:0] core_data;"));
+        QVERIFY(verifyVerilogContent(
+            "test_instance_array_width",
+            "/* FIXME: Port core_data is 8 bits wide, instance arrays select 32 bits */"));
+        bool foundWarning = false;
+        for (const QString &msg : messageList) {
+            foundWarning = foundWarning || msg.contains("Instance arrays select 32 bits");
+        }
+        QVERIFY(foundWarning);
+    }
+
     void testGenerateWithBitsSelectionFullCoverage()
     {
         messageList.clear();
@@ -2973,6 +3571,205 @@ net:
             "axi_bus1_rdata should be declared as input");
     }
 
+    void testBusInterfaceMode()
+    {
+        messageList.clear();
+
+        const QString busContent = R"(
+sv_bus:
+  port:
+    valid:
+      master:
+        direction: out
+      slave:
+        direction: in
+    ready:
+      master:
+        direction: in
+      slave:
+        direction: out
+    data:
+      master:
+        direction: out
+        width: 32
+      slave:
+        direction: in
+        width: 32
+)";
+        const QDir busDir(projectManager.getBusPath());
+        QFile      busFile(busDir.filePath("sv_bus.soc_bus"));
+        if (busFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&busFile);
+            stream << busContent;
+            busFile.close();
+        }
+
+        const QString moduleContent = R"(
+sv_src:
+  port:
+    m_valid:
+      type: logic
+      direction: out
+    m_ready:
+      type: logic
+      direction: in
+    m_data:
+      type: logic[31:0]
+      direction: out
+  bus:
+    m:
+      bus: sv_bus
+      mode: master
+      mapping:
+        valid: m_valid
+        ready: m_ready
+        data: m_data
+sv_dst:
+  port:
+    s_valid:
+      type: logic
+      direction: in
+    s_ready:
+      type: logic
+      direction: out
+    s_data:
+      type: logic[31:0]
+      direction: in
+  bus:
+    s:
+      bus: sv_bus
+      mode: slave
+      mapping:
+        valid: s_valid
+        ready: s_ready
+        data: s_data
+)";
+        const QDir moduleDir(projectManager.getModulePath());
+        QFile      moduleFile(moduleDir.filePath("sv_bus_cells.soc_mod"));
+        if (moduleFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&moduleFile);
+            stream << moduleContent;
+            moduleFile.close();
+        }
+
+        const QString filePath = createTempFile("test_sv_if.soc_net", R"(
+instance:
+  u_src0:
+    module: sv_src
+    bus:
+      m:
+        link: link0
+  u_dst0:
+    module: sv_dst
+    bus:
+      s:
+        link: link0
+  u_src1:
+    module: sv_src
+    bus:
+      m:
+        link: link1
+  u_dst1:
+    module: sv_dst
+    bus:
+      s:
+        link: link1
+)");
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "verilog",
+               "--sv-interface",
+               "-d",
+               projectManager.getCurrentPath(),
+               filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyVerilogOutputExistence("test_sv_if"));
+
+        /* One interface instance per link instead of one wire per signal */
+        QVERIFY(verifyVerilogContent("test_sv_if", "test_sv_if_sv_bus_if link0 ();"));
+        QVERIFY(verifyVerilogContent("test_sv_if", "test_sv_if_sv_bus_if link1 ();"));
+        QVERIFY(!verifyVerilogContent("test_sv_if", "wire [31:0] link0_data;"));
+        QVERIFY(verifyVerilogContent("test_sv_if", ".m_data(link0.data)"));
+        QVERIFY(verifyVerilogContent("test_sv_if", ".s_ready(link1.ready)"));
+
+        /* Both links share the definition, with a modport per bus mode */
+        QVERIFY(verifyVerilogContent("test_sv_if", "interface test_sv_if_sv_bus_if;"));
+        QVERIFY(!verifyVerilogContent("test_sv_if", "test_sv_if_sv_bus_if_1"));
+        QVERIFY(verifyVerilogContent("test_sv_if", "logic [31:0] data;"));
+        QVERIFY(verifyVerilogContent(
+            "test_sv_if", "modport master (output valid, input ready, output data);"));
+        QVERIFY(verifyVerilogContent(
+            "test_sv_if", "modport slave (input valid, output ready, input data);"));
+
+        /* Without the option the bus is flattened as before */
+        messageList.clear();
+        QSocCliWorker     flatCliWorker;
+        const QStringList flatArguments
+            = {"qsoc", "generate", "verilog", "-d", projectManager.getCurrentPath(), filePath};
+        flatCliWorker.setup(flatArguments, false);
+        flatCliWorker.run();
+
+        QVERIFY(verifyVerilogContent("test_sv_if", "wire [31:0] link0_data;"));
+        QVERIFY(!verifyVerilogContent("test_sv_if", "endinterface"));
+    }
+
+    void testBusInterfaceRejectLogicReference()
+    {
+        messageList.clear();
+
+        /* Bus and modules written by testBusInterfaceMode */
+        const QString filePath = createTempFile("test_sv_if_comb.soc_net", R"(
+port:
+  fire:
+    direction: output
+    type: logic
+instance:
+  u_src0:
+    module: sv_src
+    bus:
+      m:
+        link: link0
+  u_dst0:
+    module: sv_dst
+    bus:
+      s:
+        link: link0
+comb:
+  - out: fire
+    expr: "link0_valid & link0_ready"
+)");
+        const QString outputPath
+            = QDir(projectManager.getOutputPath()).filePath("test_sv_if_comb.v");
+        QFile::remove(outputPath);
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "verilog",
+               "--sv-interface",
+               "-d",
+               projectManager.getCurrentPath(),
+               filePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* The flat name would be undeclared, so nothing is written */
+        QVERIFY(!QFile::exists(outputPath));
+        bool foundError = false;
+        for (const QString &msg : messageList) {
+            foundError = foundError
+                         || (msg.contains("Bus signal net") && msg.contains("comb")
+                             && msg.contains("--sv-interface"));
+        }
+        QVERIFY(foundError);
+    }
+
     /* Test conditional compilation: no condition (backward compatibility) */
     void testConditionalNoCondition()
     {
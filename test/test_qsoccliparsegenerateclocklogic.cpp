@@ -2630,6 +2630,97 @@ clock:
         QVERIFY(verifyVerilogContentNormalized(verilogContent, ".clk_out(clk_out_inv_out)"));
     }
 
+    void test_svg_diagram()
+    {
+        QString netlistContent = R"(
+port:
+  pll_800m:
+    direction: input
+    type: logic
+  osc_24m:
+    direction: input
+    type: logic
+  func_sel:
+    direction: input
+    type: logic
+  rst_n:
+    direction: input
+    type: logic
+  cpu_clk:
+    direction: output
+    type: logic
+
+instance: {}
+
+net: {}
+
+clock:
+  - name: svg_clk_ctrl
+    clock: clk_sys
+    test_enable: test_en
+    input:
+      pll_800m:
+        freq: 800MHz
+      osc_24m:
+        freq: 24MHz
+    target:
+      cpu_clk:
+        freq: 200MHz
+        div:
+          default: 4
+          width: 3
+          reset: rst_n
+        link:
+          pll_800m:
+          osc_24m:
+        select: func_sel
+        test_clock: osc_24m
+)";
+
+        QString netlistPath = createTempFile("test_svg_diagram.soc_net", netlistContent);
+        QVERIFY(!netlistPath.isEmpty());
+
+        messageList.clear();
+        {
+            QSocCliWorker socCliWorker;
+            QStringList   args;
+            args << "qsoc" << "generate" << "verilog" << "-d" << projectManager.getCurrentPath()
+                 << netlistPath;
+
+            socCliWorker.setup(args, false);
+            socCliWorker.run();
+        }
+
+        /* Rendered in process next to the Typst source, named after the controller */
+        const QDir outputDir(projectManager.getOutputPath());
+        QVERIFY(QFile::exists(outputDir.filePath("svg_clk_ctrl.typ")));
+        QFile svgFile(outputDir.filePath("svg_clk_ctrl.svg"));
+        QVERIFY(svgFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString svgContent = QString::fromUtf8(svgFile.readAll());
+        svgFile.close();
+
+        QVERIFY(svgContent.startsWith("<?xml"));
+        QVERIFY(svgContent.contains("<svg xmlns=\"http://www.w3.org/2000/svg\""));
+        QVERIFY(svgContent.trimmed().endsWith("</svg>"));
+        QVERIFY(svgContent.contains(">Clock tree</text>"));
+        QVERIFY(svgContent.contains(">Clock Sources</text>"));
+        QVERIFY(svgContent.contains(">800MHz</text>"));
+        QVERIFY(svgContent.contains(">cpu_clk</text>"));
+        QVERIFY(svgContent.contains(">test_en</text>"));
+        QVERIFY(svgContent.contains(">N∈[0,7]</text>"));
+        QVERIFY(svgContent.contains("marker-end=\"url(#arrow)\""));
+
+        /* The render time is reported */
+        bool reported = false;
+        for (const QString &message : messageList) {
+            if (message.contains("Generated SVG clock diagram:")
+                && message.contains(QRegularExpression("\\d+ ms$"))) {
+                reported = true;
+            }
+        }
+        QVERIFY(reported);
+    }
+
 private:
     QString readGeneratedVerilog(const QString &filename)
     {
@@ -4,6 +4,7 @@
 #include "cli/qsoccliworker.h"
 #include "common/config.h"
 #include "common/qsocprojectmanager.h"
+#include "common/qsocyamlutils.h"
 #include "qsoc_test.h"
 
 #include <QDir>
@@ -649,6 +650,86 @@ comb: []
         QVERIFY(verifyVerilogContentNormalized(verilogContent, "input wire clk"));
         QVERIFY(verifyVerilogContentNormalized(verilogContent, "input wire [7:0] data"));
     }
+
+    void testMergeReportConflict()
+    {
+        /* A later fragment overriding a value is reported, not rejected */
+        QString netlist1Content = R"(
+port:
+  clk:
+    direction: input
+    type: logic
+
+instance:
+  inst1:
+    module: dummy_module
+    port:
+      clk:
+        link: clk
+)";
+
+        QString netlist2Content = R"(
+instance:
+  inst1:
+    module: another_module
+    port:
+      clk:
+        link: clk
+)";
+
+        QString netlist1Path = createTempFile("test_conflict1.soc_net", netlist1Content);
+        QString netlist2Path = createTempFile("test_conflict2.soc_net", netlist2Content);
+        QVERIFY(!netlist1Path.isEmpty());
+        QVERIFY(!netlist2Path.isEmpty());
+
+        messageList.clear();
+        {
+            QSocCliWorker socCliWorker;
+            QStringList   args;
+            args << "qsoc" << "generate" << "verilog" << "--merge" << "-d"
+                 << projectManager.getCurrentPath() << netlist1Path << netlist2Path;
+
+            socCliWorker.setup(args, false);
+            socCliWorker.run();
+        }
+
+        bool reported = false;
+        for (const QString &message : messageList) {
+            if (message.contains("merge conflict at instance.inst1.module")
+                && message.contains("dummy_module") && message.contains("another_module")) {
+                reported = true;
+            }
+        }
+        QVERIFY(reported);
+
+        /* The later fragment wins */
+        QString verilogPath = QDir(projectManager.getOutputPath()).filePath("test_conflict1.v");
+        QVERIFY(QFile::exists(verilogPath));
+        QFile verilogFile(verilogPath);
+        QVERIFY(verilogFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        QString verilogContent = verilogFile.readAll();
+        verilogFile.close();
+        QVERIFY(verifyVerilogContentNormalized(verilogContent, "another_module"));
+        QVERIFY(!verilogContent.contains("dummy_module"));
+    }
+
+    void testMergeNodeListConflict()
+    {
+        /* Conflicts name the fragments, and a kind change is reported too */
+        const QList<YAML::Node> fragmentList
+            = {YAML::Load("instance: {u_cpu: {module: cpu_a}}\nnet: {}\n"),
+               YAML::Load("instance: {u_cpu: {module: cpu_a}}\n"),
+               YAML::Load("instance: {u_cpu: {module: cpu_b}}\nnet: [n0]\n")};
+        QStringList conflictList;
+        const YAML::Node result
+            = QSocYamlUtils::mergeNodeList(fragmentList, {"a", "b", "c"}, &conflictList);
+        QCOMPARE(
+            QString::fromStdString(result["instance"]["u_cpu"]["module"].Scalar()),
+            QString("cpu_b"));
+        QCOMPARE(conflictList.size(), 2);
+        QVERIFY(conflictList.at(0).startsWith("instance.u_cpu.module: \"cpu_a\" from b"));
+        QVERIFY(conflictList.at(1).startsWith("net: a map from a overridden by a list from c"));
+    }
 };
 
 QStringList Test::messageList;
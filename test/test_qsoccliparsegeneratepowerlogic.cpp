@@ -827,6 +827,135 @@ power:
         /* Verify test_en connection */
         QVERIFY(verifyVerilogContentNormalized(verilogContent, ".test_en (test_en)"));
     }
+
+    void test_diagram_output()
+    {
+        QString netlistContent = R"(
+port:
+  clk_ao:
+    direction: input
+    type: logic
+  rst_ao:
+    direction: input
+    type: logic
+  rdy_ao:
+    direction: output
+    type: logic
+
+instance: {}
+
+net: {}
+
+power:
+  - name: pwr_diagram
+    host_clock: clk_ao
+    host_reset: rst_ao
+    domain:
+      - name: ao
+        v_mv: 900
+        wait_dep: 2
+        settle_on: 3
+        settle_off: 4
+)";
+
+        QString netlistPath = createTempFile("test_power_diagram.soc_net", netlistContent);
+        QVERIFY(!netlistPath.isEmpty());
+
+        messageList.clear();
+        {
+            QSocCliWorker socCliWorker;
+            QStringList   args;
+            args << "qsoc" << "generate" << "verilog" << "-d" << projectManager.getCurrentPath()
+                 << netlistPath;
+
+            socCliWorker.setup(args, false);
+            socCliWorker.run();
+        }
+
+        /* The Typst source keeps the circuiteria document the layout always wrote */
+        const QDir outputDir(projectManager.getOutputPath());
+        QFile      typstFile(outputDir.filePath("pwr_diagram.typ"));
+        QVERIFY(typstFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString typstContent = QString::fromUtf8(typstFile.readAll());
+        typstFile.close();
+
+        const QString expectedTypst
+            = QString(R"(#import "@preview/circuiteria:0.2.0": *
+#import "@preview/cetz:0.3.2": draw
+#set page(width: auto, height: auto, margin: .5cm)
+#set text(font: "Sarasa Mono SC", size: 10pt)
+#align(center)[
+  = Power tree
+  #text(size: 8pt, fill: gray)[Generated by QSoC v%1]
+]
+#v(0.5cm)
+#circuit({
+  // === Legend ===
+  element.block(
+    x: 0.00, y: -1.20, w: 1.60, h: 0.80,
+    id: "legend_ao", name: "AO", fill: gray,
+    ports: (west: ((id: "i"),), east: ((id: "o"),))
+  )
+  draw.content((0.80, -2.30), [AO])
+  element.block(
+    x: 4.00, y: -1.20, w: 1.60, h: 0.80,
+    id: "legend_root", name: "ROOT", fill: util.colors.green,
+    ports: (west: ((id: "i"),), east: ((id: "o"),))
+  )
+  draw.content((4.80, -2.30), [ROOT])
+  element.block(
+    x: 8.00, y: -1.20, w: 1.60, h: 0.80,
+    id: "legend_normal", name: "NORM", fill: util.colors.blue,
+    ports: (west: ((id: "i"),), east: ((id: "o"),))
+  )
+  draw.content((8.80, -2.30), [NORMAL])
+  element.block(
+    x: 12.00, y: -1.20, w: 1.60, h: 0.80,
+    id: "legend_fsm", name: "FSM", fill: util.colors.orange,
+    ports: (west: ((id: "i"),), east: ((id: "o"),))
+  )
+  draw.content((12.80, -2.30), [FSM])
+  // ---- ao [ao] ----
+  element.block(
+    x: 0.00, y: -4.70, w: 1.80, h: 1.20,
+    id: "ao_DOM", name: "AO", fill: gray,
+    ports: (west: ((id: "in"),), east: ((id: "out"),))
+  )
+  draw.content((0.90, -5.30), text(size: 8pt)[ao])
+  draw.content((0.90, -5.70), text(size: 6pt)[900mV])
+  element.block(
+    x: 3.00, y: -4.70, w: 1.50, h: 1.20,
+    id: "ao_FSM", name: "FSM", fill: util.colors.orange,
+    ports: (west: ((id: "in"),), east: ((id: "out"),))
+  )
+  draw.content((3.75, -5.30), text(size: 6pt)[wait:2])
+  draw.content((3.75, -5.60), text(size: 6pt)[on:3])
+  draw.content((3.75, -5.90), text(size: 6pt)[off:4])
+  wire.wire("w_ao_dom_fsm", (
+    "ao_DOM-port-out", "ao_FSM-port-in"
+  ))
+  draw.line("ao_FSM-port-out", (7.50, -4.10), mark: (end: ">", fill: black))
+  draw.content((7.80, -4.10), anchor: "west", [rdy_ao])
+})
+)")
+                  .arg(QSOC_VERSION);
+        QCOMPARE(typstContent, expectedTypst);
+
+        /* The SVG draws the same diagram */
+        QFile svgFile(outputDir.filePath("pwr_diagram.svg"));
+        QVERIFY(svgFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString svgContent = QString::fromUtf8(svgFile.readAll());
+        svgFile.close();
+
+        QVERIFY(svgContent.startsWith("<?xml"));
+        QVERIFY(svgContent.trimmed().endsWith("</svg>"));
+        QVERIFY(svgContent.contains(">Power tree</text>"));
+        QVERIFY(svgContent.contains(">900mV</text>"));
+        QVERIFY(svgContent.contains(">wait:2</text>"));
+        QVERIFY(svgContent.contains(">rdy_ao</text>"));
+        QVERIFY(svgContent.contains("marker-end=\"url(#arrow)\""));
+        QVERIFY(!messageList.filter("Generated SVG diagram:").isEmpty());
+    }
 };
 
 QStringList Test::messageList;
@@ -1163,6 +1163,73 @@ reset:
         // Should NOT have rst_apb_n as input since it's an output (check only in reset module)
         QVERIFY(!verifyVerilogContentNormalized(moduleHeader, "input  wire rst_apb_n"));
     }
+
+    void testSvgDiagram()
+    {
+        QString netlistContent = R"(
+port:
+  clk_sys:
+    direction: input
+    type: logic
+  por_rst_n:
+    direction: input
+    type: logic
+  cpu_rst_n:
+    direction: output
+    type: logic
+
+instance: {}
+
+net: {}
+
+reset:
+  - name: svg_reset_ctrl
+    clock: clk_sys
+    source:
+      por_rst_n:
+        active: low
+    target:
+      cpu_rst_n:
+        active: low
+        link:
+          por_rst_n:
+            sync:
+              clock: clk_sys
+              stage: 2
+)";
+
+        QString netlistPath = createTempFile("test_svg_reset.soc_net", netlistContent);
+        QVERIFY(!netlistPath.isEmpty());
+
+        messageList.clear();
+        {
+            QSocCliWorker socCliWorker;
+            QStringList   args;
+            args << "qsoc" << "generate" << "verilog" << "-d" << projectManager.getCurrentPath()
+                 << netlistPath;
+
+            socCliWorker.setup(args, false);
+            socCliWorker.run();
+        }
+
+        /* Diagrams are named after the reset controller */
+        const QDir outputDir(projectManager.getOutputPath());
+        QVERIFY(QFile::exists(outputDir.filePath("svg_reset_ctrl.typ")));
+        QFile svgFile(outputDir.filePath("svg_reset_ctrl.svg"));
+        QVERIFY(svgFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString svgContent = QString::fromUtf8(svgFile.readAll());
+        svgFile.close();
+
+        QVERIFY(svgContent.startsWith("<?xml"));
+        QVERIFY(svgContent.trimmed().endsWith("</svg>"));
+        QVERIFY(svgContent.contains(">Reset tree</text>"));
+        QVERIFY(svgContent.contains(">Reset Sources</text>"));
+        QVERIFY(svgContent.contains(">por_rst_n</text>"));
+        QVERIFY(svgContent.contains(">cpu_rst_n</text>"));
+        QVERIFY(svgContent.contains(">SYNC</text>"));
+        QVERIFY(svgContent.contains("marker-end=\"url(#arrow)\""));
+        QVERIFY(!messageList.filter("Generated SVG reset diagram:").isEmpty());
+    }
 };
 
 QStringList Test::messageList;
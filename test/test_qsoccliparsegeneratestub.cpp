@@ -515,6 +515,235 @@ private slots:
         }
         QVERIFY(foundNoModulesError);
     }
+
+    void testGenerateStubLargeLibrary()
+    {
+        /* Enough modules to render on several threads */
+        const int     moduleCount = 300;
+        const QString macroPath
+            = QDir(projectManager.getModulePath()).filePath("macro_lib.soc_mod");
+        QFile macroFile(macroPath);
+        QVERIFY(macroFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream stream(&macroFile);
+        for (int index = 0; index < moduleCount; ++index) {
+            stream << QString("macro_%1:\n").arg(index, 3, 10, QChar('0'))
+                   << "  port:\n"
+                   << "    clk:\n      type: logic\n      direction: input\n"
+                   << "    data:\n      type: logic[" << (index % 16) << ":0]\n"
+                   << "      direction: output\n";
+        }
+        macroFile.close();
+
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "stub",
+               "-d",
+               projectManager.getCurrentPath(),
+               "-l",
+               "macro_lib",
+               "-m",
+               "macro_.*",
+               "macro_stub"};
+
+        auto readOutput = [this](const QString &fileName) {
+            QFile file(QDir(projectManager.getOutputPath()).filePath(fileName));
+            return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+        };
+
+        {
+            QSocCliWorker socCliWorker;
+            socCliWorker.setup(appArguments, false);
+            socCliWorker.run();
+        }
+        const QByteArray verilog = readOutput("macro_stub.v");
+        const QByteArray lib     = readOutput("macro_stub.lib");
+
+        /* Library filter selects by library name, not by module name */
+        QVERIFY(verilog.contains("module macro_000"));
+        QVERIFY(!verilog.contains("module simple_pll"));
+        QVERIFY(!lib.contains("cell (dff_mem_1r_1w)"));
+
+        /* Modules keep library order in both files */
+        qsizetype verilogPos = -1;
+        qsizetype libPos     = -1;
+        for (int index = 0; index < moduleCount; ++index) {
+            const QByteArray name = QString("macro_%1").arg(index, 3, 10, QChar('0')).toUtf8();
+            const qsizetype  nextVerilogPos = verilog.indexOf("module " + name + " ");
+            const qsizetype  nextLibPos     = lib.indexOf("cell (" + name + ")");
+            QVERIFY2(nextVerilogPos > verilogPos, name.constData());
+            QVERIFY2(nextLibPos > libPos, name.constData());
+            verilogPos = nextVerilogPos;
+            libPos     = nextLibPos;
+        }
+        QVERIFY(lib.contains("type (DATA16B)"));
+        QVERIFY(lib.trimmed().endsWith("}  /* end of library */"));
+
+        /* Output does not depend on thread scheduling */
+        {
+            QSocCliWorker socCliWorker;
+            socCliWorker.setup(appArguments, false);
+            socCliWorker.run();
+        }
+        QCOMPARE(readOutput("macro_stub.v"), verilog);
+        QCOMPARE(readOutput("macro_stub.lib"), lib);
+
+        QFile::remove(macroPath);
+    }
+
+    void testGenerateStubTimingArcs()
+    {
+        const QString timedPath
+            = QDir(projectManager.getModulePath()).filePath("timed_lib.soc_mod");
+        QFile timedFile(timedPath);
+        QVERIFY(timedFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        timedFile.write(R"(
+timed_macro:
+  timing:
+    clock: clk
+    setup: 0.12
+    hold: 0.03
+    clk_to_q: 0.45
+  port:
+    clk:
+      type: logic
+      direction: in
+    din:
+      type: logic[3:0]
+      direction: in
+      timing:
+        setup: 0.2
+    dout:
+      type: logic
+      direction: out
+)");
+        timedFile.close();
+
+        const QString timingPath = QDir(projectManager.getCurrentPath()).filePath("timing.csv");
+        QFile         timingFile(timingPath);
+        QVERIFY(timingFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        timingFile.write(
+            "module,port,capacitance,max_transition,clk_to_q\n"
+            "*,,0.004,,\n"
+            "timed_macro,dout,,0.25,0.5\n"
+            "timed_macro,missing,0.1,,\n");
+        timingFile.close();
+
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "stub",
+               "-d",
+               projectManager.getCurrentPath(),
+               "-l",
+               "timed_lib",
+               "-t",
+               timingPath,
+               "timed_stub"};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* Shared single point templates */
+        QVERIFY(verifyFileContent("timed_stub.lib", "lu_table_template (qsoc_delay_template)"));
+        QVERIFY(
+            verifyFileContent("timed_stub.lib", "lu_table_template (qsoc_constraint_template)"));
+
+        /* Related clock becomes a clock pin without arcs of its own */
+        QVERIFY(verifyFileContent(
+            "timed_stub.lib", "pin(clk) { direction : input; clock : true; capacitance : 0.004;"));
+
+        /* Port setup overrides the module value, hold comes from the module */
+        QVERIFY(verifyFileContent(
+            "timed_stub.lib",
+            "timing () { related_pin : \"clk\"; timing_type : setup_rising; "
+            "rise_constraint (qsoc_constraint_template) { values (\"0.2\"); }"));
+        QVERIFY(verifyFileContent(
+            "timed_stub.lib",
+            "timing_type : hold_rising; "
+            "rise_constraint (qsoc_constraint_template) { values (\"0.03\"); }"));
+
+        /* CSV rows override the module YAML */
+        QVERIFY(verifyFileContent(
+            "timed_stub.lib",
+            "pin(dout) { direction : output; capacitance : 0.004; max_transition : 0.25;"));
+        QVERIFY(verifyFileContent(
+            "timed_stub.lib",
+            "timing_type : rising_edge; cell_rise (qsoc_delay_template) { values (\"0.5\"); }"));
+        QVERIFY(verifyFileContent(
+            "timed_stub.lib", "rise_transition (qsoc_delay_template) { values (\"0.25\"); }"));
+        QVERIFY(!verifyFileContent("timed_stub.lib", "values (\"0.45\")"));
+
+        /* Rows for ports that do not exist are reported */
+        bool foundUnknownPort = false;
+        for (const QString &msg : messageList) {
+            if (msg.contains("Timing row for unknown port")) {
+                foundUnknownPort = true;
+                break;
+            }
+        }
+        QVERIFY(foundUnknownPort);
+
+        QFile::remove(timedPath);
+    }
+
+    void testGenerateStubTimingUnknownClock()
+    {
+        const QString timedPath
+            = QDir(projectManager.getModulePath()).filePath("bad_clock_lib.soc_mod");
+        QFile timedFile(timedPath);
+        QVERIFY(timedFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        timedFile.write(R"(
+bad_clock_macro:
+  timing:
+    clock: clk_typo
+    setup: 0.12
+    clk_to_q: 0.45
+  port:
+    clk:
+      type: logic
+      direction: in
+    din:
+      type: logic
+      direction: in
+    dout:
+      type: logic
+      direction: out
+)");
+        timedFile.close();
+
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "stub",
+               "-d",
+               projectManager.getCurrentPath(),
+               "-l",
+               "bad_clock_lib",
+               "bad_clock_stub"};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* No arc refers to a pin the cell does not have */
+        QVERIFY(verifyFileContent("bad_clock_stub.lib", "pin(din) { direction : input;"));
+        QVERIFY(!verifyFileContent("bad_clock_stub.lib", "clk_typo"));
+        QVERIFY(!verifyFileContent("bad_clock_stub.lib", "related_pin :"));
+
+        bool foundWarning = false;
+        for (const QString &msg : messageList) {
+            if (msg.contains("Timing clock") && msg.contains("clk_typo")
+                && msg.contains("is not a port")) {
+                foundWarning = true;
+                break;
+            }
+        }
+        QVERIFY(foundWarning);
+
+        QFile::remove(timedPath);
+    }
 };
 
 QStringList Test::messageList;
@@ -332,6 +332,54 @@ options:
         QVERIFY(verifyTemplateContent("yaml_test_template", "Optimization: high"));
     }
 
+    void testGenerateTemplateWithDepfile()
+    {
+        messageList.clear();
+        const QDir projectDir(projectManager.getCurrentPath());
+
+        const QString yamlFilePath = projectDir.filePath("depfile_config.yaml");
+        QFile         yamlFile(yamlFilePath);
+        QVERIFY(yamlFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream yamlStream(&yamlFile);
+        yamlStream << "settings:\n  project: depfile_project\n";
+        yamlFile.close();
+
+        const QString templateFilePath = projectDir.filePath("depfile_template.txt.j2");
+        QFile         templateFile(templateFilePath);
+        QVERIFY(templateFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream templateStream(&templateFile);
+        templateStream << "Project: {{ settings.project }}\n";
+        templateFile.close();
+
+        const QString depfilePath = projectDir.filePath("depfile_template.d");
+        QFile::remove(depfilePath);
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "template",
+               "-d",
+               projectManager.getCurrentPath(),
+               "--yaml",
+               yamlFilePath,
+               "--depfile",
+               depfilePath,
+               templateFilePath};
+        QCOMPARE(socCliWorker.execute(appArguments), 0);
+
+        /* One rule: the rendered file depends on the template and the data file */
+        QFile depfile(depfilePath);
+        QVERIFY(depfile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString content = QString::fromUtf8(depfile.readAll());
+        depfile.close();
+        const QString target
+            = QDir(projectManager.getOutputPath()).absoluteFilePath("depfile_template.txt");
+        QVERIFY(content.startsWith(target + ":"));
+        QVERIFY(content.contains(QFileInfo(templateFilePath).absoluteFilePath()));
+        QVERIFY(content.contains(QFileInfo(yamlFilePath).absoluteFilePath()));
+    }
+
     void testGenerateTemplateWithJsonData()
     {
         messageList.clear();
@@ -660,6 +708,164 @@ endmodule // {{ module.name }})";
         /* Test binary formatting */
         QVERIFY(verifyTemplateContent("format_test_template", "Binary: 0b1111"));
     }
+
+    void testGenerateTemplateWithIndexCallbacks()
+    {
+        messageList.clear();
+        const QDir projectDir(projectManager.getCurrentPath());
+
+        /* Registers and their fields, joined by register name */
+        const QString jsonContent  = R"({
+    "registers": [
+        {"name": "CTRL", "offset": 0},
+        {"name": "STATUS", "offset": 4},
+        {"name": "DATA", "offset": 8}
+    ],
+    "fields": [
+        {"reg": "CTRL", "name": "EN"},
+        {"reg": "CTRL", "name": "MODE"},
+        {"reg": "STATUS", "name": "BUSY"}
+    ]
+})";
+        const QString jsonFilePath = projectDir.filePath("index_test_data.json");
+        QFile         jsonFile(jsonFilePath);
+        QVERIFY(jsonFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream jsonStream(&jsonFile);
+        jsonStream << jsonContent;
+        jsonFile.close();
+
+        const QString templateContent  = R"({% set regs = index_by(registers, "name") %}
+{% for f in fields %}{% set r = lookup(regs, f.reg) %}Field {{ f.name }}@{{ r.offset }}
+{% endfor %}
+{% set groups = group_by(fields, "reg") %}CTRL fields: {{ length(lookup(groups, "CTRL")) }}
+Sorted:{% for r in sort_by(registers, "offset", true) %} {{ r.name }}{% endfor %}
+{% set found = lookup(registers, "offset", 4) %}At 4: {{ found.name }}
+)";
+        const QString templateFilePath = projectDir.filePath("index_test_template.j2");
+        QFile         templateFile(templateFilePath);
+        QVERIFY(templateFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream templateStream(&templateFile);
+        templateStream << templateContent;
+        templateFile.close();
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "template",
+               "-d",
+               projectManager.getCurrentPath(),
+               "--json",
+               jsonFilePath,
+               templateFilePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyTemplateOutputExistence("index_test_template"));
+        QVERIFY(verifyTemplateContent("index_test_template", "Field EN@0"));
+        QVERIFY(verifyTemplateContent("index_test_template", "Field MODE@0"));
+        QVERIFY(verifyTemplateContent("index_test_template", "Field BUSY@4"));
+        QVERIFY(verifyTemplateContent("index_test_template", "CTRL fields: 2"));
+        QVERIFY(verifyTemplateContent("index_test_template", "Sorted: DATA STATUS CTRL"));
+        QVERIFY(verifyTemplateContent("index_test_template", "At 4: STATUS"));
+        QVERIFY(messageList.filter("is called again on the same array").isEmpty());
+    }
+
+    void testGenerateTemplateWithIndexInLoop()
+    {
+        messageList.clear();
+        const QDir projectDir(projectManager.getCurrentPath());
+
+        const QString jsonFilePath = projectDir.filePath("index_loop_data.json");
+        QFile         jsonFile(jsonFilePath);
+        QVERIFY(jsonFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        jsonFile.write(R"({
+    "registers": [{"name": "CTRL", "offset": 0}, {"name": "STATUS", "offset": 4}],
+    "fields": [{"reg": "CTRL"}, {"reg": "STATUS"}, {"reg": "STATUS"}]
+})");
+        jsonFile.close();
+
+        /* The index is rebuilt for every field, the render still succeeds but warns once */
+        const QString templateFilePath = projectDir.filePath("index_loop_template.j2");
+        QFile         templateFile(templateFilePath);
+        QVERIFY(templateFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        templateFile.write(
+            "{% for f in fields %}{% set r = lookup(index_by(registers, \"name\"), f.reg) %}"
+            "Offset {{ r.offset }}\n{% endfor %}");
+        templateFile.close();
+
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "template",
+               "-d",
+               projectManager.getCurrentPath(),
+               "--json",
+               jsonFilePath,
+               templateFilePath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        QVERIFY(verifyTemplateOutputExistence("index_loop_template"));
+        QVERIFY(verifyTemplateContent("index_loop_template", "Offset 0\nOffset 4\nOffset 4"));
+        QCOMPARE(
+            messageList.filter(QRegularExpression("index_by on key .*name.* is called again"))
+                .size(),
+            1);
+    }
+
+    void testGenerateTemplateRenderErrorKeepsOutput()
+    {
+        messageList.clear();
+        const QDir    projectDir(projectManager.getCurrentPath());
+        const QString jsonFilePath = projectDir.filePath("keep_output_data.json");
+        QFile         jsonFile(jsonFilePath);
+        QVERIFY(jsonFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        jsonFile.write(R"({"name": "first"})");
+        jsonFile.close();
+
+        const QString templateFilePath = projectDir.filePath("keep_output_template.j2");
+        const auto    renderTemplate   = [&](const QByteArray &templateContent) {
+            QFile templateFile(templateFilePath);
+            if (templateFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                templateFile.write(templateContent);
+                templateFile.close();
+            }
+            QSocCliWorker     socCliWorker;
+            const QStringList appArguments
+                = {"qsoc",
+                   "generate",
+                   "template",
+                   "-d",
+                   projectManager.getCurrentPath(),
+                   "--json",
+                   jsonFilePath,
+                   templateFilePath};
+            socCliWorker.setup(appArguments, false);
+            socCliWorker.run();
+        };
+
+        renderTemplate("Render {{ name }}\n");
+        const QString outputPath
+            = QDir(projectManager.getOutputPath()).filePath("keep_output_template");
+        QFile outputFile(outputPath);
+        QVERIFY(outputFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        QCOMPARE(outputFile.readAll(), QByteArray("Render first\n"));
+        outputFile.close();
+
+        /* Fails after part of the output is rendered, the previous file stays */
+        messageList.clear();
+        renderTemplate("Render {{ name }}\n{{ missing_value }}\n");
+        QVERIFY(
+            !messageList.filter(QRegularExpression("Error:.*failed to render template")).empty());
+        QVERIFY(outputFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        QCOMPARE(outputFile.readAll(), QByteArray("Render first\n"));
+        outputFile.close();
+        QCOMPARE(
+            QDir(projectManager.getOutputPath()).entryList({"keep_output_template*"}, QDir::Files),
+            QStringList({"keep_output_template", "keep_output_template.json"}));
+    }
 };
 
 QStringList Test::messageList;
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "common/config.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
+#include "qsoc_test.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    QString            projectName;
+    QSocProjectManager projectManager;
+
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        messageList << msg;
+    }
+
+    static void writeFile(const QString &filePath, const QString &content)
+    {
+        QFile file(filePath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&file);
+            stream << content;
+            file.close();
+        }
+    }
+
+    /* Rewrite a file with a modification time that differs from the last one */
+    static void rewriteFile(const QString &filePath, const QString &content)
+    {
+        const QDateTime lastModified = QFileInfo(filePath).lastModified();
+        writeFile(filePath, content);
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(lastModified.addSecs(2), QFileDevice::FileModificationTime);
+            file.close();
+        }
+    }
+
+    static QString readFile(const QString &filePath)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return QString();
+        }
+        return QString::fromUtf8(file.readAll());
+    }
+
+    static QString moduleContent(int width)
+    {
+        return QString(R"(
+watch_cell:
+  port:
+    din:
+      type: logic[%1:0]
+      direction: in
+    dout:
+      type: logic[%1:0]
+      direction: out
+)")
+            .arg(width - 1);
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        /* Re-enable message handler for collecting CLI output */
+        qInstallMessageHandler(messageOutput);
+        /* Set project name */
+        projectName = QFileInfo(__FILE__).baseName() + "_data";
+        /* Setup project manager */
+        projectManager.setProjectName(projectName);
+        projectManager.setCurrentPath(QDir::current().filePath(projectName));
+        projectManager.mkpath();
+        projectManager.save(projectName);
+        projectManager.load(projectName);
+    }
+
+    void cleanupTestCase()
+    {
+#ifdef ENABLE_TEST_CLEANUP
+        /* Clean up the test project directory */
+        QDir projectDir(projectManager.getCurrentPath());
+        if (projectDir.exists()) {
+            projectDir.removeRecursively();
+        }
+#endif // ENABLE_TEST_CLEANUP
+    }
+
+    /* Reloads in watch mode drop what the library files no longer define */
+    void testWatchReloadDropsRemovedModules()
+    {
+        const QString filePath
+            = QDir(projectManager.getModulePath()).filePath("watch_reload.soc_mod");
+        writeFile(filePath, moduleContent(8).replace("watch_cell", "watch_keep") + R"(
+watch_drop:
+  port:
+    clk:
+      type: logic
+      direction: in
+)");
+
+        QSocModuleManager moduleManager(nullptr, &projectManager);
+        moduleManager.setLibraryCache(true);
+        QVERIFY(moduleManager.load(QRegularExpression("watch_reload")));
+        QVERIFY(moduleManager.isModuleExist("watch_keep"));
+        QVERIFY(moduleManager.isModuleExist("watch_drop"));
+
+        /* A module removed from the file is gone after the reload */
+        rewriteFile(filePath, moduleContent(8).replace("watch_cell", "watch_keep"));
+        QVERIFY(moduleManager.load(QRegularExpression("watch_reload")));
+        QVERIFY(moduleManager.isModuleExist("watch_keep"));
+        QVERIFY(!moduleManager.isModuleExist("watch_drop"));
+        QCOMPARE(moduleManager.getModuleLibrary("watch_keep"), QString("watch_reload"));
+
+        /* A deleted library file takes its modules along */
+        QVERIFY(QFile::remove(filePath));
+        QVERIFY(moduleManager.load(QRegularExpression(".*")));
+        QVERIFY(!moduleManager.isModuleExist("watch_keep"));
+    }
+
+    void testWatchReloadDropsRemovedBuses()
+    {
+        const QString busContent = R"(
+%1:
+  port:
+    valid:
+      master:
+        direction: out
+      slave:
+        direction: in
+)";
+        const QString filePath = QDir(projectManager.getBusPath()).filePath("watch_reload.soc_bus");
+        writeFile(filePath, busContent.arg("watch_keep_bus") + busContent.arg("watch_drop_bus"));
+
+        QSocBusManager busManager(nullptr, &projectManager);
+        busManager.setLibraryCache(true);
+        QVERIFY(busManager.load(QRegularExpression("watch_reload")));
+        QVERIFY(busManager.isBusExist("watch_keep_bus"));
+        QVERIFY(busManager.isBusExist("watch_drop_bus"));
+
+        rewriteFile(filePath, busContent.arg("watch_keep_bus"));
+        QVERIFY(busManager.load(QRegularExpression("watch_reload")));
+        QVERIFY(busManager.isBusExist("watch_keep_bus"));
+        QVERIFY(!busManager.isBusExist("watch_drop_bus"));
+
+        QVERIFY(QFile::remove(filePath));
+        QVERIFY(busManager.load(QRegularExpression(".*")));
+        QVERIFY(!busManager.isBusExist("watch_keep_bus"));
+    }
+
+    /* Runs last, leaving the watch loop exits the application event loops */
+    void testWatchRegeneratesOnLibraryChange()
+    {
+        const QString modulePath
+            = QDir(projectManager.getModulePath()).filePath("watch_cells.soc_mod");
+        const QString netlistPath
+            = QDir(projectManager.getOutputPath()).filePath("watch_top.soc_net");
+        const QString outputPath = QDir(projectManager.getOutputPath()).filePath("watch_top.v");
+        writeFile(modulePath, moduleContent(8));
+        writeFile(netlistPath, R"(
+instance:
+  u_a:
+    module: watch_cell
+    port:
+      dout:
+        link: data
+  u_b:
+    module: watch_cell
+    port:
+      din:
+        link: data
+)");
+
+        /* Widen the ports once watching, stop when the output follows */
+        QTimer::singleShot(500, [&]() { writeFile(modulePath, moduleContent(16)); });
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+        QTimer pollTimer;
+        connect(&pollTimer, &QTimer::timeout, [&]() {
+            if (readFile(outputPath).contains("[15:0]") || elapsedTimer.elapsed() > 10000) {
+                QCoreApplication::exit(0);
+            }
+        });
+        pollTimer.start(100);
+
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "generate",
+               "verilog",
+               "--watch",
+               "-d",
+               projectManager.getCurrentPath(),
+               netlistPath};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+        pollTimer.stop();
+
+        const QString verilogContent = readFile(outputPath);
+        QVERIFY(verilogContent.contains("[15:0]"));
+        QVERIFY(!verilogContent.contains("[7:0]"));
+
+        const QString output = messageList.join("\n");
+        QVERIFY(output.contains("Watching"));
+        QVERIFY(output.contains("Regenerated 1 of 1 outputs"));
+    }
+};
+
+QStringList Test::messageList;
+
+QSOC_TEST_MAIN(Test)
+
+#include "test_qsoccliparsegeneratewatch.moc"
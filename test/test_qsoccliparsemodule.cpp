@@ -4,14 +4,20 @@
 #include "cli/qsoccliworker.h"
 #include "common/qsocbusmanager.h"
 #include "common/qsocmodulemanager.h"
+#include "common/qsocwidthevaluator.h"
 #include "qsoc_test.h"
 
 #include <QDir>
 #include <QFile>
+#include <QMutex>
 #include <QStringList>
+#include <QTemporaryDir>
+#include <QThreadPool>
 #include <QtTest>
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
 struct TestApp
 {
@@ -32,6 +38,7 @@ class Test : public QObject
 
 private:
     static QStringList messageList;
+    static QMutex      messageMutex;
     QSocProjectManager projectManager;
     QSocBusManager     busManager;
     QSocModuleManager  moduleManager;
@@ -42,9 +49,28 @@ private:
     {
         Q_UNUSED(type);
         Q_UNUSED(context);
+        /* Concurrent library saves log from pool threads */
+        const QMutexLocker locker(&messageMutex);
         messageList << msg;
     }
 
+    /* Write a module library with one clocked module per name */
+    QString writeModuleLibrary(const QString &libraryName, const QStringList &moduleNameList)
+    {
+        const QString filePath
+            = QDir(projectManager.getModulePath()).filePath(libraryName + ".soc_mod");
+        QFile file(filePath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&file);
+            for (const QString &moduleName : moduleNameList) {
+                stream << moduleName << ":\n"
+                       << "  port:\n    clk:\n      direction: input\n      type: logic\n";
+            }
+            file.close();
+        }
+        return filePath;
+    }
+
     /* Helper method to check if the messageList contains a specific message */
     bool messageListContains(const QString &message)
     {
@@ -361,6 +387,191 @@ private slots:
         QVERIFY(messageListContains("error"));
     }
 
+    /* Test module import parsing the file list in chunks */
+    void testModuleImportChunked()
+    {
+        /* Three self-contained modules, imported two files at a time */
+        QStringList filePathList;
+        for (int index = 0; index < 3; ++index) {
+            const QString testFilePath
+                = QDir(projectPath).filePath(QString("test_module_chunk%1.v").arg(index));
+            QFile testFile(testFilePath);
+            if (testFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                QTextStream out(&testFile);
+                out << "module test_module_chunk" << index << " (\n"
+                    << "  input  wire       clk,\n"
+                    << "  output wire [3:0] data\n"
+                    << ");\n"
+                    << "  assign data = 4'd" << index << ";\n"
+                    << "endmodule\n";
+                testFile.close();
+            }
+            filePathList.append(QFileInfo(testFilePath).absoluteFilePath());
+        }
+        const QString fileListPath = QDir(projectPath).filePath("test_module_chunk.f");
+        QFile         fileList(fileListPath);
+        QVERIFY(fileList.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream(&fileList) << filePathList.join("\n") << "\n";
+        fileList.close();
+
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "module",
+               "import",
+               "-l",
+               "test_module_chunk",
+               "-f",
+               fileListPath,
+               "--chunk",
+               "2",
+               "--project",
+               projectName,
+               "-d",
+               projectManager.getProjectPath()};
+        QCOMPARE(socCliWorker.execute(appArguments), 0);
+
+        /* Every chunk lands in the same library */
+        moduleManager.load(QRegularExpression(".*"));
+        for (int index = 0; index < 3; ++index) {
+            QVERIFY(moduleManager.isModuleExist(QString("test_module_chunk%1").arg(index)));
+            QCOMPARE(
+                moduleManager.getModuleLibrary(QString("test_module_chunk%1").arg(index)),
+                QString("test_module_chunk"));
+        }
+
+        /* Chunks hold at least one file */
+        messageList.clear();
+        QSocCliWorker invalidWorker;
+        QCOMPARE(
+            invalidWorker.execute(
+                {"qsoc", "module", "import", "--chunk", "0", "-f", fileListPath}),
+            1);
+        QVERIFY(messageListContains("invalid chunk size"));
+    }
+
+    void testModuleImportPersistentCache()
+    {
+        const QString testFilePath = QDir(projectPath).filePath("test_module_cache.v");
+        QFile         testFile(testFilePath);
+        QVERIFY(testFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream(&testFile) << "module test_module_cache (input wire clk);\nendmodule\n";
+        testFile.close();
+
+        /* Persistent entries go to the directory given, never the user cache */
+        QTemporaryDir cacheDir;
+        QVERIFY(cacheDir.isValid());
+        for (int run = 0; run < 2; ++run) {
+            QSocModuleManager importManager(nullptr, &projectManager);
+            importManager.setImportCacheDir(cacheDir.path());
+            messageList.clear();
+            QVERIFY(importManager.importFromFileList(
+                "test_module_cache",
+                QRegularExpression("test_module_cache"),
+                QString(),
+                {testFilePath}));
+            QCOMPARE(messageListContains("Import cache hit:"), run == 1);
+        }
+        QCOMPARE(QDir(cacheDir.path()).entryList({"*.yml"}, QDir::Files).size(), 1);
+
+        /* Without a directory, a new manager starts cold */
+        QSocModuleManager memoryManager(nullptr, &projectManager);
+        messageList.clear();
+        QVERIFY(memoryManager.importFromFileList(
+            "test_module_cache",
+            QRegularExpression("test_module_cache"),
+            QString(),
+            {testFilePath}));
+        QVERIFY(!messageListContains("Import cache hit:"));
+    }
+
+    void testModuleImportParameterized()
+    {
+        const QString testFilePath = QDir(projectPath).filePath("test_module_param.v");
+        QFile         testFile(testFilePath);
+        QVERIFY(testFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream(&testFile) << "module test_module_param #(\n"
+                               << "  parameter WIDTH = 8,\n"
+                               << "  parameter DEPTH = 4\n"
+                               << ") (\n"
+                               << "  input  wire                     clk,\n"
+                               << "  output wire [WIDTH-1:0]         dout,\n"
+                               << "  output wire [$clog2(DEPTH)-1:0] level\n"
+                               << ");\n"
+                               << "endmodule\n";
+        testFile.close();
+
+        /* One instance overrides DEPTH through a netlist parameter */
+        const QString netlistPath = QDir(projectPath).filePath("test_module_param.soc_net");
+        QFile         netlistFile(netlistPath);
+        QVERIFY(netlistFile.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream(&netlistFile) << "parameter:\n"
+                                  << "  FIFO_DEPTH: 16\n"
+                                  << "instance:\n"
+                                  << "  u_param:\n"
+                                  << "    module: test_module_param\n"
+                                  << "    parameter:\n"
+                                  << "      DEPTH: FIFO_DEPTH\n";
+        netlistFile.close();
+
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "module",
+               "import",
+               "-l",
+               "test_module_param",
+               "-G",
+               "test_module_param:WIDTH=16",
+               "-G",
+               "test_module_param:WIDTH=8",
+               "--netlist",
+               netlistPath,
+               "-j",
+               "2",
+               testFilePath,
+               "--project",
+               projectName,
+               "-d",
+               projectManager.getProjectPath()};
+        QCOMPARE(socCliWorker.execute(appArguments), 0);
+
+        moduleManager.load(QRegularExpression(".*"));
+        const YAML::Node moduleYaml = moduleManager.getModuleYaml(QString("test_module_param"));
+        const YAML::Node &parameterization = moduleYaml["parameterization"];
+        QVERIFY(parameterization.IsMap());
+        /* WIDTH=8 is the default, it needs no elaboration of its own */
+        QCOMPARE(parameterization.size(), std::size_t(2));
+
+        const YAML::Node &wide = parameterization["DEPTH=4,WIDTH=16"];
+        QVERIFY(wide.IsMap());
+        QCOMPARE(
+            QSocWidthEvaluator::typeWidth(
+                QString::fromStdString(wide["port"]["dout"]["type"].as<std::string>())),
+            16);
+        const YAML::Node &deep = parameterization["DEPTH=16,WIDTH=8"];
+        QVERIFY(deep.IsMap());
+        QCOMPARE(
+            QSocWidthEvaluator::typeWidth(
+                QString::fromStdString(deep["port"]["level"]["type"].as<std::string>())),
+            4);
+        /* The defaults stay on the module itself */
+        QCOMPARE(
+            QSocWidthEvaluator::typeWidth(
+                QString::fromStdString(moduleYaml["port"]["dout"]["type"].as<std::string>())),
+            8);
+
+        messageList.clear();
+        QSocCliWorker invalidWorker;
+        QCOMPARE(
+            invalidWorker.execute(
+                {"qsoc", "module", "import", "-G", "test_module_param", testFilePath}),
+            1);
+        QVERIFY(messageListContains("invalid parameterization"));
+    }
+
     /* Test module list command */
     void testModuleList()
     {
@@ -637,9 +848,130 @@ private slots:
         const bool hasModuleStill = moduleManager.isModuleExist("test_module_remove_api");
         QVERIFY(!hasModuleStill);
     }
+
+    void testConcurrentLibrarySave()
+    {
+        /* One library shared by two processes, each loaded it before the other saved */
+        const QString filePath
+            = QDir(projectManager.getModulePath()).filePath("test_shared_lib.soc_mod");
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream stream(&file);
+        for (const QString &moduleName : QStringList{"shared_a", "shared_b", "shared_c"}) {
+            stream << moduleName << ":\n"
+                   << "  port:\n    clk:\n      direction: input\n      type: logic\n";
+        }
+        file.close();
+
+        QSocModuleManager firstManager(nullptr, &projectManager);
+        QSocModuleManager secondManager(nullptr, &projectManager);
+        QVERIFY(firstManager.load(QString("test_shared_lib")));
+        QVERIFY(secondManager.load(QString("test_shared_lib")));
+
+        YAML::Node firstYaml = YAML::Clone(firstManager.getModuleYaml(QString("shared_a")));
+        firstYaml["bus"]["first"]["bus"] = "first_bus";
+        QVERIFY(firstManager.updateModuleYaml("shared_a", firstYaml));
+
+        YAML::Node secondYaml = YAML::Clone(secondManager.getModuleYaml(QString("shared_b")));
+        secondYaml["bus"]["second"]["bus"] = "second_bus";
+        QVERIFY(secondManager.updateModuleYaml("shared_b", secondYaml));
+        QVERIFY(secondManager.removeModule(QRegularExpression("shared_c")));
+
+        /* The second save kept the first one and took it over */
+        const YAML::Node takenYaml = secondManager.getModuleYaml(QString("shared_a"));
+        QVERIFY(takenYaml["bus"]["first"]);
+        QVERIFY(!QFile::exists(filePath + ".lock"));
+
+        QSocModuleManager checkManager(nullptr, &projectManager);
+        QVERIFY(checkManager.load(QString("test_shared_lib")));
+        const YAML::Node checkFirstYaml  = checkManager.getModuleYaml(QString("shared_a"));
+        const YAML::Node checkSecondYaml = checkManager.getModuleYaml(QString("shared_b"));
+        QVERIFY(checkFirstYaml["bus"]["first"]);
+        QVERIFY(checkSecondYaml["bus"]["second"]);
+        QVERIFY(!checkManager.isModuleExist("shared_c"));
+    }
+
+    void testConcurrentLibrarySaveThreads()
+    {
+        /* Managers saving at the same time, each waits for the lock of the others */
+        const int   jobs = 8;
+        QStringList nameList;
+        for (int job = 0; job < jobs; ++job) {
+            nameList << QString("parallel_%1").arg(job);
+        }
+        const QString filePath = writeModuleLibrary("test_parallel_lib", nameList);
+
+        std::vector<std::unique_ptr<QSocModuleManager>> managerList;
+        for (int job = 0; job < jobs; ++job) {
+            managerList.push_back(std::make_unique<QSocModuleManager>(nullptr, &projectManager));
+            QVERIFY(managerList.back()->load(QString("test_parallel_lib")));
+        }
+
+        std::vector<char> savedList(jobs, 0);
+        QThreadPool       pool;
+        pool.setMaxThreadCount(jobs);
+        for (int job = 0; job < jobs; ++job) {
+            pool.start([&, job]() {
+                QSocModuleManager *manager    = managerList[job].get();
+                const QString     &moduleName = nameList.at(job);
+                YAML::Node         moduleYaml = YAML::Clone(manager->getModuleYaml(moduleName));
+                moduleYaml["bus"]["job"]["bus"] = moduleName.toStdString();
+
+                savedList[job] = manager->updateModuleYaml(moduleName, moduleYaml) ? 1 : 0;
+            });
+        }
+        pool.waitForDone();
+
+        QSocModuleManager checkManager(nullptr, &projectManager);
+        QVERIFY(checkManager.load(QString("test_parallel_lib")));
+        for (int job = 0; job < jobs; ++job) {
+            QVERIFY(savedList[job]);
+            QVERIFY(checkManager.getModuleYaml(nameList.at(job))["bus"]["job"]);
+        }
+        QVERIFY(!QFile::exists(filePath + ".lock"));
+    }
+
+    void testCachedLibrarySeesSameTimeRewrite()
+    {
+        /* Another process rewrites the library within the timestamp resolution */
+        const QString filePath = writeModuleLibrary("test_digest_lib", {"digest_a", "digest_b"});
+
+        QSocModuleManager cachedManager(nullptr, &projectManager);
+        cachedManager.setLibraryCache(true);
+        QVERIFY(cachedManager.load(QString("test_digest_lib")));
+
+        const auto rewriteSameTime = [&filePath, this](const QStringList &moduleNameList) {
+            const QDateTime lastModified = QFileInfo(filePath).lastModified();
+            writeModuleLibrary("test_digest_lib", moduleNameList);
+            QFile file(filePath);
+            if (file.open(QIODevice::ReadWrite)) {
+                file.setFileTime(lastModified, QFileDevice::FileModificationTime);
+                file.close();
+            }
+        };
+
+        /* Same size and time, a save still merges the other change */
+        rewriteSameTime({"digest_a", "digest_x"});
+        YAML::Node moduleYaml = YAML::Clone(cachedManager.getModuleYaml(QString("digest_a")));
+        moduleYaml["bus"]["cached"]["bus"] = "cached_bus";
+        QVERIFY(cachedManager.updateModuleYaml("digest_a", moduleYaml));
+        QVERIFY(cachedManager.isModuleExist("digest_x"));
+
+        QSocModuleManager checkManager(nullptr, &projectManager);
+        QVERIFY(checkManager.load(QString("test_digest_lib")));
+        QVERIFY(checkManager.getModuleYaml(QString("digest_a"))["bus"]["cached"]);
+        QVERIFY(checkManager.isModuleExist("digest_x"));
+
+        /* And a load replaces the resident copy */
+        rewriteSameTime({"digest_a", "digest_y"});
+        QVERIFY(cachedManager.load(QString("test_digest_lib")));
+        QVERIFY(cachedManager.isModuleExist("digest_y"));
+        QVERIFY(!cachedManager.isModuleExist("digest_x"));
+    }
 };
 
 QStringList Test::messageList;
+QMutex      Test::messageMutex;
 
 QSOC_TEST_MAIN(Test)
 
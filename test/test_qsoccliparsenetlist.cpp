@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "cli/qsoccliworker.h"
+#include "common/config.h"
+#include "common/qsocprojectmanager.h"
+#include "qsoc_test.h"
+
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+#include <QtCore>
+#include <QtTest>
+
+struct TestApp
+{
+    static auto &instance()
+    {
+        static auto                  argc      = 1;
+        static char                  appName[] = "qsoc";
+        static std::array<char *, 1> argv      = {{appName}};
+        /* Use QCoreApplication for cli test */
+        static const QCoreApplication app = QCoreApplication(argc, argv.data());
+        return app;
+    }
+};
+
+class Test : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList messageList;
+    QString            projectName;
+    QSocProjectManager projectManager;
+    QString            netlistPath;
+
+    static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+    {
+        Q_UNUSED(type);
+        Q_UNUSED(context);
+        messageList << msg;
+    }
+
+    QString createTempFile(const QString &filePath, const QString &content)
+    {
+        QFile file(filePath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream stream(&file);
+            stream << content;
+            file.close();
+        }
+        return filePath;
+    }
+
+    void createTestFiles()
+    {
+        createTempFile(QDir(projectManager.getModulePath()).filePath("trace_cells.soc_mod"), R"(
+trace_src:
+  port:
+    clk:
+      type: logic
+      direction: in
+    dout:
+      type: logic[7:0]
+      direction: out
+trace_mid:
+  port:
+    clk:
+      type: logic
+      direction: in
+    din:
+      type: logic[7:0]
+      direction: in
+    dout:
+      type: logic[7:0]
+      direction: out
+trace_dst:
+  port:
+    din:
+      type: logic[7:0]
+      direction: in
+    dout:
+      type: logic[7:0]
+      direction: out
+)");
+
+        netlistPath = createTempFile(
+            QDir(projectManager.getOutputPath()).filePath("trace_top.soc_net"), R"(
+port:
+  clk:
+    direction: input
+    type: logic
+  result:
+    direction: output
+    type: logic[7:0]
+instance:
+  u_src:
+    module: trace_src
+    port:
+      clk:
+        link: clk
+      dout:
+        link: stage0
+  u_mid:
+    module: trace_mid
+    port:
+      clk:
+        link: clk
+      din:
+        link: stage0
+      dout:
+        link: stage1
+  u_dst:
+    module: trace_dst
+    port:
+      din:
+        link: stage1
+      dout:
+        link: result
+)");
+    }
+
+    /* Run a trace query and return everything it printed */
+    QString runTrace(const QStringList &queryArguments)
+    {
+        messageList.clear();
+        QSocCliWorker socCliWorker;
+        QStringList   appArguments
+            = {"qsoc", "netlist", "trace", "-d", projectManager.getCurrentPath(), netlistPath};
+        appArguments << queryArguments;
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+        return messageList.join("\n");
+    }
+
+private slots:
+    void initTestCase()
+    {
+        TestApp::instance();
+        /* Re-enable message handler for collecting CLI output */
+        qInstallMessageHandler(messageOutput);
+        /* Set project name */
+        projectName = QFileInfo(__FILE__).baseName() + "_data";
+        /* Setup project manager */
+        projectManager.setProjectName(projectName);
+        projectManager.setCurrentPath(QDir::current().filePath(projectName));
+        projectManager.mkpath();
+        projectManager.save(projectName);
+        projectManager.load(projectName);
+        /* Create test files */
+        createTestFiles();
+    }
+
+    void cleanupTestCase()
+    {
+#ifdef ENABLE_TEST_CLEANUP
+        /* Clean up the test project directory */
+        QDir projectDir(projectManager.getCurrentPath());
+        if (projectDir.exists()) {
+            projectDir.removeRecursively();
+        }
+#endif // ENABLE_TEST_CLEANUP
+    }
+
+    void testNetlistTraceHelp()
+    {
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments = {"qsoc", "netlist", "trace", "--help"};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* Just verify the command doesn't crash */
+        QVERIFY(true);
+    }
+
+    void testNetlistTraceDriver()
+    {
+        const QString output = runTrace({"driver", "stage1"});
+        QVERIFY(output.contains("stage1 <- u_mid.dout"));
+
+        /* Top-level inputs drive their nets */
+        QVERIFY(runTrace({"driver", "u_src.clk"}).contains("clk <- top.clk"));
+    }
+
+    void testNetlistTraceFanout()
+    {
+        const QString output = runTrace({"fanout", "u_src.dout", "--depth", "3"});
+        QVERIFY(output.contains("1 stage0 -> u_mid.din"));
+        QVERIFY(output.contains("2 stage1 -> u_dst.din"));
+        QVERIFY(output.contains("3 result -> top.result"));
+
+        /* One level by default */
+        QVERIFY(!runTrace({"fanout", "u_src.dout"}).contains("2 stage1 -> u_dst.din"));
+    }
+
+    void testNetlistTraceFanin()
+    {
+        const QString output = runTrace({"fanin", "result", "--depth", "2"});
+        QVERIFY(output.contains("1 result <- u_dst.dout"));
+        QVERIFY(output.contains("2 stage1 <- u_mid.dout"));
+        QVERIFY(!output.contains("stage0 <- u_src.dout"));
+    }
+
+    void testNetlistTracePath()
+    {
+        const QString output = runTrace({"path", "clk", "result"});
+        QVERIFY(output.contains(
+            "clk -> u_mid.clk -> u_mid.dout -> stage1 -> u_dst.din -> u_dst.dout -> result"));
+
+        /* Paths follow the signal flow */
+        QVERIFY(runTrace({"path", "result", "clk"}).contains("Error: no path"));
+    }
+
+    void testNetlistTraceBits()
+    {
+        const QString output = runTrace({"bits", "stage0"});
+        QVERIFY(output.contains("[7:0] driver u_src.dout"));
+        QVERIFY(output.contains("[7:0] load u_mid.din"));
+        QVERIFY(!output.contains("] undriven"));
+    }
+
+    void testNetlistTraceSubNetlist()
+    {
+        const QDir outputDir(projectManager.getOutputPath());
+        createTempFile(outputDir.filePath("trace_sub.soc_net"), R"(
+port:
+  din:
+    direction: input
+    type: logic[7:0]
+  dout:
+    direction: output
+    type: logic[7:0]
+instance:
+  u_dst:
+    module: trace_dst
+    port:
+      din:
+        link: din
+      dout:
+        link: dout
+)");
+        const QString hierPath = createTempFile(outputDir.filePath("trace_hier.soc_net"), R"(
+port:
+  clk:
+    direction: input
+    type: logic
+instance:
+  u_src:
+    module: trace_src
+    port:
+      clk:
+        link: clk
+      dout:
+        link: stage0
+  u_sub:
+    netlist: trace_sub.soc_net
+    port:
+      din:
+        link: stage0
+)");
+        QFile::remove(outputDir.filePath("trace_sub.v"));
+
+        messageList.clear();
+        QSocCliWorker     socCliWorker;
+        const QStringList appArguments
+            = {"qsoc",
+               "netlist",
+               "trace",
+               "-d",
+               projectManager.getCurrentPath(),
+               hierPath,
+               "fanout",
+               "u_src.dout"};
+        socCliWorker.setup(appArguments, false);
+        socCliWorker.run();
+
+        /* The sub-netlist is expanded for its ports, but a query writes nothing */
+        QVERIFY(messageList.join("\n").contains("stage0 -> u_sub.din"));
+        QVERIFY(!QFile::exists(outputDir.filePath("trace_sub.v")));
+    }
+
+    void testNetlistTraceErrors()
+    {
+        QVERIFY(runTrace({"fanout", "missing"}).contains("Error: unknown net, pin or instance"));
+        QVERIFY(runTrace({"sideways", "stage0"}).contains("Error: unknown query"));
+        QVERIFY(runTrace({"path", "clk"}).contains("Error: missing path end target"));
+        QVERIFY(runTrace({"fanout", "clk", "--depth", "0"}).contains("Error: invalid depth"));
+    }
+};
+
+QStringList Test::messageList;
+
+QSOC_TEST_MAIN(Test)
+
+#include "test_qsoccliparsenetlist.moc"
@@ -1,8 +1,15 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: 2023-2025 Huang Rui <vowstar@gmail.com>
 
+#include "cli/qsoccliserver.h"
 #include "cli/qsoccliworker.h"
 #include "common/config.h"
+#include "common/qllmservice.h"
+#include "common/qsocbusmanager.h"
+#include "common/qsocconfig.h"
+#include "common/qsocgeneratemanager.h"
+#include "common/qsocmodulemanager.h"
+#include "common/qsocprojectmanager.h"
 #include "qsoc_test.h"
 
 #include <QStringList>
@@ -10,7 +17,10 @@
 #include <QtCore>
 #include <QtTest>
 
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 struct TestApp
 {
@@ -136,6 +146,132 @@ private slots:
         QCOMPARE(messageList.count(), 1);
         QVERIFY(messageList.first().contains("QSoC " QSOC_VERSION));
     }
+
+    void residentExecuteVersion()
+    {
+        messageList.clear();
+        int exitCode = -1;
+        {
+            QSocCliWorker socCliWorker(nullptr, QSocCliWorker::Managers());
+            exitCode = socCliWorker.execute({"qsoc", "--version"});
+        }
+
+        QCOMPARE(exitCode, 0);
+        QCOMPARE(messageList.count(), 1);
+        QVERIFY(messageList.first().contains("QSoC " QSOC_VERSION));
+    }
+
+    void residentRejectInteractive()
+    {
+        const QStringList commandList = {"gui", "agent", "serve"};
+        for (const QString &command : commandList) {
+            messageList.clear();
+            QSocCliWorker socCliWorker(nullptr, QSocCliWorker::Managers());
+            QCOMPARE(socCliWorker.execute({"qsoc", command}), 1);
+            QVERIFY(messageList.first().contains("not available in daemon or batch mode"));
+        }
+    }
+
+    void residentLibraryReload()
+    {
+        /* Project with one module library */
+        const QString      projectName = QFileInfo(__FILE__).baseName() + "_data";
+        QSocProjectManager setupProject;
+        setupProject.setProjectName(projectName);
+        setupProject.setCurrentPath(QDir::current().filePath(projectName));
+        QVERIFY(setupProject.mkpath());
+        QVERIFY(setupProject.save(projectName));
+        const QString projectPath = setupProject.getCurrentPath();
+        const QString libraryPath
+            = QDir(setupProject.getModulePath()).filePath("resident.soc_mod");
+        auto writeLibrary = [&libraryPath](const QByteArray &content) {
+            QFile file(libraryPath);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            file.write(content);
+        };
+        writeLibrary("resident_a:\n  port: {}\n");
+
+        /* Managers set up like the daemon, each command gets a new project */
+        std::vector<std::unique_ptr<QSocProjectManager>> projectList;
+        projectList.push_back(std::make_unique<QSocProjectManager>());
+        QSocConfig          socConfig(nullptr, projectList.back().get());
+        QLLMService         llmService(nullptr, &socConfig);
+        QSocBusManager      busManager(nullptr, projectList.back().get());
+        QSocModuleManager   moduleManager(nullptr, projectList.back().get(), &busManager, &llmService);
+        QSocGenerateManager generateManager(
+            nullptr, projectList.back().get(), &moduleManager, &busManager);
+        busManager.setLibraryCache(true);
+        moduleManager.setLibraryCache(true);
+        QSocCliWorker::Managers managers;
+        managers.socConfig       = &socConfig;
+        managers.llmService      = &llmService;
+        managers.busManager      = &busManager;
+        managers.moduleManager   = &moduleManager;
+        managers.generateManager = &generateManager;
+        auto listModules         = [&]() {
+            messageList.clear();
+            projectList.push_back(std::make_unique<QSocProjectManager>());
+            managers.attachProject(projectList.back().get());
+            QSocCliWorker worker(nullptr, managers);
+            return worker.execute({"qsoc", "module", "list", "-d", projectPath});
+        };
+
+        QCOMPARE(listModules(), 0);
+        QVERIFY(messageList.join("\n").contains("resident_a"));
+        const YAML::Node resident = moduleManager.getModuleYaml("resident_a");
+        QVERIFY(resident.IsMap());
+
+        /* An unchanged library is not parsed again */
+        QCOMPARE(listModules(), 0);
+        QVERIFY(messageList.join("\n").contains("resident_a"));
+        QVERIFY(moduleManager.getModuleYaml("resident_a").is(resident));
+
+        /* A changed library replaces the resident copy */
+        writeLibrary("resident_b:\n  port: {}\n");
+        QCOMPARE(listModules(), 0);
+        QVERIFY(messageList.join("\n").contains("resident_b"));
+        QVERIFY(!messageList.join("\n").contains("resident_a"));
+        QVERIFY(moduleManager.isModuleExist("resident_b"));
+        QVERIFY(!moduleManager.isModuleExist("resident_a"));
+
+        QDir(projectPath).removeRecursively();
+    }
+
+    void serveForwardExitCode()
+    {
+        const QString serverName
+            = QString("qsoc-test-%1.sock").arg(QCoreApplication::applicationPid());
+        QSocCliServer server;
+        QVERIFY(server.listen(serverName));
+        /* A second daemon must not take over the socket */
+        QSocCliServer other;
+        QVERIFY(!other.listen(serverName));
+
+        const QList<QPair<QStringList, int>> caseList = {
+            {{"qsoc", "--version"}, 0},
+            {{"qsoc", "--verbose=10"}, 1},
+        };
+        for (const auto &item : caseList) {
+            messageList.clear();
+            std::atomic<bool> done{false};
+            int               exitCode  = -1;
+            bool              forwarded = false;
+            QThread          *client    = QThread::create([&]() {
+                forwarded = QSocCliServer::forward(serverName, item.first, exitCode);
+                done      = true;
+            });
+            client->start();
+            QTRY_VERIFY_WITH_TIMEOUT(done, 10000);
+            client->wait();
+            delete client;
+            QVERIFY(forwarded);
+            QCOMPARE(exitCode, item.second);
+        }
+
+        /* Unreachable daemons fall back to local execution */
+        int exitCode = -1;
+        QVERIFY(!QSocCliServer::forward(serverName + ".missing", {"qsoc", "-v"}, exitCode));
+    }
 };
 
 QStringList Test::messageList;
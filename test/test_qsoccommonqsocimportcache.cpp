@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocimportcache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+class TestQSocImportCache : public QObject
+{
+    Q_OBJECT
+
+private:
+    static bool writeFile(const QString &filePath, const QByteArray &content)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return false;
+        }
+        return file.write(content) == content.size();
+    }
+
+    static QSocImportCache::Entry entry(const QString &moduleName)
+    {
+        QSocImportCache::Entry result;
+        result.moduleList.append(moduleName);
+        result.descriptorMap[moduleName.toStdString()]["port"]["clk"]["direction"] = "input";
+        return result;
+    }
+
+private slots:
+    void unitKey();
+    void storeLookup();
+    void changedInclude();
+    void persistent();
+};
+
+void TestQSocImportCache::unitKey()
+{
+    const QStringList sourceList{"a.v", "b.v"};
+    const QString     key = QSocImportCache::unitKey(sourceList, {"WIDTH=8"}, {});
+
+    QCOMPARE(key.size(), 64);
+    QCOMPARE(QSocImportCache::unitKey(sourceList, {"WIDTH=8"}, {}), key);
+    QVERIFY(QSocImportCache::unitKey(sourceList, {"WIDTH=16"}, {}) != key);
+    QVERIFY(QSocImportCache::unitKey(sourceList, {}, {"WIDTH"}) != key);
+    QVERIFY(QSocImportCache::unitKey({"b.v", "a.v"}, {"WIDTH=8"}, {}) != key);
+    /* A relative source is the same unit as its absolute path */
+    QCOMPARE(
+        QSocImportCache::unitKey({QDir::current().filePath("a.v"), "b.v"}, {"WIDTH=8"}, {}), key);
+    /* So is a relative include directory */
+    const QString incdirPath = QDir::current().filePath("inc");
+    const QString rtlPath    = QDir::current().filePath("rtl");
+    QCOMPARE(
+        QSocImportCache::unitKey({"+incdir+inc+" + rtlPath, "a.v"}, {}, {}),
+        QSocImportCache::unitKey({"+incdir+" + incdirPath + "+rtl", "a.v"}, {}, {}));
+
+    /* The working directory is part of the key, relative options depend on it */
+    const QString currentPath = QDir::currentPath();
+    QTemporaryDir otherDir;
+    QVERIFY(otherDir.isValid());
+    QVERIFY(QDir::setCurrent(otherDir.path()));
+    const QString otherKey = QSocImportCache::unitKey(
+        {currentPath + "/a.v", currentPath + "/b.v"}, {"WIDTH=8"}, {});
+    QVERIFY(QDir::setCurrent(currentPath));
+    QVERIFY(otherKey != key);
+}
+
+void TestQSocImportCache::storeLookup()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString sourcePath = tempDir.filePath("top.v");
+    QVERIFY(writeFile(sourcePath, "module top(input clk); endmodule\n"));
+
+    QSocImportCache        cache;
+    const QString          key = QSocImportCache::unitKey({sourcePath}, {}, {});
+    QSocImportCache::Entry result;
+    QVERIFY(!cache.lookup(key, result));
+    QVERIFY(cache.store(key, {sourcePath}, entry("top")));
+    QVERIFY(cache.lookup(key, result));
+    QCOMPARE(result.moduleList, QStringList{"top"});
+    QCOMPARE(result.descriptorMap["top"]["port"]["clk"]["direction"].as<std::string>(), "input");
+
+    /* A file that cannot be hashed is not stored */
+    QVERIFY(!cache.store(key, {tempDir.filePath("missing.v")}, entry("top")));
+}
+
+void TestQSocImportCache::changedInclude()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString sourcePath  = tempDir.filePath("top.v");
+    const QString includePath = tempDir.filePath("defs.vh");
+    QVERIFY(writeFile(sourcePath, "`include \"defs.vh\"\nmodule top; endmodule\n"));
+    QVERIFY(writeFile(includePath, "`define WIDTH 8\n"));
+
+    QSocImportCache        cache;
+    const QString          key = QSocImportCache::unitKey({sourcePath}, {}, {});
+    QSocImportCache::Entry result;
+    QVERIFY(cache.store(key, {sourcePath, includePath}, entry("top")));
+    QVERIFY(cache.lookup(key, result));
+
+    /* A different size changes the stamp even within the same second */
+    QVERIFY(writeFile(includePath, "`define WIDTH 16\n"));
+    QVERIFY(!cache.lookup(key, result));
+}
+
+void TestQSocImportCache::persistent()
+{
+    QTemporaryDir sourceDir;
+    QTemporaryDir cacheDir;
+    QVERIFY(sourceDir.isValid());
+    QVERIFY(cacheDir.isValid());
+    const QString sourcePath = sourceDir.filePath("top.v");
+    QVERIFY(writeFile(sourcePath, "module top(input clk); endmodule\n"));
+    const QString key = QSocImportCache::unitKey({sourcePath}, {}, {});
+
+    {
+        QSocImportCache cache(cacheDir.path());
+        QVERIFY(cache.store(key, {sourcePath}, entry("top")));
+    }
+    QVERIFY(QFile::exists(QDir(cacheDir.path()).filePath(key + ".yml")));
+
+    /* A new instance reads the record written by the first one */
+    QSocImportCache        cache(cacheDir.path());
+    QSocImportCache::Entry result;
+    QVERIFY(cache.lookup(key, result));
+    QCOMPARE(result.moduleList, QStringList{"top"});
+    QCOMPARE(result.descriptorMap["top"]["port"]["clk"]["direction"].as<std::string>(), "input");
+
+    /* Memory only caches do not see it */
+    QSocImportCache memoryCache;
+    QVERIFY(!memoryCache.lookup(key, result));
+}
+
+QTEST_APPLESS_MAIN(TestQSocImportCache)
+#include "test_qsoccommonqsocimportcache.moc"
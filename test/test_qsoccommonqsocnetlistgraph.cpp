@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocnetlistgraph.h"
+
+#include <QtTest>
+
+class TestQSocNetlistGraph : public QObject
+{
+    Q_OBJECT
+
+private:
+    using Direction = QSocNetlistGraph::Direction;
+
+    /* clk -> u_src -> stage0 -> u_mid -> stage1 -> u_dst -> result, u_mon taps stage0 */
+    static QSocNetlistGraph pipeline()
+    {
+        QSocNetlistGraph graph;
+        graph.addPin("clk", "top", "clk", Direction::Output, QString(), 1);
+        graph.addPin("clk", "u_src", "clk", Direction::Input, QString(), 1);
+        graph.addPin("clk", "u_mid", "clk", Direction::Input, QString(), 1);
+        graph.addPin("stage0", "u_src", "dout", Direction::Output, QString(), 8);
+        graph.addPin("stage0", "u_mid", "din", Direction::Input, QString(), 8);
+        graph.addPin("stage0", "u_mon", "probe", Direction::Input, QString(), 8);
+        graph.addPin("stage1", "u_mid", "dout", Direction::Output, QString(), 8);
+        graph.addPin("stage1", "u_dst", "din", Direction::Input, QString(), 8);
+        graph.addPin("result", "u_dst", "dout", Direction::Output, QString(), 8);
+        graph.addPin("result", "top", "result", Direction::Input, QString(), 8);
+        return graph;
+    }
+
+private slots:
+    void counts();
+    void contains();
+    void drivers();
+    void fanoutDepth();
+    void faninDepth();
+    void pathBetween();
+    void pathMissing();
+    void bitSlices();
+    void largeChain();
+    void queryByName();
+};
+
+void TestQSocNetlistGraph::counts()
+{
+    const QSocNetlistGraph graph = pipeline();
+    QCOMPARE(graph.netCount(), 4);
+    QCOMPARE(graph.pinCount(), 10);
+}
+
+void TestQSocNetlistGraph::contains()
+{
+    const QSocNetlistGraph graph = pipeline();
+    QVERIFY(graph.contains("stage0"));
+    QVERIFY(graph.contains("u_mid.din"));
+    QVERIFY(graph.contains("u_mid"));
+    QVERIFY(graph.contains("top"));
+    QVERIFY(!graph.contains("u_mid.missing"));
+    QVERIFY(!graph.contains("missing"));
+}
+
+void TestQSocNetlistGraph::drivers()
+{
+    const QSocNetlistGraph graph = pipeline();
+    QCOMPARE(graph.drivers("stage1"), QStringList{"stage1 <- u_mid.dout"});
+    QCOMPARE(graph.drivers("u_dst.din"), QStringList{"stage1 <- u_mid.dout"});
+    /* An instance reads clk and stage0 */
+    QCOMPARE(graph.drivers("u_mid"), QStringList({"clk <- top.clk", "stage0 <- u_src.dout"}));
+
+    QSocNetlistGraph floating;
+    floating.addPin("float", "u_a", "din", Direction::Input);
+    QCOMPARE(floating.drivers("float"), QStringList{"float undriven"});
+}
+
+void TestQSocNetlistGraph::fanoutDepth()
+{
+    const QSocNetlistGraph graph = pipeline();
+    QCOMPARE(
+        graph.fanout("stage0"), QStringList({"1 stage0 -> u_mid.din", "1 stage0 -> u_mon.probe"}));
+    QCOMPARE(
+        graph.fanout("u_src.dout", 3),
+        QStringList(
+            {"1 stage0 -> u_mid.din",
+             "1 stage0 -> u_mon.probe",
+             "2 stage1 -> u_dst.din",
+             "3 result -> top.result"}));
+    /* The clock reaches both registers, and through them the rest */
+    QCOMPARE(graph.fanout("clk").size(), 2);
+    QCOMPARE(graph.fanout("clk", 10).size(), 6);
+}
+
+void TestQSocNetlistGraph::faninDepth()
+{
+    const QSocNetlistGraph graph = pipeline();
+    QCOMPARE(graph.fanin("result"), QStringList{"1 result <- u_dst.dout"});
+    QCOMPARE(
+        graph.fanin("top.result", 3),
+        QStringList(
+            {"1 result <- u_dst.dout",
+             "2 stage1 <- u_mid.dout",
+             "3 clk <- top.clk",
+             "3 stage0 <- u_src.dout"}));
+}
+
+void TestQSocNetlistGraph::pathBetween()
+{
+    const QSocNetlistGraph graph = pipeline();
+    QCOMPARE(
+        graph.path("stage0", "result"),
+        QStringList(
+            {"stage0", "u_mid.din", "u_mid.dout", "stage1", "u_dst.din", "u_dst.dout", "result"}));
+    QCOMPARE(
+        graph.path("u_src", "u_dst.din"),
+        QStringList({"u_src", "stage0", "u_mid.din", "u_mid.dout", "stage1", "u_dst.din"}));
+    QCOMPARE(graph.path("clk", "u_mid").size(), 2);
+}
+
+void TestQSocNetlistGraph::pathMissing()
+{
+    const QSocNetlistGraph graph = pipeline();
+    /* Paths follow the signal flow only */
+    QVERIFY(graph.path("result", "stage0").isEmpty());
+    QVERIFY(graph.path("u_mon", "result").isEmpty());
+    QVERIFY(graph.path("stage0", "missing").isEmpty());
+}
+
+void TestQSocNetlistGraph::bitSlices()
+{
+    QSocNetlistGraph graph;
+    graph.addPin("bus", "u_lo", "dout", Direction::Output, "[3:0]", 4);
+    graph.addPin("bus", "u_hi", "dout", Direction::Output, "[5:4]", 2);
+    graph.addPin("bus", "u_ov", "dout", Direction::Output, "[5]", 1);
+    graph.addPin("bus", "u_load", "din", Direction::Input, QString(), 8);
+    graph.addPin("bus", "u_any", "din", Direction::Input, QString(), 0);
+
+    QCOMPARE(
+        graph.bitSlices("bus"),
+        QStringList(
+            {"[3:0] driver u_lo.dout[3:0]",
+             "[5:4] driver u_hi.dout[5:4]",
+             "[5] driver u_ov.dout[5]",
+             "[7:0] load u_load.din",
+             "[?] load u_any.din",
+             "[5] multiple drivers",
+             "[7:6] undriven"}));
+    QVERIFY(graph.bitSlices("u_lo").isEmpty());
+}
+
+void TestQSocNetlistGraph::largeChain()
+{
+    /* A 10k net chain, every query visits each net once */
+    const int        length = 10000;
+    QSocNetlistGraph graph;
+    for (int index = 0; index < length; ++index) {
+        const QString instance = QString("u_buf%1").arg(index);
+        graph.addPin(QString("n%1").arg(index), instance, "a", Direction::Input);
+        graph.addPin(QString("n%1").arg(index + 1), instance, "y", Direction::Output);
+    }
+    QCOMPARE(graph.netCount(), length + 1);
+
+    const QStringList path = graph.path("n0", QString("n%1").arg(length));
+    QCOMPARE(path.size(), 3 * length + 1);
+    QCOMPARE(graph.fanout("n0", length).size(), length);
+    QCOMPARE(graph.fanin(QString("n%1").arg(length), length).size(), length);
+}
+
+void TestQSocNetlistGraph::queryByName()
+{
+    using QueryStatus = QSocNetlistGraph::QueryStatus;
+
+    const QSocNetlistGraph graph = pipeline();
+    QStringList            result;
+    QCOMPARE(graph.query("driver", "stage1", QString(), 1, result), QueryStatus::Ok);
+    QCOMPARE(result, graph.drivers("stage1"));
+    QCOMPARE(graph.query("fanout", "stage0", QString(), 2, result), QueryStatus::Ok);
+    QCOMPARE(result, graph.fanout("stage0", 2));
+    QCOMPARE(graph.query("fanin", "result", QString(), 2, result), QueryStatus::Ok);
+    QCOMPARE(result, graph.fanin("result", 2));
+    QCOMPARE(graph.query("path", "stage0", "result", 1, result), QueryStatus::Ok);
+    QCOMPARE(result, QStringList{graph.path("stage0", "result").join(" -> ")});
+    QCOMPARE(graph.query("bits", "stage0", QString(), 1, result), QueryStatus::Ok);
+    QCOMPARE(result, graph.bitSlices("stage0"));
+
+    QCOMPARE(graph.query("loads", "stage0", QString(), 1, result), QueryStatus::UnknownQuery);
+    QCOMPARE(graph.query("driver", "missing", QString(), 1, result), QueryStatus::UnknownTarget);
+    QCOMPARE(
+        graph.query("path", "stage0", "missing", 1, result), QueryStatus::UnknownEndTarget);
+    QCOMPARE(graph.query("path", "result", "stage0", 1, result), QueryStatus::NoPath);
+    QCOMPARE(graph.query("bits", "u_mid", QString(), 1, result), QueryStatus::NotNet);
+    QVERIFY(result.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestQSocNetlistGraph)
+#include "test_qsoccommonqsocnetlistgraph.moc"
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocwidthevaluator.h"
+
+#include <QtTest>
+
+class TestQSocWidthEvaluator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void evaluate_data();
+    void evaluate();
+    void evaluate_invalid_data();
+    void evaluate_invalid();
+    void typeWidth_data();
+    void typeWidth();
+    void resolveParameters_defaults();
+    void resolveParameters_overrides();
+    void parameterKey();
+};
+
+void TestQSocWidthEvaluator::evaluate_data()
+{
+    QTest::addColumn<QString>("expression");
+    QTest::addColumn<qint64>("expected");
+
+    QTest::newRow("decimal") << "42" << qint64(42);
+    QTest::newRow("underscore") << "1_000" << qint64(1000);
+    QTest::newRow("sizedHex") << "8'hff" << qint64(255);
+    QTest::newRow("unsizedDecimal") << "'d12" << qint64(12);
+    QTest::newRow("sizedBinary") << "4'b1010" << qint64(10);
+    QTest::newRow("truncated") << "4'hff" << qint64(15);
+    QTest::newRow("parameter") << "DATA_W" << qint64(32);
+    QTest::newRow("minusOne") << "DATA_W-1" << qint64(31);
+    QTest::newRow("precedence") << "2 + 3 * 4" << qint64(14);
+    QTest::newRow("parentheses") << "(2 + 3) * 4" << qint64(20);
+    QTest::newRow("power") << "2 ** 10" << qint64(1024);
+    QTest::newRow("shift") << "1 << DEPTH_LOG" << qint64(16);
+    QTest::newRow("divide") << "DATA_W / 8" << qint64(4);
+    QTest::newRow("modulo") << "DATA_W % 5" << qint64(2);
+    QTest::newRow("unaryMinus") << "-DATA_W + 40" << qint64(8);
+    QTest::newRow("logicalNot") << "!0" << qint64(1);
+    QTest::newRow("compare") << "DATA_W >= 32" << qint64(1);
+    QTest::newRow("equality") << "DATA_W != 32" << qint64(0);
+    QTest::newRow("bitwise") << "12 & 10 | 1" << qint64(9);
+    QTest::newRow("ternary") << "DATA_W > 16 ? 2 : 1" << qint64(2);
+    QTest::newRow("nestedTernary") << "0 ? 1 : 0 ? 2 : 3" << qint64(3);
+    QTest::newRow("clog2") << "$clog2(DEPTH)" << qint64(4);
+    QTest::newRow("clog2Round") << "$clog2(17)" << qint64(5);
+    QTest::newRow("clog2One") << "$clog2(1)" << qint64(0);
+    /* Invalid operands are fine when they are not used */
+    QTest::newRow("untakenBranch") << "ZERO == 0 ? 1 : 64 / ZERO" << qint64(1);
+    QTest::newRow("shortCircuit") << "0 && UNKNOWN" << qint64(0);
+}
+
+void TestQSocWidthEvaluator::evaluate()
+{
+    QFETCH(QString, expression);
+    QFETCH(qint64, expected);
+
+    const QSocWidthEvaluator::ParameterMap parameters
+        = {{"DATA_W", 32}, {"DEPTH", 16}, {"DEPTH_LOG", 4}, {"ZERO", 0}};
+    const std::optional<qint64> value = QSocWidthEvaluator::evaluate(expression, parameters);
+    QVERIFY(value.has_value());
+    QCOMPARE(*value, expected);
+}
+
+void TestQSocWidthEvaluator::evaluate_invalid_data()
+{
+    QTest::addColumn<QString>("expression");
+
+    QTest::newRow("empty") << "";
+    QTest::newRow("unknownName") << "WIDTH - 1";
+    QTest::newRow("divideByZero") << "8 / 0";
+    QTest::newRow("unbalanced") << "(8 - 1";
+    QTest::newRow("trailing") << "8 8";
+    QTest::newRow("unknownFunction") << "$bits(x)";
+    QTest::newRow("unknownBits") << "8'hxx";
+    QTest::newRow("missingElse") << "1 ? 2";
+}
+
+void TestQSocWidthEvaluator::evaluate_invalid()
+{
+    QFETCH(QString, expression);
+    QVERIFY(!QSocWidthEvaluator::evaluate(expression).has_value());
+}
+
+void TestQSocWidthEvaluator::typeWidth_data()
+{
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("singleBit") << "logic" << 1;
+    QTest::newRow("literalRange") << "logic[7:0]" << 8;
+    QTest::newRow("offsetRange") << "logic [15:8]" << 8;
+    QTest::newRow("ascending") << "logic[0:3]" << 4;
+    QTest::newRow("msbOnly") << "logic[5]" << 6;
+    QTest::newRow("parameterized") << "logic[DATA_W-1:0]" << 32;
+    QTest::newRow("clog2") << "reg [$clog2(DEPTH)-1:0]" << 4;
+    QTest::newRow("ternaryRange") << "logic[DATA_W > 8 ? 15 : 7:0]" << 16;
+    /* Unresolvable ranges are reported, not guessed */
+    QTest::newRow("unknown") << "logic[WIDTH-1:0]" << -1;
+}
+
+void TestQSocWidthEvaluator::typeWidth()
+{
+    QFETCH(QString, type);
+    QFETCH(int, expected);
+
+    const QSocWidthEvaluator::ParameterMap parameters = {{"DATA_W", 32}, {"DEPTH", 16}};
+    QCOMPARE(QSocWidthEvaluator::typeWidth(type, parameters).value_or(-1), expected);
+}
+
+void TestQSocWidthEvaluator::resolveParameters_defaults()
+{
+    /* Defaults may refer to parameters declared before them */
+    const YAML::Node defaults = YAML::Load(
+        "DATA_W: {type: integer, value: 8}\n"
+        "DEPTH: {type: integer, value: 16}\n"
+        "ADDR_W: {type: integer, value: $clog2(DEPTH)}\n"
+        "NAME: {type: string, value: '\"fifo\"'}\n");
+    const QSocWidthEvaluator::ParameterMap parameters = QSocWidthEvaluator::resolveParameters(
+        defaults);
+    QCOMPARE(parameters.value("DATA_W"), qint64(8));
+    QCOMPARE(parameters.value("ADDR_W"), qint64(4));
+    /* Values that are not constant integers are left out */
+    QVERIFY(!parameters.contains("NAME"));
+}
+
+void TestQSocWidthEvaluator::resolveParameters_overrides()
+{
+    const YAML::Node defaults = YAML::Load(
+        "DEPTH: {type: integer, value: 16}\n"
+        "ADDR_W: {type: integer, value: $clog2(DEPTH)}\n"
+        "DATA_W: {type: integer, value: 8}\n");
+    /* Overrides are evaluated in the parent scope */
+    const YAML::Node overrides = YAML::Load("DEPTH: 64\nDATA_W: BUS_W / 2\n");
+    const QSocWidthEvaluator::ParameterMap parameters
+        = QSocWidthEvaluator::resolveParameters(defaults, overrides, {{"BUS_W", 64}});
+    QCOMPARE(parameters.value("DEPTH"), qint64(64));
+    QCOMPARE(parameters.value("ADDR_W"), qint64(6));
+    QCOMPARE(parameters.value("DATA_W"), qint64(32));
+}
+
+void TestQSocWidthEvaluator::parameterKey()
+{
+    const QSocWidthEvaluator::ParameterMap first  = {{"WIDTH", 32}, {"DEPTH", 16}};
+    const QSocWidthEvaluator::ParameterMap second = {{"DEPTH", 16}, {"WIDTH", 32}};
+    const QSocWidthEvaluator::ParameterMap third  = {{"DEPTH", 16}, {"WIDTH", 8}};
+    QCOMPARE(QSocWidthEvaluator::parameterKey(first), QString("DEPTH=16,WIDTH=32"));
+    QCOMPARE(QSocWidthEvaluator::parameterKey(first), QSocWidthEvaluator::parameterKey(second));
+    QVERIFY(QSocWidthEvaluator::parameterKey(first) != QSocWidthEvaluator::parameterKey(third));
+}
+
+QTEST_APPLESS_MAIN(TestQSocWidthEvaluator)
+#include "test_qsoccommonqsocwidthevaluator.moc"
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2025 Huang Rui <vowstar@gmail.com>
+
+#include "common/qsocyamlutils.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+class TestQSocYamlUtils : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir tempDir;
+
+    QString createFile(const QString &fileName, const QByteArray &content)
+    {
+        const QString filePath = tempDir.filePath(fileName);
+        QFile         file(filePath);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(content);
+            file.close();
+        }
+        return filePath;
+    }
+
+private slots:
+    void loadFile_emptyFile();
+    void loadFile_missingFile();
+    void loadFile_parseError();
+    void saveFile_replace();
+    void saveFile_failureKeepsFile();
+};
+
+void TestQSocYamlUtils::loadFile_emptyFile()
+{
+    const QString filePath = createFile("empty.yaml", QByteArray());
+    QVERIFY(QSocYamlUtils::loadFile(filePath).IsNull());
+}
+
+void TestQSocYamlUtils::loadFile_missingFile()
+{
+    bool thrown = false;
+    try {
+        QSocYamlUtils::loadFile(tempDir.filePath("missing.yaml"));
+    } catch (const YAML::BadFile &) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
+
+void TestQSocYamlUtils::loadFile_parseError()
+{
+    const QString filePath = createFile("broken.yaml", "port:\n  clk: [input\n  rst: x\n");
+    QString       error;
+    try {
+        QSocYamlUtils::loadFile(filePath);
+    } catch (const YAML::ParserException &e) {
+        error = e.what();
+    }
+    QVERIFY(!error.isEmpty());
+}
+
+void TestQSocYamlUtils::saveFile_replace()
+{
+    const QString filePath = createFile("save.yaml", "module: old\nport: {}\n");
+    YAML::Node    node;
+    node["module"]             = "new";
+    node["port"]["clk"]["type"] = "logic";
+
+    QVERIFY(QSocYamlUtils::saveFile(filePath, node));
+    const YAML::Node loaded = QSocYamlUtils::loadFile(filePath);
+    QCOMPARE(QSocYamlUtils::yamlNodeToString(loaded), QSocYamlUtils::yamlNodeToString(node));
+    /* Nothing is left behind next to the target */
+    QCOMPARE(QDir(tempDir.path()).entryList({"save.yaml*"}, QDir::Files), QStringList{"save.yaml"});
+}
+
+void TestQSocYamlUtils::saveFile_failureKeepsFile()
+{
+    const QString filePath = createFile("keep.yaml", "module: old\n");
+    YAML::Node    node;
+    node["module"] = "new";
+    QVERIFY(!QSocYamlUtils::saveFile(tempDir.filePath("missing/keep.yaml"), node));
+
+    /* A read-only directory refuses the temporary file, the old file stays */
+    QFile::setPermissions(tempDir.path(), QFile::ReadOwner | QFile::ExeOwner);
+    const bool saved = QSocYamlUtils::saveFile(filePath, node);
+    QFile::setPermissions(
+        tempDir.path(), QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+    if (saved) {
+        QSKIP("Directory permissions are not enforced for this user");
+    }
+    QCOMPARE(QSocYamlUtils::loadFile(filePath)["module"].as<std::string>(), std::string("old"));
+}
+
+QTEST_APPLESS_MAIN(TestQSocYamlUtils)
+#include "test_qsoccommonqsocyamlutils.moc"
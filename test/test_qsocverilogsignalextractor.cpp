@@ -85,6 +85,16 @@ private slots:
     void realWorld_busInterface();
     void realWorld_fifoControl();
     void realWorld_arithmeticUnit();
+
+    /*
+     * Batched Analysis Tests
+     * Test in-memory syntax-level extraction over many snippets at once
+     */
+    void batch_match_legacyExtractor();
+    void batch_infer_bitWidths();
+    void batch_exclude_parameters();
+    void batch_isolate_syntaxError();
+    void batch_handle_emptyInput();
 };
 
 void Test::initTestCase()
@@ -907,6 +917,141 @@ assign carry_out = cout[31];
     QVERIFY(signalSet.contains("cout"));
 }
 
+/* ========== Batched Analysis Tests ========== */
+/* Test the in-memory batched extractor used by collectCombSeqFsmSignals */
+
+void Test::batch_match_legacyExtractor()
+{
+    /* Batched syntax-level extraction must agree with the elaborating extractor */
+    const QStringList snippets = {
+        "assign y = a & b;",
+        "assign out = in1 & in2 | in3;",
+        "assign result = data_in[7:0] + counter;",
+        "assign out = sel ? input_a[31:0] : input_b[31:0];",
+        "assign result = {upper[7:0], lower[7:0]};",
+        "assign out = ((a[7:0] & b[7:0]) | (c[15:8] ^ d[15:8])) + e[31:16];",
+        R"(
+reg [31:0] result_reg;
+assign result = result_reg;
+
+always @(*) begin
+    result_reg = 32'b0;
+    if (sel == 2'b00)
+        result_reg = a;
+    else if (sel == 2'b01)
+        result_reg = b;
+end
+)",
+        R"(
+reg [7:0] data_reg;
+assign data = data_reg;
+
+always @(posedge clk or negedge rst_n) begin
+    if (!rst_n)
+        data_reg <= 8'h00;
+    else
+        data_reg <= data_in;
+end
+)",
+        R"(
+always @(*) begin
+    case (ctrl)
+        2'b00: output_reg = input_a;
+        2'b01: output_reg = input_b;
+        2'b10: output_reg = input_c;
+        default: output_reg = 8'h00;
+    endcase
+end
+)",
+    };
+
+    const QList<QSlangDriver::SnippetSignalInfo> infoList = QSlangDriver::analyzeVerilogSnippets(
+        snippets);
+    QCOMPARE(infoList.size(), snippets.size());
+
+    for (qsizetype i = 0; i < snippets.size(); ++i) {
+        QSlangDriver driver;
+        QVERIFY(driver.parseVerilogSnippet(snippets.at(i), true));
+        QVERIFY(infoList.at(i).valid);
+        QCOMPARE(infoList.at(i).signalSet, driver.extractSignalReferences());
+    }
+}
+
+void Test::batch_infer_bitWidths()
+{
+    /* Widths are the maximum constant index seen per signal in each snippet */
+    const QStringList snippets = {
+        "assign out = data[7:0] + data[15:8];",
+        "assign result = input_data[12:5];",
+        "assign flag = status[127];",
+        "assign result = enable & ready;",
+    };
+
+    const QList<QSlangDriver::SnippetSignalInfo> infoList = QSlangDriver::analyzeVerilogSnippets(
+        snippets);
+    QCOMPARE(infoList.size(), 4);
+    QCOMPARE(infoList.at(0).bitWidths.value("data"), 16);
+    QVERIFY(!infoList.at(0).bitWidths.contains("out"));
+    QCOMPARE(infoList.at(1).bitWidths.value("input_data"), 13);
+    QCOMPARE(infoList.at(2).bitWidths.value("status"), 128);
+    QVERIFY(infoList.at(3).bitWidths.isEmpty());
+    /* Widths must not leak between snippets */
+    QVERIFY(!infoList.at(1).bitWidths.contains("data"));
+}
+
+void Test::batch_exclude_parameters()
+{
+    /* Parameters and internal names are constants, not signals */
+    const QStringList snippets = {
+        "localparam WIDTH = 8;\nassign out = in_data[WIDTH-1:0] & __internal;",
+    };
+
+    const QList<QSlangDriver::SnippetSignalInfo> infoList = QSlangDriver::analyzeVerilogSnippets(
+        snippets);
+    QCOMPARE(infoList.size(), 1);
+    QVERIFY(infoList.at(0).valid);
+    QVERIFY(infoList.at(0).signalSet.contains("out"));
+    QVERIFY(infoList.at(0).signalSet.contains("in_data"));
+    QVERIFY(!infoList.at(0).signalSet.contains("WIDTH"));
+    QVERIFY(!infoList.at(0).signalSet.contains("__internal"));
+}
+
+void Test::batch_isolate_syntaxError()
+{
+    /* A broken snippet must not affect its neighbours in the batch */
+    const QStringList snippets = {
+        "assign a_out = a_in;",
+        "always @(*) begin assign broken = ;",
+        "assign c_out = c_in[3:0];",
+    };
+
+    const QList<QSlangDriver::SnippetSignalInfo> infoList = QSlangDriver::analyzeVerilogSnippets(
+        snippets);
+    QCOMPARE(infoList.size(), 3);
+
+    QVERIFY(infoList.at(0).valid);
+    QCOMPARE(infoList.at(0).signalSet, QSet<QString>({"a_out", "a_in"}));
+
+    QVERIFY(!infoList.at(1).valid);
+
+    QVERIFY(infoList.at(2).valid);
+    QCOMPARE(infoList.at(2).signalSet, QSet<QString>({"c_out", "c_in"}));
+    QCOMPARE(infoList.at(2).bitWidths.value("c_in"), 4);
+}
+
+void Test::batch_handle_emptyInput()
+{
+    /* No snippets means no parse and no results */
+    QVERIFY(QSlangDriver::analyzeVerilogSnippets({}).isEmpty());
+
+    /* An empty snippet is valid and references nothing */
+    const QList<QSlangDriver::SnippetSignalInfo> infoList = QSlangDriver::analyzeVerilogSnippets(
+        {""});
+    QCOMPARE(infoList.size(), 1);
+    QVERIFY(infoList.at(0).valid);
+    QVERIFY(infoList.at(0).signalSet.isEmpty());
+}
+
 QSOC_TEST_MAIN(Test)
 
 #include "test_qsocverilogsignalextractor.moc"